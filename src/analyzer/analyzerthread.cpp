@@ -1,5 +1,7 @@
 #include "analyzer/analyzerthread.h"
 
+#include <QThread>
+#include <atomic>
 #include <mutex>
 
 #include "analyzer/analyzerbeats.h"
@@ -12,6 +14,7 @@
 #include "engine/engine.h"
 #include "library/dao/analysisdao.h"
 #include "moc_analyzerthread.cpp"
+#include "sources/audiosourceparallelproxy.h"
 #include "sources/audiosourcestereoproxy.h"
 #include "sources/soundsourceproxy.h"
 #include "track/track.h"
@@ -36,6 +39,60 @@ mixxx::Logger kLogger("AnalyzerThread");
 // continuous feedback.
 const mixxx::Duration kBusyProgressInhibitDuration = mixxx::Duration::fromMillis(60);
 
+// The segments of tracks with these file types are decoded in parallel.
+// Their decoders produce identical samples after seeking, i.e. the
+// result is bit-exact compared to decoding sequentially.
+const QStringList kParallelDecodingFileTypes = {
+        QStringLiteral("aiff"),
+        QStringLiteral("flac"),
+        QStringLiteral("wav"),
+};
+
+constexpr int kMaxParallelDecodingSources = 4;
+
+// Batch analysis already runs one AnalyzerThread per core
+std::atomic<int> s_runningAnalyzerThreads(0);
+
+// Opens additional instances of the audio source with the same provider
+// for decoding multiple segments of the track in parallel.
+mixxx::AudioSourcePointer openParallelAudioSource(
+        const TrackPointer& pTrack,
+        const mixxx::SoundSourceProviderPointer& pProvider,
+        mixxx::AudioSourcePointer pAudioSource,
+        const mixxx::AudioSource::OpenParams& openParams) {
+    // Each running analyzer thread gets an equal share of the cores, one of
+    // them is busy with the analysis itself. The remaining ones are used
+    // for decoding, so the cores are not oversubscribed.
+    const int runningAnalyzerThreads = math_max(1, s_runningAnalyzerThreads.load());
+    const int maxSourceCount = math_min(kMaxParallelDecodingSources,
+            QThread::idealThreadCount() / runningAnalyzerThreads - 1);
+    if (maxSourceCount < 2 ||
+            !kParallelDecodingFileTypes.contains(pTrack->getType()) ||
+            pAudioSource->frameLength() <
+                    2 * mixxx::AudioSourceParallelProxy::kDefaultSegmentFrames) {
+        return pAudioSource;
+    }
+    std::vector<mixxx::AudioSourcePointer> audioSources;
+    audioSources.push_back(pAudioSource);
+    while (static_cast<int>(audioSources.size()) < maxSourceCount) {
+        auto pParallelAudioSource =
+                SoundSourceProxy(pTrack, pProvider).openAudioSource(openParams);
+        if (!pParallelAudioSource ||
+                pParallelAudioSource->getSignalInfo() != pAudioSource->getSignalInfo() ||
+                pParallelAudioSource->frameIndexRange() != pAudioSource->frameIndexRange()) {
+            break;
+        }
+        audioSources.push_back(std::move(pParallelAudioSource));
+    }
+    if (audioSources.size() < 2) {
+        return pAudioSource;
+    }
+    kLogger.debug()
+            << "Decoding" << pTrack->getFileInfo()
+            << "with" << audioSources.size() << "parallel audio sources";
+    return std::make_shared<mixxx::AudioSourceParallelProxy>(std::move(audioSources));
+}
+
 void deleteAnalyzerThread(AnalyzerThread* plainPtr) {
     if (plainPtr) {
         plainPtr->deleteAfterFinished();
@@ -125,13 +182,14 @@ void AnalyzerThread::doRun() {
     mixxx::AudioSource::OpenParams openParams;
     openParams.setChannelCount(mixxx::kAnalysisChannels);
 
+    s_runningAnalyzerThreads.fetch_add(1);
     while (awaitWorkItemsFetched()) {
         DEBUG_ASSERT(m_currentTrack);
         kLogger.debug() << "Analyzing" << m_currentTrack->getFileInfo();
 
         // Get the audio
-        const auto audioSource =
-                SoundSourceProxy(m_currentTrack).openAudioSource(openParams);
+        SoundSourceProxy soundSourceProxy(m_currentTrack);
+        auto audioSource = soundSourceProxy.openAudioSource(openParams);
         if (!audioSource) {
             kLogger.warning()
                     << "Failed to open file for analyzing:"
@@ -152,6 +210,12 @@ void AnalyzerThread::doRun() {
         }
 
         if (processTrack) {
+            // Only open additional sources once they are actually needed
+            audioSource = openParallelAudioSource(
+                    m_currentTrack,
+                    soundSourceProxy.getProvider(),
+                    std::move(audioSource),
+                    openParams);
             const auto analysisResult = analyzeAudioSource(audioSource);
             DEBUG_ASSERT(analysisResult != AnalysisResult::Pending);
             if (analysisResult == AnalysisResult::Finished) {
@@ -178,6 +242,7 @@ void AnalyzerThread::doRun() {
             emitDoneProgress(kAnalyzerProgressDone);
         }
     }
+    s_runningAnalyzerThreads.fetch_sub(1);
     DEBUG_ASSERT(!m_currentTrack);
     DEBUG_ASSERT(isStopping());
 
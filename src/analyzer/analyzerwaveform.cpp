@@ -252,6 +252,9 @@ bool AnalyzerWaveform::processSamples(const CSAMPLE* buffer, const int bufferLen
         }
     }
 
+    m_waveform->updatePyramid();
+    m_waveformSummary->updatePyramid();
+
     //kLogger.debug() << "process - m_waveform->getCompletion()" << m_waveform->getCompletion() << "off" << m_waveform->getDataSize();
     //kLogger.debug() << "process - m_waveformSummary->getCompletion()" << m_waveformSummary->getCompletion() << "off" << m_waveformSummary->getDataSize();
     return true;
@@ -269,6 +272,7 @@ void AnalyzerWaveform::storeResults(TrackPointer tio) {
     if (m_waveform) {
         m_waveform->setSaveState(Waveform::SaveState::SavePending);
         m_waveform->setCompletion(m_waveform->getDataSize());
+        m_waveform->updatePyramid();
         m_waveform->setVersion(WaveformFactory::currentWaveformVersion());
         m_waveform->setDescription(WaveformFactory::currentWaveformDescription());
     }
@@ -278,6 +282,7 @@ void AnalyzerWaveform::storeResults(TrackPointer tio) {
     if (m_waveformSummary) {
         m_waveformSummary->setSaveState(Waveform::SaveState::SavePending);
         m_waveformSummary->setCompletion(m_waveformSummary->getDataSize());
+        m_waveformSummary->updatePyramid();
         m_waveformSummary->setVersion(WaveformFactory::currentWaveformSummaryVersion());
         m_waveformSummary->setDescription(WaveformFactory::currentWaveformSummaryDescription());
     }
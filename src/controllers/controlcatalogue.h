@@ -0,0 +1,220 @@
+#pragma once
+
+#include <QCoreApplication>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "preferences/configobject.h"
+#include "util/class.h"
+
+/// Immutable catalogue of all controls that can be mapped by a controller,
+/// with their titles and descriptions and the menu structure in which they
+/// are presented to the user.
+///
+/// Building it creates a few thousand entries, so it is done only once and
+/// shared by all ControlPickerMenu, ControlDelegate and learning wizard
+/// instances. It is only rebuilt when the number of decks, samplers,
+/// preview decks, microphones or auxiliaries has changed since.
+class ControlCatalogue {
+    // Keep the translations of the former ControlPickerMenu builder
+    Q_DECLARE_TR_FUNCTIONS(ControlPickerMenu)
+
+  public:
+    struct Control {
+        ConfigKey key;
+        QString title;
+        QString description;
+    };
+
+    /// A node of the menu tree. Each entry is either a submenu, a control
+    /// or a separator.
+    class Menu {
+      public:
+        struct Entry {
+            std::unique_ptr<Menu> pSubmenu;
+            int controlIndex = -1;
+            QString actionTitle;
+
+            bool isSeparator() const {
+                return !pSubmenu && controlIndex < 0;
+            }
+        };
+
+        explicit Menu(const QString& title)
+                : m_title(title) {
+        }
+
+        const QString& title() const {
+            return m_title;
+        }
+        const std::vector<Entry>& entries() const {
+            return m_entries;
+        }
+
+        Menu* addMenu(const QString& title);
+        Menu* addMenu(std::unique_ptr<Menu> pMenu);
+        void addControl(int controlIndex, const QString& actionTitle);
+        void addSeparator();
+
+      private:
+        QString m_title;
+        std::vector<Entry> m_entries;
+
+        DISALLOW_COPY_AND_ASSIGN(Menu);
+    };
+
+    /// Builds the catalogue for the current number of players. Prefer
+    /// the shared instance().
+    ControlCatalogue();
+
+    /// Returns the shared catalogue, built on first use. Must only be
+    /// called from the main thread. Previously returned instances stay
+    /// valid after a rebuild.
+    static std::shared_ptr<const ControlCatalogue> instance();
+
+    const Menu& rootMenu() const {
+        return *m_pRootMenu;
+    }
+
+    /// All controls in menu order. A control index refers to this list.
+    const QList<ConfigKey>& controlsAvailable() const {
+        return m_controlsAvailable;
+    }
+    const Control& control(int controlIndex) const {
+        return m_controls[controlIndex];
+    }
+
+    /// The indices of all controls sorted by their title.
+    const std::vector<int>& controlIndicesByTitle() const {
+        return m_controlIndicesByTitle;
+    }
+
+    bool controlExists(const ConfigKey& key) const;
+    QString descriptionForConfigKey(const ConfigKey& key) const;
+    QString controlTitleForConfigKey(const ConfigKey& key) const;
+
+    /// Returns the indices of all controls, in menu order, whose title,
+    /// description, group or item contain a word starting with each of the
+    /// words in text. The search is case insensitive.
+    std::vector<int> search(const QString& text) const;
+
+  private:
+    /// The numbers the menu structure depends on
+    struct PlayerCounts {
+        int decks = 0;
+        int samplers = 0;
+        int previewDecks = 0;
+        int microphones = 0;
+        int auxiliaries = 0;
+
+        static PlayerCounts current();
+
+        bool operator==(const PlayerCounts& other) const {
+            return decks == other.decks &&
+                    samplers == other.samplers &&
+                    previewDecks == other.previewDecks &&
+                    microphones == other.microphones &&
+                    auxiliaries == other.auxiliaries;
+        }
+    };
+
+    Menu* addSubmenu(const QString& title, Menu* pParent = nullptr);
+    void addSingleControl(const QString& group,
+            const QString& control,
+            const QString& title,
+            const QString& description,
+            Menu* pMenu,
+            const QString& prefix = QString(),
+            const QString& actionTitle = QString());
+    void addControl(const QString& group,
+            const QString& control,
+            const QString& title,
+            const QString& helpText,
+            Menu* pMenu,
+            bool addReset = false,
+            const QString& prefix = QString());
+    void addPlayerControl(const QString& control,
+            const QString& title,
+            const QString& helpText,
+            Menu* pMenu,
+            bool deckControls,
+            bool samplerControls,
+            bool previewdeckControls,
+            bool addReset = false);
+    void addDeckAndSamplerControl(const QString& control,
+            const QString& title,
+            const QString& helpText,
+            Menu* pMenu,
+            bool addReset = false);
+    void addDeckAndPreviewDeckControl(const QString& control,
+            const QString& title,
+            const QString& helpText,
+            Menu* pMenu,
+            bool addReset = false);
+    void addDeckAndSamplerAndPreviewDeckControl(const QString& control,
+            const QString& title,
+            const QString& helpText,
+            Menu* pMenu,
+            bool addReset = false);
+    void addDeckControl(const QString& control,
+            const QString& title,
+            const QString& helpText,
+            Menu* pMenu,
+            bool addReset = false);
+    void addSamplerControl(const QString& control,
+            const QString& title,
+            const QString& helpText,
+            Menu* pMenu,
+            bool addReset = false);
+    void addPreviewDeckControl(const QString& control,
+            const QString& title,
+            const QString& helpText,
+            Menu* pMenu,
+            bool addReset = false);
+    void addMicrophoneAndAuxControl(const QString& control,
+            const QString& title,
+            const QString& helpText,
+            Menu* pMenu,
+            bool microphoneControls,
+            bool auxControls,
+            bool addReset = false);
+
+    int addAvailableControl(const ConfigKey& key, const QString& title, const QString& description);
+
+    void buildIndex();
+
+    const PlayerCounts m_playerCounts;
+
+    QString m_effectMasterOutputStr;
+    QString m_effectHeadphoneOutputStr;
+    QString m_deckStr;
+    QString m_previewdeckStr;
+    QString m_samplerStr;
+    QString m_resetStr;
+    QString m_microphoneStr;
+    QString m_auxStr;
+    QString m_effectRackStr;
+    QString m_effectUnitStr;
+    QString m_effectStr;
+    QString m_parameterStr;
+    QString m_buttonParameterStr;
+    QString m_libraryStr;
+
+    std::unique_ptr<Menu> m_pRootMenu;
+
+    std::vector<Control> m_controls;
+    QList<ConfigKey> m_controlsAvailable;
+    QHash<ConfigKey, QString> m_descriptionsByKey;
+    QHash<ConfigKey, QString> m_titlesByKey;
+
+    std::vector<int> m_controlIndicesByTitle;
+    // Lower case words of all controls with the control index, sorted
+    // for prefix lookups with std::lower_bound.
+    std::vector<std::pair<QString, int>> m_searchIndex;
+
+    DISALLOW_COPY_AND_ASSIGN(ControlCatalogue);
+};
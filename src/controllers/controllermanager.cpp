@@ -11,6 +11,9 @@
 #include "util/compatibility/qmutex.h"
 #include "util/time.h"
 #include "util/trace.h"
+#ifdef __ALSA_SEQ__
+#include "controllers/midi/alsaseqenumerator.h"
+#endif
 #ifdef __HSS1394__
 #include "controllers/midi/hss1394enumerator.h"
 #endif
@@ -146,7 +149,13 @@ void ControllerManager::slotInitialize() {
 
     // Instantiate all enumerators. Enumerators can take a long time to
     // construct since they interact with host MIDI APIs.
+#ifdef __ALSA_SEQ__
+    // Event driven and time stamped, replaces the polled PortMidi backend
+    // that would list the same ALSA devices again.
+    m_enumerators.append(new AlsaSeqEnumerator());
+#else
     m_enumerators.append(new PortMidiEnumerator());
+#endif
 #ifdef __HSS1394__
     m_enumerators.append(new Hss1394Enumerator(m_pConfig));
 #endif
@@ -2,9 +2,15 @@
 
 #include <QMenu>
 #include <QObject>
+#include <memory>
 
+#include "controllers/controlcatalogue.h"
 #include "preferences/usersettings.h"
 
+/// Menu for choosing a control from the shared ControlCatalogue.
+///
+/// The submenus are only populated when they are shown for the first time,
+/// so creating a picker is cheap.
 class ControlPickerMenu : public QMenu {
     Q_OBJECT
   public:
@@ -12,7 +18,11 @@ class ControlPickerMenu : public QMenu {
     virtual ~ControlPickerMenu();
 
     const QList<ConfigKey>& controlsAvailable() const {
-        return m_controlsAvailable;
+        return m_pCatalogue->controlsAvailable();
+    }
+
+    const ControlCatalogue& catalogue() const {
+        return *m_pCatalogue;
     }
 
     bool controlExists(const ConfigKey& key) const;
@@ -28,85 +38,7 @@ class ControlPickerMenu : public QMenu {
     void controlChosen(int controlIndex);
 
   private:
-    QMenu* addSubmenu(QString title, QMenu* pParent = NULL);
-    void addSingleControl(const QString& group,
-            const QString& control,
-            const QString& title,
-            const QString& description,
-            QMenu* pMenu,
-            const QString& prefix = QString(),
-            const QString& actionTitle = QString());
-    void addControl(const QString& group,
-            const QString& control,
-            const QString& title,
-            const QString& helpText,
-            QMenu* pMenu,
-            bool addReset = false,
-            const QString& prefix = QString());
-    void addPlayerControl(const QString& control,
-            const QString& title,
-            const QString& helpText,
-            QMenu* pMenu,
-            bool deckControls,
-            bool samplerControls,
-            bool previewdeckControls,
-            bool addReset = false);
-    void addDeckAndSamplerControl(const QString& control,
-            const QString& title,
-            const QString& helpText,
-            QMenu* pMenu,
-            bool addReset = false);
-    void addDeckAndPreviewDeckControl(const QString& control,
-            const QString& title,
-            const QString& helpText,
-            QMenu* pMenu,
-            bool addReset = false);
-    void addDeckAndSamplerAndPreviewDeckControl(const QString& control,
-            const QString& title,
-            const QString& helpText,
-            QMenu* pMenu,
-            bool addReset = false);
-    void addDeckControl(const QString& control,
-            const QString& title,
-            const QString& helpText,
-            QMenu* pMenu,
-            bool addReset = false);
-    void addSamplerControl(const QString& control,
-            const QString& title,
-            const QString& helpText,
-            QMenu* pMenu,
-            bool addReset = false);
-    void addPreviewDeckControl(const QString& control,
-            const QString& title,
-            const QString& helpText,
-            QMenu* pMenu,
-            bool addReset = false);
-    void addMicrophoneAndAuxControl(const QString& control,
-            const QString& title,
-            const QString& helpText,
-            QMenu* pMenu,
-            bool microphoneControls,
-            bool auxControls,
-            bool addReset = false);
-
-    int addAvailableControl(const ConfigKey& key, const QString& title, const QString& description);
-
-    QString m_effectMasterOutputStr;
-    QString m_effectHeadphoneOutputStr;
-    QString m_deckStr;
-    QString m_previewdeckStr;
-    QString m_samplerStr;
-    QString m_resetStr;
-    QString m_microphoneStr;
-    QString m_auxStr;
-    QString m_effectRackStr;
-    QString m_effectUnitStr;
-    QString m_effectStr;
-    QString m_parameterStr;
-    QString m_buttonParameterStr;
-    QString m_libraryStr;
+    void populateMenu(QMenu* pMenu, const ControlCatalogue::Menu& menu);
 
-    QList<ConfigKey> m_controlsAvailable;
-    QHash<ConfigKey, QString> m_descriptionsByKey;
-    QHash<ConfigKey, QString> m_titlesByKey;
+    const std::shared_ptr<const ControlCatalogue> m_pCatalogue;
 };
@@ -9,7 +9,7 @@
 
 ControlDelegate::ControlDelegate(QObject* pParent)
         : QStyledItemDelegate(pParent),
-          m_pPicker(new ControlPickerMenu(nullptr)),
+          m_pCatalogue(ControlCatalogue::instance()),
           m_iMidiOptionsColumn(-1),
           m_bIsIndexScript(false) {
 }
@@ -53,7 +53,7 @@ QString ControlDelegate::displayText(const QVariant& value,
         return tr("%1 %2").arg(key.group, key.item);
     }
 
-    QString description = m_pPicker->descriptionForConfigKey(key);
+    QString description = m_pCatalogue->descriptionForConfigKey(key);
     if (!description.isEmpty()) {
         return description;
     }
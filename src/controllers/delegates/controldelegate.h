@@ -1,8 +1,9 @@
 #pragma once
 
 #include <QStyledItemDelegate>
+#include <memory>
 
-#include "controllers/controlpickermenu.h"
+#include "controllers/controlcatalogue.h"
 
 class ControlDelegate : public QStyledItemDelegate {
     Q_OBJECT
@@ -28,7 +29,7 @@ class ControlDelegate : public QStyledItemDelegate {
                       const QModelIndex& index) const;
 
   private:
-    ControlPickerMenu* m_pPicker;
+    const std::shared_ptr<const ControlCatalogue> m_pCatalogue;
     int m_iMidiOptionsColumn;
     // HACK(rryan): Does the last painted index have a script
     // MidiOption. displayText does not give us the current QModelIndex so we
@@ -1,6 +1,7 @@
 #include "controllers/dlgcontrollerlearning.h"
 
 #include <QCompleter>
+#include <QLineEdit>
 
 #include "control/controlobject.h"
 #include "controllers/learningutils.h"
@@ -8,18 +9,12 @@
 #include "moc_dlgcontrollerlearning.cpp"
 #include "util/versionstore.h"
 
-namespace {
-typedef QPair<QString, ConfigKey> NamedControl;
-bool namedControlComparator(const NamedControl& l1, const NamedControl& l2) {
-    return l1.first < l2.first;
-}
-} // namespace
-
 DlgControllerLearning::DlgControllerLearning(QWidget* parent,
         Controller* controller)
         : QDialog(parent),
           m_pController(controller),
           m_controlPickerMenu(this),
+          m_pControlSearchModel(new QStandardItemModel(this)),
           m_messagesLearned(false) {
     qRegisterMetaType<MidiInputMappings>("MidiInputMappings");
 
@@ -69,8 +64,19 @@ DlgControllerLearning::DlgControllerLearning(QWidget* parent,
             this,
             &DlgControllerLearning::controlPicked);
 
-    comboBoxChosenControl->completer()->setCompletionMode(
-        QCompleter::PopupCompletion);
+    // Typing into the combo box searches all words of the title,
+    // description, group and item of the controls, not only title prefixes.
+    QCompleter* pCompleter = new QCompleter(m_pControlSearchModel, this);
+    pCompleter->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    comboBoxChosenControl->setCompleter(pCompleter);
+    connect(comboBoxChosenControl->lineEdit(),
+            &QLineEdit::textEdited,
+            this,
+            &DlgControllerLearning::slotControlSearchTextEdited);
+    connect(pCompleter,
+            QOverload<const QModelIndex&>::of(&QCompleter::activated),
+            this,
+            &DlgControllerLearning::slotControlSearchActivated);
     populateComboBox();
     connect(comboBoxChosenControl,
             QOverload<int>::of(&QComboBox::currentIndexChanged),
@@ -145,22 +151,38 @@ DlgControllerLearning::DlgControllerLearning(QWidget* parent,
 }
 
 void DlgControllerLearning::populateComboBox() {
-    // Sort all of the controls and add them to the combo box
+    // Add all of the controls to the combo box, the catalogue has them
+    // already sorted by title.
+    const ControlCatalogue& catalogue = m_controlPickerMenu.catalogue();
     comboBoxChosenControl->clear();
     comboBoxChosenControl->addItem("", QVariant::fromValue(ConfigKey()));
-    QList<NamedControl> sorted_controls;
-    foreach(ConfigKey key, m_controlPickerMenu.controlsAvailable())
-    {
-        sorted_controls.push_back(
-                NamedControl(m_controlPickerMenu.controlTitleForConfigKey(key),
-                             key));
+    for (const int controlIndex : catalogue.controlIndicesByTitle()) {
+        const ConfigKey& key = catalogue.control(controlIndex).key;
+        comboBoxChosenControl->addItem(catalogue.controlTitleForConfigKey(key),
+                QVariant::fromValue(key));
+    }
+}
+
+void DlgControllerLearning::slotControlSearchTextEdited(const QString& text) {
+    const ControlCatalogue& catalogue = m_controlPickerMenu.catalogue();
+    m_pControlSearchModel->clear();
+    for (const int controlIndex : catalogue.search(text)) {
+        const ConfigKey& key = catalogue.control(controlIndex).key;
+        auto* pItem = new QStandardItem(catalogue.controlTitleForConfigKey(key));
+        pItem->setData(QVariant::fromValue(key));
+        m_pControlSearchModel->appendRow(pItem);
     }
-    std::sort(sorted_controls.begin(), sorted_controls.end(),
-          namedControlComparator);
-    foreach(NamedControl control, sorted_controls)
-    {
-        comboBoxChosenControl->addItem(control.first,
-                                       QVariant::fromValue(control.second));
+    comboBoxChosenControl->completer()->complete();
+}
+
+void DlgControllerLearning::slotControlSearchActivated(const QModelIndex& index) {
+    // Titles are not unique, select the control by its key
+    const ConfigKey key = index.data(Qt::UserRole + 1).value<ConfigKey>();
+    for (int i = 0; i < comboBoxChosenControl->count(); ++i) {
+        if (comboBoxChosenControl->itemData(i).value<ConfigKey>() == key) {
+            comboBoxChosenControl->setCurrentIndex(i);
+            return;
+        }
     }
 }
 
@@ -2,6 +2,7 @@
 
 #include <QDialog>
 #include <QList>
+#include <QStandardItemModel>
 #include <QString>
 #include <QTimer>
 
@@ -64,6 +65,8 @@ class DlgControllerLearning : public QDialog,
 
   private slots:
     void showControlMenu();
+    void slotControlSearchTextEdited(const QString& text);
+    void slotControlSearchActivated(const QModelIndex& index);
 #ifdef CONTROLLERLESSTESTING
     void DEBUGFakeMidiMessage();
     void DEBUGFakeMidiMessage();
@@ -78,6 +81,9 @@ class DlgControllerLearning : public QDialog,
 
     Controller* m_pController;
     ControlPickerMenu m_controlPickerMenu;
+    // The controls found by ControlCatalogue::search() for the text typed
+    // into the combo box
+    QStandardItemModel* m_pControlSearchModel;
     ConfigKey m_currentControl;
     bool m_messagesLearned;
     QTimer m_firstMessageTimer;
@@ -17,6 +17,7 @@
 #include "defs_urls.h"
 #include "moc_dlgprefcontroller.cpp"
 #include "preferences/usersettings.h"
+#include "util/timer.h"
 #include "util/versionstore.h"
 
 namespace {
@@ -47,6 +48,8 @@ DlgPrefController::DlgPrefController(
           m_pOutputProxyModel(nullptr),
           m_GuiInitialized(false),
           m_bDirty(false) {
+    // Opening the preferences creates one page per controller
+    ScopedTimer t("DlgPrefController::DlgPrefController");
     m_ui.setupUi(this);
     // Create text color for the file and wiki links
     createLinkColor();
@@ -5,14 +5,26 @@
 #include "controllers/defs_controllers.h"
 #include "controllers/hid/legacyhidcontrollermappingfilehandler.h"
 #include "moc_hidcontroller.cpp"
+#include "util/stat.h"
 #include "util/string.h"
 #include "util/time.h"
 #include "util/trace.h"
 
+namespace {
+constexpr Stat::ComputeFlags kLatencyStatFlags = Stat::COUNT | Stat::AVERAGE |
+        Stat::SAMPLE_VARIANCE | Stat::MIN | Stat::MAX;
+} // namespace
+
 HidController::HidController(
         mixxx::hid::DeviceInfo&& deviceInfo)
         : Controller(deviceInfo.formatName()),
-          m_deviceInfo(std::move(deviceInfo)) {
+          m_deviceInfo(std::move(deviceInfo)),
+          m_inputQueueLatencyStatKey(
+                  QStringLiteral("HidController %1 input queue latency")
+                          .arg(m_deviceInfo.formatName())),
+          m_inputToEngineLatencyStatKey(
+                  QStringLiteral("HidController %1 input to engine latency")
+                          .arg(m_deviceInfo.formatName())) {
     setDeviceCategory(mixxx::hid::DeviceCategory::guessFromDeviceInfo(m_deviceInfo));
 
     // All HID devices are full-duplex
@@ -114,11 +126,7 @@ int HidController::open() {
             &HidController::receive,
             Qt::QueuedConnection);
 
-    // Controller input needs to be prioritized since it can affect the
-    // audio directly, like when scratching
-    // The effect of the priority parameter is dependent on the operating system's scheduling policy.
-    // In particular, the priority will be ignored on systems that do not support thread priorities (as Linux).
-    m_pHidIoThread->start(QThread::HighPriority);
+    m_pHidIoThread->startIo();
 
     VERIFY_OR_DEBUG_ASSERT(m_pHidIoThread->testAndSetThreadState(
             HidIoThreadState::Initialized, HidIoThreadState::OutputActive)) {
@@ -197,6 +205,20 @@ int HidController::close() {
     return 0;
 }
 
+void HidController::receive(const QByteArray& data, mixxx::Duration timestamp) {
+    Stat::track(m_inputQueueLatencyStatKey,
+            Stat::DURATION_NANOSEC,
+            Stat::experimentFlags(kLatencyStatFlags),
+            (mixxx::Time::elapsed() - timestamp).toIntegerNanos());
+
+    Controller::receive(data, timestamp);
+
+    Stat::track(m_inputToEngineLatencyStatKey,
+            Stat::DURATION_NANOSEC,
+            Stat::experimentFlags(kLatencyStatFlags),
+            (mixxx::Time::elapsed() - timestamp).toIntegerNanos());
+}
+
 /// This function is only for class compatibility with the (midi)controller
 /// and will not do the same as for MIDI devices,
 /// because sending of raw bytes is not a supported HIDAPI feature.
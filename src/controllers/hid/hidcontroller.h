@@ -36,6 +36,10 @@ class HidController final : public Controller {
     int open() override;
     int close() override;
 
+    /// Tracks the latency of InputReports until they are handled by the
+    /// mapping, in addition to Controller::receive.
+    void receive(const QByteArray& data, mixxx::Duration timestamp) override;
+
   private:
     // For devices which only support a single report, reportID must be set to
     // 0x0.
@@ -43,6 +47,11 @@ class HidController final : public Controller {
 
     const mixxx::hid::DeviceInfo m_deviceInfo;
 
+    // Stat keys, from reading an InputReport to receiving it on this thread
+    // and to setting the controls from the mapping
+    const QString m_inputQueueLatencyStatKey;
+    const QString m_inputToEngineLatencyStatKey;
+
     std::unique_ptr<HidIoThread> m_pHidIoThread;
     std::shared_ptr<LegacyHidControllerMapping> m_pMapping;
 
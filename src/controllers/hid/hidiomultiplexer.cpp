@@ -0,0 +1,261 @@
+#include "controllers/hid/hidiomultiplexer.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <QtDebug>
+#include <algorithm>
+#include <cerrno>
+
+#include "moc_hidiomultiplexer.cpp"
+#include "util/assert.h"
+#include "util/time.h"
+#include "util/trace.h"
+
+namespace {
+
+constexpr int kMaxEvents = 16;
+
+// The epoll user data of the wake up and timer file descriptors. Devices
+// are identified by their address.
+char s_wakeTag;
+char s_outputTimerTag;
+
+void drainFd(int fd) {
+    uint64_t value;
+    while (read(fd, &value, sizeof(value)) > 0) {
+    }
+}
+
+} // anonymous namespace
+
+// static
+std::shared_ptr<HidIoMultiplexer> HidIoMultiplexer::instance() {
+    static QMutex s_mutex;
+    static std::weak_ptr<HidIoMultiplexer> s_pInstance;
+    const auto lock = lockMutex(&s_mutex);
+    std::shared_ptr<HidIoMultiplexer> pInstance = s_pInstance.lock();
+    if (!pInstance) {
+        pInstance = std::make_shared<HidIoMultiplexer>();
+        pInstance->setObjectName(QStringLiteral("HidIoMultiplexer"));
+        // Controller input needs to be prioritized since it can affect the
+        // audio directly, like when scratching. The priority is ignored
+        // by the default scheduling policy of Linux.
+        pInstance->start(QThread::HighPriority);
+        s_pInstance = pInstance;
+    }
+    return pInstance;
+}
+
+HidIoMultiplexer::HidIoMultiplexer()
+        : m_epollFd(epoll_create1(EPOLL_CLOEXEC)),
+          m_wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+          m_outputTimerFd(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)),
+          m_stop(0),
+          m_outputRequested(0),
+          m_outputTimerArmed(false) {
+    VERIFY_OR_DEBUG_ASSERT(m_epollFd >= 0 && m_wakeFd >= 0 && m_outputTimerFd >= 0) {
+        qWarning() << "HidIoMultiplexer: Failed to create file descriptors" << errno;
+        return;
+    }
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.ptr = &s_wakeTag;
+    epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &event);
+    event.data.ptr = &s_outputTimerTag;
+    epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_outputTimerFd, &event);
+}
+
+HidIoMultiplexer::~HidIoMultiplexer() {
+    m_stop.storeRelease(1);
+    wake();
+    wait();
+    DEBUG_ASSERT(m_devices.empty());
+    for (int fd : {m_outputTimerFd, m_wakeFd, m_epollFd}) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+void HidIoMultiplexer::addDevice(Device* pDevice) {
+    auto lock = lockMutex(&m_devicesMutex);
+    m_devices.push_back(Entry{pDevice, true, false});
+    // Input is watched once the device is active
+    lock.unlock();
+    wake();
+}
+
+void HidIoMultiplexer::removeDevice(Device* pDevice) {
+    const auto lock = lockMutex(&m_devicesMutex);
+    const auto it = std::find_if(m_devices.begin(),
+            m_devices.end(),
+            [pDevice](const Entry& entry) {
+                return entry.pDevice == pDevice;
+            });
+    if (it == m_devices.end()) {
+        return;
+    }
+    setInputWatched(&*it, false);
+    m_devices.erase(it);
+}
+
+void HidIoMultiplexer::requestOutput() {
+    if (m_outputRequested.testAndSetOrdered(0, 1)) {
+        wake();
+    }
+}
+
+void HidIoMultiplexer::wake() {
+    const uint64_t value = 1;
+    if (write(m_wakeFd, &value, sizeof(value)) < 0) {
+        // The counter can only overflow if the thread is not running
+        DEBUG_ASSERT(errno == EAGAIN);
+    }
+}
+
+void HidIoMultiplexer::run() {
+    while (m_stop.loadAcquire() == 0) {
+        epoll_event events[kMaxEvents];
+        // Sleep until something happens, no timeout
+        const int count = epoll_wait(m_epollFd, events, kMaxEvents, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            qWarning() << "HidIoMultiplexer: epoll_wait() failed" << errno;
+            break;
+        }
+        const auto timestamp = mixxx::Time::elapsed();
+        Trace process("HidIoMultiplexer process events");
+        const auto lock = lockMutex(&m_devicesMutex);
+        handleEvents(events, count, timestamp);
+        sendOutputReports();
+        updateDevices();
+        if (m_outputRequested.loadAcquire() != 0 && !m_outputTimerArmed) {
+            // Requested while the last batch was sent
+            armOutputTimer(m_lastOutputTime + kOutputFramePeriod - mixxx::Time::elapsed());
+        }
+    }
+}
+
+void HidIoMultiplexer::pollInput() {
+    // Reads InputReports which arrived while an OutputReport was written,
+    // without waiting for more.
+    epoll_event events[kMaxEvents];
+    const int count = epoll_wait(m_epollFd, events, kMaxEvents, 0);
+    if (count > 0) {
+        handleEvents(events, count, mixxx::Time::elapsed());
+    }
+}
+
+void HidIoMultiplexer::handleEvents(
+        const epoll_event* pEvents, int count, mixxx::Duration timestamp) {
+    for (int i = 0; i < count; ++i) {
+        const epoll_event& event = pEvents[i];
+        if (event.data.ptr == &s_wakeTag) {
+            // The reason is checked afterwards
+            drainFd(m_wakeFd);
+            continue;
+        }
+        if (event.data.ptr == &s_outputTimerTag) {
+            drainFd(m_outputTimerFd);
+            m_outputTimerArmed = false;
+            continue;
+        }
+        const auto it = std::find_if(m_devices.begin(),
+                m_devices.end(),
+                [&event](const Entry& entry) {
+                    return entry.pDevice == event.data.ptr;
+                });
+        if (it == m_devices.end()) {
+            // Removed while the event was pending
+            continue;
+        }
+        if (event.events & (EPOLLERR | EPOLLHUP)) {
+            // The device has been unplugged, the file descriptor stays
+            // readable until it is closed.
+            qWarning() << "HidIoMultiplexer: Device disconnected or failed,"
+                       << "InputReports are no longer read";
+            it->failed = true;
+            setInputWatched(&*it, false);
+            continue;
+        }
+        if (!it->pDevice->isInputActive()) {
+            // Leave the reports in the kernel buffer for now
+            setInputWatched(&*it, false);
+            continue;
+        }
+        it->pDevice->readInputReports(timestamp);
+    }
+}
+
+void HidIoMultiplexer::sendOutputReports() {
+    if (m_outputRequested.loadAcquire() == 0) {
+        return;
+    }
+    const auto now = mixxx::Time::elapsed();
+    const auto nextFrame = m_lastOutputTime + kOutputFramePeriod;
+    if (now < nextFrame) {
+        // Collect more reports until the next frame begins, the timer is
+        // armed by the caller
+        return;
+    }
+    m_lastOutputTime = now;
+    // Reports cached from now on are sent in the next frame
+    m_outputRequested.storeRelease(0);
+    bool pending = false;
+    for (const auto& entry : m_devices) {
+        pending |= entry.pDevice->sendOutputReports([this] { pollInput(); });
+    }
+    if (pending) {
+        m_outputRequested.storeRelease(1);
+    }
+}
+
+void HidIoMultiplexer::updateDevices() {
+    auto it = m_devices.begin();
+    while (it != m_devices.end()) {
+        if (it->pDevice->checkStopped([this] { pollInput(); })) {
+            Device* pDevice = it->pDevice;
+            setInputWatched(&*it, false);
+            it = m_devices.erase(it);
+            pDevice->removed();
+            continue;
+        }
+        if (it->inputPaused && !it->failed && it->pDevice->isInputActive()) {
+            setInputWatched(&*it, true);
+        }
+        ++it;
+    }
+}
+
+void HidIoMultiplexer::armOutputTimer(mixxx::Duration delay) {
+    itimerspec spec = {};
+    const qint64 nanos = std::max<qint64>(delay.toIntegerNanos(), 1);
+    spec.it_value.tv_sec = static_cast<time_t>(nanos / 1000000000);
+    spec.it_value.tv_nsec = static_cast<long>(nanos % 1000000000);
+    if (timerfd_settime(m_outputTimerFd, 0, &spec, nullptr) == 0) {
+        m_outputTimerArmed = true;
+    }
+}
+
+void HidIoMultiplexer::setInputWatched(Entry* pEntry, bool watched) {
+    if (pEntry->inputPaused == !watched) {
+        return;
+    }
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.ptr = pEntry->pDevice;
+    const int fd = pEntry->pDevice->fileDescriptor();
+    // Errors and hang ups are always reported, so the file descriptor
+    // is removed from the set instead of clearing EPOLLIN.
+    if (watched) {
+        epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event);
+    } else {
+        epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    }
+    pEntry->inputPaused = !watched;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QThread>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "util/compatibility/qmutex.h"
+#include "util/duration.h"
+
+struct epoll_event;
+
+/// Single IO thread for all HID devices on Linux
+///
+/// Instead of one thread per device that polls hidapi and sleeps in
+/// between, the hidraw file descriptors of all open devices are watched
+/// with epoll. The thread only wakes up when an InputReport arrives, when
+/// OutputReports have been cached or when the state of a device changed.
+///
+/// OutputReports are coalesced: All reports cached by the mappings within
+/// one output frame are sent together, superseded reports are skipped.
+class HidIoMultiplexer : public QThread {
+    Q_OBJECT
+  public:
+    /// Interface of a device, all functions are called on the IO thread
+    /// with the exception of fileDescriptor().
+    class Device {
+      public:
+        virtual ~Device() = default;
+
+        /// The non-blocking hidraw file descriptor
+        virtual int fileDescriptor() const = 0;
+        /// If false, InputReports are left in the kernel buffer until
+        /// the device becomes active again.
+        virtual bool isInputActive() const = 0;
+        /// Reads all available InputReports. The timestamp is the time the
+        /// thread woke up, which is close to the arrival of the report.
+        virtual void readInputReports(mixxx::Duration timestamp) = 0;
+        /// Sends every cached OutputReport once. pollInput must be called
+        /// after each report, because writing takes up to a few
+        /// milliseconds. Returns true if reports are still pending.
+        virtual bool sendOutputReports(const std::function<void()>& pollInput) = 0;
+        /// Returns true if the device has stopped and must be removed.
+        virtual bool checkStopped(const std::function<void()>& pollInput) = 0;
+        /// Called after the device has been removed when it stopped. The
+        /// device may be destroyed immediately afterwards.
+        virtual void removed() = 0;
+    };
+
+    /// The shared instance, which is started on first use and stopped
+    /// when the last reference is released.
+    static std::shared_ptr<HidIoMultiplexer> instance();
+
+    HidIoMultiplexer();
+    ~HidIoMultiplexer() override;
+
+    void addDevice(Device* pDevice);
+    /// Blocks until the IO thread is no longer using the device.
+    void removeDevice(Device* pDevice);
+
+    /// Sends the cached OutputReports of all devices at the begin of the
+    /// next output frame. Wait-free if output is already requested.
+    void requestOutput();
+    /// Wakes up the IO thread to check the states of all devices.
+    void wake();
+
+    /// The minimum interval between two batches of OutputReports. This is
+    /// the frame period of USB full speed devices, like most controllers.
+    static constexpr mixxx::Duration kOutputFramePeriod =
+            mixxx::Duration::fromMicros(1000);
+
+  protected:
+    void run() override;
+
+  private:
+    struct Entry {
+        Device* pDevice;
+        // The file descriptor is only in the epoll set while input is
+        // watched.
+        bool inputPaused;
+        bool failed;
+    };
+
+    void pollInput();
+    void handleEvents(const epoll_event* pEvents, int count, mixxx::Duration timestamp);
+    void sendOutputReports();
+    void updateDevices();
+    void armOutputTimer(mixxx::Duration delay);
+    void setInputWatched(Entry* pEntry, bool watched);
+
+    int m_epollFd;
+    // Written to wake up the IO thread
+    int m_wakeFd;
+    // Expires at the begin of the next output frame
+    int m_outputTimerFd;
+    QAtomicInt m_stop;
+    QAtomicInt m_outputRequested;
+    bool m_outputTimerArmed;
+    mixxx::Duration m_lastOutputTime;
+
+    /// Locked by the IO thread while using the devices
+    QMutex m_devicesMutex;
+    std::vector<Entry> m_devices;
+};
@@ -1,6 +1,12 @@
 #include "controllers/hid/hidiooutputreport.h"
 
 #include <hidapi.h>
+#ifdef __LINUX__
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
 
 #include "controllers/defs_controllers.h"
 #include "controllers/hid/legacyhidcontrollermappingfilehandler.h"
@@ -69,8 +75,14 @@ void HidIoOutputReport::updateCachedData(const QByteArray& data,
     m_resendUnchangedReport = resendUnchangedReport;
 }
 
+bool HidIoOutputReport::hasUnsentData() {
+    auto cacheLock = lockMutex(&m_cachedDataMutex);
+    return m_possiblyUnsentDataCached;
+}
+
 bool HidIoOutputReport::sendCachedData(QMutex* pHidDeviceAndPollMutex,
         hid_device* pHidDevice,
+        int hidrawFd,
         const mixxx::hid::DeviceInfo& deviceInfo,
         const RuntimeLoggingCategory& logOutput) {
     auto startOfHidWrite = mixxx::Time::elapsed();
@@ -117,16 +129,35 @@ bool HidIoOutputReport::sendCachedData(QMutex* pHidDeviceAndPollMutex,
 
     auto hidDeviceLock = lockMutex(pHidDeviceAndPollMutex);
 
-    // hid_write can take several milliseconds, because hidapi synchronizes
-    // the asyncron HID communication from the OS
-    int result = hid_write(pHidDevice,
-            reinterpret_cast<const unsigned char*>(m_lastSentData.constData()),
-            m_lastSentData.size());
-    if (result == -1) {
-        qCWarning(logOutput) << "Unable to send data to" << deviceInfo.formatName() << ":"
-                             << mixxx::convertWCStringToQString(
-                                        hid_error(pHidDevice),
-                                        kMaxHidErrorMessageSize);
+    int result;
+#ifdef __LINUX__
+    if (hidrawFd >= 0) {
+        // Like hid_write of the hidraw backend of hidapi, this blocks until
+        // the kernel driver has sent the report.
+        result = static_cast<int>(write(hidrawFd,
+                m_lastSentData.constData(),
+                m_lastSentData.size()));
+        if (result < 0) {
+            qCWarning(logOutput) << "Unable to send data to" << deviceInfo.formatName() << ":"
+                                 << strerror(errno);
+            result = -1;
+        }
+    } else
+#else
+    Q_UNUSED(hidrawFd);
+#endif
+    {
+        // hid_write can take several milliseconds, because hidapi synchronizes
+        // the asyncron HID communication from the OS
+        result = hid_write(pHidDevice,
+                reinterpret_cast<const unsigned char*>(m_lastSentData.constData()),
+                m_lastSentData.size());
+        if (result == -1) {
+            qCWarning(logOutput) << "Unable to send data to" << deviceInfo.formatName() << ":"
+                                 << mixxx::convertWCStringToQString(
+                                            hid_error(pHidDevice),
+                                            kMaxHidErrorMessageSize);
+        }
     }
 
     hidDeviceLock.unlock();
@@ -18,11 +18,17 @@ class HidIoOutputReport {
 
     /// Sends the OutputReport to the HID device, when changed data are cached.
     /// Returns true if a time consuming hid_write operation was executed.
+    /// If hidrawFd is valid, the report is written to the hidraw file descriptor
+    /// directly instead of using HIDAPI.
     bool sendCachedData(QMutex* pHidDeviceAndPollMutex,
             hid_device* pHidDevice,
+            int hidrawFd,
             const mixxx::hid::DeviceInfo& deviceInfo,
             const RuntimeLoggingCategory& logOutput);
 
+    /// Returns true if data are cached, which may not have been sent yet
+    bool hasUnsentData();
+
   private:
     const quint8 m_reportId;
     QByteArray m_lastSentData;
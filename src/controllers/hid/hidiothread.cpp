@@ -1,11 +1,21 @@
 #include "controllers/hid/hidiothread.h"
 
 #include <hidapi.h>
+#ifdef __LINUX__
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
 
 #include <QTimer>
 
 #include "controllers/defs_controllers.h"
 #include "controllers/hid/legacyhidcontrollermappingfilehandler.h"
+#ifdef __LINUX__
+#include "controllers/hid/hidiomultiplexer.h"
+#endif
 #include "moc_hidiothread.cpp"
 #include "util/string.h"
 #include "util/time.h"
@@ -28,8 +38,81 @@ QString loggingCategoryPrefix(const QString& deviceName) {
     return QStringLiteral("controller.") +
             RuntimeLoggingCategory::removeInvalidCharsFromCategory(deviceName.toLower());
 }
+
+#ifdef __LINUX__
+int openHidraw(const mixxx::hid::DeviceInfo& deviceInfo) {
+    // The hidraw backend of hidapi uses the device node as path
+    if (qstrncmp(deviceInfo.pathRaw(), "/dev/hidraw", 11) != 0) {
+        return -1;
+    }
+    const int fd = open(deviceInfo.pathRaw(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        qWarning() << "Unable to open" << deviceInfo.pathRaw()
+                   << "for the HID IO multiplexer:" << strerror(errno);
+    }
+    return fd;
+}
+#endif
 } // namespace
 
+#ifdef __LINUX__
+class HidIoThread::MultiplexedDevice : public HidIoMultiplexer::Device {
+  public:
+    explicit MultiplexedDevice(HidIoThread* pThread)
+            : m_pThread(pThread) {
+    }
+
+    int fileDescriptor() const override {
+        return m_pThread->m_hidrawFd;
+    }
+
+    bool isInputActive() const override {
+        return m_pThread->m_state.loadAcquire() ==
+                static_cast<int>(HidIoThreadState::InputOutputActive);
+    }
+
+    void readInputReports(mixxx::Duration timestamp) override {
+        m_pThread->readHidrawInputReports(timestamp);
+    }
+
+    bool sendOutputReports(const std::function<void()>& pollInput) override {
+        // Each report is sent at most once per output frame, the
+        // HidIoOutputReports only keep the most recent data.
+        for (std::size_t i = 0; i < m_pThread->m_outputReports.size(); ++i) {
+            if (!m_pThread->sendNextCachedOutputReport()) {
+                return false;
+            }
+            pollInput();
+        }
+        return m_pThread->hasUnsentOutputReports();
+    }
+
+    bool checkStopped(const std::function<void()>& pollInput) override {
+        // Same order as in HidIoThread::run()
+        if (m_pThread->testAndSetThreadState(
+                    HidIoThreadState::StopRequested, HidIoThreadState::Stopped)) {
+            return true;
+        }
+        if (m_pThread->m_state.loadAcquire() !=
+                static_cast<int>(HidIoThreadState::StopWhenAllReportsSent)) {
+            return false;
+        }
+        while (m_pThread->sendNextCachedOutputReport()) {
+            pollInput();
+        }
+        return m_pThread->testAndSetThreadState(
+                HidIoThreadState::StopWhenAllReportsSent, HidIoThreadState::Stopped);
+    }
+
+    void removed() override {
+        m_pThread->m_runLoopSemaphore.release();
+    }
+
+  private:
+    HidIoThread* const m_pThread;
+};
+#endif
+
 HidIoThread::HidIoThread(
         hid_device* pHidDevice, const mixxx::hid::DeviceInfo& deviceInfo)
         : QThread(),
@@ -49,13 +132,44 @@ HidIoThread::HidIoThread(
         memset(m_pPollData[i], 0, kBufferSize);
     }
     m_outputReportIterator = m_outputReports.begin();
+#ifdef __LINUX__
+    m_hidrawFd = openHidraw(deviceInfo);
+#endif
     m_state.storeRelease(static_cast<int>(HidIoThreadState::Initialized));
 }
 
 HidIoThread::~HidIoThread() {
+#ifdef __LINUX__
+    if (m_pMultiplexer) {
+        // No-op if the device has already stopped
+        m_pMultiplexer->removeDevice(m_pMultiplexedDevice.get());
+    }
+    if (m_hidrawFd >= 0) {
+        close(m_hidrawFd);
+    }
+#endif
     hid_close(m_pHidDevice);
 }
 
+void HidIoThread::startIo() {
+#ifdef __LINUX__
+    if (m_hidrawFd >= 0) {
+        // Acquired on behalf of the multiplexer until it has removed the
+        // stopped device, like the run loop does
+        m_runLoopSemaphore.acquire();
+        m_pMultiplexedDevice = std::make_unique<MultiplexedDevice>(this);
+        m_pMultiplexer = HidIoMultiplexer::instance();
+        m_pMultiplexer->addDevice(m_pMultiplexedDevice.get());
+        return;
+    }
+#endif
+    // Controller input needs to be prioritized since it can affect the
+    // audio directly, like when scratching
+    // The effect of the priority parameter is dependent on the operating system's scheduling policy.
+    // In particular, the priority will be ignored on systems that do not support thread priorities (as Linux).
+    start(QThread::HighPriority);
+}
+
 void HidIoThread::run() {
     const QSemaphoreReleaser releaser(m_runLoopSemaphore);
     m_runLoopSemaphore.acquire();
@@ -112,11 +226,40 @@ void HidIoThread::pollBufferedInputReports() {
             // No InputReports left to be read
             break;
         }
-        processInputReport(bytesRead);
+        processInputReport(bytesRead, mixxx::Time::elapsed());
+    }
+}
+
+#ifdef __LINUX__
+void HidIoThread::readHidrawInputReports(mixxx::Duration timestamp) {
+    Trace hidRead("HidIoThread readHidrawInputReports");
+    auto hidDeviceLock = lockMutex(&m_hidDeviceAndPollMutex);
+    // Each read returns exactly one InputReport, including the report ID
+    // for numbered reports, like hid_read of the hidraw backend.
+    while (true) {
+        const auto bytesRead = read(m_hidrawFd, m_pPollData[m_pollingBufferIndex], kBufferSize);
+        if (bytesRead < 0) {
+            if (errno != EAGAIN && errno != EINTR) {
+                qCWarning(m_logInput) << "Unable to read HID InputReports from"
+                                      << m_deviceInfo.formatName() << ":"
+                                      << strerror(errno);
+            }
+            break;
+        } else if (bytesRead == 0) {
+            break;
+        }
+        processInputReport(static_cast<int>(bytesRead), timestamp);
     }
 }
 
-void HidIoThread::processInputReport(int bytesRead) {
+void HidIoThread::wakeMultiplexer() {
+    if (m_pMultiplexer) {
+        m_pMultiplexer->wake();
+    }
+}
+#endif
+
+void HidIoThread::processInputReport(int bytesRead, mixxx::Duration timestamp) {
     Trace process("HidIO processInputReport");
     unsigned char* pPreviousBuffer = m_pPollData[(m_pollingBufferIndex + 1) % kNumBuffers];
     unsigned char* pCurrentBuffer = m_pPollData[m_pollingBufferIndex];
@@ -140,7 +283,7 @@ void HidIoThread::processInputReport(int bytesRead) {
     // This eexecute callback function in JavaScript mapping and print to stdout in case of --controllerDebug
     emit receive(QByteArray(reinterpret_cast<const char*>(pCurrentBuffer),
                          bytesRead),
-            mixxx::Time::elapsed());
+            timestamp);
 }
 
 QByteArray HidIoThread::getInputReport(quint8 reportID) {
@@ -206,6 +349,12 @@ void HidIoThread::updateCachedOutputReportData(quint8 reportID,
 
     actualOutputReportIterator->second->updateCachedData(
             data, m_deviceInfo, m_logOutput, resendUnchangedReport);
+
+#ifdef __LINUX__
+    if (m_pMultiplexer) {
+        m_pMultiplexer->requestOutput();
+    }
+#endif
 }
 
 bool HidIoThread::sendNextCachedOutputReport() {
@@ -229,8 +378,16 @@ bool HidIoThread::sendNextCachedOutputReport() {
         // by std::map<Key,T,Compare,Allocator>::operator[]
         // The standard says that "No iterators or references are invalidated." using this operator.
         // Therefore m_outputReportIterator doesn't require Mutex protection.
-        if (m_outputReportIterator->second->sendCachedData(
-                    &m_hidDeviceAndPollMutex, m_pHidDevice, m_deviceInfo, m_logOutput)) {
+#ifdef __LINUX__
+        const int hidrawFd = m_hidrawFd;
+#else
+        const int hidrawFd = -1;
+#endif
+        if (m_outputReportIterator->second->sendCachedData(&m_hidDeviceAndPollMutex,
+                    m_pHidDevice,
+                    hidrawFd,
+                    m_deviceInfo,
+                    m_logOutput)) {
             // Return after each time consuming sendCachedData
             return true;
         }
@@ -239,6 +396,17 @@ bool HidIoThread::sendNextCachedOutputReport() {
     return false;
 }
 
+bool HidIoThread::hasUnsentOutputReports() {
+    const auto mapLock = lockMutex(&m_outputReportMapMutex);
+    for (const auto& [reportId, pOutputReport] : m_outputReports) {
+        Q_UNUSED(reportId);
+        if (pOutputReport->hasUnsentData()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void HidIoThread::sendFeatureReport(
         quint8 reportID, const QByteArray& reportData) {
     auto startOfHidSendFeatureReport = mixxx::Time::elapsed();
@@ -325,6 +493,9 @@ bool HidIoThread::testAndSetThreadState(HidIoThreadState expectedState,
         return false;
     }
 
+#ifdef __LINUX__
+    wakeMultiplexer();
+#endif
     return true;
 }
 
@@ -336,4 +507,7 @@ bool HidIoThread::waitUntilRunLoopIsStopped(unsigned int timeoutMillis) {
 
 void HidIoThread::setThreadState(HidIoThreadState expectedState) {
     m_state.storeRelease(static_cast<int>(expectedState));
+#ifdef __LINUX__
+    wakeMultiplexer();
+#endif
 }
@@ -4,6 +4,7 @@
 #include <QSemaphore>
 #include <QThread>
 #include <map>
+#include <memory>
 
 #include "controllers/controller.h"
 #include "controllers/hid/hiddevice.h"
@@ -11,6 +12,10 @@
 #include "util/compatibility/qmutex.h"
 #include "util/duration.h"
 
+#ifdef __LINUX__
+class HidIoMultiplexer;
+#endif
+
 enum class HidIoThreadState {
     Initialized,
     OutputActive,
@@ -27,6 +32,11 @@ class HidIoThread : public QThread {
             const mixxx::hid::DeviceInfo& deviceInfo);
     ~HidIoThread() override;
 
+    /// Starts the IO with the device. On Linux, the hidraw devices are
+    /// served by the shared HidIoMultiplexer thread. Otherwise, or if the
+    /// hidraw device can't be opened, the run loop of this thread is started.
+    void startIo();
+
     void run() override;
 
     /// Sets the state of the HidIoThread lifecycle,
@@ -55,9 +65,17 @@ class HidIoThread : public QThread {
 
   private:
     bool sendNextCachedOutputReport();
+    bool hasUnsentOutputReports();
 
     void pollBufferedInputReports();
-    void processInputReport(int bytesRead);
+    void processInputReport(int bytesRead, mixxx::Duration timestamp);
+
+#ifdef __LINUX__
+    class MultiplexedDevice;
+    void readHidrawInputReports(mixxx::Duration timestamp);
+    /// Wakes up the multiplexer, if the device is served by it
+    void wakeMultiplexer();
+#endif
 
     const mixxx::hid::DeviceInfo m_deviceInfo;
     const RuntimeLoggingCategory m_logBase;
@@ -97,4 +115,13 @@ class HidIoThread : public QThread {
 
     /// Semaphore with capacity 1, which is left acquired, as long as the run loop of the thread runs
     QSemaphore m_runLoopSemaphore;
+
+#ifdef __LINUX__
+    /// A second, non-blocking file descriptor of the hidraw device, which is
+    /// used for reading InputReports and writing OutputReports. hidapi does
+    /// not expose its own. Feature reports are still handled by hidapi.
+    int m_hidrawFd;
+    std::shared_ptr<HidIoMultiplexer> m_pMultiplexer;
+    std::unique_ptr<MultiplexedDevice> m_pMultiplexedDevice;
+#endif
 };
@@ -0,0 +1,204 @@
+#include "controllers/midi/alsaseqcontroller.h"
+
+#include "controllers/midi/midiutils.h"
+#include "moc_alsaseqcontroller.cpp"
+
+namespace {
+
+const QString kClientName = QStringLiteral("Mixxx");
+
+// All short messages have at most 3 bytes
+constexpr int kEncoderBufferSize = 16;
+
+} // anonymous namespace
+
+AlsaSeqController::AlsaSeqController(const QString& deviceName,
+        int client,
+        int port,
+        bool isInput,
+        bool isOutput)
+        : MidiController(deviceName),
+          m_client(client),
+          m_port(port),
+          m_pOutputSeq(nullptr),
+          m_pEncoder(nullptr),
+          m_outputPort(-1) {
+    setInputDevice(isInput);
+    setOutputDevice(isOutput);
+}
+
+AlsaSeqController::~AlsaSeqController() {
+    if (isOpen()) {
+        close();
+    }
+}
+
+int AlsaSeqController::open() {
+    if (isOpen()) {
+        qCWarning(m_logBase) << "ALSA MIDI device" << getName() << "already open";
+        return -1;
+    }
+
+    qCInfo(m_logBase) << "AlsaSeqController: Opening" << getName()
+                      << "at" << m_client << ":" << m_port;
+
+    if (isInputDevice()) {
+        m_pReader = std::make_unique<AlsaSeqReader>(kClientName);
+        if (!m_pReader->open(m_client, m_port)) {
+            qCWarning(m_logBase) << "ALSA MIDI device" << getName()
+                                 << "could not be opened for input";
+            m_pReader.reset();
+            return -1;
+        }
+        // The reader emits from its own thread, the messages are queued
+        // into the controller thread with their original time stamps.
+        connect(m_pReader.get(),
+                &AlsaSeqReader::receivedShortMessage,
+                this,
+                &AlsaSeqController::receivedShortMessage);
+        connect(m_pReader.get(),
+                &AlsaSeqReader::receivedSysex,
+                this,
+                &AlsaSeqController::receive);
+        m_pReader->start(QThread::TimeCriticalPriority);
+    }
+
+    if (isOutputDevice() && !openOutput()) {
+        qCWarning(m_logBase) << "ALSA MIDI device" << getName()
+                             << "could not be opened for output";
+        closeOutput();
+        if (m_pReader) {
+            m_pReader->close();
+            m_pReader.reset();
+        }
+        return -1;
+    }
+
+    setOpen(true);
+    startEngine();
+    return 0;
+}
+
+int AlsaSeqController::close() {
+    if (!isOpen()) {
+        qCWarning(m_logBase) << "ALSA MIDI device" << getName() << "already closed";
+        return -1;
+    }
+
+    if (m_pReader) {
+        disconnect(m_pReader.get(),
+                &AlsaSeqReader::receivedShortMessage,
+                this,
+                &AlsaSeqController::receivedShortMessage);
+        disconnect(m_pReader.get(),
+                &AlsaSeqReader::receivedSysex,
+                this,
+                &AlsaSeqController::receive);
+    }
+
+    stopEngine();
+    MidiController::close();
+
+    if (m_pReader) {
+        m_pReader->close();
+        m_pReader.reset();
+    }
+    closeOutput();
+
+    setOpen(false);
+    return 0;
+}
+
+bool AlsaSeqController::openOutput() {
+    int result = snd_seq_open(&m_pOutputSeq, "default", SND_SEQ_OPEN_OUTPUT, 0);
+    if (result < 0) {
+        qCWarning(m_logBase) << "Failed to open ALSA sequencer:" << snd_strerror(result);
+        m_pOutputSeq = nullptr;
+        return false;
+    }
+    snd_seq_set_client_name(m_pOutputSeq, kClientName.toLocal8Bit().constData());
+    m_outputPort = snd_seq_create_simple_port(m_pOutputSeq,
+            "Output",
+            SND_SEQ_PORT_CAP_READ | SND_SEQ_PORT_CAP_SUBS_READ,
+            SND_SEQ_PORT_TYPE_MIDI_GENERIC | SND_SEQ_PORT_TYPE_APPLICATION);
+    if (m_outputPort < 0) {
+        qCWarning(m_logBase) << "Failed to create ALSA sequencer port:"
+                             << snd_strerror(m_outputPort);
+        return false;
+    }
+    result = snd_seq_connect_to(m_pOutputSeq, m_outputPort, m_client, m_port);
+    if (result < 0) {
+        qCWarning(m_logBase) << "Failed to connect to" << m_client << ":" << m_port
+                             << snd_strerror(result);
+        return false;
+    }
+    result = snd_midi_event_new(kEncoderBufferSize, &m_pEncoder);
+    if (result < 0) {
+        m_pEncoder = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void AlsaSeqController::closeOutput() {
+    if (m_pEncoder) {
+        snd_midi_event_free(m_pEncoder);
+        m_pEncoder = nullptr;
+    }
+    if (m_pOutputSeq) {
+        snd_seq_close(m_pOutputSeq);
+        m_pOutputSeq = nullptr;
+    }
+    m_outputPort = -1;
+}
+
+void AlsaSeqController::sendEvent(snd_seq_event_t* pEvent) {
+    snd_seq_ev_set_source(pEvent, m_outputPort);
+    snd_seq_ev_set_subs(pEvent);
+    snd_seq_ev_set_direct(pEvent);
+    const int result = snd_seq_event_output_direct(m_pOutputSeq, pEvent);
+    if (result < 0) {
+        qCWarning(m_logOutput) << "Failed to send MIDI event:" << snd_strerror(result);
+    }
+}
+
+void AlsaSeqController::sendShortMsg(unsigned char status,
+        unsigned char byte1,
+        unsigned char byte2) {
+    if (!m_pOutputSeq || !m_pEncoder) {
+        return;
+    }
+
+    const unsigned char data[3] = {status, byte1, byte2};
+    snd_seq_event_t event;
+    snd_seq_ev_clear(&event);
+    // Don't continue a previous message with running status
+    snd_midi_event_reset_encode(m_pEncoder);
+    // Messages with less than 3 bytes are complete before the end
+    const long consumed = snd_midi_event_encode(m_pEncoder, data, sizeof(data), &event);
+    if (consumed <= 0 || event.type == SND_SEQ_EVENT_NONE) {
+        qCWarning(m_logOutput) << "Failed to encode MIDI message:" << status << byte1 << byte2;
+        return;
+    }
+    sendEvent(&event);
+    qCDebug(m_logOutput) << MidiUtils::formatMidiOpCode(getName(),
+            status,
+            byte1,
+            byte2,
+            MidiUtils::channelFromStatus(status),
+            MidiUtils::opCodeFromStatus(status));
+}
+
+void AlsaSeqController::sendBytes(const QByteArray& data) {
+    if (!m_pOutputSeq) {
+        return;
+    }
+
+    snd_seq_event_t event;
+    snd_seq_ev_clear(&event);
+    snd_seq_ev_set_sysex(&event,
+            static_cast<unsigned int>(data.size()),
+            const_cast<char*>(data.constData()));
+    sendEvent(&event);
+    qCDebug(m_logOutput) << MidiUtils::formatSysexMessage(getName(), data);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <alsa/asoundlib.h>
+
+#include <memory>
+
+#include "controllers/midi/alsaseqreader.h"
+#include "controllers/midi/midicontroller.h"
+
+/// ALSA sequencer based MIDI backend for Linux
+///
+/// Unlike PortMidiController this is not a polling device. Input is
+/// received by an AlsaSeqReader thread that sleeps until the kernel
+/// delivers events and forwards them with their time stamps. Output
+/// messages are sent directly without a queue.
+///
+/// ALSA ports are usually full-duplex, so input and output of a device
+/// share the same address.
+class AlsaSeqController : public MidiController {
+    Q_OBJECT
+  public:
+    AlsaSeqController(const QString& deviceName,
+            int client,
+            int port,
+            bool isInput,
+            bool isOutput);
+    ~AlsaSeqController() override;
+
+  private slots:
+    int open() override;
+    int close() override;
+
+  protected:
+    void sendShortMsg(unsigned char status,
+            unsigned char byte1,
+            unsigned char byte2) override;
+
+  private:
+    // The sysex data must already contain the start byte 0xf0 and the end byte
+    // 0xf7.
+    void sendBytes(const QByteArray& data) override;
+
+    bool openOutput();
+    void closeOutput();
+    void sendEvent(snd_seq_event_t* pEvent);
+
+    const int m_client;
+    const int m_port;
+
+    std::unique_ptr<AlsaSeqReader> m_pReader;
+
+    snd_seq_t* m_pOutputSeq;
+    snd_midi_event_t* m_pEncoder;
+    int m_outputPort;
+};
@@ -0,0 +1,98 @@
+#include "controllers/midi/alsaseqenumerator.h"
+
+#include <alsa/asoundlib.h>
+
+#include "controllers/midi/alsaseqcontroller.h"
+#include "moc_alsaseqenumerator.cpp"
+#include "util/cmdlineargs.h"
+
+namespace {
+
+const auto kMidiThroughPortPrefix = QLatin1String("Midi Through Port");
+
+bool recognizeDevice(const QString& portName) {
+    // In developer mode we show the MIDI Through Port, otherwise ignore it
+    // since it routinely causes trouble.
+    return CmdlineArgs::Instance().getDeveloper() ||
+            !portName.startsWith(kMidiThroughPortPrefix, Qt::CaseInsensitive);
+}
+
+bool hasCapabilities(unsigned int capabilities, unsigned int required) {
+    return (capabilities & required) == required;
+}
+
+} // anonymous namespace
+
+AlsaSeqEnumerator::AlsaSeqEnumerator()
+        : MidiEnumerator() {
+}
+
+AlsaSeqEnumerator::~AlsaSeqEnumerator() {
+    qDebug() << "Deleting ALSA MIDI devices...";
+    QListIterator<Controller*> dev_it(m_devices);
+    while (dev_it.hasNext()) {
+        delete dev_it.next();
+    }
+}
+
+QList<Controller*> AlsaSeqEnumerator::queryDevices() {
+    qDebug() << "Scanning ALSA MIDI devices:";
+
+    QListIterator<Controller*> dev_it(m_devices);
+    while (dev_it.hasNext()) {
+        delete dev_it.next();
+    }
+    m_devices.clear();
+
+    snd_seq_t* pSeq;
+    const int result = snd_seq_open(&pSeq, "default", SND_SEQ_OPEN_DUPLEX, 0);
+    if (result < 0) {
+        qWarning() << "Failed to open ALSA sequencer:" << snd_strerror(result);
+        return m_devices;
+    }
+    const int ownClientId = snd_seq_client_id(pSeq);
+
+    snd_seq_client_info_t* pClientInfo;
+    snd_seq_client_info_alloca(&pClientInfo);
+    snd_seq_port_info_t* pPortInfo;
+    snd_seq_port_info_alloca(&pPortInfo);
+
+    snd_seq_client_info_set_client(pClientInfo, -1);
+    while (snd_seq_query_next_client(pSeq, pClientInfo) >= 0) {
+        const int client = snd_seq_client_info_get_client(pClientInfo);
+        if (client == SND_SEQ_CLIENT_SYSTEM || client == ownClientId) {
+            continue;
+        }
+        snd_seq_port_info_set_client(pPortInfo, client);
+        snd_seq_port_info_set_port(pPortInfo, -1);
+        while (snd_seq_query_next_port(pSeq, pPortInfo) >= 0) {
+            const unsigned int capabilities = snd_seq_port_info_get_capability(pPortInfo);
+            if (capabilities & SND_SEQ_PORT_CAP_NO_EXPORT) {
+                continue;
+            }
+            const bool isInput = hasCapabilities(capabilities,
+                    SND_SEQ_PORT_CAP_READ | SND_SEQ_PORT_CAP_SUBS_READ);
+            const bool isOutput = hasCapabilities(capabilities,
+                    SND_SEQ_PORT_CAP_WRITE | SND_SEQ_PORT_CAP_SUBS_WRITE);
+            if (!isInput && !isOutput) {
+                continue;
+            }
+            // The same names as with PortMidi, which uses the port name
+            // on Linux. This keeps the mappings and settings of existing
+            // configurations.
+            const QString portName = QString::fromLocal8Bit(
+                    snd_seq_port_info_get_name(pPortInfo));
+            if (!recognizeDevice(portName)) {
+                continue;
+            }
+            const int port = snd_seq_port_info_get_port(pPortInfo);
+            qDebug() << " Found" << portName << "at" << client << ":" << port
+                     << (isInput ? "input" : "") << (isOutput ? "output" : "");
+            m_devices.push_back(new AlsaSeqController(
+                    portName, client, port, isInput, isOutput));
+        }
+    }
+
+    snd_seq_close(pSeq);
+    return m_devices;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "controllers/midi/midienumerator.h"
+
+/// This class handles discovery and enumeration of MIDI devices that appear
+/// as ports of the ALSA sequencer on Linux.
+class AlsaSeqEnumerator : public MidiEnumerator {
+    Q_OBJECT
+  public:
+    AlsaSeqEnumerator();
+    ~AlsaSeqEnumerator() override;
+
+    QList<Controller*> queryDevices() override;
+
+  private:
+    QList<Controller*> m_devices;
+};
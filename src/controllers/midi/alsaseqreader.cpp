@@ -0,0 +1,232 @@
+#include "controllers/midi/alsaseqreader.h"
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <QtDebug>
+#include <cerrno>
+#include <vector>
+
+#include "controllers/midi/midiutils.h"
+#include "moc_alsaseqreader.cpp"
+#include "util/assert.h"
+#include "util/time.h"
+#include "util/trace.h"
+
+namespace {
+
+// Longer System Exclusive messages are dropped
+constexpr int kMaxSysexLength = 65536;
+
+// All short messages have at most 3 bytes
+constexpr int kDecoderBufferSize = 16;
+
+} // anonymous namespace
+
+AlsaSeqReader::AlsaSeqReader(const QString& clientName)
+        : QThread(),
+          m_clientName(clientName),
+          m_pSeq(nullptr),
+          m_pDecoder(nullptr),
+          m_clientId(-1),
+          m_portId(-1),
+          m_queue(-1),
+          m_wakeFd(-1),
+          m_stop(0) {
+    if (snd_midi_event_new(kDecoderBufferSize, &m_pDecoder) < 0) {
+        qWarning() << "AlsaSeqReader: Failed to create MIDI event decoder";
+        m_pDecoder = nullptr;
+    } else {
+        // Every message starts with its status byte
+        snd_midi_event_no_status(m_pDecoder, 1);
+    }
+}
+
+AlsaSeqReader::~AlsaSeqReader() {
+    close();
+    if (m_pDecoder) {
+        snd_midi_event_free(m_pDecoder);
+    }
+}
+
+bool AlsaSeqReader::open(int client, int port) {
+    DEBUG_ASSERT(!isRunning());
+    DEBUG_ASSERT(!m_pSeq);
+    int result = snd_seq_open(&m_pSeq, "default", SND_SEQ_OPEN_INPUT, 0);
+    if (result < 0) {
+        qWarning() << "AlsaSeqReader: Failed to open sequencer:" << snd_strerror(result);
+        m_pSeq = nullptr;
+        return false;
+    }
+    snd_seq_set_client_name(m_pSeq, m_clientName.toLocal8Bit().constData());
+    m_clientId = snd_seq_client_id(m_pSeq);
+    m_portId = snd_seq_create_simple_port(m_pSeq,
+            "Input",
+            SND_SEQ_PORT_CAP_WRITE | SND_SEQ_PORT_CAP_SUBS_WRITE,
+            SND_SEQ_PORT_TYPE_MIDI_GENERIC | SND_SEQ_PORT_TYPE_APPLICATION);
+    m_queue = snd_seq_alloc_queue(m_pSeq);
+    if (m_portId < 0 || m_queue < 0) {
+        qWarning() << "AlsaSeqReader: Failed to create port or queue";
+        close();
+        return false;
+    }
+
+    // Let the kernel stamp each event with the real time of the queue
+    snd_seq_port_subscribe_t* pSubscription;
+    snd_seq_port_subscribe_alloca(&pSubscription);
+    snd_seq_addr_t sender;
+    sender.client = static_cast<unsigned char>(client);
+    sender.port = static_cast<unsigned char>(port);
+    snd_seq_addr_t dest;
+    dest.client = static_cast<unsigned char>(m_clientId);
+    dest.port = static_cast<unsigned char>(m_portId);
+    snd_seq_port_subscribe_set_sender(pSubscription, &sender);
+    snd_seq_port_subscribe_set_dest(pSubscription, &dest);
+    snd_seq_port_subscribe_set_queue(pSubscription, m_queue);
+    snd_seq_port_subscribe_set_time_update(pSubscription, 1);
+    snd_seq_port_subscribe_set_time_real(pSubscription, 1);
+    result = snd_seq_subscribe_port(m_pSeq, pSubscription);
+    if (result < 0) {
+        qWarning() << "AlsaSeqReader: Failed to subscribe to"
+                   << client << ":" << port << snd_strerror(result);
+        close();
+        return false;
+    }
+
+    snd_seq_start_queue(m_pSeq, m_queue, nullptr);
+    snd_seq_drain_output(m_pSeq);
+    m_queueStartTime = mixxx::Time::elapsed();
+
+    // The thread blocks in poll(), all reads must return immediately
+    snd_seq_nonblock(m_pSeq, 1);
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_wakeFd < 0) {
+        qWarning() << "AlsaSeqReader: Failed to create eventfd";
+        close();
+        return false;
+    }
+    m_sysex.clear();
+    return true;
+}
+
+void AlsaSeqReader::close() {
+    if (isRunning()) {
+        stop();
+        wait();
+    }
+    if (m_wakeFd >= 0) {
+        ::close(m_wakeFd);
+        m_wakeFd = -1;
+    }
+    if (m_pSeq) {
+        // Also removes the port, the queue and the subscription
+        snd_seq_close(m_pSeq);
+        m_pSeq = nullptr;
+    }
+    m_clientId = -1;
+    m_portId = -1;
+    m_queue = -1;
+}
+
+void AlsaSeqReader::stop() {
+    m_stop = 1;
+    const uint64_t value = 1;
+    if (write(m_wakeFd, &value, sizeof(value)) != sizeof(value)) {
+        qWarning() << "AlsaSeqReader: Failed to wake up reader thread";
+    }
+}
+
+void AlsaSeqReader::run() {
+    m_stop = 0;
+    VERIFY_OR_DEBUG_ASSERT(m_pSeq && m_wakeFd >= 0) {
+        return;
+    }
+    const int seqFdCount = snd_seq_poll_descriptors_count(m_pSeq, POLLIN);
+    std::vector<pollfd> fds(seqFdCount + 1);
+    snd_seq_poll_descriptors(m_pSeq, fds.data(), seqFdCount, POLLIN);
+    fds[seqFdCount].fd = m_wakeFd;
+    fds[seqFdCount].events = POLLIN;
+    fds[seqFdCount].revents = 0;
+
+    while (m_stop.loadAcquire() == 0) {
+        // Sleep until events arrive, no timeout
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            qWarning() << "AlsaSeqReader: poll() failed" << errno;
+            break;
+        }
+        Trace process("AlsaSeqReader process events");
+        // Handle all pending events at once
+        while (true) {
+            snd_seq_event_t* pEvent = nullptr;
+            const int result = snd_seq_event_input(m_pSeq, &pEvent);
+            if (result == -ENOSPC) {
+                qWarning() << "AlsaSeqReader: Input buffer overrun, events have been lost";
+                continue;
+            }
+            if (result < 0) {
+                // -EAGAIN: No more events
+                break;
+            }
+            if (pEvent) {
+                processEvent(*pEvent);
+            }
+        }
+    }
+}
+
+mixxx::Duration AlsaSeqReader::eventTimestamp(const snd_seq_event_t& event) const {
+    if ((event.flags & SND_SEQ_TIME_STAMP_MASK) != SND_SEQ_TIME_STAMP_REAL) {
+        // Events that are not delivered through our subscription
+        return mixxx::Time::elapsed();
+    }
+    return m_queueStartTime +
+            mixxx::Duration::fromNanos(
+                    static_cast<qint64>(event.time.time.tv_sec) * 1000000000 +
+                    event.time.time.tv_nsec);
+}
+
+void AlsaSeqReader::processEvent(const snd_seq_event_t& event) {
+    const mixxx::Duration timestamp = eventTimestamp(event);
+    if (event.type == SND_SEQ_EVENT_SYSEX) {
+        // Long messages might be split into multiple events
+        const auto* pData = static_cast<const unsigned char*>(event.data.ext.ptr);
+        const int length = static_cast<int>(event.data.ext.len);
+        if (length <= 0) {
+            return;
+        }
+        if (pData[0] == MidiUtils::opCodeValue(MidiOpCode::SystemExclusive)) {
+            m_sysex.clear();
+        }
+        if (m_sysex.size() + length > kMaxSysexLength) {
+            qWarning() << "AlsaSeqReader: Dropping System Exclusive message with more than"
+                       << kMaxSysexLength << "bytes";
+            m_sysex.clear();
+            return;
+        }
+        m_sysex.append(reinterpret_cast<const char*>(pData), length);
+        if (pData[length - 1] == MidiUtils::opCodeValue(MidiOpCode::EndOfExclusive)) {
+            emit receivedSysex(m_sysex, timestamp);
+            m_sysex.clear();
+        }
+        return;
+    }
+
+    VERIFY_OR_DEBUG_ASSERT(m_pDecoder) {
+        return;
+    }
+    unsigned char buffer[kDecoderBufferSize];
+    const long length = snd_midi_event_decode(m_pDecoder, buffer, sizeof(buffer), &event);
+    if (length <= 0) {
+        // Sequencer events without a MIDI representation, e.g.
+        // port subscription notifications
+        return;
+    }
+    emit receivedShortMessage(buffer[0],
+            length > 1 ? buffer[1] : 0,
+            length > 2 ? buffer[2] : 0,
+            timestamp);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <alsa/asoundlib.h>
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QThread>
+
+#include "util/duration.h"
+
+/// Receives MIDI messages from an ALSA sequencer port in a dedicated thread
+///
+/// The thread blocks on the file descriptors of its own sequencer client
+/// until events arrive, so no polling is needed. The events are time
+/// stamped by the kernel with the real time of a sequencer queue when
+/// they are received, which is converted into the time base of
+/// mixxx::Time::elapsed().
+class AlsaSeqReader : public QThread {
+    Q_OBJECT
+  public:
+    explicit AlsaSeqReader(const QString& clientName);
+    ~AlsaSeqReader() override;
+
+    /// Creates the sequencer client and subscribes to the port of the
+    /// device. Must be called before the thread is started.
+    bool open(int client, int port);
+    /// Stops the thread and closes the sequencer client.
+    void close();
+
+    /// The address of the local port that events are received on.
+    int clientId() const {
+        return m_clientId;
+    }
+    int portId() const {
+        return m_portId;
+    }
+
+    // Only public for testing
+    void processEvent(const snd_seq_event_t& event);
+
+  signals:
+    void receivedShortMessage(unsigned char status,
+            unsigned char control,
+            unsigned char value,
+            mixxx::Duration timestamp);
+    void receivedSysex(const QByteArray& data, mixxx::Duration timestamp);
+
+  protected:
+    void run() override;
+
+  private:
+    void stop();
+    mixxx::Duration eventTimestamp(const snd_seq_event_t& event) const;
+
+    const QString m_clientName;
+    snd_seq_t* m_pSeq;
+    snd_midi_event_t* m_pDecoder;
+    int m_clientId;
+    int m_portId;
+    int m_queue;
+    // Wakes up the thread when stopping
+    int m_wakeFd;
+    QAtomicInt m_stop;
+    mixxx::Duration m_queueStartTime;
+    QByteArray m_sysex;
+};
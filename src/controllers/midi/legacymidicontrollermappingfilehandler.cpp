@@ -7,6 +7,105 @@
 #define DEFAULT_OUTPUT_ON 0x7F
 #define DEFAULT_OUTPUT_OFF 0x00
 
+namespace {
+
+const QString kScaleTransform = QStringLiteral("scale");
+const QString kScratchTouchTransform = QStringLiteral("scratch-touch");
+const QString kScratchJogTransform = QStringLiteral("scratch-jog");
+
+MidiInputTransform::Encoder encoderFromString(
+        const QString& encoder, MidiInputTransform::Encoder defaultEncoder) {
+    if (encoder == QLatin1String("absolute")) {
+        return MidiInputTransform::Encoder::Absolute;
+    } else if (encoder == QLatin1String("twos-complement")) {
+        return MidiInputTransform::Encoder::TwosComplement;
+    } else if (encoder == QLatin1String("offset64")) {
+        return MidiInputTransform::Encoder::Offset64;
+    }
+    if (!encoder.isEmpty()) {
+        qWarning() << "LegacyMidiControllerMappingFileHandler: Unknown encoder" << encoder;
+    }
+    return defaultEncoder;
+}
+
+QString encoderToString(MidiInputTransform::Encoder encoder) {
+    switch (encoder) {
+    case MidiInputTransform::Encoder::TwosComplement:
+        return QStringLiteral("twos-complement");
+    case MidiInputTransform::Encoder::Offset64:
+        return QStringLiteral("offset64");
+    case MidiInputTransform::Encoder::Absolute:
+        break;
+    }
+    return QStringLiteral("absolute");
+}
+
+double doubleAttribute(const QDomElement& element, const QString& name, double defaultValue) {
+    bool ok = false;
+    const double value = element.attribute(name).toDouble(&ok);
+    return ok ? value : defaultValue;
+}
+
+MidiInputTransform transformFromXML(
+        const QDomElement& element, MidiInputTransform::Type type) {
+    MidiInputTransform transform;
+    transform.type = type;
+    transform.min = doubleAttribute(element, QStringLiteral("min"), transform.min);
+    transform.max = doubleAttribute(element, QStringLiteral("max"), transform.max);
+    transform.step = doubleAttribute(element, QStringLiteral("step"), transform.step);
+    // A jog wheel is always a relative encoder
+    transform.encoder = encoderFromString(element.attribute(QStringLiteral("encoder")),
+            type == MidiInputTransform::Type::ScratchJog
+                    ? MidiInputTransform::Encoder::TwosComplement
+                    : MidiInputTransform::Encoder::Absolute);
+    if (type == MidiInputTransform::Type::ScratchJog &&
+            transform.encoder == MidiInputTransform::Encoder::Absolute) {
+        transform.encoder = MidiInputTransform::Encoder::TwosComplement;
+    }
+    transform.intervalsPerRev = static_cast<int>(doubleAttribute(element,
+            QStringLiteral("intervals-per-rev"),
+            transform.intervalsPerRev));
+    transform.rpm = doubleAttribute(element, QStringLiteral("rpm"), transform.rpm);
+    transform.alpha = doubleAttribute(element, QStringLiteral("alpha"), transform.alpha);
+    transform.beta = doubleAttribute(element, QStringLiteral("beta"), transform.beta);
+    transform.ramp = element.attribute(QStringLiteral("ramp")) != QLatin1String("false");
+    return transform;
+}
+
+QDomElement transformToXML(QDomDocument* doc, const MidiInputTransform& transform) {
+    QDomElement element;
+    switch (transform.type) {
+    case MidiInputTransform::Type::Scale:
+        element = doc->createElement(kScaleTransform);
+        element.setAttribute(QStringLiteral("min"), transform.min);
+        element.setAttribute(QStringLiteral("max"), transform.max);
+        if (transform.encoder != MidiInputTransform::Encoder::Absolute) {
+            element.setAttribute(QStringLiteral("encoder"), encoderToString(transform.encoder));
+            element.setAttribute(QStringLiteral("step"), transform.step);
+        }
+        break;
+    case MidiInputTransform::Type::ScratchTouch:
+        element = doc->createElement(kScratchTouchTransform);
+        element.setAttribute(QStringLiteral("intervals-per-rev"), transform.intervalsPerRev);
+        element.setAttribute(QStringLiteral("rpm"), transform.rpm);
+        element.setAttribute(QStringLiteral("alpha"), transform.alpha);
+        element.setAttribute(QStringLiteral("beta"), transform.beta);
+        element.setAttribute(QStringLiteral("ramp"),
+                transform.ramp ? QStringLiteral("true") : QStringLiteral("false"));
+        break;
+    case MidiInputTransform::Type::ScratchJog:
+        element = doc->createElement(kScratchJogTransform);
+        element.setAttribute(QStringLiteral("encoder"), encoderToString(transform.encoder));
+        element.setAttribute(QStringLiteral("step"), transform.step);
+        break;
+    case MidiInputTransform::Type::None:
+        break;
+    }
+    return element;
+}
+
+} // anonymous namespace
+
 std::shared_ptr<LegacyControllerMapping>
 LegacyMidiControllerMappingFileHandler::load(const QDomElement& root,
         const QString& filePath,
@@ -61,6 +160,7 @@ LegacyMidiControllerMappingFileHandler::load(const QDomElement& root,
         QDomElement optionsNode = control.firstChildElement("options").firstChildElement();
 
         MidiOptions options;
+        MidiInputTransform transform;
 
         QString strMidiOption;
         while (!optionsNode.isNull()) {
@@ -97,6 +197,13 @@ LegacyMidiControllerMappingFileHandler::load(const QDomElement& root,
                 options.setFlag(MidiOption::FourteenBitMSB);
             } else if (strMidiOption == QLatin1String("fourteen-bit-lsb")) {
                 options.setFlag(MidiOption::FourteenBitLSB);
+            } else if (strMidiOption == kScaleTransform) {
+                transform = transformFromXML(optionsNode, MidiInputTransform::Type::Scale);
+            } else if (strMidiOption == kScratchTouchTransform) {
+                transform = transformFromXML(
+                        optionsNode, MidiInputTransform::Type::ScratchTouch);
+            } else if (strMidiOption == kScratchJogTransform) {
+                transform = transformFromXML(optionsNode, MidiInputTransform::Type::ScratchJog);
             }
 
             optionsNode = optionsNode.nextSiblingElement();
@@ -106,6 +213,7 @@ LegacyMidiControllerMappingFileHandler::load(const QDomElement& root,
         inputMapping.control = ConfigKey(controlGroup, controlKey);
         inputMapping.description = controlDescription;
         inputMapping.options = options;
+        inputMapping.transform = transform;
         inputMapping.key = MidiKey(midiStatusByte, midiControl);
 
         // qDebug() << "New inputMapping:" << QString::number(inputMapping.key.key, 16).toUpper()
@@ -293,8 +401,12 @@ QDomElement LegacyMidiControllerMappingFileHandler::inputMappingToXML(
     //Midi options
     QDomElement optionsNode = doc->createElement("options");
 
+    if (!mapping.transform.isNull()) {
+        optionsNode.appendChild(transformToXML(doc, mapping.transform));
+    }
+
     // "normal" is no options
-    if (!mapping.options) {
+    if (!mapping.options && mapping.transform.isNull()) {
         QDomElement singleOption = doc->createElement("normal");
         optionsNode.appendChild(singleOption);
     } else {
@@ -3,6 +3,7 @@
 #include "control/controlobject.h"
 #include "controllers/defs_controllers.h"
 #include "controllers/midi/midiutils.h"
+#include "controllers/scripting/legacy/controllerscriptinterfacelegacy.h"
 #include "defs_urls.h"
 #include "errordialoghandler.h"
 #include "mixer/playermanager.h"
@@ -52,6 +53,17 @@ bool MidiController::matchMapping(const MappingInfo& mapping) {
 }
 
 bool MidiController::applyMapping() {
+    ControllerScriptEngineLegacy* pEngine = getScriptEngine();
+    if (pEngine && m_pMapping) {
+        QStringList inputHandlers;
+        for (const auto& mapping : m_pMapping->getInputMappings()) {
+            if (mapping.options.testFlag(MidiOption::Script)) {
+                inputHandlers.append(mapping.control.item);
+            }
+        }
+        pEngine->setInputHandlers(inputHandlers);
+    }
+
     // Handles the engine
     bool result = Controller::applyMapping();
 
@@ -265,12 +277,20 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
     unsigned char channel = MidiUtils::channelFromStatus(status);
     MidiOpCode opCode = MidiUtils::opCodeFromStatus(status);
 
+    if (!mapping.transform.isNull()) {
+        processInputTransform(mapping, opCode, value);
+        return;
+    }
+
     if (mapping.options.testFlag(MidiOption::Script)) {
         ControllerScriptEngineLegacy* pEngine = getScriptEngine();
         if (pEngine == nullptr) {
             return;
         }
 
+        ControllerScriptProfiler::Scope profile(pEngine->profiler(),
+                ControllerScriptProfiler::HandlerType::Input,
+                mapping.control.item);
         QJSValue function = pEngine->wrapFunctionCode(mapping.control.item, 5);
         const auto args = QJSValueList{
                 channel,
@@ -389,6 +409,69 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
     pCO->setValueFromMidi(static_cast<MidiOpCode>(opCode), newValue);
 }
 
+void MidiController::processInputTransform(
+        const MidiInputMapping& mapping, MidiOpCode opCode, unsigned char value) {
+    const MidiInputTransform& transform = mapping.transform;
+    if (transform.type == MidiInputTransform::Type::Scale) {
+        ControlObject* pCO = ControlObject::getControl(mapping.control);
+        if (pCO == nullptr) {
+            return;
+        }
+        const double newValue = transform.scaledValue(pCO->get(), value);
+        if (mapping.options.testFlag(MidiOption::SoftTakeover)) {
+            m_st.enable(pCO);
+            if (m_st.ignore(pCO, pCO->getParameterForValue(newValue))) {
+                return;
+            }
+        }
+        pCO->set(newValue);
+        return;
+    }
+
+    int deck;
+    if (!PlayerManager::isDeckGroup(mapping.control.group, &deck)) {
+        qCWarning(m_logBase) << "MidiController: Scratching requires a deck group, not"
+                             << mapping.control.group;
+        return;
+    }
+    // The scratch state is shared with the scripts of the mapping
+    ControllerScriptEngineLegacy* pEngine = getScriptEngine();
+    ControllerScriptInterfaceLegacy* pScriptInterface =
+            pEngine ? pEngine->scriptInterface() : nullptr;
+
+    if (transform.type == MidiInputTransform::Type::ScratchTouch) {
+        if (pScriptInterface == nullptr) {
+            qCWarning(m_logBase) << "MidiController: Scratching is not available"
+                                 << "without the script engine";
+            return;
+        }
+        // Many controllers send NoteOff with a nonzero release velocity
+        const bool touched = opCode != MidiOpCode::NoteOff && value != 0;
+        if (touched) {
+            pScriptInterface->scratchEnable(deck,
+                    transform.intervalsPerRev,
+                    transform.rpm,
+                    transform.alpha,
+                    transform.beta,
+                    transform.ramp);
+        } else {
+            pScriptInterface->scratchDisable(deck, transform.ramp);
+        }
+        return;
+    }
+
+    DEBUG_ASSERT(transform.type == MidiInputTransform::Type::ScratchJog);
+    const int movement = MidiInputTransform::relativeValue(transform.encoder, value);
+    if (pScriptInterface && pScriptInterface->isScratching(deck)) {
+        pScriptInterface->scratchTick(deck, movement);
+        return;
+    }
+    ControlObject* pCO = ControlObject::getControl(mapping.control);
+    if (pCO != nullptr) {
+        pCO->set(movement * transform.step);
+    }
+}
+
 double MidiController::computeValue(
         MidiOptions options, double prevmidivalue, double newmidivalue) {
     double tempval = 0.;
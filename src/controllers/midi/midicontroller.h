@@ -81,6 +81,10 @@ class MidiController : public Controller {
             const MidiInputMapping& mapping,
             const QByteArray& data,
             mixxx::Duration timestamp);
+    /// Applies a MidiInputTransform natively instead of calling a script
+    void processInputTransform(const MidiInputMapping& mapping,
+            MidiOpCode opCode,
+            unsigned char value);
 
     double computeValue(MidiOptions options, double _prevmidivalue, double _newmidivalue);
     void createOutputHandlers();
@@ -1,5 +1,7 @@
 #include "controllers/midi/midiutils.h"
 
+#include "util/math.h"
+
 QDebug operator<<(QDebug debug, MidiOpCode midiOpCode) {
     debug << static_cast<uint8_t>(midiOpCode);
     return debug;
@@ -22,3 +24,24 @@ MidiKey::MidiKey(unsigned char status, unsigned char control)
           control(MidiUtils::isMessageTwoBytes(
               MidiUtils::opCodeFromStatus(status)) ? control : 0xFF) {
 }
+
+// static
+int MidiInputTransform::relativeValue(Encoder encoder, unsigned char value) {
+    switch (encoder) {
+    case Encoder::TwosComplement:
+        return value < 64 ? value : value - 128;
+    case Encoder::Offset64:
+        return value - 64;
+    case Encoder::Absolute:
+        break;
+    }
+    return value;
+}
+
+double MidiInputTransform::scaledValue(double currentValue, unsigned char midiValue) const {
+    if (encoder == Encoder::Absolute) {
+        return min + (max - min) * midiValue / 127.0;
+    }
+    const double newValue = currentValue + relativeValue(encoder, midiValue) * step;
+    return math_clamp(newValue, math_min(min, max), math_max(min, max));
+}
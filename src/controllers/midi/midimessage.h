@@ -178,6 +178,76 @@ struct MidiKey {
     };
 };
 
+/// A native replacement for the most common script bindings, so these
+/// inputs are processed on the controller thread without calling into the
+/// JS engine. The soft-takeover option applies to Scale, all other options
+/// are ignored if a transform is set.
+struct MidiInputTransform {
+    enum class Type : uint8_t {
+        None,
+        /// Maps 0-127, or the movement of a relative encoder, onto the
+        /// range [min, max] of the control value
+        Scale,
+        /// Enables scratching on the deck of the control while the jog
+        /// wheel is touched (value != 0), NoteOff counts as a release
+        ScratchTouch,
+        /// Scratches the deck while it is touched, otherwise sets the control
+        /// (usually jog) to the movement multiplied by step
+        ScratchJog,
+    };
+
+    enum class Encoder : uint8_t {
+        Absolute,
+        /// 1 to 63 clockwise, 127 to 65 counter-clockwise
+        TwosComplement,
+        /// 65 to 127 clockwise, 63 to 0 counter-clockwise
+        Offset64,
+    };
+
+    MidiInputTransform()
+            : type(Type::None),
+              encoder(Encoder::Absolute),
+              min(0.0),
+              max(1.0),
+              step(1.0),
+              intervalsPerRev(128),
+              rpm(33.0 + 1.0 / 3.0),
+              alpha(1.0 / 8),
+              beta(1.0 / 8 / 32),
+              ramp(true) {
+    }
+
+    bool isNull() const {
+        return type == Type::None;
+    }
+
+    /// The signed movement of a relative encoder
+    static int relativeValue(Encoder encoder, unsigned char value);
+
+    /// The new control value of a Scale transform
+    double scaledValue(double currentValue, unsigned char midiValue) const;
+
+    bool operator==(const MidiInputTransform& other) const {
+        return type == other.type && encoder == other.encoder &&
+                min == other.min && max == other.max && step == other.step &&
+                intervalsPerRev == other.intervalsPerRev && rpm == other.rpm &&
+                alpha == other.alpha && beta == other.beta && ramp == other.ramp;
+    }
+
+    Type type;
+    Encoder encoder;
+    // Scale, step is also used by ScratchJog
+    double min;
+    double max;
+    double step;
+    // ScratchTouch, see engine.scratchEnable()
+    int intervalsPerRev;
+    double rpm;
+    double alpha;
+    double beta;
+    bool ramp;
+};
+
 struct MidiInputMapping {
     MidiInputMapping() {
     }
@@ -205,11 +275,13 @@ struct MidiInputMapping {
 
     bool operator==(const MidiInputMapping& other) const {
         return key == other.key && options == other.options &&
-                control == other.control && description == other.description;
+                transform == other.transform && control == other.control &&
+                description == other.description;
     }
 
     MidiKey key;
     MidiOptions options;
+    MidiInputTransform transform;
     ConfigKey control;
     QString description;
 };
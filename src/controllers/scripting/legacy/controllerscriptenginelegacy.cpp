@@ -7,10 +7,12 @@
 #include "errordialoghandler.h"
 #include "mixer/playermanager.h"
 #include "moc_controllerscriptenginelegacy.cpp"
+#include "util/timer.h"
 
 ControllerScriptEngineLegacy::ControllerScriptEngineLegacy(
         Controller* controller, const RuntimeLoggingCategory& logger)
-        : ControllerScriptEngineBase(controller, logger) {
+        : ControllerScriptEngineBase(controller, logger),
+          m_profiler(controller ? controller->getName() : QString()) {
     connect(&m_fileWatcher,
             &QFileSystemWatcher::fileChanged,
             this,
@@ -99,6 +101,21 @@ void ControllerScriptEngineLegacy::setScriptFiles(
     m_scriptFiles = scripts;
 }
 
+void ControllerScriptEngineLegacy::setInputHandlers(const QStringList& codeSnippets) {
+    m_inputHandlers = codeSnippets;
+    m_inputHandlers.removeDuplicates();
+}
+
+void ControllerScriptEngineLegacy::warmUpInputHandlers() {
+    ScopedTimer t("ControllerScriptEngineLegacy::warmUpInputHandlers");
+    // The handlers themselves are not executed, because that would act on
+    // the mixer. Only the wrappers are compiled and cached now instead of on
+    // the first input, which might be in the middle of a performance.
+    for (const QString& codeSnippet : std::as_const(m_inputHandlers)) {
+        wrapFunctionCode(codeSnippet, 5);
+    }
+}
+
 bool ControllerScriptEngineLegacy::initialize() {
     if (!ControllerScriptEngineBase::initialize()) {
         return false;
@@ -125,6 +142,7 @@ bool ControllerScriptEngineLegacy::initialize() {
             new ControllerScriptInterfaceLegacy(this, m_logger);
     engineGlobalObject.setProperty(
             "engine", m_pJSEngine->newQObject(legacyScriptInterface));
+    m_pScriptInterface = legacyScriptInterface;
 
     for (const LegacyControllerMapping::ScriptFileInfo& script : std::as_const(m_scriptFiles)) {
         if (!evaluateScriptFile(script.file)) {
@@ -147,9 +165,10 @@ bool ControllerScriptEngineLegacy::initialize() {
             continue;
         }
         functionName.append(QStringLiteral(".incomingData"));
-        m_incomingDataFunctions.append(
+        m_incomingDataFunctions.append(IncomingDataFunction{
+                functionName,
                 wrapArrayBufferCallback(
-                        wrapFunctionCode(functionName, 2)));
+                        wrapFunctionCode(functionName, 2))});
     }
 
     // m_pController is nullptr in tests.
@@ -163,6 +182,8 @@ bool ControllerScriptEngineLegacy::initialize() {
         return false;
     }
 
+    warmUpInputHandlers();
+
     return true;
 }
 
@@ -171,6 +192,7 @@ void ControllerScriptEngineLegacy::shutdown() {
     m_scriptWrappedFunctionCache.clear();
     m_incomingDataFunctions.clear();
     m_scriptFunctionPrefixes.clear();
+    m_pScriptInterface.clear();
     ControllerScriptEngineBase::shutdown();
 }
 
@@ -186,8 +208,11 @@ bool ControllerScriptEngineLegacy::handleIncomingData(const QByteArray& data) {
             static_cast<uint>(data.size()),
     };
 
-    for (const QJSValue& function : std::as_const(m_incomingDataFunctions)) {
-        ControllerScriptEngineBase::executeFunction(function, args);
+    for (const IncomingDataFunction& function : std::as_const(m_incomingDataFunctions)) {
+        ControllerScriptProfiler::Scope profile(&m_profiler,
+                ControllerScriptProfiler::HandlerType::Input,
+                function.name);
+        ControllerScriptEngineBase::executeFunction(function.function, args);
     }
 
     return true;
@@ -4,9 +4,13 @@
 #include <QJSEngine>
 #include <QJSValue>
 #include <QMessageBox>
+#include <QPointer>
 
 #include "controllers/legacycontrollermapping.h"
 #include "controllers/scripting/controllerscriptenginebase.h"
+#include "controllers/scripting/legacy/controllerscriptprofiler.h"
+
+class ControllerScriptInterfaceLegacy;
 
 /// ControllerScriptEngineLegacy loads and executes controller scripts for the legacy
 /// JS/XML hybrid controller mapping system.
@@ -26,11 +30,33 @@ class ControllerScriptEngineLegacy : public ControllerScriptEngineBase {
     /// and ensures the function is executed with the correct 'this' object.
     QJSValue wrapFunctionCode(const QString& codeSnippet, int numberOfArgs);
 
+    /// Measures the JS callbacks of the mapping if profiling is enabled
+    ControllerScriptProfiler* profiler() {
+        return &m_profiler;
+    }
+
+    /// The "engine" object of the scripts, which is also used by the native
+    /// MIDI input transforms to share the scratch state with the scripts.
+    /// Only available while the engine is initialized.
+    ControllerScriptInterfaceLegacy* scriptInterface() const {
+        return m_pScriptInterface;
+    }
+
   public slots:
     void setScriptFiles(const QList<LegacyControllerMapping::ScriptFileInfo>& scripts);
+    /// The code of the input handlers that are bound in the XML file of
+    /// the mapping. They are prepared by initialize() so the first input
+    /// is not delayed by compiling the wrapper function.
+    void setInputHandlers(const QStringList& codeSnippets);
 
   private:
+    struct IncomingDataFunction {
+        QString name;
+        QJSValue function;
+    };
+
     bool evaluateScriptFile(const QFileInfo& scriptFile);
+    void warmUpInputHandlers();
     void shutdown() override;
 
     QJSValue wrapArrayBufferCallback(const QJSValue& callback);
@@ -40,10 +66,15 @@ class ControllerScriptEngineLegacy : public ControllerScriptEngineBase {
             bool bFatalError = false);
 
     QJSValue m_makeArrayBufferWrapperFunction;
+    // Owned by the JS engine
+    QPointer<ControllerScriptInterfaceLegacy> m_pScriptInterface;
     QList<QString> m_scriptFunctionPrefixes;
-    QList<QJSValue> m_incomingDataFunctions;
+    QList<IncomingDataFunction> m_incomingDataFunctions;
     QHash<QString, QJSValue> m_scriptWrappedFunctionCache;
     QList<LegacyControllerMapping::ScriptFileInfo> m_scriptFiles;
+    QStringList m_inputHandlers;
+
+    ControllerScriptProfiler m_profiler;
 
     QFileSystemWatcher m_fileWatcher;
 
@@ -263,6 +263,11 @@ QJSValue ControllerScriptInterfaceLegacy::makeConnectionInternal(
     connection.callback = callback;
     connection.id = QUuid::createUuid();
     connection.skipSuperseded = skipSuperseded;
+    if (m_pScriptEngineLegacy->profiler()->isEnabled()) {
+        connection.profilerName = connection.key.group + QStringLiteral(",") +
+                connection.key.item + QChar(' ') +
+                ControllerScriptProfiler::handlerName(callback);
+    }
 
     if (coScript->addScriptConnection(connection)) {
         return pJsEngine->newQObject(
@@ -465,6 +470,9 @@ int ControllerScriptInterfaceLegacy::beginTimer(
     TimerInfo info;
     info.callback = timerCallback;
     info.oneShot = oneShot;
+    if (m_pScriptEngineLegacy->profiler()->isEnabled()) {
+        info.profilerName = ControllerScriptProfiler::handlerName(timerCallback);
+    }
     m_timers[timerId] = info;
     if (timerId == 0) {
         qCWarning(m_logger) << "Script timer could not be created";
@@ -522,6 +530,9 @@ void ControllerScriptInterfaceLegacy::timerEvent(QTimerEvent* event) {
         stopTimer(timerId);
     }
 
+    ControllerScriptProfiler::Scope profile(m_pScriptEngineLegacy->profiler(),
+            ControllerScriptProfiler::HandlerType::Timer,
+            timerTarget.profilerName);
     m_pScriptEngineLegacy->executeFunction(timerTarget.callback);
 }
 
@@ -88,6 +88,8 @@ class ControllerScriptInterfaceLegacy : public QObject {
     struct TimerInfo {
         QJSValue callback;
         bool oneShot;
+        // Only set if profiling is enabled
+        QString profilerName;
     };
     QHash<int, TimerInfo> m_timers;
 
@@ -0,0 +1,91 @@
+#include "controllers/scripting/legacy/controllerscriptprofiler.h"
+
+#include "util/assert.h"
+#include "util/cmdlineargs.h"
+#include "util/stat.h"
+
+namespace {
+
+constexpr int kMaxSourceNameLength = 60;
+
+constexpr Stat::ComputeFlags kDurationStatFlags = Stat::COUNT | Stat::AVERAGE |
+        Stat::SAMPLE_VARIANCE | Stat::MIN | Stat::MAX;
+constexpr Stat::ComputeFlags kHistogramStatFlags = Stat::COUNT | Stat::HISTOGRAM;
+
+QString handlerTypeName(ControllerScriptProfiler::HandlerType type) {
+    switch (type) {
+    case ControllerScriptProfiler::HandlerType::Input:
+        return QStringLiteral("input");
+    case ControllerScriptProfiler::HandlerType::Timer:
+        return QStringLiteral("timer");
+    case ControllerScriptProfiler::HandlerType::Connection:
+        return QStringLiteral("connection");
+    }
+    DEBUG_ASSERT(!"unreachable");
+    return QString();
+}
+
+} // anonymous namespace
+
+ControllerScriptProfiler::ControllerScriptProfiler(const QString& controllerName)
+        : m_controllerName(controllerName),
+          m_enabled(CmdlineArgs::Instance().getDeveloper()) {
+}
+
+const ControllerScriptProfiler::StatKeys& ControllerScriptProfiler::statKeys(
+        HandlerType type, const QString& handlerName) {
+    QHash<QString, StatKeys>& keys = m_statKeys[static_cast<int>(type)];
+    auto it = keys.find(handlerName);
+    if (it == keys.end()) {
+        StatKeys statKeys;
+        statKeys.duration = QStringLiteral("JS %1 %2").arg(handlerTypeName(type), handlerName);
+        if (!m_controllerName.isEmpty()) {
+            statKeys.duration += QStringLiteral(" (%1)").arg(m_controllerName);
+        }
+        statKeys.histogram = statKeys.duration + QStringLiteral(" histogram");
+        it = keys.insert(handlerName, statKeys);
+    }
+    return it.value();
+}
+
+const QString& ControllerScriptProfiler::statKey(
+        HandlerType type, const QString& handlerName) {
+    return statKeys(type, handlerName).duration;
+}
+
+void ControllerScriptProfiler::track(
+        HandlerType type, const QString& handlerName, mixxx::Duration duration) {
+    const StatKeys& keys = statKeys(type, handlerName);
+    Stat::track(keys.duration,
+            Stat::DURATION_NANOSEC,
+            Stat::experimentFlags(kDurationStatFlags),
+            duration.toIntegerNanos());
+    Stat::track(keys.histogram,
+            Stat::DURATION_NANOSEC,
+            Stat::experimentFlags(kHistogramStatFlags),
+            histogramBucket(duration).toIntegerNanos());
+}
+
+// static
+QString ControllerScriptProfiler::handlerName(const QJSValue& function) {
+    const QString name = function.property(QStringLiteral("name")).toString();
+    if (!name.isEmpty()) {
+        return name;
+    }
+    QString source = function.toString().simplified();
+    if (source.size() > kMaxSourceNameLength) {
+        source.truncate(kMaxSourceNameLength);
+        source.append(QStringLiteral("..."));
+    }
+    return source;
+}
+
+// static
+mixxx::Duration ControllerScriptProfiler::histogramBucket(mixxx::Duration duration) {
+    const qint64 nanos = duration.toIntegerNanos();
+    qint64 bucketMicros = 1;
+    while (bucketMicros * 1000 < nanos) {
+        bucketMicros *= 2;
+    }
+    return mixxx::Duration::fromMicros(bucketMicros);
+}
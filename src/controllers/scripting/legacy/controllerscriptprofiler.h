@@ -0,0 +1,85 @@
+#pragma once
+
+#include <QHash>
+#include <QJSValue>
+#include <QString>
+
+#include "util/duration.h"
+#include "util/performancetimer.h"
+
+/// ControllerScriptProfiler reports the execution time of the JS callbacks
+/// of a legacy controller mapping to the StatsManager, so a slow input
+/// handler, timer or connection callback can be found by its name.
+///
+/// Like ScopedTimer it is only enabled in developer mode, otherwise the
+/// callbacks are not measured at all.
+class ControllerScriptProfiler {
+  public:
+    enum class HandlerType {
+        Input,
+        Timer,
+        Connection,
+    };
+
+    explicit ControllerScriptProfiler(const QString& controllerName);
+
+    bool isEnabled() const {
+        return m_enabled;
+    }
+    void setEnabled(bool enabled) {
+        m_enabled = enabled;
+    }
+
+    /// The StatsManager key of the durations of a handler. The key of the
+    /// histogram is the same with " histogram" appended.
+    const QString& statKey(HandlerType type, const QString& handlerName);
+
+    void track(HandlerType type, const QString& handlerName, mixxx::Duration duration);
+
+    /// A name for a JS function to identify it in the statistics. Functions
+    /// that are assigned to object properties are anonymous, those are
+    /// identified by the beginning of their source code.
+    static QString handlerName(const QJSValue& function);
+
+    /// Durations are rounded up to a power of two microseconds for the
+    /// histogram, otherwise it would have one bucket for every report.
+    static mixxx::Duration histogramBucket(mixxx::Duration duration);
+
+    /// Measures a callback while in scope, if profiling is enabled
+    class Scope {
+      public:
+        Scope(ControllerScriptProfiler* pProfiler,
+                HandlerType type,
+                const QString& handlerName)
+                : m_pProfiler(pProfiler && pProfiler->isEnabled() ? pProfiler : nullptr),
+                  m_type(type),
+                  m_handlerName(m_pProfiler ? handlerName : QString()) {
+            if (m_pProfiler) {
+                m_timer.start();
+            }
+        }
+        ~Scope() {
+            if (m_pProfiler) {
+                m_pProfiler->track(m_type, m_handlerName, m_timer.elapsed());
+            }
+        }
+
+      private:
+        ControllerScriptProfiler* const m_pProfiler;
+        const HandlerType m_type;
+        const QString m_handlerName;
+        PerformanceTimer m_timer;
+    };
+
+  private:
+    struct StatKeys {
+        QString duration;
+        QString histogram;
+    };
+    const StatKeys& statKeys(HandlerType type, const QString& handlerName);
+
+    const QString m_controllerName;
+    bool m_enabled;
+    // One cache per HandlerType, since the keys are needed for every callback
+    QHash<QString, StatKeys> m_statKeys[3];
+};
@@ -5,6 +5,10 @@
 
 void ScriptConnection::executeCallback(double value) const {
     Trace executeCallbackTrace("JS %1 callback", key.item);
+    ControllerScriptProfiler::Scope profile(
+            controllerEngine ? controllerEngine->profiler() : nullptr,
+            ControllerScriptProfiler::HandlerType::Connection,
+            profilerName);
     const auto args = QJSValueList{
             value,
             key.group,
@@ -19,6 +19,9 @@ class ScriptConnection {
     ControllerScriptInterfaceLegacy* engineJSProxy;
     ControllerScriptEngineLegacy* controllerEngine;
     bool skipSuperseded;
+    /// The name of the callback in the statistics of the
+    /// ControllerScriptProfiler, only set if profiling is enabled
+    QString profilerName;
 
     void executeCallback(double value) const;
 
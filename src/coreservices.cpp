@@ -331,7 +331,8 @@ void CoreServices::initialize(QApplication* pApp) {
             &ScreensaverManager::slotCurrentPlayingDeckChanged);
 
     emit initializationProgressUpdate(50, tr("library"));
-    CoverArtCache::createInstance();
+    CoverArtCache::createInstance()->setDiskCacheDirectory(
+            QDir(pConfig->getSettingsPath()).filePath(QStringLiteral("cache/covers")));
 
     m_pTrackCollectionManager = std::make_shared<TrackCollectionManager>(
             this,
@@ -3,6 +3,7 @@
 
 #include "control/controlproxy.h"
 #include "effects/backends/builtin/lvmixeqbase.h"
+#include "effects/backends/builtin/equalizer_util.h"
 #include "effects/backends/effectprocessor.h"
 #include "engine/effects/engineeffect.h"
 #include "engine/effects/engineeffectparameter.h"
@@ -38,6 +39,10 @@ class Bessel4LVMixEQEffect : public EffectProcessorImpl<Bessel4LVMixEQEffectGrou
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatureState) override;
 
+    SINT getTailFrames(const mixxx::EngineParameters& engineParameters) override {
+        return EqualizerUtil::tailFrames(engineParameters);
+    }
+
   private:
     QString debugString() const {
         return getId();
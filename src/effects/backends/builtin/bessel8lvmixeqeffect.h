@@ -4,6 +4,7 @@
 
 #include "control/controlproxy.h"
 #include "effects/backends/builtin/lvmixeqbase.h"
+#include "effects/backends/builtin/equalizer_util.h"
 #include "effects/backends/effectprocessor.h"
 #include "engine/effects/engineeffect.h"
 #include "engine/effects/engineeffectparameter.h"
@@ -40,6 +41,10 @@ class Bessel8LVMixEQEffect : public EffectProcessorImpl<Bessel8LVMixEQEffectGrou
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatureState) override;
 
+    SINT getTailFrames(const mixxx::EngineParameters& engineParameters) override {
+        return EqualizerUtil::tailFrames(engineParameters);
+    }
+
   private:
     QString debugString() const {
         return getId();
@@ -2,6 +2,7 @@
 
 #include "control/controlproxy.h"
 #include "effects/backends/builtin/lvmixeqbase.h"
+#include "effects/backends/builtin/equalizer_util.h"
 #include "effects/backends/effectprocessor.h"
 #include "engine/effects/engineeffect.h"
 #include "engine/effects/engineeffectparameter.h"
@@ -74,6 +75,10 @@ class BiquadFullKillEQEffect : public EffectProcessorImpl<BiquadFullKillEQEffect
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatureState) override;
 
+    SINT getTailFrames(const mixxx::EngineParameters& engineParameters) override {
+        return EqualizerUtil::tailFrames(engineParameters);
+    }
+
     void setFilters(mixxx::audio::SampleRate sampleRate,
             double lowFreqCorner,
             double highFreqCorner);
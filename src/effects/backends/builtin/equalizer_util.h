@@ -3,9 +3,19 @@
 #include <QObject>
 
 #include "effects/backends/effectmanifest.h"
+#include "engine/engine.h"
 
 class EqualizerUtil {
   public:
+    // The IIR filters of the equalizers and the filter effects have decayed
+    // below the noise floor after this time, even for resonant low corner
+    // frequencies and including the group delay of the LV Mix EQs.
+    static constexpr double kTailSeconds = 1.0;
+
+    static SINT tailFrames(const mixxx::EngineParameters& engineParameters) {
+        return static_cast<SINT>(engineParameters.sampleRate().toDouble() * kTailSeconds);
+    }
+
     // Creates common EQ parameters like low/mid/high gain and kill buttons.
     static void createCommonParameters(EffectManifest* pManifest, bool linear) {
         EffectManifestParameter::ValueScaler valueScaler =
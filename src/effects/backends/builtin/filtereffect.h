@@ -1,5 +1,6 @@
 #pragma once
 
+#include "effects/backends/builtin/equalizer_util.h"
 #include "effects/backends/effectprocessor.h"
 #include "engine/effects/engineeffect.h"
 #include "engine/effects/engineeffectparameter.h"
@@ -44,6 +45,10 @@ class FilterEffect : public EffectProcessorImpl<FilterGroupState> {
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatures) override;
 
+    SINT getTailFrames(const mixxx::EngineParameters& engineParameters) override {
+        return EqualizerUtil::tailFrames(engineParameters);
+    }
+
   private:
     QString debugString() const {
         return getId();
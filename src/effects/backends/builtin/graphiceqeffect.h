@@ -3,6 +3,7 @@
 #include <QMap>
 
 #include "control/controlproxy.h"
+#include "effects/backends/builtin/equalizer_util.h"
 #include "effects/backends/effectprocessor.h"
 #include "engine/effects/engineeffect.h"
 #include "engine/effects/engineeffectparameter.h"
@@ -48,6 +49,10 @@ class GraphicEQEffect : public EffectProcessorImpl<GraphicEQEffectGroupState> {
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatureState) override;
 
+    SINT getTailFrames(const mixxx::EngineParameters& engineParameters) override {
+        return EqualizerUtil::tailFrames(engineParameters);
+    }
+
   private:
     QString debugString() const {
         return getId();
@@ -3,6 +3,7 @@
 #include <QMap>
 
 #include "control/controlproxy.h"
+#include "effects/backends/builtin/equalizer_util.h"
 #include "effects/backends/effectprocessor.h"
 #include "engine/effects/engineeffect.h"
 #include "engine/effects/engineeffectparameter.h"
@@ -56,6 +57,10 @@ class LinkwitzRiley8EQEffect : public EffectProcessorImpl<LinkwitzRiley8EQEffect
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatureState) override;
 
+    SINT getTailFrames(const mixxx::EngineParameters& engineParameters) override {
+        return EqualizerUtil::tailFrames(engineParameters);
+    }
+
   private:
     QString debugString() const {
         return getId();
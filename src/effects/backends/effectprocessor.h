@@ -110,6 +110,18 @@ class EffectProcessor {
     /// the dry signal is delayed to overlap with the output wet signal
     /// after processing all effects in the effects chain.
     virtual SINT getGroupDelayFrames() = 0;
+
+    /// Returned by getTailFrames() if the effect may produce output without
+    /// any input, or if the length of its tail is not known.
+    static constexpr SINT kUnknownTailFrames = -1;
+
+    /// This method is used for obtaining the number of frames the effect
+    /// keeps producing output after its input has become silent, for example
+    /// the decay of a filter or the repeats of an echo, including the group
+    /// delay. EngineEffectChain stops processing an effect once its input has
+    /// been silent for longer than the tail and resumes when the input is no
+    /// longer silent.
+    virtual SINT getTailFrames(const mixxx::EngineParameters& engineParameters) = 0;
 };
 
 /// EffectProcessorImpl manages a separate EffectState for every combination of
@@ -167,6 +179,14 @@ class EffectProcessorImpl : public EffectProcessor {
         return 0;
     }
 
+    /// By default, an effect is processed even if its input is silent,
+    /// because it may be a generator like the metronome. Effects that only
+    /// process their input should override this method.
+    virtual SINT getTailFrames(const mixxx::EngineParameters& engineParameters) override {
+        Q_UNUSED(engineParameters);
+        return kUnknownTailFrames;
+    }
+
     void process(const ChannelHandle& inputHandle,
             const ChannelHandle& outputHandle,
             const CSAMPLE* pInput,
@@ -7,18 +7,103 @@
 #include "util/math.h"
 #include "util/sample.h"
 
+namespace {
+
+constexpr int kMaxTaps = 2 * EngineBufferScaleLinear::kMaxHalfTaps;
+
+// Number of precomputed fractional positions of the windowed-sinc kernel.
+// Coefficients between two phases are interpolated linearly.
+constexpr int kSincPhases = 256;
+
+// Cutoff relative to the Nyquist frequency and the Kaiser window shape. A
+// cutoff below 1.0 leaves room for the transition band of the short kernel.
+constexpr double kSincCutoff = 0.9;
+constexpr double kSincKaiserBeta = 8.0;
+
+int halfTapsOf(EngineBufferScaleLinear::Interpolator interpolator) {
+    switch (interpolator) {
+    case EngineBufferScaleLinear::Interpolator::Hermite:
+        return 2;
+    case EngineBufferScaleLinear::Interpolator::Sinc:
+        return EngineBufferScaleLinear::kMaxHalfTaps;
+    case EngineBufferScaleLinear::Interpolator::Linear:
+    default:
+        return 1;
+    }
+}
+
+// Zeroth order modified Bessel function of the first kind
+double besselI0(double x) {
+    const double halfX = x / 2;
+    double term = 1.0;
+    double sum = 1.0;
+    for (int k = 1; k < 32; ++k) {
+        term *= halfX / k;
+        sum += term * term;
+    }
+    return sum;
+}
+
+// Polyphase bank of a Kaiser windowed sinc. Row p holds the kMaxTaps
+// coefficients for the fractional position p / kSincPhases, applied to the
+// frames floor - kMaxHalfTaps + 1 ... floor + kMaxHalfTaps.
+class SincTable {
+  public:
+    SincTable() {
+        const double i0Beta = besselI0(kSincKaiserBeta);
+        for (int phase = 0; phase <= kSincPhases; ++phase) {
+            const double frac = static_cast<double>(phase) / kSincPhases;
+            double coefficients[kMaxTaps];
+            double sum = 0.0;
+            for (int k = 0; k < kMaxTaps; ++k) {
+                // Distance of the tap from the interpolated position
+                const double x = k - (EngineBufferScaleLinear::kMaxHalfTaps - 1) - frac;
+                const double t = x / EngineBufferScaleLinear::kMaxHalfTaps;
+                const double window = fabs(t) < 1.0
+                        ? besselI0(kSincKaiserBeta * sqrt(1.0 - t * t)) / i0Beta
+                        : 0.0;
+                const double arg = M_PI * kSincCutoff * x;
+                const double sinc = arg == 0.0 ? 1.0 : sin(arg) / arg;
+                coefficients[k] = window * sinc;
+                sum += coefficients[k];
+            }
+            // Normalize for unity gain at DC
+            for (int k = 0; k < kMaxTaps; ++k) {
+                m_coefficients[phase][k] = static_cast<CSAMPLE>(coefficients[k] / sum);
+            }
+        }
+    }
+
+    const CSAMPLE* row(int phase) const {
+        return m_coefficients[phase];
+    }
+
+  private:
+    CSAMPLE m_coefficients[kSincPhases + 1][kMaxTaps];
+};
+
+const SincTable& sincTable() {
+    static const SincTable table;
+    return table;
+}
+
+} // anonymous namespace
+
 EngineBufferScaleLinear::EngineBufferScaleLinear(ReadAheadManager *pReadAheadManager)
     : m_pReadAheadManager(pReadAheadManager),
       m_bufferInt(SampleUtil::alloc(kiLinearScaleReadAheadLength)),
       m_bufferIntSize(0),
+      m_requestedInterpolator(defaultInterpolator()),
+      m_interpolator(defaultInterpolator()),
       m_bClear(false),
       m_dRate(1.0),
       m_dOldRate(1.0),
       m_dCurrentFrame(0.0),
       m_dNextFrame(0.0) {
-    m_floorSampleOld[0] = 0.0;
-    m_floorSampleOld[1] = 0.0;
+    SampleUtil::clear(m_history, kHistoryFrames * 2);
     SampleUtil::clear(m_bufferInt, kiLinearScaleReadAheadLength);
+    // Build the shared table here and not lazily in the engine thread
+    sincTable();
 }
 
 EngineBufferScaleLinear::~EngineBufferScaleLinear() {
@@ -34,13 +119,39 @@ void EngineBufferScaleLinear::setScaleParameters(double base_rate,
     m_dRate = base_rate * *pTempoRatio;
 }
 
+void EngineBufferScaleLinear::setInterpolator(Interpolator interpolator) {
+    m_requestedInterpolator.store(interpolator, std::memory_order_relaxed);
+}
+
 void EngineBufferScaleLinear::clear() {
     m_bClear = true;
     // Clear out buffer and saved sample data
     m_bufferIntSize = 0;
     m_dNextFrame = 0;
-    m_floorSampleOld[0] = 0;
-    m_floorSampleOld[1] = 0;
+    SampleUtil::clear(m_history, kHistoryFrames * 2);
+}
+
+void EngineBufferScaleLinear::pushHistory(const CSAMPLE* pSamples, SINT frames) {
+    if (frames <= 0) {
+        return;
+    }
+    const SINT newFrames = math_min<SINT>(frames, kHistoryFrames);
+    const SINT keptFrames = kHistoryFrames - newFrames;
+    // Drop the oldest frames, the ranges may overlap
+    std::copy(m_history + getOutputSignal().frames2samples(newFrames),
+            m_history + getOutputSignal().frames2samples(kHistoryFrames),
+            m_history);
+    SampleUtil::copy(m_history + getOutputSignal().frames2samples(keptFrames),
+            pSamples + getOutputSignal().frames2samples(frames - newFrames),
+            getOutputSignal().frames2samples(newFrames));
+}
+
+inline CSAMPLE EngineBufferScaleLinear::sampleAt(SINT frame, int channel) const {
+    if (frame < 0) {
+        DEBUG_ASSERT(frame >= -kHistoryFrames);
+        return m_history[getOutputSignal().frames2samples(kHistoryFrames + frame) + channel];
+    }
+    return m_bufferInt[getOutputSignal().frames2samples(frame) + channel];
 }
 
 // laurent de soras - punked from musicdsp.org (mad props)
@@ -67,6 +178,7 @@ double EngineBufferScaleLinear::scaleBuffer(
         m_dOldRate = m_dRate;  // If cleared, don't interpolate rate.
         m_bClear = false;
     }
+    m_interpolator = m_requestedInterpolator.load(std::memory_order_relaxed);
     double rate_add_old = m_dOldRate; // Smoothly interpolate to new playback rate
     double rate_add_new = m_dRate;
     SINT frames_read = 0;
@@ -81,12 +193,17 @@ double EngineBufferScaleLinear::scaleBuffer(
         m_dRate = 0.0;
         frames_read += do_scale(pOutputBuffer, getOutputSignal().samples2frames(iOutputBufferSize));
 
-        // reset m_floorSampleOld in a way as we were coming from
+        // reset the history in a way as we were coming from
         // the other direction
-        SINT iNextSample = getOutputSignal().frames2samples(static_cast<SINT>(ceil(m_dNextFrame)));
-        if (iNextSample + 1 < m_bufferIntSize) {
-            m_floorSampleOld[0] = m_bufferInt[iNextSample];
-            m_floorSampleOld[1] = m_bufferInt[iNextSample + 1];
+        SINT iNextFrame = static_cast<SINT>(ceil(m_dNextFrame));
+        for (SINT frame = 0; frame < kHistoryFrames; ++frame) {
+            SINT iNextSample = getOutputSignal().frames2samples(iNextFrame + frame);
+            if (iNextSample < 0 || iNextSample + 1 >= m_bufferIntSize) {
+                break;
+            }
+            SINT iHistorySample = getOutputSignal().frames2samples(kHistoryFrames - 1 - frame);
+            m_history[iHistorySample] = m_bufferInt[iNextSample];
+            m_history[iHistorySample + 1] = m_bufferInt[iNextSample + 1];
         }
 
         // if the buffer has extra samples, do a read so RAMAN ends up back where
@@ -168,14 +285,11 @@ SINT EngineBufferScaleLinear::do_copy(CSAMPLE* buf, SINT buf_size) {
     // blow away the fractional sample position here
     m_bufferIntSize = 0; // force buffer read
     m_dNextFrame = 0;
-    if (read_samples > 1) {
-        m_floorSampleOld[0] = buf[read_samples - 2];
-        m_floorSampleOld[1] = buf[read_samples - 1];
-    }
+    pushHistory(buf, getOutputSignal().samples2frames(read_samples));
     return read_samples;
 }
 
-// Stretch a specified buffer worth of audio using linear interpolation
+// Stretch a specified buffer worth of audio using the selected interpolator
 SINT EngineBufferScaleLinear::do_scale(CSAMPLE* buf, SINT buf_size) {
     double rate_old = m_dOldRate;
     const double rate_new = m_dRate;
@@ -220,129 +334,162 @@ SINT EngineBufferScaleLinear::do_scale(CSAMPLE* buf, SINT buf_size) {
             m_dNextFrame - floor(m_dNextFrame));
 
     int read_failed_count = 0;
-    CSAMPLE floor_sample[2];
-    CSAMPLE ceil_sample[2];
-
-    floor_sample[0] = 0;
-    floor_sample[1] = 0;
-    ceil_sample[0] = 0;
-    ceil_sample[1] = 0;
-
     SINT frames_read = 0;
     SINT i = 0;
-    //int screwups_debug = 0;
 
     double rate_add = fabs(rate_old);
     const double rate_delta_abs =
             rate_old < 0 || rate_new < 0 ? -rate_delta : rate_delta;
 
-    // Hot frame loop
+    const int halfTaps = halfTapsOf(m_interpolator);
+
+    // Hot frame loop. Frames are gathered block wise with all their taps,
+    // then interpolated at once.
     while (i < buf_size) {
-        // shift indices
-        m_dCurrentFrame = m_dNextFrame;
-
-        // Because our index is a float value, we're going to be interpolating
-        // between two samples, a lower (prev) and upper (cur) sample.
-        // If the lower sample is off the end of the buffer (values between
-        // -.999 and 0), load it from the saved globals.
-
-        // The first bounds check (< m_bufferIntSize) is probably not needed.
-
-        SINT currentFrameFloor = static_cast<SINT>(floor(m_dCurrentFrame));
-
-        if (currentFrameFloor < 0) {
-            // we have advanced to a new buffer in the previous run,
-            // but the floor still points to the old buffer
-            // so take the cached sample, this happens on slow rates
-            floor_sample[0] = m_floorSampleOld[0];
-            floor_sample[1] = m_floorSampleOld[1];
-            ceil_sample[0] = m_bufferInt[0];
-            ceil_sample[1] = m_bufferInt[1];
-        } else if (getOutputSignal().frames2samples(currentFrameFloor) + 3 < m_bufferIntSize) {
-            // take floor_sample form the buffer of the previous run
-            floor_sample[0] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor)];
-            floor_sample[1] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor) + 1];
-            ceil_sample[0] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor) + 2];
-            ceil_sample[1] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor) + 3];
-        } else {
-            // if we don't have the ceil_sample in buffer, load some more
-
-            if (getOutputSignal().frames2samples(currentFrameFloor) + 1 < m_bufferIntSize) {
-                // take floor_sample form the buffer of the previous run
-                floor_sample[0] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor)];
-                floor_sample[1] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor) + 1];
-            }
+        CSAMPLE* const pBlock = &buf[i];
+        SINT blockFrames = 0;
+        while (i < buf_size && blockFrames < kBlockFrames) {
+            // shift indices
+            m_dCurrentFrame = m_dNextFrame;
+
+            // Because our index is a float value, we're going to be
+            // interpolating between the taps around it. Taps left of the
+            // buffer start (negative indices) are taken from the history.
+
+            SINT currentFrameFloor = static_cast<SINT>(floor(m_dCurrentFrame));
+
+            // if we don't have all taps right of the position in buffer,
+            // load some more
+            if (getOutputSignal().frames2samples(currentFrameFloor + halfTaps) + 1 >=
+                    m_bufferIntSize) {
+                do {
+                    SINT old_bufsize = m_bufferIntSize;
+                    if (unscaled_frames_needed == 0) {
+                        // protection against infinite loop
+                        // This may happen due to double precision issues
+                        ++unscaled_frames_needed;
+                    }
 
-            do {
-                SINT old_bufsize = m_bufferIntSize;
-                if (unscaled_frames_needed == 0) {
-                    // protection against infinite loop
-                    // This may happen due to double precision issues
-                    ++unscaled_frames_needed;
-                }
+                    SINT samples_to_read = math_min<SINT>(
+                            kiLinearScaleReadAheadLength,
+                            getOutputSignal().frames2samples(unscaled_frames_needed));
 
-                SINT samples_to_read = math_min<SINT>(
-                        kiLinearScaleReadAheadLength,
-                        getOutputSignal().frames2samples(unscaled_frames_needed));
+                    // Keep the tail of the buffer of the previous run for the
+                    // taps left of the position
+                    pushHistory(m_bufferInt, getOutputSignal().samples2frames(old_bufsize));
 
-                m_bufferIntSize = m_pReadAheadManager->getNextSamples(
-                        rate_new == 0 ? rate_old : rate_new,
-                        m_bufferInt, samples_to_read);
+                    m_bufferIntSize = m_pReadAheadManager->getNextSamples(
+                            rate_new == 0 ? rate_old : rate_new,
+                            m_bufferInt, samples_to_read);
 
-                if (m_bufferIntSize == 0) {
-                    if (++read_failed_count > 1) {
-                        break;
-                    } else {
-                        continue;
+                    if (m_bufferIntSize == 0) {
+                        if (++read_failed_count > 1) {
+                            break;
+                        } else {
+                            continue;
+                        }
                     }
-                }
 
-                frames_read += getOutputSignal().samples2frames(m_bufferIntSize);
-                unscaled_frames_needed -= getOutputSignal().samples2frames(m_bufferIntSize);
+                    frames_read += getOutputSignal().samples2frames(m_bufferIntSize);
+                    unscaled_frames_needed -= getOutputSignal().samples2frames(m_bufferIntSize);
 
-                // adapt the m_dCurrentFrame the index of the new buffer
-                m_dCurrentFrame -= getOutputSignal().samples2frames(old_bufsize);
-                currentFrameFloor = static_cast<SINT>(floor(m_dCurrentFrame));
-            } while (getOutputSignal().frames2samples(currentFrameFloor) + 3 >= m_bufferIntSize);
+                    // adapt the m_dCurrentFrame the index of the new buffer
+                    m_dCurrentFrame -= getOutputSignal().samples2frames(old_bufsize);
+                    currentFrameFloor = static_cast<SINT>(floor(m_dCurrentFrame));
+                } while (getOutputSignal().frames2samples(currentFrameFloor + halfTaps) + 1 >=
+                        m_bufferIntSize);
 
-            // I guess?
-            if (read_failed_count > 1) {
-                break;
+                // I guess?
+                if (read_failed_count > 1) {
+                    break;
+                }
             }
 
-            // Now that the buffer is up to date, we can get the value of the sample
-            // at the floor of our position.
-            if (currentFrameFloor >= 0) {
-                // the previous position is in the new buffer
-                floor_sample[0] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor)];
-                floor_sample[1] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor) + 1];
+            const SINT firstTap = currentFrameFloor - halfTaps + 1;
+            for (int tap = 0; tap < 2 * halfTaps; ++tap) {
+                m_taps[0][tap][blockFrames] = sampleAt(firstTap + tap, 0);
+                m_taps[1][tap][blockFrames] = sampleAt(firstTap + tap, 1);
             }
-            ceil_sample[0] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor) + 2];
-            ceil_sample[1] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor) + 3];
-        }
 
-        // For the current index, what percentage is it
-        // between the previous and the next?
-        CSAMPLE frac = static_cast<CSAMPLE>(m_dCurrentFrame) - currentFrameFloor;
+            // For the current index, what percentage is it
+            // between the previous and the next?
+            m_frac[blockFrames] = static_cast<CSAMPLE>(m_dCurrentFrame) - currentFrameFloor;
+            ++blockFrames;
 
-        // Perform linear interpolation
-        buf[i] = floor_sample[0] + frac * (ceil_sample[0] - floor_sample[0]);
-        buf[i + 1] = floor_sample[1] + frac * (ceil_sample[1] - floor_sample[1]);
+            // increment the index for the next loop
+            m_dNextFrame = m_dCurrentFrame + rate_add;
 
-        m_floorSampleOld[0] = floor_sample[0];
-        m_floorSampleOld[1] = floor_sample[1];
+            // Smooth any changes in the playback rate over one buf_size
+            // samples. This prevents the change from being discontinuous and helps
+            // improve sound quality.
+            rate_add += rate_delta_abs;
+            i += getOutputSignal().getChannelCount();
+        }
 
-        // increment the index for the next loop
-        m_dNextFrame = m_dCurrentFrame + rate_add;
+        interpolateBlock(pBlock, blockFrames);
 
-        // Smooth any changes in the playback rate over one buf_size
-        // samples. This prevents the change from being discontinuous and helps
-        // improve sound quality.
-        rate_add += rate_delta_abs;
-        i += getOutputSignal().getChannelCount();
+        if (read_failed_count > 1) {
+            break;
+        }
     }
 
     SampleUtil::clear(&buf[i], buf_size - i);
 
     return frames_read;
 }
+
+void EngineBufferScaleLinear::interpolateBlock(CSAMPLE* buf, SINT frames) {
+    CSAMPLE output[2][kBlockFrames];
+    switch (m_interpolator) {
+    case Interpolator::Hermite:
+        for (int channel = 0; channel < 2; ++channel) {
+            const auto& taps = m_taps[channel];
+            CSAMPLE* pOutput = output[channel];
+            // note: LOOP VECTORIZED.
+            for (SINT n = 0; n < frames; ++n) {
+                pOutput[n] = hermite4(m_frac[n], taps[0][n], taps[1][n], taps[2][n], taps[3][n]);
+            }
+        }
+        break;
+    case Interpolator::Sinc: {
+        // Gather the coefficients of all frames first, so that the multiply
+        // accumulate below runs across frames.
+        const SincTable& table = sincTable();
+        for (SINT n = 0; n < frames; ++n) {
+            const CSAMPLE phasePos = m_frac[n] * kSincPhases;
+            const int phase = math_clamp(static_cast<int>(phasePos), 0, kSincPhases - 1);
+            const CSAMPLE weight = phasePos - phase;
+            const CSAMPLE* pRow = table.row(phase);
+            const CSAMPLE* pNextRow = table.row(phase + 1);
+            for (int tap = 0; tap < kMaxTaps; ++tap) {
+                m_coefficients[tap][n] = pRow[tap] + weight * (pNextRow[tap] - pRow[tap]);
+            }
+        }
+        for (int channel = 0; channel < 2; ++channel) {
+            const auto& taps = m_taps[channel];
+            CSAMPLE* pOutput = output[channel];
+            SampleUtil::clear(pOutput, frames);
+            for (int tap = 0; tap < kMaxTaps; ++tap) {
+                // note: LOOP VECTORIZED.
+                for (SINT n = 0; n < frames; ++n) {
+                    pOutput[n] += m_coefficients[tap][n] * taps[tap][n];
+                }
+            }
+        }
+        break;
+    }
+    case Interpolator::Linear:
+    default:
+        for (int channel = 0; channel < 2; ++channel) {
+            const auto& taps = m_taps[channel];
+            CSAMPLE* pOutput = output[channel];
+            // Perform linear interpolation
+            // note: LOOP VECTORIZED.
+            for (SINT n = 0; n < frames; ++n) {
+                pOutput[n] = taps[0][n] + m_frac[n] * (taps[1][n] - taps[0][n]);
+            }
+        }
+        break;
+    }
+    SampleUtil::interleaveBuffer(buf, output[0], output[1], frames);
+}
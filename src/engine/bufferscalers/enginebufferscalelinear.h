@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include "engine/bufferscalers/enginebufferscale.h"
 #include "engine/readaheadmanager.h"
 
@@ -10,6 +12,14 @@ constexpr int kiLinearScaleReadAheadLength = 10240;
 class EngineBufferScaleLinear : public EngineBufferScale  {
     Q_OBJECT
   public:
+    // This enum is also used in mixxx.cfg
+    // Don't remove or swap values to keep backward compatibility
+    enum class Interpolator {
+        Linear = 0,
+        Hermite = 1,
+        Sinc = 2,
+    };
+
     explicit EngineBufferScaleLinear(
             ReadAheadManager *pReadAheadManager);
     ~EngineBufferScaleLinear() override;
@@ -23,12 +33,39 @@ class EngineBufferScaleLinear : public EngineBufferScale  {
                             double* pTempoRatio,
                              double* pPitchRatio) override;
 
+    // Selects the interpolation kernel. May be called from any thread, the
+    // new kernel is picked up at the start of the next scaleBuffer() call.
+    // All kernels share the same sample history, so switching is click-free.
+    void setInterpolator(Interpolator interpolator);
+    Interpolator getInterpolator() const {
+        return m_requestedInterpolator.load(std::memory_order_relaxed);
+    }
+
+    constexpr static Interpolator defaultInterpolator() {
+        return Interpolator::Linear;
+    }
+
+    // Frames left and right of the interpolated position used by the
+    // widest kernel (Sinc)
+    static constexpr int kMaxHalfTaps = 8;
+
   private:
     void onSampleRateChanged() override {}
 
     SINT do_scale(CSAMPLE* buf, SINT buf_size);
     SINT do_copy(CSAMPLE* buf, SINT buf_size);
 
+    // Interpolates the frames gathered in m_taps/m_frac into buf
+    void interpolateBlock(CSAMPLE* buf, SINT frames);
+
+    // Remembers the trailing frames of pSamples as history for the taps left
+    // of the first frame of the next buffer.
+    void pushHistory(const CSAMPLE* pSamples, SINT frames);
+
+    // Returns a sample of the internal buffer or of the history in front of
+    // it for negative frame indices
+    CSAMPLE sampleAt(SINT frame, int channel) const;
+
     // The read-ahead manager that we use to fetch samples
     ReadAheadManager* m_pReadAheadManager;
 
@@ -36,7 +73,21 @@ class EngineBufferScaleLinear : public EngineBufferScale  {
     CSAMPLE* m_bufferInt;
     SINT m_bufferIntSize;
 
-    CSAMPLE m_floorSampleOld[2];
+    // The frames that directly precede m_bufferInt. Twice the half tap count
+    // is required because a refill may leave the position up to kMaxHalfTaps
+    // frames in front of the new buffer.
+    static constexpr int kHistoryFrames = 2 * kMaxHalfTaps;
+    CSAMPLE m_history[kHistoryFrames * 2];
+
+    // The frames of one block are gathered into a structure of arrays first,
+    // so that the kernels can be vectorized across frames.
+    static constexpr int kBlockFrames = 64;
+    CSAMPLE m_taps[2][2 * kMaxHalfTaps][kBlockFrames];
+    CSAMPLE m_frac[kBlockFrames];
+    CSAMPLE m_coefficients[2 * kMaxHalfTaps][kBlockFrames];
+
+    std::atomic<Interpolator> m_requestedInterpolator;
+    Interpolator m_interpolator;
 
     bool m_bClear;
     double m_dRate;
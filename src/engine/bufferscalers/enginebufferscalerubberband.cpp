@@ -2,11 +2,15 @@
 
 #include <rubberband/RubberBandStretcher.h>
 
+#include <QAtomicInt>
 #include <QtDebug>
+#include <optional>
 
 #include "control/controlobject.h"
+#include "engine/engineworkerscheduler.h"
 #include "engine/readaheadmanager.h"
 #include "moc_enginebufferscalerubberband.cpp"
+#include "util/compatibility/qmutex.h"
 #include "util/counter.h"
 #include "util/defs.h"
 #include "util/math.h"
@@ -23,14 +27,76 @@ size_t kRubberBandBlockSize = 256;
 
 #define RUBBERBANDV3 (RUBBERBAND_API_MAJOR_VERSION >= 2 && RUBBERBAND_API_MINOR_VERSION >= 7)
 
+// Stretched frames the worker keeps ready ahead of the playhead. This is
+// also the delay of tempo and pitch changes in look-ahead mode, because
+// they are applied in stream order.
+constexpr SINT kLookAheadFrames = 2048;
+
+// Unstretched input may be consumed up to 4 times faster than the output
+constexpr SINT kLookAheadInputFrames = 4 * kLookAheadFrames;
+
+// Each retrieval from the stretcher is one block, they are a few hundred
+// frames each.
+constexpr int kLookAheadMaxBlocks = 256;
+
 }  // namespace
 
+EngineBufferScaleRubberBandWorker::EngineBufferScaleRubberBandWorker(
+        EngineBufferScaleRubberBand* pScaler)
+        : m_pScaler(pScaler),
+          m_stop(false) {
+}
+
+void EngineBufferScaleRubberBandWorker::run() {
+    // the id of this thread, for debugging purposes
+    static auto lastId = QAtomicInt(0);
+    const auto id = lastId.fetchAndAddRelaxed(1) + 1;
+    QThread::currentThread()->setObjectName(
+            QStringLiteral("EngineBufferScaleRubberBandWorker ") + QString::number(id));
+
+    while (!m_stop.load()) {
+        m_semaRun.acquire();
+        if (m_stop.load()) {
+            break;
+        }
+        m_pScaler->processLookAhead();
+    }
+}
+
+void EngineBufferScaleRubberBandWorker::startRunning() {
+    m_stop.store(false);
+    start(QThread::HighPriority);
+}
+
+void EngineBufferScaleRubberBandWorker::quitWait() {
+    m_stop.store(true);
+    m_semaRun.release();
+    wait();
+}
+
 EngineBufferScaleRubberBand::EngineBufferScaleRubberBand(
         ReadAheadManager* pReadAheadManager)
         : m_pReadAheadManager(pReadAheadManager),
+          m_stretcherTimeRatioInverse(1.0),
           m_buffer_back(SampleUtil::alloc(MAX_BUFFER_LEN)),
           m_bBackwards(false),
-          m_useEngineFiner(false) {
+          m_useEngineFiner(false),
+          m_pWorkerScheduler(nullptr),
+          m_lookAheadEnabled(false),
+          m_workerSession(0),
+          m_lastWorkerSession(0),
+          m_stretcherOwner(0),
+          m_syncRequested(false),
+          m_lookAheadInput(2 * kLookAheadInputFrames),
+          m_lookAheadOutput(2 * kLookAheadFrames),
+          m_lookAheadBlocks(kLookAheadMaxBlocks),
+          m_currentLookAheadBlock{0, 1.0},
+          m_lookAheadResetRequested(0),
+          m_lookAheadResetCompleted(0),
+          m_lookAheadResetFlushed(0),
+          m_pendingPitchScale(1.0),
+          m_pendingTimeRatioInverse(1.0),
+          m_parametersPending(false) {
     m_retrieve_buffer[0] = SampleUtil::alloc(MAX_BUFFER_LEN);
     m_retrieve_buffer[1] = SampleUtil::alloc(MAX_BUFFER_LEN);
     // Initialize the internal buffers to prevent re-allocations
@@ -39,6 +105,11 @@ EngineBufferScaleRubberBand::EngineBufferScaleRubberBand(
 }
 
 EngineBufferScaleRubberBand::~EngineBufferScaleRubberBand() {
+    // EngineMaster deletes the scheduler before the channels, so like the
+    // CachingReader worker ours is only stopped and not removed from it.
+    if (m_workerSession.load()) {
+        m_pWorker->quitWait();
+    }
     SampleUtil::free(m_buffer_back);
     SampleUtil::free(m_retrieve_buffer[0]);
     SampleUtil::free(m_retrieve_buffer[1]);
@@ -71,19 +142,43 @@ void EngineBufferScaleRubberBand::setScaleParameters(double base_rate,
     // no-op.
     double pitchScale = fabs(base_rate * *pPitchRatio);
 
-    if (pitchScale > 0) {
-        //qDebug() << "EngineBufferScaleRubberBand setPitchScale" << *pitch << pitchScale;
-        m_pRubberBand->setPitchScale(pitchScale);
-    }
-
     // RubberBand handles checking for whether the change in timeRatio is a
     // no-op. Time ratio is the ratio of stretched to unstretched duration. So 1
     // second in real duration is 0.5 seconds in stretched duration if tempo is
     // 2.
     double timeRatioInverse = base_rate * speed_abs;
+
+    if (m_stretcherOwner.load(std::memory_order_relaxed)) {
+        // The worker may be running the stretcher right now. The new
+        // parameters are applied in stream order by whoever processes the
+        // next block.
+        m_pendingPitchScale.store(pitchScale, std::memory_order_relaxed);
+        m_pendingTimeRatioInverse.store(timeRatioInverse, std::memory_order_relaxed);
+        m_parametersPending.store(true, std::memory_order_release);
+    } else {
+        const double appliedTimeRatioInverse = applyParameters(pitchScale, timeRatioInverse);
+        if (appliedTimeRatioInverse != timeRatioInverse) {
+            speed_abs = appliedTimeRatioInverse / base_rate;
+            *pTempoRatio = m_bBackwards ? -speed_abs : speed_abs;
+        }
+    }
+    // Used by other methods so we need to keep them up to date.
+    m_dBaseRate = base_rate;
+    m_dTempoRatio = speed_abs;
+    m_dPitchRatio = *pPitchRatio;
+}
+
+double EngineBufferScaleRubberBand::applyParameters(
+        double pitchScale, double timeRatioInverse) {
+    if (pitchScale > 0) {
+        //qDebug() << "EngineBufferScaleRubberBand setPitchScale" << *pitch << pitchScale;
+        m_pRubberBand->setPitchScale(pitchScale);
+    }
+
     if (timeRatioInverse > 0) {
         //qDebug() << "EngineBufferScaleRubberBand setTimeRatio" << 1 / timeRatioInverse;
         m_pRubberBand->setTimeRatio(1.0 / timeRatioInverse);
+        m_stretcherTimeRatioInverse = timeRatioInverse;
     }
 
     if (runningEngineVersion() == 2) {
@@ -98,17 +193,33 @@ void EngineBufferScaleRubberBand::setScaleParameters(double base_rate,
                 timeRatioInverse += 0.001;
                 m_pRubberBand->setTimeRatio(1.0 / timeRatioInverse);
             }
-            speed_abs = timeRatioInverse / base_rate;
-            *pTempoRatio = m_bBackwards ? -speed_abs : speed_abs;
+            m_stretcherTimeRatioInverse = timeRatioInverse;
         }
     }
-    // Used by other methods so we need to keep them up to date.
-    m_dBaseRate = base_rate;
-    m_dTempoRatio = speed_abs;
-    m_dPitchRatio = *pPitchRatio;
+    return timeRatioInverse;
+}
+
+void EngineBufferScaleRubberBand::applyPendingParameters() {
+    // Must be called by the owner of the stretcher
+    if (m_parametersPending.exchange(false, std::memory_order_acquire)) {
+        // In look-ahead mode the adjusted time ratio of the RubberBand <=1.8.1
+        // workaround cannot be reported back to EngineBuffer.
+        applyParameters(m_pendingPitchScale.load(std::memory_order_relaxed),
+                m_pendingTimeRatioInverse.load(std::memory_order_relaxed));
+    }
 }
 
 void EngineBufferScaleRubberBand::onSampleRateChanged() {
+    // Wait until the worker has finished its current block
+    std::optional<QT_MUTEX_LOCKER> locker;
+    if (m_workerSession.load(std::memory_order_acquire)) {
+        m_syncRequested.store(true);
+        locker.emplace(&m_stretcherMutex);
+        m_syncRequested.store(false);
+        // Queued input and output belong to the old stretcher
+        m_lookAheadResetRequested.fetch_add(1, std::memory_order_release);
+    }
+
     // TODO: Resetting the sample rate will cause internal
     // memory allocations that may block the real-time thread.
     // When is this function actually invoked??
@@ -136,9 +247,19 @@ void EngineBufferScaleRubberBand::onSampleRateChanged() {
     // avoid memory reallocations during playback.
     m_pRubberBand->setTimeRatio(2.0);
     m_pRubberBand->setTimeRatio(1.0);
+    m_stretcherTimeRatioInverse = 1.0;
 }
 
 void EngineBufferScaleRubberBand::clear() {
+    if (m_stretcherOwner.load(std::memory_order_relaxed)) {
+        // The worker may be running the stretcher right now, it resets the
+        // stretcher together with the queued input.
+        m_lookAheadResetRequested.fetch_add(1, std::memory_order_release);
+        return;
+    }
+    // Audio left over from a stopped worker
+    m_lookAheadInput.flushReadData(m_lookAheadInput.readAvailable());
+    flushLookAheadOutput();
     VERIFY_OR_DEBUG_ASSERT(m_pRubberBand) {
         return;
     }
@@ -182,9 +303,99 @@ double EngineBufferScaleRubberBand::scaleBuffer(
     }
 
     SINT total_received_frames = 0;
+    // Unstretched frames consumed to produce the scaled buffer
+    double framesRead = 0.0;
 
     SINT remaining_frames = getOutputSignal().samples2frames(iOutputBufferSize);
     CSAMPLE* read = pOutputBuffer;
+
+    const int workerSession = m_workerSession.load(std::memory_order_acquire);
+    if (workerSession) {
+        // Hand the stretcher over to the running worker. We are done with
+        // it at this point, and a previous session has been stopped.
+        m_stretcherOwner.store(workerSession, std::memory_order_release);
+    } else if (m_stretcherOwner.load(std::memory_order_relaxed)) {
+        // The worker has been stopped
+        takeOverStretcher();
+    }
+
+    if (workerSession) {
+        total_received_frames = readLookAheadOutput(
+                read, remaining_frames, &framesRead);
+        remaining_frames -= total_received_frames;
+        read += getOutputSignal().frames2samples(total_received_frames);
+        // The look-ahead underruns after every seek until the worker has
+        // caught up. Never wait for the worker, but render the missing
+        // frames here if it is not using the stretcher right now.
+        if (remaining_frames > 0 && m_stretcherMutex.tryLock()) {
+            if (m_pRubberBand) {
+                const unsigned int resetRequested =
+                        m_lookAheadResetRequested.load(std::memory_order_acquire);
+                if (resetRequested !=
+                        m_lookAheadResetCompleted.load(std::memory_order_relaxed)) {
+                    completeLookAheadReset(resetRequested);
+                }
+                // The worker might have queued more frames before we got
+                // the lock, they come first.
+                SINT received_frames = readLookAheadOutput(
+                        read, remaining_frames, &framesRead);
+                total_received_frames += received_frames;
+                remaining_frames -= received_frames;
+                read += getOutputSignal().frames2samples(received_frames);
+
+                received_frames = processSynchronously(read, remaining_frames);
+                framesRead += m_dBaseRate * m_dTempoRatio * received_frames;
+                total_received_frames += received_frames;
+                remaining_frames -= received_frames;
+                read += getOutputSignal().frames2samples(received_frames);
+            }
+            m_stretcherMutex.unlock();
+        }
+        // Queued input would be dropped while a reset is pending
+        if (m_lookAheadResetCompleted.load(std::memory_order_relaxed) ==
+                m_lookAheadResetRequested.load(std::memory_order_relaxed)) {
+            fillLookAheadInput();
+        }
+        // m_pWorker is not reset while the scaler exists
+        m_pWorker->workReady();
+    } else {
+        // Stretched frames left over from a stopped worker come first
+        total_received_frames = readLookAheadOutput(
+                read, remaining_frames, &framesRead);
+        remaining_frames -= total_received_frames;
+        read += getOutputSignal().frames2samples(total_received_frames);
+
+        // framesRead is interpreted as the total number of virtual sample frames
+        // consumed to produce the scaled buffer. Due to this, we do not take into
+        // account directionality or starting point.
+        // NOTE(rryan): Why no m_dPitchAdjust here? Pitch does not change the time
+        // ratio. m_dSpeedAdjust is the ratio of unstretched time to stretched
+        // time. So, if we used total_received_frames in stretched time, then
+        // multiplying that by the ratio of unstretched time to stretched time
+        // will get us the unstretched sample frames read.
+        const SINT received_frames = processSynchronously(read, remaining_frames);
+        framesRead += m_dBaseRate * m_dTempoRatio * received_frames;
+        total_received_frames += received_frames;
+        remaining_frames -= received_frames;
+        read += getOutputSignal().frames2samples(received_frames);
+    }
+
+    if (remaining_frames > 0) {
+        SampleUtil::clear(read, getOutputSignal().frames2samples(remaining_frames));
+        Counter counter("EngineBufferScaleRubberBand::getScaled underflow");
+        counter.increment();
+    }
+
+    return framesRead;
+}
+
+SINT EngineBufferScaleRubberBand::processSynchronously(
+        CSAMPLE* pOutputBuffer, SINT frames) {
+    applyPendingParameters();
+
+    SINT total_received_frames = 0;
+    SINT remaining_frames = frames;
+    CSAMPLE* read = pOutputBuffer;
     bool last_read_failed = false;
     bool break_out_after_retrieve_and_reset_rubberband = false;
     while (remaining_frames > 0) {
@@ -224,12 +435,7 @@ double EngineBufferScaleRubberBand::scaleBuffer(
         //qDebug() << "iLenFramesRequired" << iLenFramesRequired;
 
         if (remaining_frames > 0 && iLenFramesRequired > 0) {
-            SINT iAvailSamples = m_pReadAheadManager->getNextSamples(
-                        // The value doesn't matter here. All that matters is we
-                        // are going forward or backward.
-                        (m_bBackwards ? -1.0 : 1.0) * m_dBaseRate * m_dTempoRatio,
-                        m_buffer_back,
-                        getOutputSignal().frames2samples(iLenFramesRequired));
+            SINT iAvailSamples = readInput(m_buffer_back, iLenFramesRequired);
             SINT iAvailFrames = getOutputSignal().samples2frames(iAvailSamples);
 
             if (iAvailFrames > 0) {
@@ -247,24 +453,236 @@ double EngineBufferScaleRubberBand::scaleBuffer(
             }
         }
     }
+    return total_received_frames;
+}
 
-    if (remaining_frames > 0) {
-        SampleUtil::clear(read, getOutputSignal().frames2samples(remaining_frames));
-        Counter counter("EngineBufferScaleRubberBand::getScaled underflow");
-        counter.increment();
+SINT EngineBufferScaleRubberBand::readInput(CSAMPLE* pBuffer, SINT frames) {
+    const SINT samples = getOutputSignal().frames2samples(frames);
+    // Input that has been queued for the worker comes first
+    SINT received_samples = m_lookAheadInput.read(pBuffer, static_cast<int>(samples));
+    if (received_samples < samples) {
+        received_samples += m_pReadAheadManager->getNextSamples(
+                // The value doesn't matter here. All that matters is we
+                // are going forward or backward.
+                (m_bBackwards ? -1.0 : 1.0) * m_dBaseRate * m_dTempoRatio,
+                pBuffer + received_samples,
+                samples - received_samples);
     }
+    return received_samples;
+}
 
-    // framesRead is interpreted as the total number of virtual sample frames
-    // consumed to produce the scaled buffer. Due to this, we do not take into
-    // account directionality or starting point.
-    // NOTE(rryan): Why no m_dPitchAdjust here? Pitch does not change the time
-    // ratio. m_dSpeedAdjust is the ratio of unstretched time to stretched
-    // time. So, if we used total_received_frames in stretched time, then
-    // multiplying that by the ratio of unstretched time to stretched time
-    // will get us the unstretched sample frames read.
-    double framesRead = m_dBaseRate * m_dTempoRatio * total_received_frames;
+void EngineBufferScaleRubberBand::fillLookAheadInput() {
+    const double rate = m_dBaseRate * m_dTempoRatio;
+    const SINT queuedOutputFrames =
+            getOutputSignal().samples2frames(m_lookAheadOutput.readAvailable());
+    const SINT queuedInputFrames =
+            getOutputSignal().samples2frames(m_lookAheadInput.readAvailable());
+    SINT framesToRead = static_cast<SINT>(
+                                (kLookAheadFrames - queuedOutputFrames) * rate) -
+            queuedInputFrames;
+    framesToRead = math_min(framesToRead,
+            getOutputSignal().samples2frames(m_lookAheadInput.writeAvailable()));
+    if (framesToRead <= 0) {
+        return;
+    }
 
-    return framesRead;
+    // Read directly into the FIFO
+    CSAMPLE* pRegion[2];
+    ring_buffer_size_t regionSize[2];
+    m_lookAheadInput.aquireWriteRegions(
+            static_cast<int>(getOutputSignal().frames2samples(framesToRead)),
+            &pRegion[0],
+            &regionSize[0],
+            &pRegion[1],
+            &regionSize[1]);
+    SINT written = 0;
+    for (int region = 0; region < 2; ++region) {
+        SINT regionWritten = 0;
+        while (regionWritten < regionSize[region]) {
+            SINT samples = m_pReadAheadManager->getNextSamples(
+                    (m_bBackwards ? -1.0 : 1.0) * rate,
+                    pRegion[region] + regionWritten,
+                    regionSize[region] - regionWritten);
+            if (samples == 0) {
+                // End of track, the synchronous path flushes the stretcher.
+                break;
+            }
+            regionWritten += samples;
+        }
+        written += regionWritten;
+        if (regionWritten < regionSize[region]) {
+            break;
+        }
+    }
+    m_lookAheadInput.releaseWriteRegions(static_cast<int>(written));
+}
+
+SINT EngineBufferScaleRubberBand::readLookAheadOutput(
+        CSAMPLE* pBuffer, SINT frames, double* pFramesRead) {
+    const unsigned int resetCompleted =
+            m_lookAheadResetCompleted.load(std::memory_order_acquire);
+    if (resetCompleted != m_lookAheadResetFlushed) {
+        flushLookAheadOutput();
+        m_lookAheadResetFlushed = resetCompleted;
+    }
+    if (resetCompleted != m_lookAheadResetRequested.load(std::memory_order_relaxed)) {
+        // The queued output is stale
+        return 0;
+    }
+
+    const SINT received_frames = getOutputSignal().samples2frames(
+            m_lookAheadOutput.read(pBuffer,
+                    static_cast<int>(getOutputSignal().frames2samples(frames))));
+    // Tempo changes are applied in stream order, so the frames may have
+    // been rendered with different time ratios.
+    SINT remaining_frames = received_frames;
+    while (remaining_frames > 0) {
+        if (m_currentLookAheadBlock.frames == 0) {
+            // The block has been written before its frames
+            VERIFY_OR_DEBUG_ASSERT(m_lookAheadBlocks.read(&m_currentLookAheadBlock, 1) == 1) {
+                *pFramesRead += m_dBaseRate * m_dTempoRatio * remaining_frames;
+                break;
+            }
+        }
+        const SINT blockFrames = math_min(remaining_frames, m_currentLookAheadBlock.frames);
+        *pFramesRead += m_currentLookAheadBlock.timeRatioInverse * blockFrames;
+        m_currentLookAheadBlock.frames -= blockFrames;
+        remaining_frames -= blockFrames;
+    }
+    return received_frames;
+}
+
+void EngineBufferScaleRubberBand::flushLookAheadOutput() {
+    // We are the consumer of both FIFOs
+    m_lookAheadOutput.flushReadData(m_lookAheadOutput.readAvailable());
+    m_lookAheadBlocks.flushReadData(m_lookAheadBlocks.readAvailable());
+    m_currentLookAheadBlock.frames = 0;
+}
+
+void EngineBufferScaleRubberBand::takeOverStretcher() {
+    // The worker has been stopped before m_workerSession was cleared, so we
+    // are the consumer of m_lookAheadInput now. The queued audio is kept
+    // and played back first, unless a reset is still pending.
+    const unsigned int resetRequested =
+            m_lookAheadResetRequested.load(std::memory_order_acquire);
+    if (resetRequested != m_lookAheadResetFlushed) {
+        m_lookAheadInput.flushReadData(m_lookAheadInput.readAvailable());
+        flushLookAheadOutput();
+        if (m_pRubberBand) {
+            m_pRubberBand->reset();
+        }
+        m_lookAheadResetCompleted.store(resetRequested, std::memory_order_relaxed);
+        m_lookAheadResetFlushed = resetRequested;
+    }
+    m_stretcherOwner.store(0, std::memory_order_relaxed);
+}
+
+void EngineBufferScaleRubberBand::completeLookAheadReset(unsigned int resetRequested) {
+    // The audio thread does not queue input until the reset is completed,
+    // and drops the output itself.
+    m_lookAheadInput.flushReadData(m_lookAheadInput.readAvailable());
+    m_pRubberBand->reset();
+    m_lookAheadResetCompleted.store(resetRequested, std::memory_order_release);
+}
+
+void EngineBufferScaleRubberBand::processLookAhead() {
+    // Our session does not change while we are running
+    const int workerSession = m_workerSession.load(std::memory_order_relaxed);
+    if (m_stretcherOwner.load(std::memory_order_acquire) != workerSession) {
+        // The audio thread has not handed over the stretcher yet
+        return;
+    }
+    while (!m_syncRequested.load()) {
+        const auto locker = lockMutex(&m_stretcherMutex);
+        if (!m_pRubberBand) {
+            return;
+        }
+
+        const unsigned int resetRequested =
+                m_lookAheadResetRequested.load(std::memory_order_acquire);
+        if (resetRequested != m_lookAheadResetCompleted.load(std::memory_order_relaxed)) {
+            completeLookAheadReset(resetRequested);
+            continue;
+        }
+
+        const SINT freeFrames =
+                getOutputSignal().samples2frames(m_lookAheadOutput.writeAvailable());
+        if (freeFrames == 0 || m_lookAheadBlocks.writeAvailable() == 0) {
+            // The look-ahead is complete
+            return;
+        }
+        const SINT availableFrames = m_pRubberBand->available();
+        if (availableFrames > 0) {
+            // Retrieve before applying new parameters, these frames have
+            // been rendered with the current ones.
+            const SINT frames = retrieveAndDeinterleave(
+                    m_buffer_back, math_min(freeFrames, availableFrames));
+            const LookAheadBlock block{frames, m_stretcherTimeRatioInverse};
+            m_lookAheadBlocks.write(&block, 1);
+            m_lookAheadOutput.write(m_buffer_back,
+                    static_cast<int>(getOutputSignal().frames2samples(frames)));
+            continue;
+        }
+
+        applyPendingParameters();
+        SINT requiredFrames = static_cast<SINT>(m_pRubberBand->getSamplesRequired());
+        if (requiredFrames == 0) {
+            // See processSynchronously()
+            requiredFrames = kRubberBandBlockSize;
+        }
+        const SINT inputFrames = math_min(requiredFrames,
+                getOutputSignal().samples2frames(m_lookAheadInput.readAvailable()));
+        if (inputFrames == 0) {
+            // Wait for more input from the audio thread
+            return;
+        }
+        m_lookAheadInput.read(m_buffer_back,
+                static_cast<int>(getOutputSignal().frames2samples(inputFrames)));
+        deinterleaveAndProcess(m_buffer_back, inputFrames, false);
+    }
+}
+
+void EngineBufferScaleRubberBand::setLookAheadEnabled(bool enable) {
+    m_lookAheadEnabled.store(enable);
+    if (enable) {
+        startWorker();
+    } else {
+        stopWorker();
+    }
+}
+
+void EngineBufferScaleRubberBand::setScheduler(EngineWorkerScheduler* pWorkerScheduler) {
+    DEBUG_ASSERT(!m_pWorkerScheduler);
+    m_pWorkerScheduler = pWorkerScheduler;
+    if (m_lookAheadEnabled.load()) {
+        startWorker();
+    }
+}
+
+void EngineBufferScaleRubberBand::startWorker() {
+    if (!m_pWorkerScheduler || m_workerSession.load()) {
+        return;
+    }
+    if (m_pWorker) {
+        m_pWorkerScheduler->addWorker(m_pWorker.get());
+    } else {
+        m_pWorker = std::make_unique<EngineBufferScaleRubberBandWorker>(this);
+        m_pWorker->setScheduler(m_pWorkerScheduler);
+    }
+    // The worker waits until the audio thread has handed over the stretcher
+    // to this session.
+    m_workerSession.store(++m_lastWorkerSession, std::memory_order_release);
+    m_pWorker->startRunning();
+}
+
+void EngineBufferScaleRubberBand::stopWorker() {
+    if (!m_workerSession.load()) {
+        return;
+    }
+    m_pWorkerScheduler->removeWorker(m_pWorker.get());
+    m_pWorker->quitWait();
+    // The audio thread takes the stretcher back when it sees this
+    m_workerSession.store(0, std::memory_order_release);
 }
 
 // static
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <QMutex>
+#include <atomic>
+
 #include "engine/bufferscalers/enginebufferscale.h"
+#include "engine/engineworker.h"
+#include "util/fifo.h"
 #include "util/memory.h"
 
 namespace RubberBand {
@@ -8,8 +13,34 @@ class RubberBandStretcher;
 }  // namespace RubberBand
 
 class ReadAheadManager;
+class EngineBufferScaleRubberBand;
+class EngineWorkerScheduler;
+
+// Runs the time stretching of one EngineBufferScaleRubberBand ahead of the
+// playhead, after the audio callback has finished.
+class EngineBufferScaleRubberBandWorker : public EngineWorker {
+  public:
+    explicit EngineBufferScaleRubberBandWorker(
+            EngineBufferScaleRubberBand* pScaler);
+
+    void run() override;
+    // Starts the thread, also after a previous quitWait()
+    void startRunning();
+    void quitWait();
+
+  private:
+    EngineBufferScaleRubberBand* const m_pScaler;
+    std::atomic<bool> m_stop;
+};
 
 // Uses librubberband to scale audio.  This class is not thread safe.
+//
+// In the opt-in look-ahead mode the stretcher is owned by an
+// EngineBufferScaleRubberBandWorker that feeds and drains it through a pair
+// of lock-free FIFOs, and scaleBuffer() only copies out the stretched audio.
+// The audio thread never waits for the worker. If the look-ahead underruns,
+// e.g. right after a seek, it stretches the missing frames itself unless the
+// worker is using the stretcher at that moment.
 class EngineBufferScaleRubberBand : public EngineBufferScale {
     Q_OBJECT
   public:
@@ -23,6 +54,12 @@ class EngineBufferScaleRubberBand : public EngineBufferScale {
     // Enable engine v3 if available
     void useEngineFiner(bool enable);
 
+    // Stretch ahead of the playhead on a worker thread. The worker is
+    // started once a scheduler has been set, and stopped and unregistered
+    // from the scheduler again when the look-ahead is disabled.
+    void setLookAheadEnabled(bool enable);
+    void setScheduler(EngineWorkerScheduler* pWorkerScheduler);
+
     void setScaleParameters(double base_rate,
                             double* pTempoRatio,
                             double* pPitchRatio) override;
@@ -35,18 +72,60 @@ class EngineBufferScaleRubberBand : public EngineBufferScale {
     void clear() override;
 
   private:
+    friend class EngineBufferScaleRubberBandWorker;
+    friend class EngineBufferScaleRubberBandTest;
+
+    // A run of stretched frames in m_lookAheadOutput and the time ratio
+    // inverse they have been rendered with.
+    struct LookAheadBlock {
+        SINT frames;
+        double timeRatioInverse;
+    };
+
     // Reset RubberBand library with new audio signal
     void onSampleRateChanged() override;
 
     int runningEngineVersion();
 
+    // Returns the applied time ratio inverse, which differs from the
+    // requested one if the RubberBand <=1.8.1 workaround kicked in.
+    double applyParameters(double pitchScale, double timeRatioInverse);
+    void applyPendingParameters();
+
     void deinterleaveAndProcess(const CSAMPLE* pBuffer, SINT frames, bool flush);
     SINT retrieveAndDeinterleave(CSAMPLE* pBuffer, SINT frames);
 
+    // Runs the stretcher in the calling thread until pOutputBuffer is
+    // filled or the input is exhausted. Returns the received frames.
+    SINT processSynchronously(CSAMPLE* pOutputBuffer, SINT frames);
+    // Reads input from the look-ahead FIFO first, then from the
+    // ReadAheadManager.
+    SINT readInput(CSAMPLE* pBuffer, SINT frames);
+
+    // Worker thread: stretch into m_lookAheadOutput until it is full or
+    // m_lookAheadInput runs dry.
+    void processLookAhead();
+    // Audio thread: copy out stretched frames and add the unstretched frames
+    // they correspond to to *pFramesRead. Returns the copied frames, none
+    // while a reset is pending.
+    SINT readLookAheadOutput(CSAMPLE* pBuffer, SINT frames, double* pFramesRead);
+    // Audio thread: keep enough unstretched input queued for the worker.
+    void fillLookAheadInput();
+    // Audio thread: drop all stretched audio queued before the last reset.
+    void flushLookAheadOutput();
+    // Owner of the stretcher: drop the queued input and reset the stretcher.
+    void completeLookAheadReset(unsigned int resetRequested);
+    // Audio thread: take the stretcher back from a stopped worker.
+    void takeOverStretcher();
+    void startWorker();
+    void stopWorker();
+
     // The read-ahead manager that we use to fetch samples
     ReadAheadManager* m_pReadAheadManager;
 
     std::unique_ptr<RubberBand::RubberBandStretcher> m_pRubberBand;
+    // The time ratio inverse that m_pRubberBand currently renders with
+    double m_stretcherTimeRatioInverse;
 
     CSAMPLE* m_retrieve_buffer[2];
     CSAMPLE* m_buffer_back;
@@ -55,4 +134,54 @@ class EngineBufferScaleRubberBand : public EngineBufferScale {
     bool m_bBackwards;
 
     bool m_useEngineFiner;
+
+    // Look-ahead mode, all members below are only used once the worker
+    // exists.
+    EngineWorkerScheduler* m_pWorkerScheduler;
+    // Created on first use and kept until this scaler is destroyed, because
+    // the audio thread may still use it for one callback after it has been
+    // stopped.
+    std::unique_ptr<EngineBufferScaleRubberBandWorker> m_pWorker;
+    std::atomic<bool> m_lookAheadEnabled;
+    // Non-zero while the worker thread is running, a new value for every
+    // start. Set before the thread is started, cleared after it has been
+    // stopped.
+    std::atomic<int> m_workerSession;
+    int m_lastWorkerSession;
+    // Only written by the audio thread, which hands the stretcher over to
+    // the worker session it has seen. While non-zero, the worker owns
+    // m_pRubberBand, m_retrieve_buffer and m_buffer_back and the audio
+    // thread only touches the FIFOs, unless it holds m_stretcherMutex.
+    std::atomic<int> m_stretcherOwner;
+
+    // Held by the worker while it uses the stretcher. scaleBuffer() only
+    // tries to lock it to render the frames of an underrun itself.
+    QMutex m_stretcherMutex;
+    // Set while waiting for m_stretcherMutex, makes the worker yield after
+    // its current block.
+    std::atomic<bool> m_syncRequested;
+
+    // Interleaved, unstretched input (written by the audio thread) and
+    // stretched output (written by the worker). Each run of frames in
+    // m_lookAheadOutput is described by an entry in m_lookAheadBlocks that is
+    // written before the frames.
+    FIFO<CSAMPLE> m_lookAheadInput;
+    FIFO<CSAMPLE> m_lookAheadOutput;
+    FIFO<LookAheadBlock> m_lookAheadBlocks;
+    // Audio thread: the unread remainder of the current block
+    LookAheadBlock m_currentLookAheadBlock;
+
+    // A reset is requested by incrementing m_lookAheadResetRequested. The
+    // worker drops the queued input, resets the stretcher and then publishes
+    // the handled request in m_lookAheadResetCompleted. Until then the audio
+    // thread neither reads output nor queues input.
+    std::atomic<unsigned int> m_lookAheadResetRequested;
+    std::atomic<unsigned int> m_lookAheadResetCompleted;
+    // Audio thread: the last completed reset whose output has been dropped
+    unsigned int m_lookAheadResetFlushed;
+
+    // Parameters are applied by whichever thread owns the stretcher next.
+    std::atomic<double> m_pendingPitchScale;
+    std::atomic<double> m_pendingTimeRatioInverse;
+    std::atomic<bool> m_parametersPending;
 };
@@ -39,6 +39,29 @@ constexpr SINT kDefaultHintFrames = 1024;
 // massive drop outs are expected to occur Mixxx should run reliably!
 constexpr SINT kNumberOfCachedChunksInMemory = 80;
 
+// Hints with Hint::kFrameCountPrefetch keep this many frames resident by
+// default, i.e. one chunk or 186 ms @ 44.1 kHz. This is enough to bridge the
+// time until the regular read ahead of the current position is available
+// after jumping to a hotcue.
+const ConfigKey kPrefetchFramesConfigKey("[CachingReader]", "PrefetchFrames");
+constexpr int kDefaultPrefetchFrames = CachingReaderChunk::kFrames;
+
+// The prefetch hints of a single deck may occupy at most this many chunks.
+// Exceeding hints are dropped in the order they are provided. At least
+// kMinNonPrefetchChunks are always left for the current position, loops,
+// and other high priority hints. Otherwise the LRU eviction would start to
+// thrash between hints and there would be no chunks left for playback.
+const ConfigKey kPrefetchBudgetChunksConfigKey("[CachingReader]", "PrefetchBudgetChunks");
+constexpr int kDefaultPrefetchBudgetChunks = kNumberOfCachedChunksInMemory / 2;
+constexpr int kMinNonPrefetchChunks = 16;
+
+int getConfigValue(const UserSettingsPointer& pConfig, const ConfigKey& key, int defaultValue) {
+    if (!pConfig) {
+        return defaultValue;
+    }
+    return pConfig->getValue(key, defaultValue);
+}
+
 } // anonymous namespace
 
 CachingReader::CachingReader(const QString& group,
@@ -62,7 +85,17 @@ CachingReader::CachingReader(const QString& group,
           m_mruCachingReaderChunk(nullptr),
           m_lruCachingReaderChunk(nullptr),
           m_sampleBuffer(CachingReaderChunk::kSamples * kNumberOfCachedChunksInMemory),
-          m_worker(group, &m_chunkReadRequestFIFO, &m_readerStatusUpdateFIFO) {
+          m_worker(group, &m_chunkReadRequestFIFO, &m_readerStatusUpdateFIFO),
+          m_prefetchFrames(math_max(kDefaultHintFrames,
+                  static_cast<SINT>(getConfigValue(m_pConfig,
+                          kPrefetchFramesConfigKey,
+                          kDefaultPrefetchFrames)))),
+          m_prefetchBudgetChunks(math_clamp(
+                  getConfigValue(m_pConfig,
+                          kPrefetchBudgetChunksConfigKey,
+                          kDefaultPrefetchBudgetChunks),
+                  0,
+                  static_cast<int>(kNumberOfCachedChunksInMemory) - kMinNonPrefetchChunks)) {
     m_allocatedCachingReaderChunks.reserve(kNumberOfCachedChunksInMemory);
     // Divide up the allocated raw memory buffer into total_chunks
     // chunks. Initialize each chunk to hold nothing and add it to the free
@@ -94,6 +127,7 @@ CachingReader::CachingReader(const QString& group,
 
 CachingReader::~CachingReader() {
     m_worker.quitWait();
+    logAndResetHintStatistics();
     qDeleteAll(m_chunks);
 }
 
@@ -219,9 +253,33 @@ void CachingReader::newTrack(TrackPointer pTrack) {
         kLogger.warning()
                 << "Loading a new track while loading a track may lead to inconsistent states";
     }
+    logAndResetHintStatistics();
     m_worker.newTrack(std::move(pTrack));
 }
 
+void CachingReader::logAndResetHintStatistics() {
+    for (int i = 0; i < Hint::kTypeCount; ++i) {
+        const int hits = m_hintStatistics[i].hits.fetchAndStoreRelaxed(0);
+        const int misses = m_hintStatistics[i].misses.fetchAndStoreRelaxed(0);
+        const int dropped = m_hintStatistics[i].dropped.fetchAndStoreRelaxed(0);
+        if (hits + misses + dropped > 0) {
+            kLogger.debug()
+                    << "Hint type" << i
+                    << "seek hits:" << hits
+                    << "seek misses:" << misses
+                    << "dropped prefetches:" << dropped;
+        }
+    }
+}
+
+CachingReader::HintStatistics CachingReader::getHintStatistics(Hint::Type type) const {
+    const auto& statistics = m_hintStatistics[static_cast<int>(type)];
+    return HintStatistics{
+            atomicLoadRelaxed(statistics.hits),
+            atomicLoadRelaxed(statistics.misses),
+            atomicLoadRelaxed(statistics.dropped)};
+}
+
 // Called from the engine thread
 void CachingReader::process() {
     ReaderStatusUpdate update;
@@ -507,6 +565,8 @@ CachingReader::ReadResult CachingReader::read(SINT startSample, SINT numSamples,
 }
 
 void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
+    m_lastHintRanges.clear();
+
     // If no file is loaded, skip.
     if (atomicLoadRelaxed(m_state) != STATE_TRACK_LOADED) {
         return;
@@ -515,24 +575,28 @@ void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
     // For every chunk that the hints indicated, check if it is in the cache. If
     // any are not, then wake.
     bool shouldWake = false;
+    int prefetchChunks = 0;
 
     for (const auto& hint: hintList) {
         SINT hintFrame = hint.frame;
         SINT hintFrameCount = hint.frameCount;
+        const bool isPrefetch = hintFrameCount == Hint::kFrameCountPrefetch;
 
         // Handle some special length values
         if (hintFrameCount == Hint::kFrameCountForward) {
-        	hintFrameCount = kDefaultHintFrames;
+            hintFrameCount = kDefaultHintFrames;
         } else if (hintFrameCount == Hint::kFrameCountBackward) {
-        	hintFrame -= kDefaultHintFrames;
-        	hintFrameCount = kDefaultHintFrames;
+            hintFrame -= kDefaultHintFrames;
+            hintFrameCount = kDefaultHintFrames;
             if (hintFrame < 0) {
-            	hintFrameCount += hintFrame;
+                hintFrameCount += hintFrame;
                 if (hintFrameCount <= 0) {
                     continue;
                 }
                 hintFrame = 0;
             }
+        } else if (isPrefetch) {
+            hintFrameCount = m_prefetchFrames;
         }
 
         VERIFY_OR_DEBUG_ASSERT(hintFrameCount >= 0) {
@@ -549,9 +613,29 @@ void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
 
         const int firstChunkIndex = CachingReaderChunk::indexForFrame(readableFrameIndexRange.start());
         const int lastChunkIndex = CachingReaderChunk::indexForFrame(readableFrameIndexRange.end() - 1);
+        if (isPrefetch) {
+            // Chunks shared by multiple hints are counted multiple times,
+            // which errs on the safe side.
+            const int chunkCount = lastChunkIndex - firstChunkIndex + 1;
+            if (prefetchChunks + chunkCount > m_prefetchBudgetChunks) {
+                m_hintStatistics[static_cast<int>(hint.type)].dropped.fetchAndAddRelaxed(1);
+                continue;
+            }
+            prefetchChunks += chunkCount;
+        }
+        if (m_lastHintRanges.size() < m_lastHintRanges.capacity()) {
+            m_lastHintRanges.append(HintRange{hint.type, readableFrameIndexRange});
+        }
+
         for (int chunkIndex = firstChunkIndex; chunkIndex <= lastChunkIndex; ++chunkIndex) {
             CachingReaderChunkForOwner* pChunk = lookupChunk(chunkIndex);
             if (!pChunk) {
+                if (isPrefetch && m_chunkReadRequestFIFO.writeAvailable() == 0) {
+                    // The worker is busy. Prefetching is not urgent, just
+                    // try again during the next callback.
+                    shouldWake = true;
+                    break;
+                }
                 shouldWake = true;
                 pChunk = allocateChunkExpireLRU(chunkIndex);
                 if (!pChunk) {
@@ -591,3 +675,21 @@ void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
         m_worker.workReady();
     }
 }
+
+void CachingReader::notifySeek(SINT frame) {
+    for (const auto& hintRange : qAsConst(m_lastHintRanges)) {
+        if (!hintRange.frames.containsIndex(frame)) {
+            continue;
+        }
+        auto& statistics = m_hintStatistics[static_cast<int>(hintRange.type)];
+        const CachingReaderChunkForOwner* pChunk =
+                lookupChunk(CachingReaderChunk::indexForFrame(frame));
+        if (pChunk && pChunk->getState() == CachingReaderChunkForOwner::READY) {
+            statistics.hits.fetchAndAddRelaxed(1);
+        } else {
+            statistics.misses.fetchAndAddRelaxed(1);
+        }
+        // Only account the first, i.e. the most important matching hint
+        return;
+    }
+}
@@ -29,8 +29,11 @@ typedef struct Hint {
         FirstSound,
         IntroStart,
         IntroEnd,
-        OutroStart
+        OutroStart,
+        BeatJumpForward,
+        BeatJumpBackward,
     };
+    static constexpr int kTypeCount = static_cast<int>(Type::BeatJumpBackward) + 1;
 
     // The frame to ensure is present in memory.
     SINT frame;
@@ -44,6 +47,10 @@ typedef struct Hint {
     // for the default frame count in forward direction
     static constexpr SINT kFrameCountForward = 0;
     static constexpr SINT kFrameCountBackward = -1;
+    // for the configurable prefetch window in forward direction, used for
+    // positions the user may jump to at any time, e.g. hotcues. These hints
+    // are only served as long as the prefetch memory budget permits.
+    static constexpr SINT kFrameCountPrefetch = -2;
 } Hint;
 
 // Note that we use a QVarLengthArray here instead of a QVector. Since this list
@@ -118,6 +125,22 @@ class CachingReader : public QObject {
         m_worker.setScheduler(pScheduler);
     }
 
+    // Accounts a seek to the given frame as a hit or miss of the hint from
+    // the last call of hintAndMaybeWake() that covers the frame. Must only be
+    // called from the engine callback.
+    void notifySeek(SINT frame);
+
+    struct HintStatistics {
+        // Seeks into a resident region of this hint type
+        int hits;
+        // Seeks into a region of this hint type that was not yet resident
+        int misses;
+        // Prefetch requests that were skipped due to the memory budget
+        int dropped;
+    };
+    // Thread-safe, the statistics are reset when a new track is loaded.
+    HintStatistics getHintStatistics(Hint::Type type) const;
+
   signals:
     // Emitted once a new track is loaded and ready to be read from.
     void trackLoading();
@@ -157,6 +180,8 @@ class CachingReader : public QObject {
     // Gets a chunk from the free list, frees the LRU CachingReaderChunk if none available.
     CachingReaderChunkForOwner* allocateChunkExpireLRU(SINT chunkIndex);
 
+    void logAndResetHintStatistics();
+
     enum State {
         STATE_IDLE,
         STATE_TRACK_LOADING,
@@ -187,4 +212,23 @@ class CachingReader : public QObject {
     mixxx::IndexRange m_readableFrameIndexRange;
 
     CachingReaderWorker m_worker;
+
+    // Size of the window that is kept resident for Hint::kFrameCountPrefetch
+    // and the maximum number of chunks that all those hints may occupy.
+    const SINT m_prefetchFrames;
+    const int m_prefetchBudgetChunks;
+
+    // The resolved regions of the last hint list, for attributing seeks
+    struct HintRange {
+        Hint::Type type;
+        mixxx::IndexRange frames;
+    };
+    QVarLengthArray<HintRange, 512> m_lastHintRanges;
+
+    struct AtomicHintStatistics {
+        QAtomicInt hits;
+        QAtomicInt misses;
+        QAtomicInt dropped;
+    };
+    AtomicHintStatistics m_hintStatistics[Hint::kTypeCount];
 };
@@ -42,7 +42,8 @@ void ChannelMixer::applyEffectsAndMixChannels(const EngineMaster::GainCalculator
                 iSampleRate,
                 pChannelInfo->m_features,
                 oldGain,
-                newGain);
+                newGain,
+                pChannelInfo->m_pChannel->isSilent());
     }
 }
 
@@ -76,14 +77,18 @@ void ChannelMixer::applyEffectsInPlaceAndMixChannels(
             newGain = gainCalculator.getGain(pChannelInfo);
         }
         gainCache.m_gain = newGain;
-        pEngineEffectsManager->processPostFaderInPlace(pChannelInfo->m_handle,
+        const bool silent = pEngineEffectsManager->processPostFaderInPlace(
+                pChannelInfo->m_handle,
                 outputHandle,
                 pChannelInfo->m_pBuffer,
                 iBufferSize,
                 iSampleRate,
                 pChannelInfo->m_features,
                 oldGain,
-                newGain);
-        SampleUtil::add(pOutput, pChannelInfo->m_pBuffer, iBufferSize);
+                newGain,
+                pChannelInfo->m_pChannel->isSilent());
+        if (!silent) {
+            SampleUtil::add(pOutput, pChannelInfo->m_pBuffer, iBufferSize);
+        }
     }
 }
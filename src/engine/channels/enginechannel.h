@@ -60,6 +60,12 @@ class EngineChannel : public EngineObject {
     virtual void collectFeatures(GroupFeatureState* pGroupFeatures) const = 0;
     virtual void postProcess(const int iBuffersize) = 0;
 
+    /// Returns true if the buffer of the last process() call contains only
+    /// zeros, so the post fader effects and the mixing can skip it.
+    bool isSilent() const {
+        return m_bSilent;
+    }
+
     // TODO(XXX) This hack needs to be removed.
     virtual EngineBuffer* getEngineBuffer() {
         return NULL;
@@ -77,6 +83,9 @@ class EngineChannel : public EngineObject {
     // It is used to check for valid bpm targets by the sync code.
     const bool m_bIsPrimaryDeck;
 
+    // Set by process() of subclasses that know when their output is silent
+    bool m_bSilent;
+
   private slots:
     void slotOrientationLeft(double v);
     void slotOrientationRight(double v);
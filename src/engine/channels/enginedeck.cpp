@@ -49,6 +49,9 @@ EngineDeck::~EngineDeck() {
 }
 
 void EngineDeck::process(CSAMPLE* pOut, const int iBufferSize) {
+    // A paused deck with a loaded track produces silence. The equalizers and
+    // effects are skipped for it after their tails have decayed.
+    bool silent = false;
     // Feed the incoming audio through if passthrough is active
     const CSAMPLE* sampleBuffer = m_sampleBuffer; // save pointer on stack
     if (isPassthroughActive() && sampleBuffer) {
@@ -61,6 +64,7 @@ void EngineDeck::process(CSAMPLE* pOut, const int iBufferSize) {
         if (m_bPassthroughWasActive) {
             SampleUtil::clear(pOut, iBufferSize);
             m_bPassthroughWasActive = false;
+            m_bSilent = true;
             return;
         }
 
@@ -68,20 +72,24 @@ void EngineDeck::process(CSAMPLE* pOut, const int iBufferSize) {
         m_pBuffer->process(pOut, iBufferSize);
         m_pPregain->setSpeedAndScratching(m_pBuffer->getSpeed(), m_pBuffer->getScratching());
         m_bPassthroughWasActive = false;
+        silent = m_pBuffer->isOutputSilent();
     }
 
-    // Apply pregain
+    // Apply pregain. This is done for silence as well to keep the gain
+    // controls and the ReplayGain fading up to date.
     m_pPregain->process(pOut, iBufferSize);
 
     EngineEffectsManager* pEngineEffectsManager = m_pEffectsManager->getEngineEffectsManager();
     if (pEngineEffectsManager != nullptr) {
-        pEngineEffectsManager->processPreFaderInPlace(m_group.handle(),
+        silent = pEngineEffectsManager->processPreFaderInPlace(m_group.handle(),
                 m_pEffectsManager->getMasterHandle(),
                 pOut,
                 iBufferSize,
                 // TODO(jholthuis): Use mixxx::audio::SampleRate instead
-                static_cast<unsigned int>(m_sampleRate.get()));
+                static_cast<unsigned int>(m_sampleRate.get()),
+                silent);
     }
+    m_bSilent = silent;
 
     // Update VU meter
     m_vuMeter.process(pOut, iBufferSize);
@@ -76,7 +76,7 @@ void appendCueHint(gsl::not_null<HintVector*> pHintList,
     if (frame.isValid()) {
         const Hint cueHint = {
                 /*.frame =*/static_cast<SINT>(frame.toLowerFrameBoundary().value()),
-                /*.frameCount =*/Hint::kFrameCountForward,
+                /*.frameCount =*/Hint::kFrameCountPrefetch,
                 /*.type =*/type};
         pHintList->append(cueHint);
     }
@@ -516,10 +516,37 @@ void LoopingControl::hintReader(gsl::not_null<HintVector*> pHintList) {
             loop_hint.type = Hint::Type::LoopStart;
             loop_hint.frame = static_cast<SINT>(
                     loopInfo.startPosition.toLowerFrameBoundary().value());
-            loop_hint.frameCount = Hint::kFrameCountForward;
+            loop_hint.frameCount = Hint::kFrameCountPrefetch;
             pHintList->append(loop_hint);
         }
     }
+
+    // Keep the targets of the next beat jump in both directions ready
+    const mixxx::BeatsPointer pBeats = m_pBeats;
+    const double beatJumpSize = m_pCOBeatJumpSize->get();
+    if (pBeats && beatJumpSize > 0) {
+        const auto currentPosition = m_currentPosition.getValue();
+        const auto forwardPosition =
+                pBeats->findNBeatsFromPosition(currentPosition, beatJumpSize);
+        if (forwardPosition.isValid()) {
+            Hint beatJumpHint;
+            beatJumpHint.type = Hint::Type::BeatJumpForward;
+            beatJumpHint.frame = static_cast<SINT>(
+                    forwardPosition.toLowerFrameBoundary().value());
+            beatJumpHint.frameCount = Hint::kFrameCountPrefetch;
+            pHintList->append(beatJumpHint);
+        }
+        const auto backwardPosition =
+                pBeats->findNBeatsFromPosition(currentPosition, -beatJumpSize);
+        if (backwardPosition.isValid()) {
+            Hint beatJumpHint;
+            beatJumpHint.type = Hint::Type::BeatJumpBackward;
+            beatJumpHint.frame = static_cast<SINT>(
+                    backwardPosition.toLowerFrameBoundary().value());
+            beatJumpHint.frameCount = Hint::kFrameCountPrefetch;
+            pHintList->append(beatJumpHint);
+        }
+    }
 }
 
 mixxx::audio::FramePos LoopingControl::getSyncPositionInsideLoop(
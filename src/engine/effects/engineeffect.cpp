@@ -22,10 +22,13 @@ EngineEffect::EngineEffect(EffectManifestPointer pManifest,
 
     for (const ChannelHandleAndGroup& inputChannel : registeredInputChannels) {
         ChannelHandleMap<EffectEnableState> outputChannelMap;
+        ChannelHandleMap<SINT> silentFramesMap;
         for (const ChannelHandleAndGroup& outputChannel : registeredOutputChannels) {
             outputChannelMap.insert(outputChannel.handle(), EffectEnableState::Disabled);
+            silentFramesMap.insert(outputChannel.handle(), 0);
         }
         m_effectEnableStateForChannelMatrix.insert(inputChannel.handle(), outputChannelMap);
+        m_silentFramesForChannelMatrix.insert(inputChannel.handle(), silentFramesMap);
     }
 
     m_pProcessor->loadEngineEffectParameters(m_parametersById);
@@ -130,7 +133,8 @@ bool EngineEffect::process(const ChannelHandle& inputHandle,
         const unsigned int numSamples,
         const unsigned int sampleRate,
         const EffectEnableState chainEnableState,
-        const GroupFeatureState& groupFeatures) {
+        const GroupFeatureState& groupFeatures,
+        const bool inputSilent) {
     // Compute the effective enable state from the combination of the effect's state
     // for the channel and the state passed from the EngineEffectChain.
 
@@ -176,12 +180,30 @@ bool EngineEffect::process(const ChannelHandle& inputHandle,
 
     bool processingOccured = false;
 
-    if (effectiveEffectEnableState != EffectEnableState::Disabled) {
-        //TODO: refactor rest of audio engine to use mixxx::AudioParameters
-        const mixxx::EngineParameters engineParameters(
-                mixxx::audio::SampleRate(sampleRate),
-                numSamples / mixxx::kEngineChannelCount);
+    //TODO: refactor rest of audio engine to use mixxx::AudioParameters
+    const mixxx::EngineParameters engineParameters(
+            mixxx::audio::SampleRate(sampleRate),
+            numSamples / mixxx::kEngineChannelCount);
+
+    // Once the input has been silent for longer than the tail of the effect,
+    // its output is silent as well and processing can be skipped until the
+    // input is no longer silent. The state of the effect has decayed by then,
+    // so resuming does not click. Intermediate enabling/disabling signals
+    // are always passed to the EffectProcessor.
+    SINT& silentFrames = m_silentFramesForChannelMatrix[inputHandle][outputHandle];
+    if (inputSilent && effectiveEffectEnableState == EffectEnableState::Enabled) {
+        const SINT tailFrames = m_pProcessor->getTailFrames(engineParameters);
+        if (tailFrames != EffectProcessor::kUnknownTailFrames &&
+                silentFrames >= tailFrames) {
+            effectiveEffectEnableState = EffectEnableState::Disabled;
+        } else {
+            silentFrames += engineParameters.framesPerBuffer();
+        }
+    } else if (!inputSilent) {
+        silentFrames = 0;
+    }
 
+    if (effectiveEffectEnableState != EffectEnableState::Disabled) {
         m_pProcessor->process(inputHandle,
                 outputHandle,
                 pInput,
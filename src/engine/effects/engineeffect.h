@@ -47,6 +47,8 @@ class EngineEffect final : public EffectsRequestHandler {
             EffectsResponsePipe* pResponsePipe) override;
 
     /// Called in audio thread
+    /// If inputSilent is set, pInput contains only zeros. The EffectProcessor is
+    /// skipped once the input has been silent for longer than its tail.
     bool process(const ChannelHandle& inputHandle,
             const ChannelHandle& outputHandle,
             const CSAMPLE* pInput,
@@ -54,7 +56,8 @@ class EngineEffect final : public EffectsRequestHandler {
             const unsigned int numSamples,
             const unsigned int sampleRate,
             const EffectEnableState chainEnableState,
-            const GroupFeatureState& groupFeatures);
+            const GroupFeatureState& groupFeatures,
+            const bool inputSilent = false);
 
     const EffectManifestPointer getManifest() const {
         return m_pManifest;
@@ -76,6 +79,9 @@ class EngineEffect final : public EffectsRequestHandler {
     EffectManifestPointer m_pManifest;
     std::unique_ptr<EffectProcessor> m_pProcessor;
     ChannelHandleMap<ChannelHandleMap<EffectEnableState>> m_effectEnableStateForChannelMatrix;
+    // The number of silent input frames processed since the input was last
+    // not silent
+    ChannelHandleMap<ChannelHandleMap<SINT>> m_silentFramesForChannelMatrix;
     bool m_effectRampsFromDry;
     // Must not be modified after construction.
     QVector<EngineEffectParameterPointer> m_parameters;
@@ -233,7 +233,8 @@ bool EngineEffectChain::process(const ChannelHandle& inputHandle,
         CSAMPLE* pOut,
         const unsigned int numSamples,
         const unsigned int sampleRate,
-        const GroupFeatureState& groupFeatures) {
+        const GroupFeatureState& groupFeatures,
+        const bool inputSilent) {
     // Compute the effective enable state from the channel input routing switch and
     // the chain's enable state. When either of these are turned on/off, send the
     // effects the intermediate enabling/disabling signal.
@@ -267,6 +268,8 @@ bool EngineEffectChain::process(const ChannelHandle& inputHandle,
         CSAMPLE* pIntermediateOutput;
         SINT effectChainGroupDelayFrames = 0;
         bool firstAddDryToWetEffectProcessed = false;
+        // The output of a processed effect is not known to be silent
+        bool intermediateInputSilent = inputSilent;
 
         for (EngineEffect* pEffect : qAsConst(m_effects)) {
             if (pEffect != nullptr) {
@@ -284,7 +287,8 @@ bool EngineEffectChain::process(const ChannelHandle& inputHandle,
                             numSamples,
                             sampleRate,
                             effectiveChainEnableState,
-                            groupFeatures)) {
+                            groupFeatures,
+                            intermediateInputSilent)) {
                     if (pEffect->getManifest()->addDryToWet()) {
                         // Skip adding the dry signal to the effect's wet output
                         // when it is the first addDryToWet type effect in
@@ -313,6 +317,7 @@ bool EngineEffectChain::process(const ChannelHandle& inputHandle,
 
                     // Output of this effect becomes the input of the next effect
                     pIntermediateInput = pIntermediateOutput;
+                    intermediateInputSilent = false;
                 }
             }
         }
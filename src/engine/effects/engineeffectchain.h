@@ -37,13 +37,17 @@ class EngineEffectChain final : public EffectsRequestHandler {
             EffectsResponsePipe* pResponsePipe) override;
 
     /// called from audio thread
+    /// Returns false if no effect was processed and pOut was not written.
+    /// If inputSilent is set, pIn contains only zeros, which allows effects
+    /// to be skipped after their tail has decayed.
     bool process(const ChannelHandle& inputHandle,
             const ChannelHandle& outputHandle,
             CSAMPLE* pIn,
             CSAMPLE* pOut,
             const unsigned int numSamples,
             const unsigned int sampleRate,
-            const GroupFeatureState& groupFeatures);
+            const GroupFeatureState& groupFeatures,
+            const bool inputSilent = false);
 
     /// called from main thread
     void deleteStatesForInputChannel(const ChannelHandle channel);
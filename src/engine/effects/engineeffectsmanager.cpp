@@ -94,25 +94,29 @@ void EngineEffectsManager::onCallbackStart() {
     }
 }
 
-void EngineEffectsManager::processPreFaderInPlace(const ChannelHandle& inputHandle,
+bool EngineEffectsManager::processPreFaderInPlace(const ChannelHandle& inputHandle,
         const ChannelHandle& outputHandle,
         CSAMPLE* pInOut,
         const unsigned int numSamples,
-        const unsigned int sampleRate) {
+        const unsigned int sampleRate,
+        const bool inputSilent) {
     // Feature state is gathered after prefader effects processing.
     // This is okay because the equalizer effects do not make use of it.
     GroupFeatureState featureState;
-    processInner(SignalProcessingStage::Prefader,
+    return processInner(SignalProcessingStage::Prefader,
             inputHandle,
             outputHandle,
             pInOut,
             pInOut,
             numSamples,
             sampleRate,
-            featureState);
+            featureState,
+            CSAMPLE_GAIN_ONE,
+            CSAMPLE_GAIN_ONE,
+            inputSilent);
 }
 
-void EngineEffectsManager::processPostFaderInPlace(
+bool EngineEffectsManager::processPostFaderInPlace(
         const ChannelHandle& inputHandle,
         const ChannelHandle& outputHandle,
         CSAMPLE* pInOut,
@@ -120,8 +124,9 @@ void EngineEffectsManager::processPostFaderInPlace(
         const unsigned int sampleRate,
         const GroupFeatureState& groupFeatures,
         const CSAMPLE_GAIN oldGain,
-        const CSAMPLE_GAIN newGain) {
-    processInner(SignalProcessingStage::Postfader,
+        const CSAMPLE_GAIN newGain,
+        const bool inputSilent) {
+    return processInner(SignalProcessingStage::Postfader,
             inputHandle,
             outputHandle,
             pInOut,
@@ -130,7 +135,8 @@ void EngineEffectsManager::processPostFaderInPlace(
             sampleRate,
             groupFeatures,
             oldGain,
-            newGain);
+            newGain,
+            inputSilent);
 }
 
 void EngineEffectsManager::processPostFaderAndMix(
@@ -142,7 +148,8 @@ void EngineEffectsManager::processPostFaderAndMix(
         const unsigned int sampleRate,
         const GroupFeatureState& groupFeatures,
         const CSAMPLE_GAIN oldGain,
-        const CSAMPLE_GAIN newGain) {
+        const CSAMPLE_GAIN newGain,
+        const bool inputSilent) {
     processInner(SignalProcessingStage::Postfader,
             inputHandle,
             outputHandle,
@@ -152,10 +159,11 @@ void EngineEffectsManager::processPostFaderAndMix(
             sampleRate,
             groupFeatures,
             oldGain,
-            newGain);
+            newGain,
+            inputSilent);
 }
 
-void EngineEffectsManager::processInner(
+bool EngineEffectsManager::processInner(
         const SignalProcessingStage stage,
         const ChannelHandle& inputHandle,
         const ChannelHandle& outputHandle,
@@ -165,13 +173,19 @@ void EngineEffectsManager::processInner(
         const unsigned int sampleRate,
         const GroupFeatureState& groupFeatures,
         const CSAMPLE_GAIN oldGain,
-        const CSAMPLE_GAIN newGain) {
+        const CSAMPLE_GAIN newGain,
+        const bool inputSilent) {
     const QList<EngineEffectChain*>& chains = m_chainsByStage.value(stage);
+    // Silence stays silent until a chain has processed an effect. Applying
+    // gain to it or mixing it can be skipped.
+    bool silent = inputSilent;
 
     if (pIn == pOut) {
         // Gain and effects are applied to the buffer in place,
         // modifying the original input buffer
-        SampleUtil::applyRampingGain(pIn, oldGain, newGain, numSamples);
+        if (!silent) {
+            SampleUtil::applyRampingGain(pIn, oldGain, newGain, numSamples);
+        }
         for (EngineEffectChain* pChain : chains) {
             if (pChain) {
                 if (pChain->process(inputHandle,
@@ -180,7 +194,9 @@ void EngineEffectsManager::processInner(
                             pOut,
                             numSamples,
                             sampleRate,
-                            groupFeatures)) {
+                            groupFeatures,
+                            silent)) {
+                    silent = false;
                 }
             }
         }
@@ -193,7 +209,7 @@ void EngineEffectsManager::processInner(
         //    ChannelMixer::applyEffectsAndMixChannels use
         //    this to mix channels into pOut regardless of whether any effects were processed.
         CSAMPLE* pIntermediateInput = m_buffer1.data();
-        if (oldGain == CSAMPLE_GAIN_ONE && newGain == CSAMPLE_GAIN_ONE) {
+        if (silent || (oldGain == CSAMPLE_GAIN_ONE && newGain == CSAMPLE_GAIN_ONE)) {
             // Avoid an unnecessary copy. EngineEffectChain::process does not modify the
             // input buffer when its input & output buffers are different, so this is okay.
             pIntermediateInput = pIn;
@@ -217,16 +233,21 @@ void EngineEffectsManager::processInner(
                             pIntermediateOutput,
                             numSamples,
                             sampleRate,
-                            groupFeatures)) {
+                            groupFeatures,
+                            silent)) {
                     // Output of this chain becomes the input of the next chain.
                     pIntermediateInput = pIntermediateOutput;
+                    silent = false;
                 }
             }
         }
         // pIntermediateInput is the output of the last processed chain. It would
         // be the intermediate input of the next chain if there was one.
-        SampleUtil::add(pOut, pIntermediateInput, numSamples);
+        if (!silent) {
+            SampleUtil::add(pOut, pIntermediateInput, numSamples);
+        }
     }
+    return silent;
 }
 
 bool EngineEffectsManager::addEffectChain(EngineEffectChain* pChain,
@@ -29,16 +29,22 @@ class EngineEffectsManager final : public EffectsRequestHandler {
 
     /// Process the prefader EngineEffectChains on the pInOut buffer, modifying
     /// the contents of the input buffer.
-    void processPreFaderInPlace(
+    ///
+    /// If inputSilent is set, the buffer contains only zeros. Effects are
+    /// skipped then after their tail has decayed. Returns whether the buffer
+    /// still contains only zeros after processing.
+    bool processPreFaderInPlace(
             const ChannelHandle& inputHandle,
             const ChannelHandle& outputHandle,
             CSAMPLE* pInOut,
             const unsigned int numSamples,
-            const unsigned int sampleRate);
+            const unsigned int sampleRate,
+            const bool inputSilent = false);
 
     /// Process the postfader EngineEffectChains on the pInOut buffer, modifying
-    /// the contents of the input buffer.
-    void processPostFaderInPlace(
+    /// the contents of the input buffer. Returns whether the buffer contains
+    /// only zeros after processing, see processPreFaderInPlace().
+    bool processPostFaderInPlace(
             const ChannelHandle& inputHandle,
             const ChannelHandle& outputHandle,
             CSAMPLE* pInOut,
@@ -46,13 +52,15 @@ class EngineEffectsManager final : public EffectsRequestHandler {
             const unsigned int sampleRate,
             const GroupFeatureState& groupFeatures,
             const CSAMPLE_GAIN oldGain = CSAMPLE_GAIN_ONE,
-            const CSAMPLE_GAIN newGain = CSAMPLE_GAIN_ONE);
+            const CSAMPLE_GAIN newGain = CSAMPLE_GAIN_ONE,
+            const bool inputSilent = false);
 
     /// Process the postfader EngineEffectChains, leaving the pIn buffer unmodified
     /// and mixing the output into the pOut buffer. Using EngineEffectsManager's
     /// temporary buffers for this avoids the need for ChannelMixer to allocate a
     /// buffer for every channel, which would potentially require allocation on the
     /// audio thread because ChannelMixer supports an arbitrary number of channels.
+    /// Nothing is mixed into pOut if the processed pIn is silent.
     void processPostFaderAndMix(
             const ChannelHandle& inputHandle,
             const ChannelHandle& outputHandle,
@@ -62,7 +70,8 @@ class EngineEffectsManager final : public EffectsRequestHandler {
             const unsigned int sampleRate,
             const GroupFeatureState& groupFeatures,
             const CSAMPLE_GAIN oldGain = CSAMPLE_GAIN_ONE,
-            const CSAMPLE_GAIN newGain = CSAMPLE_GAIN_ONE);
+            const CSAMPLE_GAIN newGain = CSAMPLE_GAIN_ONE,
+            const bool inputSilent = false);
 
     bool processEffectsRequest(
             EffectsRequest& message,
@@ -82,8 +91,8 @@ class EngineEffectsManager final : public EffectsRequestHandler {
     // then the operation must occur in-place. Both pInput and pOutput are
     // represented as stereo interleaved samples. There are numSamples total
     // samples, so numSamples/2 left channel samples and numSamples/2 right
-    // channel samples.
-    void processInner(const SignalProcessingStage stage,
+    // channel samples. Returns whether the output is silent.
+    bool processInner(const SignalProcessingStage stage,
             const ChannelHandle& inputHandle,
             const ChannelHandle& outputHandle,
             CSAMPLE* pIn,
@@ -92,7 +101,8 @@ class EngineEffectsManager final : public EffectsRequestHandler {
             const unsigned int sampleRate,
             const GroupFeatureState& groupFeatures,
             const CSAMPLE_GAIN oldGain = CSAMPLE_GAIN_ONE,
-            const CSAMPLE_GAIN newGain = CSAMPLE_GAIN_ONE);
+            const CSAMPLE_GAIN newGain = CSAMPLE_GAIN_ONE,
+            const bool inputSilent = false);
 
     QScopedPointer<EffectsResponsePipe> m_pResponsePipe;
     QHash<SignalProcessingStage, QList<EngineEffectChain*>> m_chainsByStage;
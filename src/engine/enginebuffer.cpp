@@ -269,6 +269,16 @@ EngineBuffer::EngineBuffer(const QString& group,
     m_pScaleST = new EngineBufferScaleST(m_pReadAheadManager);
     m_pScaleRB = new EngineBufferScaleRubberBand(m_pReadAheadManager);
     slotKeylockEngineChanged(m_pKeylockEngine->get());
+    m_pInterpolator = new ControlProxy("[Master]", "interpolator", this);
+    m_pInterpolator->connectValueChanged(this,
+            &EngineBuffer::slotInterpolatorChanged,
+            Qt::DirectConnection);
+    slotInterpolatorChanged(m_pInterpolator->get());
+    m_pKeylockLookAhead = new ControlProxy("[Master]", "keylock_lookahead", this);
+    m_pKeylockLookAhead->connectValueChanged(this,
+            &EngineBuffer::slotKeylockLookAheadChanged,
+            Qt::DirectConnection);
+    slotKeylockLookAheadChanged(m_pKeylockLookAhead->get());
     m_pScaleVinyl = m_pScaleLinear;
     m_pScale = m_pScaleVinyl;
     m_pScale->clear();
@@ -329,6 +339,7 @@ EngineBuffer::~EngineBuffer() {
 
 void EngineBuffer::bindWorkers(EngineWorkerScheduler* pWorkerScheduler) {
     m_pReader->setScheduler(pWorkerScheduler);
+    m_pScaleRB->setScheduler(pWorkerScheduler);
 }
 
 void EngineBuffer::enableIndependentPitchTempoScaling(bool bEnable,
@@ -818,6 +829,24 @@ void EngineBuffer::slotKeylockEngineChanged(double dIndex) {
     }
 }
 
+void EngineBuffer::slotInterpolatorChanged(double dIndex) {
+    const auto interpolator = static_cast<EngineBufferScaleLinear::Interpolator>(dIndex);
+    switch (interpolator) {
+    case EngineBufferScaleLinear::Interpolator::Linear:
+    case EngineBufferScaleLinear::Interpolator::Hermite:
+    case EngineBufferScaleLinear::Interpolator::Sinc:
+        m_pScaleLinear->setInterpolator(interpolator);
+        break;
+    default:
+        m_pScaleLinear->setInterpolator(EngineBufferScaleLinear::defaultInterpolator());
+        break;
+    }
+}
+
+void EngineBuffer::slotKeylockLookAheadChanged(double dEnabled) {
+    m_pScaleRB->setLookAheadEnabled(dEnabled > 0.0);
+}
+
 void EngineBuffer::processTrackLocked(
         CSAMPLE* pOutput, const int iBufferSize, mixxx::audio::SampleRate sampleRate) {
     ScopedTimer t("EngineBuffer::process_pauselock");
@@ -1077,6 +1106,7 @@ void EngineBuffer::processTrackLocked(
             SampleUtil::copy(pOutput, m_pCrossfadeBuffer, iBufferSize);
         } else {
             SampleUtil::clear(pOutput, iBufferSize);
+            m_bOutputSilent = true;
         }
     }
 
@@ -1137,6 +1167,7 @@ void EngineBuffer::process(CSAMPLE* pOutput, const int iBufferSize) {
     m_pScaleST->setSampleRate(m_sampleRate);
     m_pScaleRB->setSampleRate(m_sampleRate);
 
+    m_bOutputSilent = false;
     bool bTrackLoading = m_iTrackLoading.loadAcquire() != 0;
     if (!bTrackLoading && m_pause.tryLock()) {
         processTrackLocked(pOutput, iBufferSize, m_sampleRate);
@@ -1160,6 +1191,7 @@ void EngineBuffer::process(CSAMPLE* pOutput, const int iBufferSize) {
         // may click.
 
         SampleUtil::clear(pOutput, iBufferSize);
+        m_bOutputSilent = true;
 
         m_rate_old = 0;
         m_speed_old = 0;
@@ -1301,6 +1333,7 @@ void EngineBuffer::processSeek(bool paused) {
         if (kLogger.traceEnabled()) {
             kLogger.trace() << "EngineBuffer::processSeek" << getGroup() << "Seek to" << position;
         }
+        m_pReader->notifySeek(static_cast<SINT>(position.toLowerFrameBoundary().value()));
         setNewPlaypos(position);
         m_previousBufferSeek = true;
     }
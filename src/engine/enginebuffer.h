@@ -126,6 +126,11 @@ class EngineBuffer : public EngineObject {
     void process(CSAMPLE* pOut, const int iBufferSize);
     void processSlip(int iBufferSize);
     void postProcess(const int iBufferSize);
+    /// Returns true if the last process() call has cleared the output buffer,
+    /// because the deck is paused or loading a track (not thread-safe)
+    bool isOutputSilent() const {
+        return m_bOutputSilent;
+    }
 
     /// Returns the seek position iff a seek is currently queued but not yet
     /// processed. If no seek was queued, and invalid frame position is returned.
@@ -207,6 +212,8 @@ class EngineBuffer : public EngineObject {
     void slotControlEnd(double);
     void slotControlSeek(double);
     void slotKeylockEngineChanged(double);
+    void slotInterpolatorChanged(double);
+    void slotKeylockLookAheadChanged(double);
 
   signals:
     void trackLoaded(TrackPointer pNewTrack, TrackPointer pOldTrack);
@@ -374,6 +381,8 @@ class EngineBuffer : public EngineObject {
     ControlPotmeter* m_playposSlider;
     ControlProxy* m_pSampleRate;
     ControlProxy* m_pKeylockEngine;
+    ControlProxy* m_pInterpolator;
+    ControlProxy* m_pKeylockLookAhead;
     ControlPushButton* m_pKeylock;
 
     // This ControlProxys is created as parent to this and deleted by
@@ -443,6 +452,7 @@ class EngineBuffer : public EngineObject {
     CSAMPLE* m_pCrossfadeBuffer;
     bool m_bCrossfadeReady;
     int m_iLastBufferSize;
+    bool m_bOutputSilent = false;
 
     QSharedPointer<VisualPlayPosition> m_visualPlayPos;
 };
@@ -8,6 +8,7 @@
 #include "control/controlpotmeter.h"
 #include "control/controlpushbutton.h"
 #include "effects/effectsmanager.h"
+#include "engine/bufferscalers/enginebufferscalelinear.h"
 #include "engine/channelmixer.h"
 #include "engine/channels/enginechannel.h"
 #include "engine/channels/enginedeck.h"
@@ -19,11 +20,13 @@
 #include "engine/engineworkerscheduler.h"
 #include "engine/enginexfader.h"
 #include "engine/sidechain/enginesidechain.h"
+#include "engine/sidechain/stemfifo.h"
 #include "engine/sync/enginesync.h"
 #include "mixer/playermanager.h"
 #include "moc_enginemaster.cpp"
 #include "preferences/usersettings.h"
 #include "util/defs.h"
+#include "util/rtaudit.h"
 #include "util/sample.h"
 #include "util/timer.h"
 #include "util/trace.h"
@@ -176,6 +179,18 @@ EngineMaster::EngineMaster(
     m_pKeylockEngine->set(pConfig->getValue(ConfigKey(group, "keylock_engine"),
             static_cast<double>(EngineBuffer::defaultKeylockEngine())));
 
+    // The interpolation kernel used by the vinyl / scratch scaler
+    m_pInterpolator = new ControlObject(ConfigKey(group, "interpolator"), true, false, true);
+    m_pInterpolator->set(pConfig->getValue(ConfigKey(group, "interpolator"),
+            static_cast<double>(EngineBufferScaleLinear::defaultInterpolator())));
+
+    // Opt-in: run keylock time stretching ahead of the playhead on worker
+    // threads
+    m_pKeylockLookAhead = new ControlObject(
+            ConfigKey(group, "keylock_lookahead"), true, false, true);
+    m_pKeylockLookAhead->set(pConfig->getValue(
+            ConfigKey(group, "keylock_lookahead"), 0.0));
+
     // TODO: Make this read only and make EngineMaster decide whether
     // processing the master mix is necessary.
     m_pMasterEnabled = new ControlObject(ConfigKey(group, "enabled"),
@@ -195,6 +210,8 @@ EngineMaster::EngineMaster(
 EngineMaster::~EngineMaster() {
     //qDebug() << "in ~EngineMaster()";
     delete m_pKeylockEngine;
+    delete m_pInterpolator;
+    delete m_pKeylockLookAhead;
     delete m_pCrossfader;
     delete m_pBalance;
     delete m_pHeadMix;
@@ -383,9 +400,41 @@ void EngineMaster::processChannels(int iBufferSize) {
     }
 }
 
+void EngineMaster::writeStems(StemFifo* pStemFifo, bool postFader) {
+    const auto isActive = [](const auto& activeChannels, int channelIndex) {
+        for (const ChannelInfo* pChannelInfo : activeChannels) {
+            // m_activeChannels starts with nullptr if there is no sync leader
+            if (pChannelInfo && pChannelInfo->m_index == channelIndex) {
+                return true;
+            }
+        }
+        return false;
+    };
+    for (int i = 0; i < pStemFifo->stemCount(); ++i) {
+        const StemFifo::Stem& stem = pStemFifo->stem(i);
+        if (stem.postFader != postFader) {
+            continue;
+        }
+        bool active;
+        if (postFader) {
+            active = isActive(m_activeTalkoverChannels, stem.channelIndex) ||
+                    isActive(m_activeBusChannels[EngineChannel::LEFT], stem.channelIndex) ||
+                    isActive(m_activeBusChannels[EngineChannel::CENTER],
+                            stem.channelIndex) ||
+                    isActive(m_activeBusChannels[EngineChannel::RIGHT], stem.channelIndex);
+        } else {
+            active = isActive(m_activeChannels, stem.channelIndex);
+        }
+        pStemFifo->writeStem(active ? m_channels[stem.channelIndex]->m_pBuffer : nullptr);
+    }
+}
+
 void EngineMaster::process(const int iBufferSize) {
+    mixxx::rtaudit::ScopedRealtimeSection realtimeSection;
     static bool haveSetName = false;
     if (!haveSetName) {
+        // One-time initialization on the first callback, allocating is fine
+        mixxx::rtaudit::ScopedAllowBlocking allowBlocking;
         QThread::currentThread()->setObjectName("Engine");
         haveSetName = true;
     }
@@ -408,6 +457,21 @@ void EngineMaster::process(const int iBufferSize) {
     // Prepare all channels for output
     processChannels(m_iBufferSize);
 
+    // The channel buffers are still pre-fader here. Mixing the talkover and
+    // the crossfader buses below applies the faders and effects in place.
+    // The block starts at the same frame position as the samples of the
+    // master mix that are written into the sidechain below.
+    StemFifo* pStemFifo = nullptr;
+    if (masterEnabled && m_pEngineSideChain) {
+        pStemFifo = m_pEngineSideChain->getStemFifo();
+        if (pStemFifo->beginBlock(m_iBufferSize,
+                    m_pEngineSideChain->writeFramePosition())) {
+            writeStems(pStemFifo, false);
+        } else {
+            pStemFifo = nullptr;
+        }
+    }
+
     // Compute headphone mix
     // Head phone left/right mix
     CSAMPLE pflMixGainInHeadphones = 1;
@@ -528,6 +592,11 @@ void EngineMaster::process(const int iBufferSize) {
                 m_pEngineEffectsManager);
     }
 
+    if (pStemFifo) {
+        writeStems(pStemFifo, true);
+        pStemFifo->commitBlock();
+    }
+
     // Process crossfader orientation bus channel effects
     if (m_pEngineEffectsManager) {
         m_pEngineEffectsManager->processPostFaderInPlace(
@@ -857,6 +926,16 @@ EngineChannel* EngineMaster::getChannel(const QString& group) {
     return nullptr;
 }
 
+int EngineMaster::getChannelIndex(const QString& group) const {
+    for (int i = 0; i < m_channels.size(); ++i) {
+        const ChannelInfo* pChannelInfo = m_channels[i];
+        if (pChannelInfo->m_pChannel->getGroup() == group) {
+            return pChannelInfo->m_index;
+        }
+    }
+    return -1;
+}
+
 CSAMPLE_GAIN EngineMaster::getMasterGain(int channelIndex) const {
     if (channelIndex >= 0 && channelIndex < m_channelMasterGainCache.size()) {
         return m_channelMasterGainCache[channelIndex].m_gain;
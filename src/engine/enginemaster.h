@@ -23,6 +23,7 @@ class EngineVuMeter;
 class ControlPotmeter;
 class ControlPushButton;
 class EngineSideChain;
+class StemFifo;
 class EffectsManager;
 class EngineEffectsManager;
 class SyncWorker;
@@ -73,6 +74,9 @@ class EngineMaster : public QObject, public AudioSource {
     // only call it before the engine has started mixing.
     void addChannel(EngineChannel* pChannel);
     EngineChannel* getChannel(const QString& group);
+    // Returns the index of the channel in the engine or -1 if there is no
+    // such channel. Used to select the channels that are recorded as stems.
+    int getChannelIndex(const QString& group) const;
     static inline CSAMPLE_GAIN gainForOrientation(EngineChannel::ChannelOrientation orientation,
             CSAMPLE_GAIN leftGain,
             CSAMPLE_GAIN centerGain,
@@ -261,6 +265,9 @@ class EngineMaster : public QObject, public AudioSource {
     // m_activeTalkoverChannels with each channel that is active for the
     // respective output.
     void processChannels(int iBufferSize);
+    // Writes the pre-fader or post-fader stems of the current callback into
+    // the StemFifo. Inactive channels are written as silence.
+    void writeStems(StemFifo* pStemFifo, bool postFader);
 
     ChannelHandleFactoryPointer m_pChannelHandleFactory;
     void applyMasterEffects();
@@ -326,6 +333,8 @@ class EngineMaster : public QObject, public AudioSource {
     ControlPushButton* m_pXFaderReverse;
     ControlPushButton* m_pHeadSplitEnabled;
     ControlObject* m_pKeylockEngine;
+    ControlObject* m_pInterpolator;
+    ControlObject* m_pKeylockLookAhead;
 
     PflGainCalculator m_headphoneGain;
     TalkoverGainCalculator m_talkoverGain;
@@ -1,6 +1,7 @@
 #include "engine/engineworkerscheduler.h"
 
 #include <QtDebug>
+#include <algorithm>
 
 #include "engine/engineworker.h"
 #include "moc_engineworkerscheduler.cpp"
@@ -29,6 +30,13 @@ void EngineWorkerScheduler::addWorker(EngineWorker* pWorker) {
     m_workers.push_back(pWorker);
 }
 
+void EngineWorkerScheduler::removeWorker(EngineWorker* pWorker) {
+    DEBUG_ASSERT(pWorker);
+    const auto locker = lockMutex(&m_mutex);
+    m_workers.erase(std::remove(m_workers.begin(), m_workers.end(), pWorker),
+            m_workers.end());
+}
+
 void EngineWorkerScheduler::runWorkers() {
     // Wake the scheduler if we have written a worker-ready message to the
     // scheduler. There is no race condition in accessing this boolean because
@@ -19,6 +19,7 @@ class EngineWorkerScheduler : public QThread {
     virtual ~EngineWorkerScheduler();
 
     void addWorker(EngineWorker* pWorker);
+    void removeWorker(EngineWorker* pWorker);
     void runWorkers();
     void workerReady();
 
@@ -37,6 +37,10 @@ class EngineRecord : public QObject, public EncoderCallback, public SideChainWor
     void closeFile();
     int updateFromPreferences();
     bool fileOpen();
+    // The file of the master mix, while fileOpen()
+    const QString& fileName() const {
+        return m_fileName;
+    }
     bool openCueFile();
     void closeCueFile();
 
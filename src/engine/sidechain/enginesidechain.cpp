@@ -27,7 +27,9 @@ EngineSideChain::EngineSideChain(
         : m_pConfig(pConfig),
           m_bStopThread(false),
           m_sampleFifo(SIDECHAIN_BUFFER_SIZE),
-          m_pWorkBuffer(SampleUtil::alloc(SIDECHAIN_BUFFER_SIZE)),
+          m_writeFramePosition(0),
+          m_readFramePosition(0),
+          m_stemFifo(SIDECHAIN_BUFFER_SIZE),
           m_pSidechainMix(sidechainMix) {
     // We use HighPriority to prevent starvation by lower-priority processes (Qt
     // main thread, analysis, etc.). This used to be LowPriority but that is not
@@ -39,10 +41,8 @@ EngineSideChain::EngineSideChain(
 }
 
 EngineSideChain::~EngineSideChain() {
-    m_waitLock.lock();
     m_bStopThread = true;
-    m_waitForSamples.wakeAll();
-    m_waitLock.unlock();
+    m_samplesAvailable.notify();
 
     // Wait until the thread has finished.
     wait();
@@ -54,8 +54,6 @@ EngineSideChain::~EngineSideChain() {
         delete pWorker;
     }
     locker.unlock();
-
-    SampleUtil::free(m_pWorkBuffer);
 }
 
 void EngineSideChain::addSideChainWorker(SideChainWorker* pWorker) {
@@ -85,11 +83,12 @@ void EngineSideChain::writeSamples(const CSAMPLE* pBuffer, int iFrames) {
     if (samples_written != iSamples) {
         Counter("EngineSideChain::writeSamples buffer overrun").increment();
     }
+    m_writeFramePosition += samples_written / kChannels;
 
     if (m_sampleFifo.writeAvailable() < SIDECHAIN_BUFFER_SIZE / 5) {
         // Signal to the sidechain that samples are available.
         Trace wakeup("EngineSideChain::writeSamples wake up");
-        m_waitForSamples.wakeAll();
+        m_samplesAvailable.notify();
     }
 }
 
@@ -102,21 +101,35 @@ void EngineSideChain::run() {
     Event::start(tag);
     while (!m_bStopThread) {
         // Sleep until samples are available.
-        m_waitLock.lock();
-
-        Event::end(tag);
-        m_waitForSamples.wait(&m_waitLock);
-        m_waitLock.unlock();
-        Event::start(tag);
+        const auto key = m_samplesAvailable.prepareWait();
+        if (m_bStopThread ||
+                m_sampleFifo.writeAvailable() < SIDECHAIN_BUFFER_SIZE / 5) {
+            m_samplesAvailable.cancelWait();
+        } else {
+            Event::end(tag);
+            m_samplesAvailable.wait(key);
+            Event::start(tag);
+        }
 
+        // Process the samples in place, without copying them out of the FIFO
+        CSAMPLE* pData1;
+        ring_buffer_size_t size1;
+        CSAMPLE* pData2;
+        ring_buffer_size_t size2;
         int samples_read;
-        while ((samples_read = m_sampleFifo.read(m_pWorkBuffer,
-                                                 SIDECHAIN_BUFFER_SIZE))) {
+        while ((samples_read = m_sampleFifo.aquireReadRegions(SIDECHAIN_BUFFER_SIZE,
+                        &pData1,
+                        &size1,
+                        &pData2,
+                        &size2))) {
             Trace process("EngineSideChain::process");
             MMutexLocker locker(&m_workerLock);
-            foreach (SideChainWorker* pWorker, m_workers) {
-                pWorker->process(m_pWorkBuffer, samples_read);
+            processWorkers(pData1, static_cast<int>(size1));
+            if (size2 > 0) {
+                processWorkers(pData2, static_cast<int>(size2));
             }
+            locker.unlock();
+            m_sampleFifo.releaseReadRegions(samples_read);
         }
 
         // Check to see if we're supposed to exit/stop this thread.
@@ -125,3 +138,12 @@ void EngineSideChain::run() {
         }
     }
 }
+
+void EngineSideChain::processWorkers(const CSAMPLE* pBuffer, int iBufferSize) {
+    // All workers see the same buffer at the same frame position, in the
+    // order they have been added.
+    foreach (SideChainWorker* pWorker, m_workers) {
+        pWorker->process(pBuffer, iBufferSize);
+    }
+    m_readFramePosition += iBufferSize / mixxx::kEngineChannelCount;
+}
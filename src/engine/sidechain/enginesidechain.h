@@ -1,13 +1,13 @@
 #pragma once
 
 #include <QThread>
-#include <QMutex>
-#include <QWaitCondition>
 #include <QList>
 
 #include "preferences/usersettings.h"
 #include "engine/sidechain/sidechainworker.h"
+#include "engine/sidechain/stemfifo.h"
 #include "soundio/soundmanagerutil.h"
+#include "util/eventcount.h"
 #include "util/fifo.h"
 #include "util/mutex.h"
 #include "util/types.h"
@@ -32,23 +32,47 @@ class EngineSideChain : public QThread, public AudioDestination {
     // Thread-safe, blocking.
     void addSideChainWorker(SideChainWorker* pWorker);
 
+    // The stems of individual channels, written by the engine callback
+    // alongside the samples of the master mix.
+    StemFifo* getStemFifo() {
+        return &m_stemFifo;
+    }
+
+    // The engine frame position of the next samples that are submitted by
+    // writeSamples(), i.e. the number of frames that have been submitted so
+    // far. Samples that are dropped on overrun are not counted. Engine
+    // thread only.
+    quint64 writeFramePosition() const {
+        return m_writeFramePosition;
+    }
+
+    // The engine frame position of the first frame of the buffer that is
+    // passed to SideChainWorker::process(). Sidechain thread only.
+    quint64 readFramePosition() const {
+        return m_readFramePosition;
+    }
+
     static constexpr int SIDECHAIN_BUFFER_SIZE = 65536;
 
   private:
     void run() override;
+    void processWorkers(const CSAMPLE* pBuffer, int iBufferSize) REQUIRES(m_workerLock);
 
     UserSettingsPointer m_pConfig;
     // Indicates that the thread should exit.
     volatile bool m_bStopThread;
 
     FIFO<CSAMPLE> m_sampleFifo;
-    CSAMPLE* m_pWorkBuffer;
+    quint64 m_writeFramePosition;
+    quint64 m_readFramePosition;
+    // Has the capacity of m_sampleFifo for each stem, so it can't fill up
+    // before the sidechain is woken up by the samples of the master mix.
+    StemFifo m_stemFifo;
     CSAMPLE* m_pSidechainMix;
 
-    // Provides thread safety around the wait condition below.
-    QMutex m_waitLock;
-    // Allows sleeping until we have samples to process.
-    QWaitCondition m_waitForSamples;
+    // Allows sleeping until we have samples to process, without blocking
+    // the engine callback when waking us up.
+    EventCount m_samplesAvailable;
 
     // Sidechain workers registered with EngineSideChain.
     MMutex m_workerLock;
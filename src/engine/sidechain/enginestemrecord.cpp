@@ -0,0 +1,255 @@
+#include "engine/sidechain/enginestemrecord.h"
+
+#include <QtDebug>
+#include <algorithm>
+
+#include "control/controlproxy.h"
+#include "engine/engine.h"
+#include "engine/enginemaster.h"
+#include "engine/sidechain/enginerecord.h"
+#include "engine/sidechain/enginesidechain.h"
+#include "engine/sidechain/stemfifo.h"
+#include "moc_enginestemrecord.cpp"
+#include "recording/defs_recording.h"
+#include "util/math.h"
+
+namespace {
+
+constexpr int kChannels = mixxx::kEngineChannelCount;
+
+// Fills the gaps of dropped blocks
+constexpr int kSilenceSamples = 1024;
+const CSAMPLE kSilence[kSilenceSamples] = {};
+
+} // anonymous namespace
+
+EngineStemRecord::EngineStemRecord(UserSettingsPointer pConfig,
+        EngineMaster* pEngineMaster,
+        EngineSideChain* pSideChain,
+        EngineRecord* pEngineRecord)
+        : m_pConfig(pConfig),
+          m_pEngineMaster(pEngineMaster),
+          m_pSideChain(pSideChain),
+          m_pStemFifo(pSideChain->getStemFifo()),
+          m_pEngineRecord(pEngineRecord),
+          m_generation(0) {
+    m_pSamplerate = new ControlProxy("[Master]", "samplerate", this);
+}
+
+EngineStemRecord::~EngineStemRecord() {
+    closeStems();
+    m_pStemFifo->clearStems();
+    delete m_pSamplerate;
+}
+
+void EngineStemRecord::process(const CSAMPLE* pBuffer, const int iBufferSize) {
+    Q_UNUSED(pBuffer);
+    const quint64 framePosition = m_pSideChain->readFramePosition();
+
+    // EngineRecord has been processed before with the same buffer. It
+    // starts, stops and splits the file of the master mix at the start of
+    // the buffer.
+    const QString masterFilePath =
+            m_pEngineRecord->fileOpen() ? m_pEngineRecord->fileName() : QString();
+    if (masterFilePath != m_masterFilePath) {
+        closeStems();
+        m_masterFilePath = masterFilePath;
+        if (!masterFilePath.isEmpty()) {
+            openStems(masterFilePath, framePosition);
+        }
+    }
+    if (m_masterFilePath.isEmpty()) {
+        updateStems();
+    }
+
+    encodeStems(framePosition + iBufferSize / kChannels);
+}
+
+void EngineStemRecord::updateStems() {
+    const QString stemsConfig =
+            m_pConfig->getValueString(ConfigKey(RECORDING_PREF_KEY, "Stems"));
+    if (stemsConfig == m_stemsConfig) {
+        return;
+    }
+    m_stemsConfig = stemsConfig;
+    QList<RecordingStem> stems = RecordingStem::parseList(stemsConfig);
+    // Same order as in the StemFifo
+    std::stable_partition(stems.begin(), stems.end(), [](const RecordingStem& stem) {
+        return !stem.postFader;
+    });
+
+    m_stems.clear();
+    QVector<StemFifo::Stem> fifoStems;
+    for (const auto& stem : qAsConst(stems)) {
+        if (fifoStems.size() >= StemFifo::kMaxStems) {
+            qWarning() << "Recording only the first" << StemFifo::kMaxStems << "stems";
+            break;
+        }
+        const int channelIndex = m_pEngineMaster->getChannelIndex(stem.group);
+        if (channelIndex < 0) {
+            qWarning() << "Cannot record stem of unknown channel" << stem.group;
+            continue;
+        }
+        m_stems.append(stem);
+        fifoStems.append(StemFifo::Stem{channelIndex, stem.postFader});
+    }
+    m_generation = m_pStemFifo->setStems(&fifoStems);
+}
+
+void EngineStemRecord::openStems(const QString& masterFilePath, quint64 framePosition) {
+    const auto sampleRate = mixxx::audio::SampleRate::fromDouble(m_pSamplerate->get());
+    const QString title = m_pConfig->getValueString(ConfigKey(RECORDING_PREF_KEY, "Title"));
+    for (const auto& stem : qAsConst(m_stems)) {
+        auto pStemFile = std::make_unique<StemFile>();
+        const QString filePath = stem.filePath(masterFilePath);
+        if (pStemFile->open(filePath,
+                    m_pConfig,
+                    sampleRate,
+                    title.isEmpty() ? stem.group : title + QChar(' ') + stem.group,
+                    framePosition)) {
+            qDebug() << "Recording stem" << stem.group << "to" << filePath;
+        } else {
+            qWarning() << "Could not open" << filePath << "for writing.";
+            pStemFile.reset();
+        }
+        m_stemFiles.push_back(std::move(pStemFile));
+    }
+}
+
+void EngineStemRecord::closeStems() {
+    for (const auto& pStemFile : m_stemFiles) {
+        if (pStemFile) {
+            pStemFile->close();
+        }
+    }
+    m_stemFiles.clear();
+}
+
+void EngineStemRecord::encodeStems(quint64 endFramePosition) {
+    StemFifo::BlockHeader header;
+    quint64 framePosition;
+    // The position of the next region of the stem
+    int stem = -1;
+    quint64 stemFramePosition = 0;
+    const auto consume = [&](int nextStem, const CSAMPLE* pSamples, int samples) {
+        if (nextStem != stem) {
+            stem = nextStem;
+            stemFramePosition = framePosition;
+        }
+        const quint64 regionFramePosition = stemFramePosition;
+        stemFramePosition += samples / kChannels;
+        if (header.generation != m_generation ||
+                stem >= static_cast<int>(m_stemFiles.size()) ||
+                !m_stemFiles[stem]) {
+            // Not recording or recorded with stems that are no longer used
+            return;
+        }
+        m_stemFiles[stem]->encode(regionFramePosition, pSamples, samples);
+    };
+    while (m_pStemFifo->readBlock(endFramePosition, &header, &framePosition, consume)) {
+        stem = -1;
+    }
+}
+
+bool EngineStemRecord::StemFile::open(const QString& filePath,
+        UserSettingsPointer pConfig,
+        mixxx::audio::SampleRate sampleRate,
+        const QString& title,
+        quint64 framePosition) {
+    // The encoder may already write the header of the file when it is
+    // initialized.
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    // Same format and settings as the master mix
+    const Encoder::Format format = EncoderFactory::getFactory().getSelectedFormat(pConfig);
+    m_pEncoder = EncoderFactory::getFactory().createRecordingEncoder(format, pConfig, this);
+    QString userErrorMsg;
+    if (m_pEncoder) {
+        m_pEncoder->updateMetaData(
+                pConfig->getValueString(ConfigKey(RECORDING_PREF_KEY, "Author")),
+                title,
+                pConfig->getValueString(ConfigKey(RECORDING_PREF_KEY, "Album")));
+        if (m_pEncoder->initEncoder(sampleRate, &userErrorMsg) < 0) {
+            m_pEncoder.reset();
+        }
+    }
+    if (!m_pEncoder) {
+        qWarning() << "Failed to initialize the encoder of the stem:" << userErrorMsg;
+        m_file.remove();
+        return false;
+    }
+    m_framePosition = framePosition;
+    return true;
+}
+
+void EngineStemRecord::StemFile::encode(
+        quint64 framePosition, const CSAMPLE* pSamples, int samples) {
+    if (framePosition < m_framePosition) {
+        // Overlaps with the previous block if the master mix has been
+        // dropped partially on overrun
+        const int skip = static_cast<int>(
+                math_min<quint64>(m_framePosition - framePosition, samples / kChannels));
+        framePosition += skip;
+        pSamples += skip * kChannels;
+        samples -= skip * kChannels;
+        if (samples == 0) {
+            return;
+        }
+    }
+    // The block has been dropped on overrun or the stems have been
+    // published after the samples of the master mix
+    quint64 missingSamples = (framePosition - m_framePosition) * kChannels;
+    while (missingSamples > 0) {
+        const int silence = static_cast<int>(
+                math_min<quint64>(missingSamples, kSilenceSamples));
+        m_pEncoder->encodeBuffer(kSilence, silence);
+        missingSamples -= silence;
+    }
+    m_pEncoder->encodeBuffer(pSamples, samples);
+    m_framePosition = framePosition + samples / kChannels;
+}
+
+void EngineStemRecord::StemFile::close() {
+    if (m_pEncoder) {
+        m_pEncoder->flush();
+        m_pEncoder.reset();
+    }
+    m_file.close();
+}
+
+void EngineStemRecord::StemFile::write(const unsigned char* header,
+        const unsigned char* body,
+        int headerLen,
+        int bodyLen) {
+    if (!m_file.isOpen()) {
+        return;
+    }
+    // Relevant for OGG
+    if (headerLen > 0) {
+        m_file.write(reinterpret_cast<const char*>(header), headerLen);
+    }
+    m_file.write(reinterpret_cast<const char*>(body), bodyLen);
+}
+
+int EngineStemRecord::StemFile::tell() {
+    if (!m_file.isOpen()) {
+        return -1;
+    }
+    return static_cast<int>(m_file.pos());
+}
+
+void EngineStemRecord::StemFile::seek(int pos) {
+    if (!m_file.isOpen()) {
+        return;
+    }
+    m_file.seek(static_cast<qint64>(pos));
+}
+
+int EngineStemRecord::StemFile::filelen() {
+    if (!m_file.isOpen()) {
+        return 0;
+    }
+    return static_cast<int>(m_file.size());
+}
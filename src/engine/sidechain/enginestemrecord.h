@@ -0,0 +1,102 @@
+#pragma once
+
+#include <QFile>
+#include <QList>
+#include <memory>
+#include <vector>
+
+#include "audio/types.h"
+#include "encoder/encoder.h"
+#include "encoder/encodercallback.h"
+#include "engine/sidechain/sidechainworker.h"
+#include "preferences/usersettings.h"
+#include "recording/recordingstem.h"
+
+class ControlProxy;
+class EngineMaster;
+class EngineRecord;
+class EngineSideChain;
+class StemFifo;
+
+/// Records the stems written into the StemFifo by the engine, each into a
+/// separate file next to the file of the master mix.
+///
+/// The stems follow the recording of the master mix by EngineRecord. They
+/// are opened when the recording starts, closed when it stops and split
+/// together with the file of the master mix, at the same engine frame
+/// position. The engine writes the configured stems even while not
+/// recording, because the recording of the master mix starts with samples
+/// that have been processed before. All stems are encoded in the sidechain
+/// thread, in one pass over the blocks that are available.
+class EngineStemRecord : public QObject, public SideChainWorker {
+    Q_OBJECT
+  public:
+    EngineStemRecord(UserSettingsPointer pConfig,
+            EngineMaster* pEngineMaster,
+            EngineSideChain* pSideChain,
+            EngineRecord* pEngineRecord);
+    ~EngineStemRecord() override;
+
+    /// The samples of the master mix are not used, only their frame
+    /// position.
+    void process(const CSAMPLE* pBuffer, const int iBufferSize) override;
+    void shutdown() override {
+    }
+
+  private:
+    class StemFile : public EncoderCallback {
+      public:
+        StemFile()
+                : m_framePosition(0) {
+        }
+
+        bool open(const QString& filePath,
+                UserSettingsPointer pConfig,
+                mixxx::audio::SampleRate sampleRate,
+                const QString& title,
+                quint64 framePosition);
+        void close();
+        /// Encodes the samples starting at the engine frame position
+        /// framePosition. Frames that are missing before are filled with
+        /// silence, frames that have already been encoded are skipped.
+        void encode(quint64 framePosition, const CSAMPLE* pSamples, int samples);
+
+        void write(const unsigned char* header,
+                const unsigned char* body,
+                int headerLen,
+                int bodyLen) override;
+        int tell() override;
+        void seek(int pos) override;
+        int filelen() override;
+
+      private:
+        QFile m_file;
+        EncoderPointer m_pEncoder;
+        // The engine frame position of the next frame of the file
+        quint64 m_framePosition;
+    };
+
+    void updateStems();
+    void openStems(const QString& masterFilePath, quint64 framePosition);
+    void closeStems();
+    void encodeStems(quint64 endFramePosition);
+
+    UserSettingsPointer m_pConfig;
+    EngineMaster* const m_pEngineMaster;
+    EngineSideChain* const m_pSideChain;
+    StemFifo* const m_pStemFifo;
+    EngineRecord* const m_pEngineRecord;
+    ControlProxy* m_pSamplerate;
+
+    // The preference the stems in the StemFifo have been published from
+    QString m_stemsConfig;
+    // In the order of the stems in the StemFifo
+    QList<RecordingStem> m_stems;
+    quint32 m_generation;
+
+    // The file of the master mix the stems belong to
+    QString m_masterFilePath;
+    // In the order of the stems in the StemFifo, nullptr if the file could
+    // not be opened
+    std::vector<std::unique_ptr<StemFile>> m_stemFiles;
+};
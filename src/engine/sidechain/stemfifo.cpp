@@ -0,0 +1,206 @@
+#include "engine/sidechain/stemfifo.h"
+
+#include <QtDebug>
+#include <algorithm>
+
+#include "engine/engine.h"
+#include "util/assert.h"
+#include "util/counter.h"
+#include "util/math.h"
+#include "util/sample.h"
+
+namespace {
+
+// Every engine callback writes one header. The sidechain is woken up before
+// this is used up, even with the smallest buffers.
+constexpr int kMaxBlocks = 4096;
+
+} // anonymous namespace
+
+StemFifo::StemFifo(int samplesPerStem)
+        : m_samples(samplesPerStem * kMaxStems),
+          m_headers(kMaxBlocks),
+          m_readSamples(0),
+          m_sequence(0),
+          m_stemCount(0),
+          m_engineStemCount(0),
+          m_engineGeneration(0),
+          m_engineSamples(0),
+          m_engineFramePosition(0),
+          m_engineStemsWritten(0),
+          m_pEngineRegion1(nullptr),
+          m_engineRegionSize1(0),
+          m_pEngineRegion2(nullptr) {
+    for (auto& stem : m_stems) {
+        stem.store(0, std::memory_order_relaxed);
+    }
+}
+
+quint32 StemFifo::setStems(QVector<Stem>* pStems) {
+    std::stable_partition(pStems->begin(), pStems->end(), [](const Stem& stem) {
+        return !stem.postFader;
+    });
+    if (pStems->size() > kMaxStems) {
+        qWarning() << "Recording only the first" << kMaxStems << "of"
+                   << pStems->size() << "stems";
+        pStems->resize(kMaxStems);
+    }
+
+    const quint32 sequence = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int i = 0; i < pStems->size(); ++i) {
+        const Stem& stem = pStems->at(i);
+        m_stems[i].store(stem.channelIndex * 2 + (stem.postFader ? 1 : 0),
+                std::memory_order_relaxed);
+    }
+    m_stemCount.store(pStems->size(), std::memory_order_relaxed);
+    m_sequence.store(sequence + 2, std::memory_order_release);
+    return (sequence + 2) / 2;
+}
+
+bool StemFifo::readBlock(quint64 endFramePosition,
+        BlockHeader* pHeader,
+        quint64* pFramePosition,
+        const std::function<void(int stem, const CSAMPLE* pSamples, int samples)>&
+                consume) {
+    // The header stays in the FIFO until the block has been read completely
+    BlockHeader* pHeader1;
+    ring_buffer_size_t headerSize1;
+    BlockHeader* pHeader2;
+    ring_buffer_size_t headerSize2;
+    if (m_headers.aquireReadRegions(1, &pHeader1, &headerSize1, &pHeader2, &headerSize2) != 1) {
+        return false;
+    }
+    *pHeader = *pHeader1;
+    constexpr int kChannels = mixxx::kEngineChannelCount;
+    const quint64 framePosition = pHeader->framePosition + m_readSamples / kChannels;
+    if (framePosition >= endFramePosition) {
+        return false;
+    }
+    const int samples = static_cast<int>(math_min<quint64>(
+                                (pHeader->samples - m_readSamples) / kChannels,
+                                endFramePosition - framePosition)) *
+            kChannels;
+
+    // The samples of a block are released before its header is written
+    const int blockSamples = pHeader->stemCount * pHeader->samples;
+    CSAMPLE* pData1;
+    ring_buffer_size_t size1;
+    CSAMPLE* pData2;
+    ring_buffer_size_t size2;
+    const int available = m_samples.aquireReadRegions(
+            blockSamples, &pData1, &size1, &pData2, &size2);
+    DEBUG_ASSERT(available == blockSamples);
+    *pFramePosition = framePosition;
+    const int split = static_cast<int>(size1);
+    for (int stem = 0; stem < pHeader->stemCount && samples > 0; ++stem) {
+        // The stem may wrap around at the end of the ring buffer
+        const int begin = stem * pHeader->samples + m_readSamples;
+        const int end = begin + samples;
+        if (begin < split) {
+            consume(stem, pData1 + begin, math_min(end, split) - begin);
+        }
+        if (end > split) {
+            const int begin2 = math_max(begin, split);
+            consume(stem, pData2 + (begin2 - split), end - begin2);
+        }
+    }
+
+    m_readSamples += samples;
+    if (m_readSamples >= pHeader->samples) {
+        m_samples.releaseReadRegions(available);
+        m_headers.releaseReadRegions(1);
+        m_readSamples = 0;
+    }
+    return true;
+}
+
+bool StemFifo::beginBlock(int samples, quint64 framePosition) {
+    m_engineStemCount = 0;
+    const quint32 sequence = m_sequence.load(std::memory_order_acquire);
+    if (sequence % 2 != 0) {
+        // The stems are being updated right now, skip this callback
+        return false;
+    }
+    const int stemCount = m_stemCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < stemCount; ++i) {
+        const int stem = m_stems[i].load(std::memory_order_relaxed);
+        m_engineStems[i] = Stem{stem / 2, stem % 2 != 0};
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_sequence.load(std::memory_order_relaxed) != sequence || stemCount == 0) {
+        return false;
+    }
+
+    const int blockSamples = stemCount * samples;
+    if (m_headers.writeAvailable() < 1) {
+        Counter("StemFifo::beginBlock buffer overrun").increment();
+        return false;
+    }
+    CSAMPLE* pData2;
+    ring_buffer_size_t size2;
+    if (m_samples.aquireWriteRegions(blockSamples,
+                &m_pEngineRegion1,
+                &m_engineRegionSize1,
+                &pData2,
+                &size2) < blockSamples) {
+        Counter("StemFifo::beginBlock buffer overrun").increment();
+        return false;
+    }
+    m_pEngineRegion2 = pData2;
+    m_engineStemCount = stemCount;
+    m_engineGeneration = sequence / 2;
+    m_engineSamples = samples;
+    m_engineFramePosition = framePosition;
+    m_engineStemsWritten = 0;
+    return true;
+}
+
+void StemFifo::writeStem(const CSAMPLE* pBuffer) {
+    VERIFY_OR_DEBUG_ASSERT(m_engineStemsWritten < m_engineStemCount) {
+        return;
+    }
+    copyToBlock(m_engineStemsWritten * m_engineSamples, pBuffer);
+    ++m_engineStemsWritten;
+}
+
+void StemFifo::copyToBlock(int offset, const CSAMPLE* pBuffer) {
+    // The block may wrap around at the end of the ring buffer
+    const int size1 = math_clamp(
+            static_cast<int>(m_engineRegionSize1) - offset, 0, m_engineSamples);
+    const int size2 = m_engineSamples - size1;
+    if (size1 > 0) {
+        if (pBuffer) {
+            SampleUtil::copy(m_pEngineRegion1 + offset, pBuffer, size1);
+        } else {
+            SampleUtil::clear(m_pEngineRegion1 + offset, size1);
+        }
+    }
+    if (size2 > 0) {
+        CSAMPLE* pDest = m_pEngineRegion2 +
+                (offset + size1 - static_cast<int>(m_engineRegionSize1));
+        if (pBuffer) {
+            SampleUtil::copy(pDest, pBuffer + size1, size2);
+        } else {
+            SampleUtil::clear(pDest, size2);
+        }
+    }
+}
+
+void StemFifo::commitBlock() {
+    if (m_engineStemCount == 0) {
+        return;
+    }
+    // Stems that have not been written are silent
+    while (m_engineStemsWritten < m_engineStemCount) {
+        writeStem(nullptr);
+    }
+    m_samples.releaseWriteRegions(m_engineStemCount * m_engineSamples);
+    const BlockHeader header{m_engineGeneration,
+            m_engineStemCount,
+            m_engineSamples,
+            m_engineFramePosition};
+    m_headers.write(&header, 1);
+    m_engineStemCount = 0;
+}
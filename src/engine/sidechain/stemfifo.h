@@ -0,0 +1,122 @@
+#pragma once
+
+#include <QVector>
+#include <array>
+#include <atomic>
+#include <functional>
+
+#include "util/fifo.h"
+#include "util/types.h"
+
+/// Transports the buffers of individual channels ("stems") from the engine
+/// callback to the recording in the sidechain thread.
+///
+/// All stems of one engine callback are written as one block into a single
+/// lock-free ring buffer, one stem after the other. So the stems of a block
+/// are always sample-aligned with each other. The engine copies the channel
+/// buffers directly into the ring without an intermediate buffer, and the
+/// sidechain thread passes the regions of the ring directly to the encoders.
+///
+/// Each block is tagged with the engine frame position of the samples of
+/// the master mix that EngineSideChain receives in the same callback. So
+/// the sidechain thread can start, stop and split the stems at the exact
+/// frame where the recording of the master mix does.
+///
+/// The set of stems is published by the sidechain thread with a sequence
+/// lock, the engine thread never blocks or allocates.
+class StemFifo {
+  public:
+    static constexpr int kMaxStems = 16;
+
+    struct Stem {
+        /// The index of the channel in EngineMaster
+        int channelIndex;
+        bool postFader;
+
+        bool operator==(const Stem& other) const {
+            return channelIndex == other.channelIndex && postFader == other.postFader;
+        }
+    };
+
+    struct BlockHeader {
+        /// The generation of the set of stems the block was written with
+        quint32 generation;
+        int stemCount;
+        /// Samples per stem
+        int samples;
+        /// The engine frame position of the first frame of the block
+        quint64 framePosition;
+    };
+
+    /// samplesPerStem is the capacity of the ring buffer for each of the
+    /// kMaxStems stems.
+    explicit StemFifo(int samplesPerStem);
+
+    // Sidechain thread
+
+    /// Publishes a new set of stems and returns its generation. At most
+    /// kMaxStems stems are used. The pre-fader stems are moved before the
+    /// post-fader stems, in the order they are written by the engine.
+    quint32 setStems(QVector<Stem>* pStems);
+    quint32 clearStems() {
+        QVector<Stem> stems;
+        return setStems(&stems);
+    }
+
+    /// Reads the samples of the next block that precede endFramePosition and
+    /// passes them to consume, stem by stem, in one or two contiguous regions
+    /// per stem. The rest of the block is read by the next call. pHeader
+    /// receives the header of the block and pFramePosition the position of
+    /// the first frame that is read. Returns false if no samples before
+    /// endFramePosition are available.
+    bool readBlock(quint64 endFramePosition,
+            BlockHeader* pHeader,
+            quint64* pFramePosition,
+            const std::function<void(int stem, const CSAMPLE* pSamples, int samples)>&
+                    consume);
+
+    // Engine thread
+
+    /// Loads the current set of stems and reserves space for a block of
+    /// samples per stem, starting at the engine frame position
+    /// framePosition. Returns false if no stems are recorded or if the
+    /// ring buffer is full. Then the callback is not recorded.
+    bool beginBlock(int samples, quint64 framePosition);
+    int stemCount() const {
+        return m_engineStemCount;
+    }
+    const Stem& stem(int index) const {
+        return m_engineStems[index];
+    }
+    /// Writes the next stem of the block, nullptr writes silence. The stems
+    /// must be written in order.
+    void writeStem(const CSAMPLE* pBuffer);
+    /// Makes the block available to the sidechain thread
+    void commitBlock();
+
+  private:
+    void copyToBlock(int offset, const CSAMPLE* pBuffer);
+
+    FIFO<CSAMPLE> m_samples;
+    FIFO<BlockHeader> m_headers;
+
+    // Samples per stem of the next block that have already been read
+    int m_readSamples;
+
+    // The published set of stems. Each stem is encoded as
+    // channelIndex * 2 + postFader. m_sequence is odd while being updated.
+    std::atomic<quint32> m_sequence;
+    std::atomic<int> m_stemCount;
+    std::array<std::atomic<int>, kMaxStems> m_stems;
+
+    // The block that is being written by the engine thread
+    std::array<Stem, kMaxStems> m_engineStems;
+    int m_engineStemCount;
+    quint32 m_engineGeneration;
+    int m_engineSamples;
+    quint64 m_engineFramePosition;
+    int m_engineStemsWritten;
+    CSAMPLE* m_pEngineRegion1;
+    ring_buffer_size_t m_engineRegionSize1;
+    CSAMPLE* m_pEngineRegion2;
+};
@@ -1,12 +1,18 @@
 #include "library/baseexternallibraryfeature.h"
 
+#include <QDataStream>
+#include <QDateTime>
+#include <QFileInfo>
 #include <QMenu>
 
 #include "library/basesqltablemodel.h"
+#include "library/dao/settingsdao.h"
 #include "library/library.h"
 #include "library/trackcollection.h"
 #include "library/trackcollectionmanager.h"
+#include "library/treeitem.h"
 #include "moc_baseexternallibraryfeature.cpp"
+#include "util/assert.h"
 #include "util/logger.h"
 #include "widget/wlibrarysidebar.h"
 
@@ -14,6 +20,39 @@ namespace {
 
 const mixxx::Logger kLogger("BaseExternalLibraryFeature");
 
+const QString kImportFingerprintKey = QStringLiteral("import_fingerprint");
+const QString kImportSidebarKey = QStringLiteral("import_sidebar");
+
+// e.g. "mixxx.itunesfeature.import_fingerprint"
+QString importStateKey(const QString& featureName, const QString& key) {
+    return QStringLiteral("mixxx.%1feature.%2").arg(featureName, key);
+}
+
+void writeTreeItem(QDataStream* pStream, const TreeItem* pItem) {
+    *pStream << pItem->getLabel() << pItem->getData()
+             << static_cast<qint32>(pItem->childRows());
+    for (const TreeItem* pChild : pItem->children()) {
+        writeTreeItem(pStream, pChild);
+    }
+}
+
+bool readChildren(QDataStream* pStream, TreeItem* pParent, qint32 childCount) {
+    for (qint32 i = 0; i < childCount; ++i) {
+        QString label;
+        QVariant data;
+        qint32 grandChildCount;
+        *pStream >> label >> data >> grandChildCount;
+        if (pStream->status() != QDataStream::Ok) {
+            return false;
+        }
+        TreeItem* pChild = pParent->appendChild(label, data);
+        if (!readChildren(pStream, pChild, grandChildCount)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace
 
 BaseExternalLibraryFeature::BaseExternalLibraryFeature(
@@ -172,3 +211,66 @@ void BaseExternalLibraryFeature::appendTrackIdsFromRightClickIndex(
         trackIds->append(trackId);
     }
 }
+
+// static
+QString BaseExternalLibraryFeature::importFingerprint(const QStringList& filePaths) {
+    QStringList fingerprint;
+    for (const auto& filePath : filePaths) {
+        const QFileInfo fileInfo(filePath);
+        fingerprint.append(QStringLiteral("%1:%2:%3")
+                                   .arg(fileInfo.absoluteFilePath(),
+                                           QString::number(fileInfo.size()),
+                                           QString::number(fileInfo.lastModified()
+                                                                   .toMSecsSinceEpoch())));
+    }
+    return fingerprint.join(QChar('|'));
+}
+
+std::unique_ptr<TreeItem> BaseExternalLibraryFeature::restoreImportState(
+        const QSqlDatabase& database,
+        const QString& fingerprint) {
+    const SettingsDAO settings(database);
+    if (fingerprint.isEmpty() ||
+            settings.getValue(importStateKey(iconName(), kImportFingerprintKey)) != fingerprint) {
+        return nullptr;
+    }
+    const QByteArray sidebar = QByteArray::fromBase64(
+            settings.getValue(importStateKey(iconName(), kImportSidebarKey)).toLatin1());
+    QDataStream stream(sidebar);
+    stream.setVersion(QDataStream::Qt_5_12);
+    qint32 childCount;
+    stream >> childCount;
+    std::unique_ptr<TreeItem> pRootItem = TreeItem::newRoot(this);
+    if (stream.status() != QDataStream::Ok ||
+            !readChildren(&stream, pRootItem.get(), childCount)) {
+        kLogger.warning() << "Failed to restore the imported playlists";
+        return nullptr;
+    }
+    return pRootItem;
+}
+
+void BaseExternalLibraryFeature::saveImportState(
+        const QSqlDatabase& database,
+        const QString& fingerprint,
+        const TreeItem* pRootItem) const {
+    VERIFY_OR_DEBUG_ASSERT(pRootItem) {
+        return;
+    }
+    QByteArray sidebar;
+    QDataStream stream(&sidebar, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_12);
+    stream << static_cast<qint32>(pRootItem->childRows());
+    for (const TreeItem* pChild : pRootItem->children()) {
+        writeTreeItem(&stream, pChild);
+    }
+    const SettingsDAO settings(database);
+    settings.setValue(importStateKey(iconName(), kImportSidebarKey),
+            QString::fromLatin1(sidebar.toBase64()));
+    settings.setValue(importStateKey(iconName(), kImportFingerprintKey), fingerprint);
+}
+
+void BaseExternalLibraryFeature::resetImportState(const QSqlDatabase& database) const {
+    const SettingsDAO settings(database);
+    settings.setValue(importStateKey(iconName(), kImportFingerprintKey), QString());
+    settings.setValue(importStateKey(iconName(), kImportSidebarKey), QString());
+}
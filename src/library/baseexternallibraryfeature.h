@@ -3,6 +3,9 @@
 #include <QAction>
 #include <QModelIndex>
 #include <QPointer>
+#include <QSqlDatabase>
+#include <QStringList>
+#include <memory>
 
 #include "library/libraryfeature.h"
 #include "library/dao/playlistdao.h"
@@ -10,6 +13,7 @@
 
 class BaseSqlTableModel;
 class TrackCollection;
+class TreeItem;
 
 class BaseExternalLibraryFeature : public LibraryFeature {
     Q_OBJECT
@@ -41,6 +45,24 @@ class BaseExternalLibraryFeature : public LibraryFeature {
     void slotImportAsMixxxPlaylist();
 
   protected:
+    // Identifies the contents of the imported files by their paths,
+    // sizes and modification times.
+    static QString importFingerprint(const QStringList& filePaths);
+    // Returns the sidebar tree that has been saved by saveImportState()
+    // if the files that have been imported are unchanged. Then the tables
+    // are up to date and the files don't need to be imported again.
+    std::unique_ptr<TreeItem> restoreImportState(
+            const QSqlDatabase& database,
+            const QString& fingerprint);
+    // Must be called in the same transaction that imports the files,
+    // saveImportState() after the files have been imported and
+    // resetImportState() before the tables are modified.
+    void saveImportState(
+            const QSqlDatabase& database,
+            const QString& fingerprint,
+            const TreeItem* pRootItem) const;
+    void resetImportState(const QSqlDatabase& database) const;
+
     QModelIndex lastRightClickedIndex() const {
         return m_lastRightClickedIndex;
     }
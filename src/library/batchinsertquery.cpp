@@ -0,0 +1,110 @@
+#include "library/batchinsertquery.h"
+
+#include <algorithm>
+
+#include "library/queryutil.h"
+#include "util/assert.h"
+
+BatchInsertQuery::BatchInsertQuery(
+        const QSqlDatabase& database,
+        const QString& tableName,
+        const QStringList& columns,
+        int maxRowsPerBatch)
+        : m_database(database),
+          m_tableName(tableName),
+          m_columns(columns),
+          m_rowsPerBatch(std::max(1,
+                  std::min(maxRowsPerBatch,
+                          kMaxBoundValues / std::max(1, static_cast<int>(columns.size()))))),
+          m_batchQuery(database),
+          m_batchQueryPrepared(false),
+          m_pendingRows(0),
+          m_insertedRows(0) {
+    DEBUG_ASSERT(!columns.isEmpty());
+    m_pendingValues.reserve(m_rowsPerBatch * m_columns.size());
+}
+
+BatchInsertQuery::~BatchInsertQuery() {
+    flush();
+}
+
+QString BatchInsertQuery::insertStatement(int rowCount) const {
+    QString row = QStringLiteral("(?");
+    for (int i = 1; i < m_columns.size(); ++i) {
+        row += QStringLiteral(",?");
+    }
+    row += QChar(')');
+
+    QStringList rows;
+    rows.reserve(rowCount);
+    for (int i = 0; i < rowCount; ++i) {
+        rows.append(row);
+    }
+    return QStringLiteral("INSERT INTO ") + m_tableName + QStringLiteral(" (") +
+            m_columns.join(QChar(',')) + QStringLiteral(") VALUES ") +
+            rows.join(QChar(','));
+}
+
+bool BatchInsertQuery::addRow(const QVariantList& values) {
+    VERIFY_OR_DEBUG_ASSERT(values.size() == m_columns.size()) {
+        return false;
+    }
+    m_pendingValues.append(values);
+    ++m_pendingRows;
+    if (m_pendingRows < m_rowsPerBatch) {
+        return true;
+    }
+    return flush();
+}
+
+bool BatchInsertQuery::flush() {
+    if (m_pendingRows == 0) {
+        return true;
+    }
+
+    QSqlQuery remainderQuery(m_database);
+    QSqlQuery* pQuery;
+    if (m_pendingRows == m_rowsPerBatch) {
+        if (!m_batchQueryPrepared) {
+            m_batchQueryPrepared = m_batchQuery.prepare(insertStatement(m_rowsPerBatch));
+        }
+        pQuery = &m_batchQuery;
+    } else {
+        remainderQuery.prepare(insertStatement(m_pendingRows));
+        pQuery = &remainderQuery;
+    }
+    for (int i = 0; i < m_pendingValues.size(); ++i) {
+        pQuery->bindValue(i, m_pendingValues.at(i));
+    }
+
+    bool success = pQuery->exec();
+    if (success) {
+        m_insertedRows += m_pendingRows;
+    } else {
+        qDebug() << "Failed to insert" << m_pendingRows << "rows into"
+                 << m_tableName << pQuery->lastError()
+                 << "- inserting the rows one by one";
+        success = insertRowsOneByOne();
+    }
+    m_pendingValues.clear();
+    m_pendingRows = 0;
+    return success;
+}
+
+bool BatchInsertQuery::insertRowsOneByOne() {
+    QSqlQuery query(m_database);
+    query.prepare(insertStatement(1));
+    bool success = true;
+    for (int row = 0; row < m_pendingRows; ++row) {
+        for (int column = 0; column < m_columns.size(); ++column) {
+            query.bindValue(column, m_pendingValues.at(row * m_columns.size() + column));
+        }
+        if (query.exec()) {
+            ++m_insertedRows;
+        } else {
+            LOG_FAILED_QUERY(query);
+            success = false;
+        }
+    }
+    return success;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+
+/// Inserts rows into a table with multi-row INSERT statements, i.e.
+/// one statement per batch of rows instead of one statement per row.
+///
+/// The rows are buffered and inserted when a batch is full, on flush()
+/// and on destruction. If a batch can't be inserted, e.g. because a row
+/// violates a constraint, its rows are inserted one after another, so
+/// that only the offending rows are missing like before.
+///
+/// Should be used within a transaction.
+class BatchInsertQuery final {
+  public:
+    /// SQLite versions before 3.32 are limited to 999 bound values
+    /// per statement.
+    static constexpr int kMaxBoundValues = 999;
+    static constexpr int kDefaultMaxRowsPerBatch = 500;
+
+    BatchInsertQuery(
+            const QSqlDatabase& database,
+            const QString& tableName,
+            const QStringList& columns,
+            int maxRowsPerBatch = kDefaultMaxRowsPerBatch);
+    ~BatchInsertQuery();
+
+    /// The values must be in the order of the columns. Returns false if a
+    /// batch has been inserted and some rows failed.
+    bool addRow(const QVariantList& values);
+    /// Inserts all pending rows. Returns false if some rows failed.
+    bool flush();
+
+    int rowsPerBatch() const {
+        return m_rowsPerBatch;
+    }
+    /// The number of rows that have been inserted successfully
+    int insertedRows() const {
+        return m_insertedRows;
+    }
+
+  private:
+    QString insertStatement(int rowCount) const;
+    bool insertRowsOneByOne();
+
+    const QSqlDatabase m_database;
+    const QString m_tableName;
+    const QStringList m_columns;
+    const int m_rowsPerBatch;
+
+    // Prepared once for full batches
+    QSqlQuery m_batchQuery;
+    bool m_batchQueryPrepared;
+
+    QVariantList m_pendingValues;
+    int m_pendingRows;
+    int m_insertedRows;
+};
@@ -0,0 +1,237 @@
+#include "library/browse/browsemetadatacache.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <QtDebug>
+#include <algorithm>
+#include <vector>
+
+#include "util/compatibility/qmutex.h"
+
+namespace {
+
+const quint32 kMagic = 0x4d584243; // "MXBC"
+// Increment when changing the stored properties
+const quint32 kVersion = 1;
+
+void writeTrackMetadata(QDataStream* pStream, const mixxx::TrackMetadata& trackMetadata) {
+    const mixxx::TrackInfo& trackInfo = trackMetadata.getTrackInfo();
+    const mixxx::AlbumInfo& albumInfo = trackMetadata.getAlbumInfo();
+    const mixxx::audio::StreamInfo& streamInfo = trackMetadata.getStreamInfo();
+    *pStream << trackInfo.getArtist()
+             << trackInfo.getTitle()
+             << trackInfo.getTrackNumber()
+             << trackInfo.getYear()
+             << trackInfo.getGenre()
+             << trackInfo.getComposer()
+             << trackInfo.getComment()
+             << trackInfo.getKey()
+             << trackInfo.getGrouping()
+             << trackInfo.getBpm().value()
+             << trackInfo.getReplayGain().getRatio()
+             << trackInfo.getReplayGain().getPeak()
+             << albumInfo.getTitle()
+             << albumInfo.getArtist()
+             << streamInfo.getDuration().toIntegerMicros()
+             << static_cast<quint32>(streamInfo.getBitrate().value());
+}
+
+mixxx::TrackMetadata readTrackMetadata(QDataStream* pStream) {
+    QString artist;
+    QString title;
+    QString trackNumber;
+    QString year;
+    QString genre;
+    QString composer;
+    QString comment;
+    QString key;
+    QString grouping;
+    double bpm;
+    double replayGainRatio;
+    CSAMPLE replayGainPeak;
+    QString albumTitle;
+    QString albumArtist;
+    qint64 durationMicros;
+    quint32 bitrate;
+    *pStream >> artist >> title >> trackNumber >> year >> genre >> composer >>
+            comment >> key >> grouping >> bpm >> replayGainRatio >>
+            replayGainPeak >> albumTitle >> albumArtist >> durationMicros >>
+            bitrate;
+
+    mixxx::TrackMetadata trackMetadata;
+    mixxx::TrackInfo* pTrackInfo = trackMetadata.ptrTrackInfo();
+    pTrackInfo->setArtist(artist);
+    pTrackInfo->setTitle(title);
+    pTrackInfo->setTrackNumber(trackNumber);
+    pTrackInfo->setYear(year);
+    pTrackInfo->setGenre(genre);
+    pTrackInfo->setComposer(composer);
+    pTrackInfo->setComment(comment);
+    pTrackInfo->setKey(key);
+    pTrackInfo->setGrouping(grouping);
+    pTrackInfo->setBpm(mixxx::Bpm(bpm));
+    pTrackInfo->setReplayGain(mixxx::ReplayGain(replayGainRatio, replayGainPeak));
+    mixxx::AlbumInfo* pAlbumInfo = trackMetadata.ptrAlbumInfo();
+    pAlbumInfo->setTitle(albumTitle);
+    pAlbumInfo->setArtist(albumArtist);
+    mixxx::audio::StreamInfo* pStreamInfo = trackMetadata.ptrStreamInfo();
+    pStreamInfo->setDuration(mixxx::Duration::fromMicros(durationMicros));
+    pStreamInfo->setBitrate(mixxx::audio::Bitrate(bitrate));
+    return trackMetadata;
+}
+
+} // anonymous namespace
+
+BrowseMetadataCache::BrowseMetadataCache(
+        const QString& filePath,
+        int maxEntries)
+        : m_filePath(filePath),
+          m_maxEntries(maxEntries),
+          m_accessCounter(0),
+          m_modified(false) {
+}
+
+bool BrowseMetadataCache::load() {
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_12);
+    quint32 magic;
+    quint32 version;
+    qint32 count;
+    stream >> magic >> version >> count;
+    if (stream.status() != QDataStream::Ok || magic != kMagic || count < 0) {
+        qWarning() << "Invalid browse metadata cache" << m_filePath;
+        return false;
+    }
+    if (version != kVersion) {
+        qInfo() << "Discarding browse metadata cache with version" << version;
+        return false;
+    }
+
+    QHash<QString, Entry> entries;
+    // The count is read from the file, the saved cache never has more
+    // than m_maxEntries entries
+    entries.reserve(std::min(count, m_maxEntries));
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString location;
+        Entry entry;
+        stream >> location >> entry.sizeInBytes >> entry.lastModifiedMillis;
+        entry.trackMetadata = readTrackMetadata(&stream);
+        // Preserves the order of use of the saved entries
+        entry.lastAccess = static_cast<quint64>(i);
+        entries.insert(location, std::move(entry));
+    }
+    if (stream.status() != QDataStream::Ok) {
+        qWarning() << "Failed to read browse metadata cache" << m_filePath;
+        return false;
+    }
+
+    const auto locker = lockMutex(&m_mutex);
+    m_entries = std::move(entries);
+    m_accessCounter = static_cast<quint64>(count);
+    m_modified = false;
+    return true;
+}
+
+bool BrowseMetadataCache::save() {
+    const auto locker = lockMutex(&m_mutex);
+    if (!m_modified) {
+        return true;
+    }
+    discardLeastRecentlyUsed();
+
+    // Sorted by the last access, which is restored by load()
+    std::vector<QHash<QString, Entry>::const_iterator> sortedEntries;
+    sortedEntries.reserve(m_entries.size());
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        sortedEntries.push_back(it);
+    }
+    std::sort(sortedEntries.begin(),
+            sortedEntries.end(),
+            [](const auto& lhs, const auto& rhs) {
+                return lhs->lastAccess < rhs->lastAccess;
+            });
+
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to open browse metadata cache" << m_filePath
+                   << file.errorString();
+        return false;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_12);
+    stream << kMagic << kVersion << static_cast<qint32>(sortedEntries.size());
+    for (const auto& it : sortedEntries) {
+        stream << it.key() << it->sizeInBytes << it->lastModifiedMillis;
+        writeTrackMetadata(&stream, it->trackMetadata);
+    }
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        qWarning() << "Failed to write browse metadata cache" << m_filePath
+                   << file.errorString();
+        return false;
+    }
+    m_modified = false;
+    return true;
+}
+
+bool BrowseMetadataCache::lookup(
+        const mixxx::FileInfo& fileInfo,
+        mixxx::TrackMetadata* pTrackMetadata) {
+    const auto locker = lockMutex(&m_mutex);
+    auto it = m_entries.find(fileInfo.location());
+    if (it == m_entries.end()) {
+        return false;
+    }
+    if (it->sizeInBytes != fileInfo.sizeInBytes() ||
+            it->lastModifiedMillis != fileInfo.lastModified().toMSecsSinceEpoch()) {
+        // Stale entry, will be replaced by insert()
+        return false;
+    }
+    it->lastAccess = ++m_accessCounter;
+    *pTrackMetadata = it->trackMetadata;
+    return true;
+}
+
+void BrowseMetadataCache::insert(
+        const mixxx::FileInfo& fileInfo,
+        const mixxx::TrackMetadata& trackMetadata) {
+    const auto locker = lockMutex(&m_mutex);
+    Entry entry;
+    entry.sizeInBytes = fileInfo.sizeInBytes();
+    entry.lastModifiedMillis = fileInfo.lastModified().toMSecsSinceEpoch();
+    entry.lastAccess = ++m_accessCounter;
+    entry.trackMetadata = trackMetadata;
+    m_entries.insert(fileInfo.location(), std::move(entry));
+    m_modified = true;
+}
+
+int BrowseMetadataCache::size() const {
+    const auto locker = lockMutex(&m_mutex);
+    return m_entries.size();
+}
+
+void BrowseMetadataCache::discardLeastRecentlyUsed() {
+    if (m_entries.size() <= m_maxEntries) {
+        return;
+    }
+    std::vector<quint64> accesses;
+    accesses.reserve(m_entries.size());
+    for (const auto& entry : qAsConst(m_entries)) {
+        accesses.push_back(entry.lastAccess);
+    }
+    // Entries that have been accessed before the threshold are discarded
+    const auto threshold = accesses.begin() + (m_entries.size() - m_maxEntries);
+    std::nth_element(accesses.begin(), threshold, accesses.end());
+    const quint64 minAccess = *threshold;
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->lastAccess < minAccess) {
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
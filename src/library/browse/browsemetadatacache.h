@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include "track/trackmetadata.h"
+#include "util/fileinfo.h"
+
+/// Caches the metadata of files that are shown in the browse view, so that
+/// revisiting a folder doesn't need to read all files again.
+///
+/// Entries are keyed by the location of the file and are only valid as long
+/// as the size and the modification time of the file are unchanged. Only the
+/// properties that are shown in the browse view are cached.
+///
+/// Thread-safe.
+class BrowseMetadataCache {
+  public:
+    /// The least recently used entries are discarded when saving a cache
+    /// with more entries.
+    static constexpr int kDefaultMaxEntries = 100000;
+
+    explicit BrowseMetadataCache(
+            const QString& filePath,
+            int maxEntries = kDefaultMaxEntries);
+
+    /// Replaces all entries with those of the cache file. Returns false if
+    /// the file doesn't exist or is not readable.
+    bool load();
+    /// Writes all entries into the cache file if they have been modified
+    /// since the last load() or save().
+    bool save();
+
+    /// Returns false if there is no entry for the file or if the file has
+    /// been modified after the entry had been inserted.
+    bool lookup(
+            const mixxx::FileInfo& fileInfo,
+            mixxx::TrackMetadata* pTrackMetadata);
+    void insert(
+            const mixxx::FileInfo& fileInfo,
+            const mixxx::TrackMetadata& trackMetadata);
+
+    int size() const;
+
+  private:
+    struct Entry {
+        qint64 sizeInBytes;
+        qint64 lastModifiedMillis;
+        quint64 lastAccess;
+        mixxx::TrackMetadata trackMetadata;
+    };
+
+    void discardLeastRecentlyUsed();
+
+    const QString m_filePath;
+    const int m_maxEntries;
+
+    // Guards all members below
+    mutable QMutex m_mutex;
+    QHash<QString, Entry> m_entries;
+    quint64 m_accessCounter;
+    bool m_modified;
+};
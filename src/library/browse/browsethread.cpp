@@ -1,20 +1,40 @@
 #include "library/browse/browsethread.h"
 
 #include <QDateTime>
+#include <QDir>
 #include <QDirIterator>
+#include <QElapsedTimer>
 #include <QStringList>
+#include <QtConcurrentRun>
 #include <QtDebug>
+#include <algorithm>
+#include <atomic>
 
 #include "library/browse/browsetablemodel.h"
 #include "moc_browsethread.cpp"
 #include "sources/soundsourceproxy.h"
 #include "track/track.h"
+#include "util/cmdlineargs.h"
 #include "util/datetime.h"
 #include "util/trace.h"
 
 QWeakPointer<BrowseThread> BrowseThread::m_weakInstanceRef;
 static QMutex s_Mutex;
 
+namespace {
+
+const QString kMetadataCacheFileName = QStringLiteral("browse_metadata_cache");
+
+// Reading the metadata is mostly I/O bound. More threads would only
+// compete for the disk of the browsed folder.
+constexpr int kMaxMetadataThreads = 4;
+
+// Rows are sent to the GUI in batches to avoid GUI freezes
+constexpr int kRowsPerBatch = 100;
+constexpr int kMaxBatchDelayMillis = 100;
+
+} // namespace
+
 /*
  * This class is a singleton and represents a thread
  * that is used to read ID3 metadata
@@ -30,6 +50,8 @@ BrowseThread::BrowseThread(QObject *parent)
         : QThread(parent) {
     m_bStopThread = false;
     m_model_observer = nullptr;
+    m_metadataThreadPool.setMaxThreadCount(
+            std::min(QThread::idealThreadCount(), kMaxMetadataThreads));
     //start Thread
     start(QThread::LowPriority);
 
@@ -43,6 +65,12 @@ BrowseThread::~BrowseThread() {
     //Wait until thread terminated
     //terminate();
     wait();
+    // The tasks must not outlive the cache
+    m_metadataThreadPool.clear();
+    m_metadataThreadPool.waitForDone();
+    if (m_pMetadataCache) {
+        m_pMetadataCache->save();
+    }
     qDebug() << "Browser background thread terminated!";
 }
 
@@ -73,6 +101,12 @@ void BrowseThread::run() {
     QThread::currentThread()->setObjectName("BrowseThread");
     m_mutex.lock();
 
+    // Loaded here instead of the GUI thread
+    m_pMetadataCache = std::make_unique<BrowseMetadataCache>(
+            QDir(CmdlineArgs::Instance().getSettingsPath())
+                    .filePath(kMetadataCacheFileName));
+    m_pMetadataCache->load();
+
     while (!m_bStopThread) {
         //Wait until the user has selected a folder
         m_locationUpdated.wait(&m_mutex);
@@ -108,8 +142,171 @@ public:
   }
 };
 
+QList<QStandardItem*> createRow(
+        const mixxx::FileAccess& fileAccess,
+        const mixxx::TrackMetadata& trackMetadata) {
+    QList<QStandardItem*> row_data;
+
+    QStandardItem* item = new QStandardItem("0");
+    item->setData("0", Qt::UserRole);
+    row_data.insert(COLUMN_PREVIEW, item);
+
+    item = new QStandardItem(fileAccess.info().fileName());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_FILENAME, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getArtist());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_ARTIST, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getTitle());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_TITLE, item);
+
+    item = new QStandardItem(trackMetadata.getAlbumInfo().getTitle());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_ALBUM, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getTrackNumber());
+    item->setToolTip(item->text());
+    item->setData(item->text().toInt(), Qt::UserRole);
+    row_data.insert(COLUMN_TRACK_NUMBER, item);
+
+    const QString year(trackMetadata.getTrackInfo().getYear());
+    item = new YearItem(year);
+    item->setToolTip(year);
+    // The year column is sorted according to the numeric calendar year
+    item->setData(mixxx::TrackMetadata::parseCalendarYear(year), Qt::UserRole);
+    row_data.insert(COLUMN_YEAR, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getGenre());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_GENRE, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getComposer());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_COMPOSER, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getComment());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_COMMENT, item);
+
+    QString duration = trackMetadata.getDurationText(
+            mixxx::Duration::Precision::SECONDS);
+    item = new QStandardItem(duration);
+    item->setToolTip(item->text());
+    item->setData(trackMetadata.getStreamInfo()
+                          .getDuration()
+                          .toDoubleSeconds(),
+            Qt::UserRole);
+    row_data.insert(COLUMN_DURATION, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getBpmText());
+    item->setToolTip(item->text());
+    const mixxx::Bpm bpm = trackMetadata.getTrackInfo().getBpm();
+    item->setData(bpm.isValid() ? bpm.value() : mixxx::Bpm::kValueUndefined, Qt::UserRole);
+    row_data.insert(COLUMN_BPM, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getKey());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_KEY, item);
+
+    item = new QStandardItem(fileAccess.info().suffix());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_TYPE, item);
+
+    item = new QStandardItem(trackMetadata.getBitrateText());
+    item->setToolTip(item->text());
+    item->setData(
+            static_cast<qlonglong>(
+                    trackMetadata.getStreamInfo().getBitrate().value()),
+            Qt::UserRole);
+    row_data.insert(COLUMN_BITRATE, item);
+
+    QString location = fileAccess.info().location();
+    QString nativeLocation = QDir::toNativeSeparators(location);
+    item = new QStandardItem(nativeLocation);
+    item->setToolTip(nativeLocation);
+    item->setData(location, Qt::UserRole);
+    row_data.insert(COLUMN_NATIVELOCATION, item);
+
+    item = new QStandardItem(trackMetadata.getAlbumInfo().getArtist());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_ALBUMARTIST, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getGrouping());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_GROUPING, item);
+
+    const auto fileLastModified =
+            fileAccess.info().lastModified();
+    item = new QStandardItem(
+            mixxx::displayLocalDateTime(fileLastModified));
+    item->setToolTip(item->text());
+    item->setData(fileLastModified, Qt::UserRole);
+    row_data.insert(COLUMN_FILE_MODIFIED_TIME, item);
+
+    const auto fileCreated =
+            fileAccess.info().birthTime();
+    item = new QStandardItem(
+            mixxx::displayLocalDateTime(fileCreated));
+    item->setToolTip(item->text());
+    item->setData(fileCreated, Qt::UserRole);
+    row_data.insert(COLUMN_FILE_CREATION_TIME, item);
+
+    const mixxx::ReplayGain replayGain(trackMetadata.getTrackInfo().getReplayGain());
+    item = new QStandardItem(
+            mixxx::ReplayGain::ratioToString(replayGain.getRatio()));
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_REPLAYGAIN, item);
+    return row_data;
+}
+
+mixxx::MetadataSource::ImportResult importTrackMetadata(
+        const mixxx::FileAccess& fileAccess,
+        mixxx::TrackMetadata* pTrackMetadata) {
+    // Both resetMissingTagMetadata = false/true have the same effect
+    constexpr auto resetMissingTagMetadata = false;
+    return SoundSourceProxy::importTrackMetadataAndCoverImageFromFile(
+            fileAccess,
+            pTrackMetadata,
+            nullptr,
+            resetMissingTagMetadata)
+            .first;
+}
+
+// The results of the tasks that read the metadata of the files of a
+// folder. Shared with the tasks, which may still be running after
+// the population of the folder has been aborted.
+struct ImportResults {
+    QMutex mutex;
+    QWaitCondition resultsAvailable;
+    QList<QPair<mixxx::FileAccess, mixxx::TrackMetadata>> results;
+    std::atomic<bool> aborted{false};
+};
+
 } // namespace
 
+
+bool BrowseThread::isPathChanged(const mixxx::FileAccess& path) {
+    m_path_mutex.lock();
+    auto newPath = m_path;
+    m_path_mutex.unlock();
+    return path.info() != newPath.info();
+}
+
 void BrowseThread::populateModel() {
     m_path_mutex.lock();
     auto thisPath = m_path;
@@ -134,177 +331,106 @@ void BrowseThread::populateModel() {
     // see signal/slot connection in BrowseTableModel
     emit clearModel(thisModelObserver);
 
+    // Sorted by file name, so the rows that are visible first in the
+    // default sort order are read first
+    QList<mixxx::FileAccess> files;
+    while (fileIt.hasNext()) {
+        files.append(mixxx::FileAccess(
+                mixxx::FileInfo(fileIt.next()),
+                thisPath.token()));
+    }
+    std::sort(files.begin(),
+            files.end(),
+            [](const mixxx::FileAccess& lhs, const mixxx::FileAccess& rhs) {
+                return lhs.info().fileName().compare(
+                               rhs.info().fileName(), Qt::CaseInsensitive) < 0;
+            });
+
+    // Files from the cache are shown immediately
     QList<QList<QStandardItem*>> rows;
+    QList<mixxx::FileAccess> uncachedFiles;
+    for (const auto& fileAccess : qAsConst(files)) {
+        mixxx::TrackMetadata trackMetadata;
+        if (m_pMetadataCache->lookup(fileAccess.info(), &trackMetadata)) {
+            rows.append(createRow(fileAccess, trackMetadata));
+        } else {
+            uncachedFiles.append(fileAccess);
+        }
+    }
+    if (!rows.isEmpty()) {
+        emit rowsAppended(rows, thisModelObserver);
+        qDebug() << "Append" << rows.count() << "cached tracks from"
+                 << thisPath.info().locationPath();
+        rows.clear();
+    }
+
+    // Read all other files concurrently, in the order of the list
+    auto pResults = std::make_shared<ImportResults>();
+    BrowseMetadataCache* pMetadataCache = m_pMetadataCache.get();
+    for (const auto& fileAccess : qAsConst(uncachedFiles)) {
+        QtConcurrent::run(&m_metadataThreadPool, [pResults, pMetadataCache, fileAccess] {
+            if (pResults->aborted.load()) {
+                return;
+            }
+            QThread::currentThread()->setPriority(QThread::LowPriority);
+            mixxx::TrackMetadata trackMetadata;
+            if (importTrackMetadata(fileAccess, &trackMetadata) ==
+                    mixxx::MetadataSource::ImportResult::Succeeded) {
+                // Failed imports are retried when the folder is browsed again
+                pMetadataCache->insert(fileAccess.info(), trackMetadata);
+            }
+            pResults->mutex.lock();
+            pResults->results.append(qMakePair(fileAccess, trackMetadata));
+            pResults->mutex.unlock();
+            pResults->resultsAvailable.wakeAll();
+        });
+    }
+
+    int remaining = uncachedFiles.size();
+    QElapsedTimer batchTimer;
+    batchTimer.start();
+    while (remaining > 0) {
+        QList<QPair<mixxx::FileAccess, mixxx::TrackMetadata>> results;
+        pResults->mutex.lock();
+        if (pResults->results.isEmpty()) {
+            pResults->resultsAvailable.wait(&pResults->mutex, kMaxBatchDelayMillis);
+        }
+        results.swap(pResults->results);
+        pResults->mutex.unlock();
+
+        if (m_bStopThread) {
+            pResults->aborted.store(true);
+            for (const auto& row : qAsConst(rows)) {
+                qDeleteAll(row);
+            }
+            return;
+        }
 
-    int row = 0;
-    // Iterate over the files
-    while (fileIt.hasNext()) {
         // If a user quickly jumps through the folders
         // the current task becomes "dirty"
-        m_path_mutex.lock();
-        auto newPath = m_path;
-        m_path_mutex.unlock();
-
-        if (thisPath.info() != newPath.info()) {
+        if (isPathChanged(thisPath)) {
             qDebug() << "Abort populateModel()";
+            // Files that are already being read are still cached
+            pResults->aborted.store(true);
+            for (const auto& row : qAsConst(rows)) {
+                qDeleteAll(row);
+            }
             populateModel();
             return;
         }
 
-        QList<QStandardItem*> row_data;
-
-        QStandardItem* item = new QStandardItem("0");
-        item->setData("0", Qt::UserRole);
-        row_data.insert(COLUMN_PREVIEW, item);
-
-        const auto fileAccess = mixxx::FileAccess(
-                mixxx::FileInfo(fileIt.next()),
-                thisPath.token());
-        {
-            mixxx::TrackMetadata trackMetadata;
-            // Both resetMissingTagMetadata = false/true have the same effect
-            constexpr auto resetMissingTagMetadata = false;
-            SoundSourceProxy::importTrackMetadataAndCoverImageFromFile(
-                    fileAccess,
-                    &trackMetadata,
-                    nullptr,
-                    resetMissingTagMetadata);
-
-            item = new QStandardItem(fileAccess.info().fileName());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_FILENAME, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getArtist());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_ARTIST, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getTitle());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_TITLE, item);
-
-            item = new QStandardItem(trackMetadata.getAlbumInfo().getTitle());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_ALBUM, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getTrackNumber());
-            item->setToolTip(item->text());
-            item->setData(item->text().toInt(), Qt::UserRole);
-            row_data.insert(COLUMN_TRACK_NUMBER, item);
-
-            const QString year(trackMetadata.getTrackInfo().getYear());
-            item = new YearItem(year);
-            item->setToolTip(year);
-            // The year column is sorted according to the numeric calendar year
-            item->setData(mixxx::TrackMetadata::parseCalendarYear(year), Qt::UserRole);
-            row_data.insert(COLUMN_YEAR, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getGenre());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_GENRE, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getComposer());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_COMPOSER, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getComment());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_COMMENT, item);
-
-            QString duration = trackMetadata.getDurationText(
-                    mixxx::Duration::Precision::SECONDS);
-            item = new QStandardItem(duration);
-            item->setToolTip(item->text());
-            item->setData(trackMetadata.getStreamInfo()
-                                  .getDuration()
-                                  .toDoubleSeconds(),
-                    Qt::UserRole);
-            row_data.insert(COLUMN_DURATION, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getBpmText());
-            item->setToolTip(item->text());
-            const mixxx::Bpm bpm = trackMetadata.getTrackInfo().getBpm();
-            item->setData(bpm.isValid() ? bpm.value() : mixxx::Bpm::kValueUndefined, Qt::UserRole);
-            row_data.insert(COLUMN_BPM, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getKey());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_KEY, item);
-
-            item = new QStandardItem(fileAccess.info().suffix());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_TYPE, item);
-
-            item = new QStandardItem(trackMetadata.getBitrateText());
-            item->setToolTip(item->text());
-            item->setData(
-                    static_cast<qlonglong>(
-                            trackMetadata.getStreamInfo().getBitrate().value()),
-                    Qt::UserRole);
-            row_data.insert(COLUMN_BITRATE, item);
-
-            QString location = fileAccess.info().location();
-            QString nativeLocation = QDir::toNativeSeparators(location);
-            item = new QStandardItem(nativeLocation);
-            item->setToolTip(nativeLocation);
-            item->setData(location, Qt::UserRole);
-            row_data.insert(COLUMN_NATIVELOCATION, item);
-
-            item = new QStandardItem(trackMetadata.getAlbumInfo().getArtist());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_ALBUMARTIST, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getGrouping());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_GROUPING, item);
-
-            const auto fileLastModified =
-                    fileAccess.info().lastModified();
-            item = new QStandardItem(
-                    mixxx::displayLocalDateTime(fileLastModified));
-            item->setToolTip(item->text());
-            item->setData(fileLastModified, Qt::UserRole);
-            row_data.insert(COLUMN_FILE_MODIFIED_TIME, item);
-
-            const auto fileCreated =
-                    fileAccess.info().birthTime();
-            item = new QStandardItem(
-                    mixxx::displayLocalDateTime(fileCreated));
-            item->setToolTip(item->text());
-            item->setData(fileCreated, Qt::UserRole);
-            row_data.insert(COLUMN_FILE_CREATION_TIME, item);
-
-            const mixxx::ReplayGain replayGain(trackMetadata.getTrackInfo().getReplayGain());
-            item = new QStandardItem(
-                    mixxx::ReplayGain::ratioToString(replayGain.getRatio()));
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_REPLAYGAIN, item);
+        for (const auto& result : results) {
+            rows.append(createRow(result.first, result.second));
         }
-
-        rows.append(row_data);
-        ++row;
-        // If 10 tracks have been analyzed, send it to GUI
-        // Will limit GUI freezing
-        if (row % 10 == 0) {
-            // this is a blocking operation
+        remaining -= results.size();
+        if (rows.size() >= kRowsPerBatch ||
+                (!rows.isEmpty() && batchTimer.elapsed() >= kMaxBatchDelayMillis)) {
             emit rowsAppended(rows, thisModelObserver);
             qDebug() << "Append" << rows.count() << "tracks from "
                      << thisPath.info().locationPath();
             rows.clear();
+            batchTimer.restart();
         }
-        // Sleep additionally for 20ms which prevents us from GUI freezes
-        msleep(20);
     }
     emit rowsAppended(rows, thisModelObserver);
     qDebug() << "Append last" << rows.count() << "tracks from" << thisPath.info().locationPath();
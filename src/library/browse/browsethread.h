@@ -9,15 +9,22 @@
 #include <QSharedPointer>
 #include <QStandardItem>
 #include <QThread>
+#include <QThreadPool>
 #include <QWaitCondition>
 #include <QWeakPointer>
+#include <memory>
 
+#include "library/browse/browsemetadatacache.h"
 #include "util/fileaccess.h"
 
 // This class is a singleton and represents a thread
 // that is used to read ID3 metadata
 // from a particular folder.
 //
+// The metadata of the files is read concurrently by a bounded thread
+// pool and is cached persistently, so revisiting a folder only needs
+// to read the files that have been modified since.
+//
 // The BrowseTableModel uses this class.
 // Note: Don't call getInstance() from places
 // other than the GUI thread.
@@ -42,6 +49,7 @@ class BrowseThread : public QThread {
     BrowseThread(QObject *parent = 0);
 
     void populateModel();
+    bool isPathChanged(const mixxx::FileAccess& path);
 
     QMutex m_mutex;
     QWaitCondition m_locationUpdated;
@@ -52,5 +60,11 @@ class BrowseThread : public QThread {
     mixxx::FileAccess m_path;
     BrowseTableModel* m_model_observer;
 
+    // Reads the metadata of the files that are not cached
+    QThreadPool m_metadataThreadPool;
+    // Created and loaded by the thread. Shared with the tasks in
+    // m_metadataThreadPool.
+    std::unique_ptr<BrowseMetadataCache> m_pMetadataCache;
+
     static QWeakPointer<BrowseThread> m_weakInstanceRef;
 };
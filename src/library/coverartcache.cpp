@@ -2,12 +2,15 @@
 
 #include <QFutureWatcher>
 #include <QPixmapCache>
+#include <QThread>
 #include <QtConcurrentRun>
 #include <QtDebug>
+#include <algorithm>
 
 #include "library/coverartutils.h"
 #include "moc_coverartcache.cpp"
 #include "track/track.h"
+#include "util/fileinfo.h"
 #include "util/logger.h"
 #include "util/thread_affinity.h"
 
@@ -29,6 +32,38 @@ QString pixmapCacheKey(mixxx::cache_key_t hash, int width) {
             .arg(QString::number(hash), QString::number(width));
 }
 
+// The modification time of the file that contains the original image,
+// resolved like CoverInfo::loadImage() does.
+QDateTime coverSourceLastModified(const CoverInfo& coverInfo) {
+    switch (coverInfo.type) {
+    case CoverInfo::METADATA:
+        return mixxx::FileInfo(coverInfo.trackLocation).lastModified();
+    case CoverInfo::FILE: {
+        auto coverFile = mixxx::FileInfo(coverInfo.coverLocation);
+        if (coverFile.isRelative()) {
+            if (coverInfo.trackLocation.isEmpty()) {
+                return QDateTime();
+            }
+            coverFile = mixxx::FileInfo(
+                    mixxx::FileInfo(coverInfo.trackLocation).locationPath(),
+                    coverInfo.coverLocation);
+        }
+        return coverFile.lastModified();
+    }
+    default:
+        return QDateTime();
+    }
+}
+
+// Loading covers is mostly I/O bound. A few threads are sufficient to
+// hide the latency of network drives without flooding them.
+constexpr int kMaxWorkerThreads = 4;
+
+// Requests for scaled covers exceeding this limit are dropped, starting
+// with the oldest ones. The cover art column requests them again when
+// the rows are repainted.
+constexpr std::size_t kMaxPendingRequests = 128;
+
 // The transformation mode when scaling images
 const Qt::TransformationMode kTransformationMode = Qt::SmoothTransformation;
 
@@ -39,8 +74,34 @@ inline QImage resizeImageWidth(const QImage& image, int width) {
 
 } // anonymous namespace
 
-CoverArtCache::CoverArtCache() {
+CoverArtCache::CoverArtCache()
+        : m_activeWorkers(0) {
     QPixmapCache::setCacheLimit(kPixmapCacheLimit);
+    m_workerPool.setMaxThreadCount(
+            math_min(kMaxWorkerThreads, math_max(2, QThread::idealThreadCount())));
+}
+
+CoverArtCache::~CoverArtCache() {
+    m_pendingRequests.clear();
+    m_workerPool.waitForDone();
+    kLogger.info()
+            << "Memory cache hits:" << m_statistics.memoryHits
+            << "| Disk cache hits:" << m_statistics.diskHits
+            << "| Misses:" << m_statistics.misses
+            << "| Dropped requests:" << m_statistics.droppedRequests;
+}
+
+void CoverArtCache::setDiskCacheDirectory(const QString& directory) {
+    DEBUG_ASSERT(m_runningRequests.isEmpty());
+    m_pDiskCache = std::make_unique<const CoverArtDiskCache>(directory);
+    kLogger.info()
+            << "Storing scaled covers in"
+            << m_pDiskCache->directory();
+    // A thumbnail that is removed while it is loaded is simply scaled
+    // again, so this doesn't need to block the requests.
+    QtConcurrent::run(&m_workerPool, [diskCache = *m_pDiskCache] {
+        diskCache.prune();
+    });
 }
 
 //static
@@ -121,6 +182,7 @@ QPixmap CoverArtCache::tryLoadCover(
                     << coverInfo
                     << loading;
         }
+        ++m_statistics.memoryHits;
         if (loading == Loading::Default) {
             emit coverFound(pRequestor, coverInfo, pixmap, requestedCacheKey, false);
         }
@@ -136,34 +198,76 @@ QPixmap CoverArtCache::tryLoadCover(
 
     if (kLogger.traceEnabled()) {
         kLogger.trace()
-                << "requestCover starting future for"
+                << "requestCover queueing"
                 << coverInfo;
     }
     m_runningRequests.insert(requestId);
-    // The watcher will be deleted in coverLoaded()
-    QFutureWatcher<FutureResult>* watcher = new QFutureWatcher<FutureResult>(this);
-    QFuture<FutureResult> future = QtConcurrent::run(
-            &CoverArtCache::loadCover,
+    m_pendingRequests.push_back(PendingRequest{
             pRequestor,
             pTrack,
             coverInfo,
             desiredWidth,
-            loading == Loading::Default);
-    connect(watcher,
-            &QFutureWatcher<FutureResult>::finished,
-            this,
-            &CoverArtCache::coverLoaded);
-    watcher->setFuture(future);
+            loading == Loading::Default});
+    if (m_pendingRequests.size() > kMaxPendingRequests) {
+        // Drop the oldest request for a scaled cover. Requests for full
+        // size covers from the skin widgets are never repeated and must
+        // not be dropped.
+        const auto dropped = std::find_if(
+                m_pendingRequests.begin(),
+                m_pendingRequests.end(),
+                [](const PendingRequest& request) {
+                    return request.desiredWidth > 0;
+                });
+        if (dropped != m_pendingRequests.end()) {
+            m_runningRequests.remove(qMakePair(
+                    dropped->pRequestor,
+                    dropped->coverInfo.cacheKey()));
+            m_pendingRequests.erase(dropped);
+            ++m_statistics.droppedRequests;
+        }
+    }
+    startPendingRequests();
     return QPixmap();
 }
 
+void CoverArtCache::startPendingRequests() {
+    while (!m_pendingRequests.empty() &&
+            m_activeWorkers < m_workerPool.maxThreadCount()) {
+        PendingRequest request = std::move(m_pendingRequests.back());
+        m_pendingRequests.pop_back();
+        if (kLogger.traceEnabled()) {
+            kLogger.trace()
+                    << "requestCover starting future for"
+                    << request.coverInfo;
+        }
+        ++m_activeWorkers;
+        // The watcher will be deleted in coverLoaded()
+        QFutureWatcher<FutureResult>* watcher = new QFutureWatcher<FutureResult>(this);
+        QFuture<FutureResult> future = QtConcurrent::run(
+                &m_workerPool,
+                &CoverArtCache::loadCover,
+                request.pRequestor,
+                std::move(request.pTrack),
+                std::move(request.coverInfo),
+                request.desiredWidth,
+                request.signalWhenDone,
+                m_pDiskCache.get());
+        connect(watcher,
+                &QFutureWatcher<FutureResult>::finished,
+                this,
+                &CoverArtCache::coverLoaded);
+        watcher->setFuture(future);
+    }
+}
+
 //static
 CoverArtCache::FutureResult CoverArtCache::loadCover(
         const QObject* pRequestor,
         TrackPointer pTrack,
         CoverInfo coverInfo,
         int desiredWidth,
-        bool signalWhenDone) {
+        bool signalWhenDone,
+        const CoverArtDiskCache* pDiskCache) {
     if (kLogger.traceEnabled()) {
         kLogger.trace()
                 << "loadCover"
@@ -180,11 +284,44 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
             signalWhenDone);
     DEBUG_ASSERT(!res.coverInfoUpdated);
 
+    // The digest of a valid cache key has been calculated from the original
+    // image. The scaled image is stored on disk under the same key, which
+    // avoids opening the track file or image file again. The original image
+    // might have been replaced since, which is only detected by the
+    // modification time of its file.
+    const bool useDiskCache = pDiskCache && desiredWidth > 0 &&
+            mixxx::isValidCacheKey(coverInfo.cacheKey());
+    if (useDiskCache) {
+        QImage image = pDiskCache->loadImage(
+                coverInfo.cacheKey(),
+                desiredWidth,
+                coverSourceLastModified(coverInfo));
+        if (!image.isNull()) {
+            CoverInfo::LoadedImage loadedImage(CoverInfo::LoadedImage::Result::Ok);
+            loadedImage.image = std::move(image);
+            loadedImage.location = pDiskCache->filePath(coverInfo.cacheKey(), desiredWidth);
+            res.loadedFromDiskCache = true;
+            res.coverArt = CoverArt(
+                    std::move(coverInfo),
+                    std::move(loadedImage),
+                    desiredWidth);
+            return res;
+        }
+    }
+
     auto loadedImage = coverInfo.loadImage(
             pTrack ? pTrack->getFileAccess().token() : SecurityTokenPointer());
     if (!loadedImage.image.isNull()) {
         // Refresh hash before resizing the original image!
         res.coverInfoUpdated = coverInfo.refreshImageDigest(loadedImage.image);
+        if (!res.coverInfoUpdated && useDiskCache &&
+                CoverImageUtils::calculateDigest(loadedImage.image) !=
+                        coverInfo.imageDigest()) {
+            // The thumbnail was missing or outdated, because the original
+            // image has been replaced since its digest has been stored.
+            coverInfo.setImage(loadedImage.image);
+            res.coverInfoUpdated = true;
+        }
         if (pTrack && res.coverInfoUpdated) {
             kLogger.info()
                     << "Updating cover info of track"
@@ -197,6 +334,10 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
             // Adjust the cover size according to the request
             // or downsize the image for efficiency.
             loadedImage.image = resizeImageWidth(loadedImage.image, desiredWidth);
+            // The digest might have been refreshed above
+            if (pDiskCache && mixxx::isValidCacheKey(coverInfo.cacheKey())) {
+                pDiskCache->saveImage(coverInfo.cacheKey(), loadedImage.image);
+            }
         }
     }
 
@@ -219,6 +360,13 @@ void CoverArtCache::coverLoaded() {
         res = pFutureWatcher->result();
         pFutureWatcher->deleteLater();
     }
+    DEBUG_ASSERT(m_activeWorkers > 0);
+    --m_activeWorkers;
+    if (res.loadedFromDiskCache) {
+        ++m_statistics.diskHits;
+    } else {
+        ++m_statistics.misses;
+    }
 
     if (kLogger.traceEnabled()) {
         kLogger.trace() << "coverLoaded" << res.coverArt;
@@ -275,4 +423,6 @@ void CoverArtCache::coverLoaded() {
                 res.requestedCacheKey,
                 res.coverInfoUpdated);
     }
+
+    startPendingRequests();
 }
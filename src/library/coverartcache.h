@@ -4,9 +4,13 @@
 #include <QPair>
 #include <QPixmap>
 #include <QSet>
+#include <QThreadPool>
 #include <QtDebug>
+#include <deque>
+#include <memory>
 
 #include "library/coverart.h"
+#include "library/coverartdiskcache.h"
 #include "track/track_decl.h"
 #include "util/singleton.h"
 
@@ -52,13 +56,29 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
                 loading);
     }
 
+    /// Enables the persistent store of scaled covers in the given
+    /// directory. Must be called before the first cover is requested.
+    void setDiskCacheDirectory(const QString& directory);
+
+    /// Hit counts since startup
+    struct Statistics {
+        int memoryHits = 0;
+        int diskHits = 0;
+        int misses = 0; // loaded from the track file or the image file
+        int droppedRequests = 0;
+    };
+    const Statistics& statistics() const {
+        return m_statistics;
+    }
+
     // Only public for testing
     struct FutureResult {
         FutureResult()
                 : pRequestor(nullptr),
                   requestedCacheKey(CoverImageUtils::defaultCacheKey()),
                   signalWhenDone(false),
-                  coverInfoUpdated(false) {
+                  coverInfoUpdated(false),
+                  loadedFromDiskCache(false) {
         }
         FutureResult(
                 const QObject* pRequestorArg,
@@ -67,7 +87,8 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
                 : pRequestor(pRequestorArg),
                   requestedCacheKey(requestedCacheKeyArg),
                   signalWhenDone(signalWhenDoneArg),
-                  coverInfoUpdated(false) {
+                  coverInfoUpdated(false),
+                  loadedFromDiskCache(false) {
         }
 
         const QObject* pRequestor;
@@ -76,15 +97,18 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
 
         CoverArt coverArt;
         bool coverInfoUpdated;
+        bool loadedFromDiskCache;
     };
     // Load cover from path indicated in coverInfo. WARNING: This is run in a
     // worker thread.
+    // Scaled covers are looked up in and stored into the optional disk cache.
     static FutureResult loadCover(
             const QObject* pRequestor,
             TrackPointer pTrack,
             CoverInfo coverInfo,
             int desiredWidth,
-            bool emitSignals);
+            bool emitSignals,
+            const CoverArtDiskCache* pDiskCache = nullptr);
 
   private slots:
     // Called when loadCover is complete in the main thread.
@@ -100,10 +124,18 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
 
   protected:
     CoverArtCache();
-    ~CoverArtCache() override = default;
+    ~CoverArtCache() override;
     friend class Singleton<CoverArtCache>;
 
   private:
+    struct PendingRequest {
+        const QObject* pRequestor;
+        TrackPointer pTrack;
+        CoverInfo coverInfo;
+        int desiredWidth;
+        bool signalWhenDone;
+    };
+    void startPendingRequests();
     static void requestCover(
             const QObject* pRequestor,
             const CoverInfo& coverInfo,
@@ -117,6 +149,19 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
             Loading loading);
 
     QSet<QPair<const QObject*, mixxx::cache_key_t>> m_runningRequests;
+
+    // Requests that are waiting for a worker thread. The most recent
+    // request is started first, because it most likely belongs to a
+    // row that is still visible while scrolling.
+    std::deque<PendingRequest> m_pendingRequests;
+    int m_activeWorkers;
+
+    Statistics m_statistics;
+
+    std::unique_ptr<const CoverArtDiskCache> m_pDiskCache;
+    // Declared after the disk cache, the destructor waits for all
+    // workers that might still access it.
+    QThreadPool m_workerPool;
 };
 
 inline
@@ -0,0 +1,179 @@
+#include "library/coverartdiskcache.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <algorithm>
+#include <vector>
+
+#include "util/assert.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("CoverArtDiskCache");
+
+// Thumbnails are small, a high quality avoids visible artifacts
+// in the cover art column on high DPI screens.
+constexpr int kJpegQuality = 90;
+
+// Refreshing the modification time is a write, so it is not done on every
+// read. The order of files used within this interval doesn't matter.
+constexpr qint64 kTouchIntervalSecs = 24 * 60 * 60;
+
+QString cacheKeyToHex(mixxx::cache_key_t cacheKey) {
+    return QStringLiteral("%1").arg(cacheKey, 16, 16, QLatin1Char('0'));
+}
+
+} // anonymous namespace
+
+CoverArtDiskCache::CoverArtDiskCache(
+        const QString& directory,
+        qint64 maxSizeBytes)
+        : m_directory(QDir::cleanPath(directory)),
+          m_maxSizeBytes(maxSizeBytes) {
+}
+
+QString CoverArtDiskCache::filePath(
+        mixxx::cache_key_t cacheKey,
+        int width) const {
+    const QString hexKey = cacheKeyToHex(cacheKey);
+    // Distribute the files over 256 subdirectories to keep the
+    // directories small for large libraries.
+    return QStringLiteral("%1/%2/%3_%4")
+            .arg(m_directory,
+                    hexKey.left(2),
+                    hexKey,
+                    QString::number(width));
+}
+
+QImage CoverArtDiskCache::loadImage(
+        mixxx::cache_key_t cacheKey,
+        int width,
+        const QDateTime& sourceLastModified) const {
+    DEBUG_ASSERT(mixxx::isValidCacheKey(cacheKey));
+    DEBUG_ASSERT(width > 0);
+    const QString path = filePath(cacheKey, width);
+    const QFileInfo fileInfo(path);
+    if (!fileInfo.exists()) {
+        return QImage();
+    }
+    const QDateTime lastModified = fileInfo.lastModified();
+    if (sourceLastModified.isValid() && lastModified < sourceLastModified) {
+        // The original image might have been replaced
+        return QImage();
+    }
+    // The format is detected from the contents
+    QImage image(path);
+    if (image.isNull()) {
+        return image;
+    }
+    if (image.width() != width) {
+        kLogger.warning()
+                << "Ignoring thumbnail with unexpected width"
+                << image.width()
+                << path;
+        return QImage();
+    }
+    // Mark the file as used for prune()
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    if (lastModified.secsTo(now) > kTouchIntervalSecs) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadWrite) ||
+                !file.setFileTime(now, QFileDevice::FileModificationTime)) {
+            kLogger.debug()
+                    << "Failed to update the modification time of"
+                    << path;
+        }
+    }
+    return image;
+}
+
+bool CoverArtDiskCache::saveImage(
+        mixxx::cache_key_t cacheKey,
+        const QImage& image) const {
+    DEBUG_ASSERT(mixxx::isValidCacheKey(cacheKey));
+    VERIFY_OR_DEBUG_ASSERT(!image.isNull()) {
+        return false;
+    }
+    const QString path = filePath(cacheKey, image.width());
+    if (!QDir().mkpath(QFileInfo(path).path())) {
+        kLogger.warning()
+                << "Failed to create directory for"
+                << path;
+        return false;
+    }
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        kLogger.warning()
+                << "Failed to open"
+                << path
+                << file.errorString();
+        return false;
+    }
+    const bool saved = image.hasAlphaChannel()
+            ? image.save(&file, "PNG")
+            : image.save(&file, "JPG", kJpegQuality);
+    if (!saved) {
+        kLogger.warning()
+                << "Failed to encode thumbnail"
+                << path;
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+int CoverArtDiskCache::prune() const {
+    struct CacheFile {
+        QString path;
+        qint64 size;
+        QDateTime lastUsed;
+    };
+    std::vector<CacheFile> files;
+    qint64 totalSize = 0;
+    QDirIterator it(m_directory, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        const QFileInfo fileInfo = it.fileInfo();
+        files.push_back(CacheFile{
+                fileInfo.filePath(),
+                fileInfo.size(),
+                fileInfo.lastModified()});
+        totalSize += fileInfo.size();
+    }
+    if (totalSize <= m_maxSizeBytes) {
+        return 0;
+    }
+
+    // Leave room for new thumbnails, so the next prune() doesn't delete a
+    // few files only
+    const qint64 targetSize = m_maxSizeBytes - m_maxSizeBytes / 4;
+    std::sort(files.begin(), files.end(), [](const CacheFile& lhs, const CacheFile& rhs) {
+        return lhs.lastUsed < rhs.lastUsed;
+    });
+    int removedCount = 0;
+    for (const auto& file : files) {
+        if (totalSize <= targetSize) {
+            break;
+        }
+        if (!QFile::remove(file.path)) {
+            kLogger.warning()
+                    << "Failed to remove"
+                    << file.path;
+            continue;
+        }
+        totalSize -= file.size;
+        ++removedCount;
+    }
+    kLogger.info()
+            << "Removed"
+            << removedCount
+            << "least recently used thumbnails, the cache size is now"
+            << totalSize
+            << "bytes";
+    return removedCount;
+}
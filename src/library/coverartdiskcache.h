@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QDateTime>
+#include <QImage>
+#include <QString>
+
+#include "util/cache.h"
+
+/// Persistent store of scaled cover art images on disk.
+///
+/// The images are addressed by the digest of the original cover image
+/// (the cache key) and the width they have been scaled to. The stored
+/// digest of a cover is outdated if its image file or track file has been
+/// replaced, so thumbnails older than that file are ignored. Images
+/// without an alpha channel are stored as JPEG, all others as PNG.
+///
+/// The total size is limited by prune(), which deletes the least recently
+/// used files. The modification time of a file is its last use, it is
+/// refreshed by loadImage() at most once per day.
+///
+/// All methods are thread-safe and are supposed to be called from the
+/// worker threads of CoverArtCache.
+class CoverArtDiskCache {
+  public:
+    // Thousands of thumbnails of a few KB each
+    static constexpr qint64 kDefaultMaxSizeBytes = 256 * 1024 * 1024;
+
+    explicit CoverArtDiskCache(
+            const QString& directory,
+            qint64 maxSizeBytes = kDefaultMaxSizeBytes);
+
+    const QString& directory() const {
+        return m_directory;
+    }
+
+    QString filePath(
+            mixxx::cache_key_t cacheKey,
+            int width) const;
+
+    /// Returns a null image if the thumbnail has not been stored yet or
+    /// if it is older than the file of the original image.
+    QImage loadImage(
+            mixxx::cache_key_t cacheKey,
+            int width,
+            const QDateTime& sourceLastModified = QDateTime()) const;
+
+    /// Atomically replaces the file, concurrent readers never see a
+    /// partially written image.
+    bool saveImage(
+            mixxx::cache_key_t cacheKey,
+            const QImage& image) const;
+
+    /// Deletes the least recently used files if the cache exceeds the size
+    /// limit, until it is a quarter below the limit. This scans the whole
+    /// directory and is supposed to be called once at startup. Returns the
+    /// number of deleted files.
+    int prune() const;
+
+  private:
+    const QString m_directory;
+    const qint64 m_maxSizeBytes;
+};
@@ -2,7 +2,9 @@
 
 #include <QHash>
 #include <QMetaMethod>
+#include <QMutexLocker>
 #include <QStringList>
+#include <QtConcurrentRun>
 #include <QtGlobal>
 #include <array>
 #include <chrono>
@@ -14,6 +16,7 @@
 #include "library/trackcollection.h"
 #include "library/trackset/crate/crate.h"
 #include "track/track.h"
+#include "util/filecopy.h"
 #include "util/optional.h"
 #include "util/thread_affinity.h"
 #include "waveform/waveformfactory.h"
@@ -30,6 +33,12 @@ constexpr int kMaxHotCues = 8;
 
 constexpr uint8_t kDefaultWaveformOpacity = 127;
 
+// The number of tracks that are loaded on the main thread at once
+constexpr int kTrackBatchSize = 32;
+
+// Copying more files at the same time to a single device doesn't help
+constexpr int kMaxConcurrentFileCopies = 2;
+
 const QStringList kSupportedFileTypes = {
         "aac",
         "m4a",
@@ -74,7 +83,14 @@ std::optional<djinterop::musical_key> toDjinteropKey(
     return keyMap[key];
 }
 
-QString exportFile(const QSharedPointer<EnginePrimeExportRequest> pRequest,
+struct ExportedFile {
+    QString relativePath;
+    // Empty if the file doesn't need to be copied
+    QString sourcePath;
+    QString destinationPath;
+};
+
+ExportedFile exportFile(const QSharedPointer<EnginePrimeExportRequest> pRequest,
         TrackPointer pTrack) {
     if (!pRequest->engineLibraryDbDir.exists()) {
         const auto msg = QStringLiteral(
@@ -96,13 +112,14 @@ QString exportFile(const QSharedPointer<EnginePrimeExportRequest> pRequest,
     const auto trackId = pTrack->getId().value();
     QString dstFilename = QString::number(trackId) + " - " + srcFileInfo.fileName();
     QString dstPath = pRequest->musicFilesDir.filePath(dstFilename);
-    if (!QFile::exists(dstPath) ||
-            srcFileInfo.lastModified() > QFileInfo{dstPath}.lastModified()) {
-        const auto srcPath = srcFileInfo.location();
-        QFile::copy(srcPath, dstPath);
+    ExportedFile exportedFile;
+    exportedFile.relativePath = pRequest->engineLibraryDbDir.relativeFilePath(dstPath);
+    if (!isFileCopyUpToDate(srcFileInfo.asQFileInfo(), QFileInfo{dstPath})) {
+        // The file is copied in the background
+        exportedFile.sourcePath = srcFileInfo.location();
+        exportedFile.destinationPath = dstPath;
     }
-
-    return pRequest->engineLibraryDbDir.relativeFilePath(dstPath);
+    return exportedFile;
 }
 
 std::optional<djinterop::track> getTrackByRelativePath(
@@ -336,29 +353,32 @@ void exportMetadata(djinterop::database* pDatabase,
     pMixxxToEnginePrimeTrackIdMap->insert(pTrack->getId(), externalTrackId);
 }
 
-void exportTrack(
+bool exportTrack(
         const QSharedPointer<EnginePrimeExportRequest> pRequest,
         djinterop::database* pDatabase,
         QHash<TrackId, int64_t>* pMixxxToEnginePrimeTrackIdMap,
         const TrackPointer pTrack,
-        const Waveform* pWaveform) {
+        const Waveform* pWaveform,
+        ExportedFile* pExportedFile) {
     // Only export supported file types.
     if (!kSupportedFileTypes.contains(pTrack->getType())) {
         qInfo() << "Skipping file" << pTrack->getFileInfo().fileName()
                 << "(id" << pTrack->getId() << ") as its file type"
                 << pTrack->getType() << "is not supported";
-        return;
+        return false;
     }
 
-    // Copy the file, if required.
-    const auto musicFileRelativePath = exportFile(pRequest, pTrack);
+    // Determine if the file needs to be copied. The metadata only needs the
+    // relative path of the copy.
+    *pExportedFile = exportFile(pRequest, pTrack);
 
     // Export meta-data.
     exportMetadata(pDatabase,
             pMixxxToEnginePrimeTrackIdMap,
             pTrack,
             pWaveform,
-            musicFileRelativePath);
+            pExportedFile->relativePath);
+    return true;
 }
 
 void exportCrate(
@@ -384,7 +404,9 @@ EnginePrimeExportJob::EnginePrimeExportJob(
         QSharedPointer<EnginePrimeExportRequest> pRequest)
         : QThread{parent},
           m_pTrackCollectionManager(pTrackCollectionManager),
-          m_pRequest{pRequest} {
+          m_pRequest{pRequest},
+          m_tracksLoaded(false) {
+    m_copyThreadPool.setMaxThreadCount(kMaxConcurrentFileCopies);
     // Must be collocated with the TrackCollectionManager.
     if (parent != nullptr) {
         DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(m_pTrackCollectionManager);
@@ -462,22 +484,159 @@ void EnginePrimeExportJob::loadIds(const QSet<CrateId>& crateIds) {
     }
 }
 
-void EnginePrimeExportJob::loadTrack(const TrackRef& trackRef) {
+void EnginePrimeExportJob::loadTracks(const QList<TrackRef>& trackRefs) {
     DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(m_pTrackCollectionManager);
 
-    // Load the track.
-    m_pLastLoadedTrack = m_pTrackCollectionManager->getOrAddTrack(trackRef);
-
-    // Load high-resolution waveform from analysis info.
+    std::vector<LoadedTrack> loadedTracks;
+    loadedTracks.reserve(trackRefs.size());
     auto& analysisDao = m_pTrackCollectionManager->internalCollection()->getAnalysisDAO();
-    const auto waveformAnalyses = analysisDao.getAnalysesForTrackByType(
-            m_pLastLoadedTrack->getId(), AnalysisDao::TYPE_WAVEFORM);
-    if (!waveformAnalyses.isEmpty()) {
-        const auto& waveformAnalysis = waveformAnalyses.first();
-        m_pLastLoadedWaveform.reset(
-                WaveformFactory::loadWaveformFromAnalysis(waveformAnalysis));
-    } else {
-        m_pLastLoadedWaveform.reset();
+    for (const auto& trackRef : trackRefs) {
+        if (m_cancellationRequested.loadAcquire() != 0) {
+            break;
+        }
+
+        // Load the track.
+        LoadedTrack loadedTrack;
+        loadedTrack.pTrack = m_pTrackCollectionManager->getOrAddTrack(trackRef);
+        if (loadedTrack.pTrack) {
+            // Load high-resolution waveform from analysis info.
+            const auto waveformAnalyses = analysisDao.getAnalysesForTrackByType(
+                    loadedTrack.pTrack->getId(), AnalysisDao::TYPE_WAVEFORM);
+            if (!waveformAnalyses.isEmpty()) {
+                const auto& waveformAnalysis = waveformAnalyses.first();
+                loadedTrack.pWaveform.reset(
+                        WaveformFactory::loadWaveformFromAnalysis(waveformAnalysis));
+            }
+        } else {
+            qWarning() << "Failed to load track" << trackRef;
+        }
+        loadedTracks.push_back(std::move(loadedTrack));
+    }
+
+    QMutexLocker locker(&m_loadedTracksMutex);
+    m_loadedTracks = std::move(loadedTracks);
+    m_tracksLoaded = true;
+    m_loadedTracksCondition.wakeAll();
+}
+
+void EnginePrimeExportJob::requestTracks(int* pNextTrackIndex) {
+    const auto trackRefs = m_trackRefs.mid(*pNextTrackIndex, kTrackBatchSize);
+    *pNextTrackIndex += trackRefs.size();
+    // Note that loading must happen on the same thread as the track collection
+    // manager, which is not the same as this method's worker thread.
+    QMetaObject::invokeMethod(
+            this,
+            [this, trackRefs] {
+                loadTracks(trackRefs);
+            },
+            Qt::QueuedConnection);
+}
+
+std::vector<EnginePrimeExportJob::LoadedTrack> EnginePrimeExportJob::takeLoadedTracks() {
+    QMutexLocker locker(&m_loadedTracksMutex);
+    while (!m_tracksLoaded) {
+        m_loadedTracksCondition.wait(&m_loadedTracksMutex);
+    }
+    m_tracksLoaded = false;
+    return std::move(m_loadedTracks);
+}
+
+void EnginePrimeExportJob::copyFile(
+        const QString& sourcePath, const QString& destinationPath) {
+    m_fileCopies.append(QtConcurrent::run(&m_copyThreadPool,
+            [this, sourcePath, destinationPath] {
+                if (m_abortFileCopies.loadAcquire() != 0 ||
+                        m_cancellationRequested.loadAcquire() != 0) {
+                    return QString();
+                }
+                QString errorMessage;
+                if (mixxx::copyFile(sourcePath, destinationPath, &errorMessage)) {
+                    return QString();
+                }
+                return QStringLiteral("Failed to copy %1 to %2: %3")
+                        .arg(sourcePath, destinationPath, errorMessage);
+            }));
+}
+
+bool EnginePrimeExportJob::finishFileCopies(bool abort) {
+    if (abort) {
+        m_abortFileCopies = 1;
+    }
+    bool success = true;
+    for (const auto& fileCopy : qAsConst(m_fileCopies)) {
+        const QString errorMessage = fileCopy.result();
+        if (!errorMessage.isEmpty()) {
+            qWarning() << errorMessage;
+            if (success && !abort) {
+                m_lastErrorMessage = errorMessage;
+            }
+            success = false;
+        }
+    }
+    m_fileCopies.clear();
+    return success;
+}
+
+bool EnginePrimeExportJob::exportTracks(djinterop::database* pDatabase,
+        QHash<TrackId, int64_t>* pMixxxToEnginePrimeTrackIdMap,
+        int* pProgress) {
+    int nextTrackIndex = 0;
+    requestTracks(&nextTrackIndex);
+    while (true) {
+        const auto loadedTracks = takeLoadedTracks();
+        const bool lastBatch = nextTrackIndex >= m_trackRefs.size();
+        if (!lastBatch) {
+            // Load the next batch while this one is written.
+            requestTracks(&nextTrackIndex);
+        }
+
+        for (const auto& loadedTrack : loadedTracks) {
+            if (m_cancellationRequested.loadAcquire() != 0) {
+                qInfo() << "Cancelling export";
+                break;
+            }
+
+            const TrackPointer& pTrack = loadedTrack.pTrack;
+            if (!pTrack) {
+                ++*pProgress;
+                emit jobProgress(*pProgress);
+                continue;
+            }
+            qInfo() << "Exporting track" << pTrack->getId().value()
+                    << "at" << pTrack->getFileInfo().location() << "...";
+            try {
+                ExportedFile exportedFile;
+                if (exportTrack(m_pRequest,
+                            pDatabase,
+                            pMixxxToEnginePrimeTrackIdMap,
+                            pTrack,
+                            loadedTrack.pWaveform.get(),
+                            &exportedFile) &&
+                        !exportedFile.sourcePath.isEmpty()) {
+                    copyFile(exportedFile.sourcePath, exportedFile.destinationPath);
+                }
+            } catch (std::exception& e) {
+                qWarning() << "Failed to export track"
+                           << pTrack->getId().value() << ":"
+                           << e.what();
+                m_lastErrorMessage = e.what();
+                break;
+            }
+
+            ++*pProgress;
+            emit jobProgress(*pProgress);
+        }
+
+        if (m_cancellationRequested.loadAcquire() != 0 || !m_lastErrorMessage.isEmpty()) {
+            if (!lastBatch) {
+                // Don't leave the requested batch behind.
+                takeLoadedTracks();
+            }
+            return false;
+        }
+        if (lastBatch) {
+            return true;
+        }
     }
 }
 
@@ -539,44 +698,12 @@ void EnginePrimeExportJob::run() {
     // We will build up a map from Mixxx track id to EL track id during export.
     QHash<TrackId, int64_t> mixxxToEnginePrimeTrackIdMap;
 
-    for (const auto& trackRef : qAsConst(m_trackRefs)) {
-        // Load each track.
-        // Note that loading must happen on the same thread as the track collection
-        // manager, which is not the same as this method's worker thread.
-        QMetaObject::invokeMethod(
-                this,
-                "loadTrack",
-                Qt::BlockingQueuedConnection,
-                Q_ARG(TrackRef, trackRef));
-
-        if (m_cancellationRequested.loadAcquire() != 0) {
-            qInfo() << "Cancelling export";
-            return;
-        }
-
-        DEBUG_ASSERT(m_pLastLoadedTrack != nullptr);
-
-        qInfo() << "Exporting track" << m_pLastLoadedTrack->getId().value()
-                << "at" << m_pLastLoadedTrack->getFileInfo().location() << "...";
-        try {
-            exportTrack(m_pRequest,
-                    pDb.get(),
-                    &mixxxToEnginePrimeTrackIdMap,
-                    m_pLastLoadedTrack,
-                    m_pLastLoadedWaveform.get());
-        } catch (std::exception& e) {
-            qWarning() << "Failed to export track"
-                       << m_pLastLoadedTrack->getId().value() << ":"
-                       << e.what();
-            m_lastErrorMessage = e.what();
+    if (!exportTracks(pDb.get(), &mixxxToEnginePrimeTrackIdMap, &currProgress)) {
+        finishFileCopies(true);
+        if (!m_lastErrorMessage.isEmpty()) {
             emit failed(m_lastErrorMessage);
-            return;
         }
-
-        m_pLastLoadedTrack.reset();
-
-        ++currProgress;
-        emit jobProgress(currProgress);
+        return;
     }
 
     // We will ensure that there is a special top-level crate representing the
@@ -591,6 +718,7 @@ void EnginePrimeExportJob::run() {
     } catch (std::exception& e) {
         qWarning() << "Failed to create/identify root crate:" << e.what();
         m_lastErrorMessage = e.what();
+        finishFileCopies(true);
         emit failed(m_lastErrorMessage);
         return;
     }
@@ -611,6 +739,7 @@ void EnginePrimeExportJob::run() {
             qWarning() << "Failed to add track" << trackRef.getId()
                        << "to root crate:" << e.what();
             m_lastErrorMessage = e.what();
+            finishFileCopies(true);
             emit failed(m_lastErrorMessage);
             return;
         }
@@ -632,6 +761,7 @@ void EnginePrimeExportJob::run() {
 
         if (m_cancellationRequested.loadAcquire() != 0) {
             qInfo() << "Cancelling export";
+            finishFileCopies(true);
             return;
         }
 
@@ -646,6 +776,7 @@ void EnginePrimeExportJob::run() {
             qWarning() << "Failed to add crate" << m_lastLoadedCrate.getId().value()
                        << ":" << e.what();
             m_lastErrorMessage = e.what();
+            finishFileCopies(true);
             emit failed(m_lastErrorMessage);
             return;
         }
@@ -654,6 +785,16 @@ void EnginePrimeExportJob::run() {
         emit jobProgress(currProgress);
     }
 
+    // The database has been written while the music files were copied.
+    if (!finishFileCopies(false)) {
+        emit failed(m_lastErrorMessage);
+        return;
+    }
+    if (m_cancellationRequested.loadAcquire() != 0) {
+        qInfo() << "Cancelling export";
+        return;
+    }
+
     qInfo() << "Engine Prime Export Job completed successfully";
     emit completed(m_trackRefs.size(), m_crateIds.size());
 }
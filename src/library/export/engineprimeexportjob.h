@@ -1,13 +1,18 @@
 #pragma once
 
 #include <QAtomicInteger>
+#include <QFuture>
+#include <QHash>
 #include <QList>
+#include <QMutex>
 #include <QQueue>
 #include <QSet>
 #include <QSharedPointer>
 #include <QThread>
+#include <QThreadPool>
 #include <QWaitCondition>
 #include <memory>
+#include <vector>
 
 #include "library/export/engineprimeexportrequest.h"
 #include "library/trackcollectionmanager.h"
@@ -17,12 +22,22 @@
 #include "track/trackid.h"
 #include "track/trackref.h"
 
+namespace djinterop {
+class database;
+} // namespace djinterop
+
 namespace mixxx {
 
 /// The Engine Prime export job performs the work of exporting the Mixxx
 /// library to an external Engine Prime (also known as "Engine Library")
 /// database, using the libdjinterop library, in accordance with the export
 /// request with which it is constructed.
+///
+/// The export is pipelined: While the job thread writes the metadata of a
+/// batch of tracks into the database, the next batch of tracks and waveforms
+/// is loaded on the main thread, and the music files are copied in the
+/// background. Music files that are unchanged since a previous export are
+/// not copied again, so an interrupted export can simply be run again.
 class EnginePrimeExportJob : public QThread {
     Q_OBJECT
   public:
@@ -56,14 +71,32 @@ class EnginePrimeExportJob : public QThread {
     // thread of the application, which will be different to the worker thread
     // used by an instance of this class.
     void loadIds(const QSet<CrateId>& crateIdsToExport);
-    void loadTrack(const TrackRef& trackRef);
     void loadCrate(const CrateId& crateId);
 
   private:
+    struct LoadedTrack {
+        TrackPointer pTrack;
+        std::unique_ptr<Waveform> pWaveform;
+    };
+
+    // Loads a batch of tracks on the main thread of the application.
+    void loadTracks(const QList<TrackRef>& trackRefs);
+    // Requests the next batch of tracks starting at *pNextTrackIndex without
+    // waiting for it.
+    void requestTracks(int* pNextTrackIndex);
+    // Waits for the requested batch of tracks.
+    std::vector<LoadedTrack> takeLoadedTracks();
+
+    bool exportTracks(djinterop::database* pDatabase,
+            QHash<TrackId, int64_t>* pMixxxToEnginePrimeTrackIdMap,
+            int* pProgress);
+    void copyFile(const QString& sourcePath, const QString& destinationPath);
+    // Waits until all music files have been copied. Returns false if a copy
+    // failed. Pending copies are not started if abort is true.
+    bool finishFileCopies(bool abort);
+
     QList<TrackRef> m_trackRefs;
     QList<CrateId> m_crateIds;
-    TrackPointer m_pLastLoadedTrack;
-    std::unique_ptr<Waveform> m_pLastLoadedWaveform;
     Crate m_lastLoadedCrate;
     QList<TrackId> m_lastLoadedCrateTrackIds;
 
@@ -73,6 +106,17 @@ class EnginePrimeExportJob : public QThread {
     QSharedPointer<EnginePrimeExportRequest> m_pRequest;
 
     QString m_lastErrorMessage;
+
+    QMutex m_loadedTracksMutex;
+    QWaitCondition m_loadedTracksCondition;
+    std::vector<LoadedTrack> m_loadedTracks;
+    bool m_tracksLoaded;
+
+    QAtomicInteger<int> m_abortFileCopies;
+    QList<QFuture<QString>> m_fileCopies;
+    // Declared last, so the copies are finished before the other members
+    // are destroyed.
+    QThreadPool m_copyThreadPool;
 };
 
 } // namespace mixxx
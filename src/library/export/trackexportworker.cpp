@@ -3,9 +3,11 @@
 #include <QDebug>
 #include <QFileInfo>
 #include <QMessageBox>
+#include <QtConcurrentRun>
 
 #include "moc_trackexportworker.cpp"
 #include "track/track.h"
+#include "util/filecopy.h"
 
 namespace {
 
@@ -69,25 +71,36 @@ QMap<QString, mixxx::FileInfo> createCopylist(const TrackPointerList& tracks) {
 }  // namespace
 
 void TrackExportWorker::run() {
-    int i = 0;
     QMap<QString, mixxx::FileInfo> copy_list = createCopylist(m_tracks);
+    m_finishedCount = 0;
+    m_totalCount = copy_list.size();
     for (auto it = copy_list.constBegin(); it != copy_list.constEnd(); ++it) {
-        // We emit progress twice per loop, which may seem excessive, but it
+        // We emit progress twice per file, which may seem excessive, but it
         // guarantees that we emit a sane progress before we start and after
         // we end.  In between, each filename will get its own visible tick
         // on the bar, which looks really nice.
-        emit progress(it->fileName(), i, copy_list.size());
-        copyFile(*it, it.key());
+        emit progress(it->fileName(), m_finishedCount, m_totalCount);
+        const bool copying = startCopyFile(*it, it.key());
         if (m_bStop.loadAcquire()) {
-            emit canceled();
-            return;
+            break;
+        }
+        if (!copying) {
+            ++m_finishedCount;
+            emit progress(it->fileName(), m_finishedCount, m_totalCount);
+        } else if (m_pendingCopies.size() >= kMaxConcurrentCopies) {
+            finishCopyFile();
         }
-        ++i;
-        emit progress(it->fileName(), i, copy_list.size());
+    }
+    // Copies that have been started are always completed
+    while (!m_pendingCopies.isEmpty()) {
+        finishCopyFile();
+    }
+    if (m_bStop.loadAcquire()) {
+        emit canceled();
     }
 }
 
-void TrackExportWorker::copyFile(
+bool TrackExportWorker::startCopyFile(
         const mixxx::FileInfo& source_fileinfo,
         const QString& dest_filename) {
     QString sourceFilename = source_fileinfo.canonicalLocation();
@@ -95,6 +108,11 @@ void TrackExportWorker::copyFile(
     QFileInfo dest_fileinfo(dest_path);
 
     if (dest_fileinfo.exists()) {
+        if (mixxx::isFileCopyUpToDate(source_fileinfo.asQFileInfo(), dest_fileinfo)) {
+            // Exported before and unchanged since then
+            qDebug() << "skipping unchanged" << sourceFilename;
+            return false;
+        }
         switch (m_overwriteMode) {
         // Give the user the option to overwrite existing files in the destination.
         case OverwriteMode::ASK:
@@ -102,47 +120,50 @@ void TrackExportWorker::copyFile(
             case OverwriteAnswer::SKIP:
             case OverwriteAnswer::SKIP_ALL:
                 qDebug() << "skipping" << sourceFilename;
-                return;
+                return false;
             case OverwriteAnswer::OVERWRITE:
             case OverwriteAnswer::OVERWRITE_ALL:
                 break;
             case OverwriteAnswer::CANCEL:
                 m_errorMessage = tr("Export process was canceled");
                 stop();
-                return;
+                return false;
             }
             break;
         case OverwriteMode::SKIP_ALL:
             qDebug() << "skipping" << sourceFilename;
-            return;
+            return false;
         case OverwriteMode::OVERWRITE_ALL:;
         }
-
-        // Remove the existing file in preparation for overwriting.
-        QFile dest_file(dest_path);
-        qDebug() << "Removing existing file" << dest_path;
-        if (!dest_file.remove()) {
-            const QString error_message = tr(
-                    "Error removing file %1: %2. Stopping.").arg(
-                    dest_path, dest_file.errorString());
-            qWarning() << error_message;
-            m_errorMessage = error_message;
-            stop();
-            return;
-        }
+        // The existing file is replaced when the copy is complete.
     }
 
     qDebug() << "Copying" << sourceFilename << "to" << dest_path;
-    QFile source_file(sourceFilename);
-    if (!source_file.copy(dest_path)) {
-        const QString error_message = tr(
-                "Error exporting track %1 to %2: %3. Stopping.").arg(
-                sourceFilename, dest_path, source_file.errorString());
+    m_pendingCopies.enqueue(PendingCopy{source_fileinfo.fileName(),
+            QtConcurrent::run(&m_copyThreadPool, [sourceFilename, dest_path] {
+                QString errorString;
+                if (mixxx::copyFile(sourceFilename, dest_path, &errorString)) {
+                    return QString();
+                }
+                return tr("Error exporting track %1 to %2: %3. Stopping.")
+                        .arg(sourceFilename, dest_path, errorString);
+            })});
+    return true;
+}
+
+void TrackExportWorker::finishCopyFile() {
+    PendingCopy pendingCopy = m_pendingCopies.dequeue();
+    const QString error_message = pendingCopy.result.result();
+    if (!error_message.isEmpty()) {
         qWarning() << error_message;
-        m_errorMessage = error_message;
-        stop();
-        return;
+        // Report the first error
+        if (!m_bStop.loadAcquire()) {
+            m_errorMessage = error_message;
+            stop();
+        }
     }
+    ++m_finishedCount;
+    emit progress(pendingCopy.fileName, m_finishedCount, m_totalCount);
 }
 
 TrackExportWorker::OverwriteAnswer TrackExportWorker::makeOverwriteRequest(
@@ -191,6 +212,6 @@ TrackExportWorker::OverwriteAnswer TrackExportWorker::makeOverwriteRequest(
 }
 
 void TrackExportWorker::stop() {
-    // We'll wait for the current file to finish copying, then stop.
+    // We'll wait for the current files to finish copying, then stop.
     m_bStop = true;
 }
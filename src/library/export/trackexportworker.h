@@ -1,18 +1,24 @@
 #pragma once
 
+#include <QFuture>
 #include <QObject>
+#include <QQueue>
 #include <QScopedPointer>
 #include <QString>
 #include <QThread>
+#include <QThreadPool>
 #include <future>
 
 #include "track/track_decl.h"
 #include "util/fileinfo.h"
 
 // A QThread class for copying a list of files to a single destination directory.
-// Currently does not preserve subdirectory relationships.  This class performs
-// all copies in a blocking style within its own thread.  May be canceled from
-// another thread.
+// Currently does not preserve subdirectory relationships.  Destination files
+// are checked and overwrite questions are asked in order within its own thread,
+// while up to kMaxConcurrentCopies files are copied in the background.
+// Destination files that are unchanged since a previous export are skipped
+// without asking, so an interrupted export can simply be resumed.  May be
+// canceled from another thread.
 class TrackExportWorker : public QThread {
     Q_OBJECT
   public:
@@ -36,6 +42,7 @@ class TrackExportWorker : public QThread {
     // should do that.
     TrackExportWorker(const QString& destDir, const TrackPointerList& tracks)
             : m_destDir(destDir), m_tracks(tracks) {
+        m_copyThreadPool.setMaxThreadCount(kMaxConcurrentCopies);
     }
     virtual ~TrackExportWorker() { };
 
@@ -48,7 +55,7 @@ class TrackExportWorker : public QThread {
         return m_errorMessage;
     }
 
-    // Cancels the export after the current copy operation.
+    // Cancels the export after the current copy operations.
     // May be called from another thread.
     void stop();
 
@@ -65,14 +72,29 @@ class TrackExportWorker : public QThread {
     void canceled();
 
   private:
-    // Copies the file at source_fileinfo to the destination directory with the
-    // name given by dest_filename (not a full path).  If the destination file
-    // exists, will emit an overwrite request signal to ask how to proceed.
-    // On unrecoverable error, sets the error message and stops the export
-    // process entirely.
-    void copyFile(const mixxx::FileInfo& source_fileinfo,
+    // Copying more files at the same time to a single device doesn't help,
+    // but hides the latency of opening and closing many small files.
+    static constexpr int kMaxConcurrentCopies = 2;
+
+    struct PendingCopy {
+        QString fileName;
+        // The error message or an empty string on success
+        QFuture<QString> result;
+    };
+
+    // Starts copying the file at source_fileinfo to the destination directory
+    // with the name given by dest_filename (not a full path) in the background.
+    // If the destination file exists and has been modified, will emit an
+    // overwrite request signal to ask how to proceed. Returns false if the
+    // file is skipped.
+    bool startCopyFile(const mixxx::FileInfo& source_fileinfo,
             const QString& dest_filename);
 
+    // Waits for the oldest pending copy and reports its progress. On
+    // unrecoverable error, sets the error message and stops the export
+    // process entirely.
+    void finishCopyFile();
+
     // Emit a signal requesting overwrite mode, and block until we get an
     // answer.  Updates m_overwriteMode appropriately.
     OverwriteAnswer makeOverwriteRequest(const QString& filename);
@@ -83,4 +105,9 @@ class TrackExportWorker : public QThread {
     OverwriteMode m_overwriteMode = OverwriteMode::ASK;
     const QString m_destDir;
     const TrackPointerList m_tracks;
+
+    QThreadPool m_copyThreadPool;
+    QQueue<PendingCopy> m_pendingCopies;
+    int m_finishedCount = 0;
+    int m_totalCount = 0;
 };
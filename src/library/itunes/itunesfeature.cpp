@@ -12,6 +12,7 @@
 #include "library/baseexternalplaylistmodel.h"
 #include "library/baseexternaltrackmodel.h"
 #include "library/basetrackcache.h"
+#include "library/batchinsertquery.h"
 #include "library/dao/settingsdao.h"
 #include "library/library.h"
 #include "library/queryutil.h"
@@ -166,14 +167,6 @@ void ITunesFeature::activate() {
 void ITunesFeature::activate(bool forceReload) {
     //qDebug("ITunesFeature::activate()");
     if (!m_isActivated || forceReload) {
-
-        //Delete all table entries of iTunes feature
-        ScopedTransaction transaction(m_database);
-        clearTable("itunes_playlist_tracks");
-        clearTable("itunes_library");
-        clearTable("itunes_playlists");
-        transaction.commit();
-
         emit showTrackModel(m_pITunesTrackModel);
 
         SettingsDAO settings(m_pTrackCollection->database());
@@ -213,9 +206,9 @@ void ITunesFeature::activate(bool forceReload) {
         m_isActivated =  true;
         // Let a worker thread do the XML parsing
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-        m_future = QtConcurrent::run(&ITunesFeature::importLibrary, this);
+        m_future = QtConcurrent::run(&ITunesFeature::importLibrary, this, forceReload);
 #else
-        m_future = QtConcurrent::run(this, &ITunesFeature::importLibrary);
+        m_future = QtConcurrent::run(this, &ITunesFeature::importLibrary, forceReload);
 #endif
         m_future_watcher.setFuture(m_future);
         m_title = tr("(loading) iTunes");
@@ -251,7 +244,7 @@ void ITunesFeature::onRightClick(const QPoint& globalPos) {
     if (chosen == &useDefault) {
         SettingsDAO settings(m_database);
         settings.setValue(ITDB_PATH_KEY, QString());
-        activate(true); // clears tables before parsing
+        activate(true); // imports the library even if unchanged
     } else if (chosen == &chooseNew) {
         SettingsDAO settings(m_database);
         QString dbfile = QFileDialog::getOpenFileName(
@@ -269,7 +262,7 @@ void ITunesFeature::onRightClick(const QPoint& globalPos) {
         Sandbox::createSecurityToken(&dbFileInfo);
 
         settings.setValue(ITDB_PATH_KEY, dbfile);
-        activate(true); // clears tables before parsing
+        activate(true); // imports the library even if unchanged
     }
 }
 
@@ -372,7 +365,7 @@ void ITunesFeature::guessMusicLibraryMountpoint(QXmlStreamReader& xml) {
 
 // This method is executed in a separate thread
 // via QtConcurrent::run
-TreeItem* ITunesFeature::importLibrary() {
+TreeItem* ITunesFeature::importLibrary(bool forceReimport) {
     bool isTracksParsed=false;
     bool isMusicFolderLocatedAfterTracks=false;
 
@@ -382,8 +375,23 @@ TreeItem* ITunesFeature::importLibrary() {
 
     qDebug() << "ITunesFeature::importLibrary() ";
 
+    const QString fingerprint = importFingerprint({m_dbfile});
+    if (!forceReimport) {
+        std::unique_ptr<TreeItem> pRootItem = restoreImportState(m_database, fingerprint);
+        if (pRootItem) {
+            qDebug() << "iTunes music collection is unchanged";
+            return pRootItem.release();
+        }
+    }
+
     ScopedTransaction transaction(m_database);
 
+    //Delete all table entries of iTunes feature
+    resetImportState(m_database);
+    clearTable("itunes_playlist_tracks");
+    clearTable("itunes_library");
+    clearTable("itunes_playlists");
+
     // By default set m_mixxxItunesRoot and m_dbItunesRoot to strip out
     // file://localhost/ from the URL. When we load the user's iTunes XML
     // configuration we may replace this with something based on the detected
@@ -427,6 +435,19 @@ TreeItem* ITunesFeature::importLibrary() {
 
     itunes_file.close();
 
+    if (xml.hasError() || m_cancelImport) {
+        // Leave the transaction uncommitted, so the tables of the previous
+        // import are restored instead of keeping a half-parsed file.
+        if (xml.hasError()) {
+            qDebug() << "Abort processing iTunes music collection";
+            qDebug() << "line:" << xml.lineNumber() <<
+                    "column:" << xml.columnNumber() <<
+                    "error:" << xml.errorString();
+        }
+        delete playlist_root;
+        return nullptr;
+    }
+
     if (isMusicFolderLocatedAfterTracks) {
         qDebug() << "Updating iTunes real path from " << m_dbItunesRoot << " to " << m_mixxxItunesRoot;
         // In some iTunes files "Music Folder" XML node is located at the end of file. So, we need to
@@ -441,35 +462,34 @@ TreeItem* ITunesFeature::importLibrary() {
         }
     }
 
-    // Even if an error occurred, commit the transaction. The file may have been
-    // half-parsed.
+    if (playlist_root) {
+        saveImportState(m_database, fingerprint, playlist_root);
+    }
     transaction.commit();
 
-    if (xml.hasError()) {
-        // do error handling
-        qDebug() << "Abort processing iTunes music collection";
-        qDebug() << "line:" << xml.lineNumber() <<
-                "column:" << xml.columnNumber() <<
-                "error:" << xml.errorString();
-        if (playlist_root) {
-            delete playlist_root;
-        }
-        playlist_root = nullptr;
-    }
     return playlist_root;
 }
 
 void ITunesFeature::parseTracks(QXmlStreamReader& xml) {
     bool in_container_dictionary = false;
     bool in_track_dictionary = false;
-    QSqlQuery query(m_database);
-    query.prepare("INSERT INTO itunes_library (id, artist, title, album, album_artist, year, genre, grouping, comment, tracknumber,"
-                  "bpm, bitrate,"
-                  "duration, location,"
-                  "rating ) "
-                  "VALUES (:id, :artist, :title, :album, :album_artist, :year, :genre, :grouping, :comment, :tracknumber,"
-                  ":bpm, :bitrate,"
-                  ":duration, :location," ":rating )");
+    BatchInsertQuery trackInserter(m_database,
+            QStringLiteral("itunes_library"),
+            {QStringLiteral("id"),
+                    QStringLiteral("artist"),
+                    QStringLiteral("title"),
+                    QStringLiteral("album"),
+                    QStringLiteral("album_artist"),
+                    QStringLiteral("year"),
+                    QStringLiteral("genre"),
+                    QStringLiteral("grouping"),
+                    QStringLiteral("comment"),
+                    QStringLiteral("tracknumber"),
+                    QStringLiteral("bpm"),
+                    QStringLiteral("bitrate"),
+                    QStringLiteral("duration"),
+                    QStringLiteral("location"),
+                    QStringLiteral("rating")});
 
     qDebug() << "Parse iTunes music collection";
 
@@ -486,7 +506,7 @@ void ITunesFeature::parseTracks(QXmlStreamReader& xml) {
                     // We are in a <dict> tag that holds track information
                     in_track_dictionary = true;
                     // Parse track here
-                    parseTrack(xml, query);
+                    parseTrack(xml, &trackInserter);
                 }
             }
         }
@@ -501,9 +521,11 @@ void ITunesFeature::parseTracks(QXmlStreamReader& xml) {
             }
         }
     }
+    trackInserter.flush();
+    qDebug() << "Inserted" << trackInserter.insertedRows() << "iTunes tracks";
 }
 
-void ITunesFeature::parseTrack(QXmlStreamReader& xml, QSqlQuery& query) {
+void ITunesFeature::parseTrack(QXmlStreamReader& xml, BatchInsertQuery* pTrackInserter) {
     //qDebug() << "----------------TRACK-----------------";
     int id = -1;
     QString title;
@@ -626,28 +648,21 @@ void ITunesFeature::parseTrack(QXmlStreamReader& xml, QSqlQuery& query) {
 
     // If we reach the end of <dict>
     // Save parsed track to database
-    query.bindValue(":id", id);
-    query.bindValue(":artist", artist);
-    query.bindValue(":title", title);
-    query.bindValue(":album", album);
-    query.bindValue(":album_artist", album_artist);
-    query.bindValue(":genre", genre);
-    query.bindValue(":grouping", grouping);
-    query.bindValue(":year", year);
-    query.bindValue(":duration", playtime);
-    query.bindValue(":location", location);
-    query.bindValue(":rating", rating);
-    query.bindValue(":comment", comment);
-    query.bindValue(":tracknumber", tracknumber);
-    query.bindValue(":bpm", bpm);
-    query.bindValue(":bitrate", bitrate);
-
-    bool success = query.exec();
-
-    if (!success) {
-        LOG_FAILED_QUERY(query);
-        return;
-    }
+    pTrackInserter->addRow({id,
+            artist,
+            title,
+            album,
+            album_artist,
+            year,
+            genre,
+            grouping,
+            comment,
+            tracknumber,
+            bpm,
+            bitrate,
+            playtime,
+            location,
+            rating});
 }
 
 TreeItem* ITunesFeature::parsePlaylists(QXmlStreamReader& xml) {
@@ -657,10 +672,11 @@ TreeItem* ITunesFeature::parsePlaylists(QXmlStreamReader& xml) {
     query_insert_to_playlists.prepare("INSERT INTO itunes_playlists (id, name) "
                                       "VALUES (:id, :name)");
 
-    QSqlQuery query_insert_to_playlist_tracks(m_database);
-    query_insert_to_playlist_tracks.prepare(
-        "INSERT INTO itunes_playlist_tracks (playlist_id, track_id, position) "
-        "VALUES (:playlist_id, :track_id, :position)");
+    BatchInsertQuery playlistTrackInserter(m_database,
+            QStringLiteral("itunes_playlist_tracks"),
+            {QStringLiteral("playlist_id"),
+                    QStringLiteral("track_id"),
+                    QStringLiteral("position")});
 
     while (!xml.atEnd() && !m_cancelImport) {
         xml.readNext();
@@ -668,7 +684,7 @@ TreeItem* ITunesFeature::parsePlaylists(QXmlStreamReader& xml) {
         if (xml.isStartElement() && xml.name() == kDict) {
             parsePlaylist(xml,
                           query_insert_to_playlists,
-                          query_insert_to_playlist_tracks,
+                          &playlistTrackInserter,
                           pRootItem.get());
             continue;
         }
@@ -678,6 +694,7 @@ TreeItem* ITunesFeature::parsePlaylists(QXmlStreamReader& xml) {
             }
         }
     }
+    playlistTrackInserter.flush();
     return pRootItem.release();
 }
 
@@ -693,7 +710,7 @@ bool ITunesFeature::readNextStartElement(QXmlStreamReader& xml) {
 }
 
 void ITunesFeature::parsePlaylist(QXmlStreamReader& xml, QSqlQuery& query_insert_to_playlists,
-                                  QSqlQuery& query_insert_to_playlist_tracks, TreeItem* root) {
+                                  BatchInsertQuery* pPlaylistTrackInserter, TreeItem* root) {
     //qDebug() << "Parse Playlist";
 
     QString playlistname;
@@ -774,18 +791,12 @@ void ITunesFeature::parsePlaylist(QXmlStreamReader& xml, QSqlQuery& query_insert
                     readNextStartElement(xml);
                     track_reference = xml.readElementText().toInt();
 
-                    query_insert_to_playlist_tracks.bindValue(":playlist_id", playlist_id);
-                    query_insert_to_playlist_tracks.bindValue(":track_id", track_reference);
-                    query_insert_to_playlist_tracks.bindValue(":position", playlist_position++);
-
                     //Insert tracks if we are not in a pre-build playlist
-                    if (!isSystemPlaylist && !query_insert_to_playlist_tracks.exec()) {
-                        qDebug() << "SQL Error in ITunesFeature.cpp: line" << __LINE__ << " "
-                                 << query_insert_to_playlist_tracks.lastError();
-                        qDebug() << "trackid" << track_reference;
-                        qDebug() << "playlistname; " << playlistname;
-                        qDebug() << "-----------------";
+                    if (!isSystemPlaylist) {
+                        pPlaylistTrackInserter->addRow(
+                                {playlist_id, track_reference, playlist_position});
                     }
+                    ++playlist_position;
                 }
             }
         }
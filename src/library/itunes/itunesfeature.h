@@ -15,6 +15,7 @@
 
 class BaseExternalTrackModel;
 class BaseExternalPlaylistModel;
+class BatchInsertQuery;
 class WLibrarySidebar;
 
 class ITunesFeature : public BaseExternalLibraryFeature {
@@ -40,13 +41,13 @@ class ITunesFeature : public BaseExternalLibraryFeature {
     BaseSqlTableModel* getPlaylistModelForPlaylist(const QString& playlist) override;
     static QString getiTunesMusicPath();
     // returns the invisible rootItem for the sidebar model
-    TreeItem* importLibrary();
+    TreeItem* importLibrary(bool forceReimport);
     void guessMusicLibraryMountpoint(QXmlStreamReader& xml);
     void parseTracks(QXmlStreamReader& xml);
-    void parseTrack(QXmlStreamReader& xml, QSqlQuery& query);
+    void parseTrack(QXmlStreamReader& xml, BatchInsertQuery* pTrackInserter);
     TreeItem* parsePlaylists(QXmlStreamReader &xml);
     void parsePlaylist(QXmlStreamReader& xml, QSqlQuery& query1,
-                       QSqlQuery &query2, TreeItem*);
+                       BatchInsertQuery* pPlaylistTrackInserter, TreeItem*);
     void clearTable(const QString& table_name);
     bool readNextStartElement(QXmlStreamReader& xml);
 
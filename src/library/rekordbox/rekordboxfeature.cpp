@@ -2,11 +2,13 @@
 
 #include <mp3guessenc.h>
 
+#include <QHash>
 #include <QMap>
 #include <QMessageBox>
 #include <QSettings>
 #include <QTextCodec>
 #include <QtDebug>
+#include <istream>
 
 #include "engine/engine.h"
 #include "library/dao/trackschema.h"
@@ -26,6 +28,7 @@
 #include "util/color/color.h"
 #include "util/db/dbconnectionpooled.h"
 #include "util/db/dbconnectionpooler.h"
+#include "util/mappedfile.h"
 #include "util/sandbox.h"
 #include "waveform/waveform.h"
 #include "widget/wlibrary.h"
@@ -302,21 +305,7 @@ int createDevicePlaylist(QSqlDatabase& database, const QString& devicePath) {
         return playlistID;
     }
 
-    QSqlQuery idQuery(database);
-    idQuery.prepare("select id from " + kRekordboxPlaylistsTable + " where name=:path");
-    idQuery.bindValue(":path", devicePath);
-
-    if (!idQuery.exec()) {
-        LOG_FAILED_QUERY(idQuery)
-                << "devicePath: " << devicePath;
-        return playlistID;
-    }
-
-    while (idQuery.next()) {
-        playlistID = idQuery.value(idQuery.record().indexOf("id")).toInt();
-    }
-
-    return playlistID;
+    return queryInsertIntoDevicePlaylist.lastInsertId().toInt();
 }
 
 mixxx::RgbColor colorFromID(int colorID) {
@@ -341,8 +330,8 @@ mixxx::RgbColor colorFromID(int colorID) {
     return kColorForIDNoColor;
 }
 
-void insertTrack(
-        QSqlDatabase& database,
+// Returns the id of the inserted track or -1
+int insertTrack(
         rekordbox_pdb_t::track_row_t* track,
         QSqlQuery& query,
         QSqlQuery& queryInsertIntoDevicePlaylistTracks,
@@ -389,24 +378,11 @@ void insertTrack(
             mixxx::RgbColor::toQVariant(
                     colorFromID(static_cast<int>(track->color_id()))));
 
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
-    }
-
     int trackID = -1;
-    QSqlQuery finderQuery(database);
-    finderQuery.prepare("select id from " + kRekordboxLibraryTable +
-            " where rb_id=:rb_id and device=:device");
-    finderQuery.bindValue(":rb_id", rbID);
-    finderQuery.bindValue(":device", device);
-
-    if (!finderQuery.exec()) {
-        LOG_FAILED_QUERY(finderQuery)
-                << "rbID:" << rbID;
-    }
-
-    if (finderQuery.next()) {
-        trackID = finderQuery.value(finderQuery.record().indexOf("id")).toInt();
+    if (query.exec()) {
+        trackID = query.lastInsertId().toInt();
+    } else {
+        LOG_FAILED_QUERY(query);
     }
 
     // Insert into device all tracks playlist
@@ -418,6 +394,7 @@ void insertTrack(
                 << "trackID:" << trackID
                 << "position:" << audioFilesCount;
     }
+    return trackID;
 }
 
 void buildPlaylistTree(
@@ -428,8 +405,8 @@ void buildPlaylistTree(
         QMap<uint32_t, bool>& playlistIsFolderMap,
         QMap<uint32_t, QMap<uint32_t, uint32_t>>& playlistTreeMap,
         QMap<uint32_t, QMap<uint32_t, uint32_t>>& playlistTrackMap,
-        const QString& playlistPath,
-        const QString& device);
+        const QHash<uint32_t, int>& trackIdMap,
+        const QString& playlistPath);
 
 QString parseDeviceDB(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* deviceItem) {
     QString device = deviceItem->getLabel();
@@ -487,8 +464,15 @@ QString parseDeviceDB(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* dev
     if (!Sandbox::askForAccess(&fileInfo)) {
         return QString();
     }
-    std::ifstream ifs(dbPath.toStdString(), std::ifstream::binary);
-    kaitai::kstream ks(&ifs);
+    // The parser seeks between the pages of all tables, so it reads the
+    // whole file from memory.
+    mixxx::MappedFile dbFile;
+    if (!dbFile.open(dbPath)) {
+        return QString();
+    }
+    mixxx::MappedFileStreamBuf dbStreamBuf(dbFile);
+    std::istream dbStream(&dbStreamBuf);
+    kaitai::kstream ks(&dbStream);
 
     rekordbox_pdb_t reckordboxDB = rekordbox_pdb_t(&ks);
 
@@ -519,6 +503,8 @@ QString parseDeviceDB(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* dev
     QMap<uint32_t, bool> playlistIsFolderMap;
     QMap<uint32_t, QMap<uint32_t, uint32_t>> playlistTreeMap;
     QMap<uint32_t, QMap<uint32_t, uint32_t>> playlistTrackMap;
+    // Rekordbox track id -> track id in kRekordboxLibraryTable
+    QHash<uint32_t, int> trackIdMap;
 
     bool folderOrPlaylistFound = false;
 
@@ -595,10 +581,11 @@ QString parseDeviceDB(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* dev
                                     } break;
                                     case rekordbox_pdb_t::PAGE_TYPE_TRACKS: {
                                         // Track found, insert into database
-                                        insertTrack(database,
-                                                static_cast<rekordbox_pdb_t::
-                                                                track_row_t*>(
-                                                        (*rowRef)->body()),
+                                        auto* track = static_cast<
+                                                rekordbox_pdb_t::track_row_t*>(
+                                                (*rowRef)->body());
+                                        trackIdMap[track->id()] = insertTrack(
+                                                track,
                                                 query,
                                                 queryInsertIntoDevicePlaylistTracks,
                                                 artistsMap,
@@ -659,8 +646,8 @@ QString parseDeviceDB(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* dev
                 playlistIsFolderMap,
                 playlistTreeMap,
                 playlistTrackMap,
-                devicePath,
-                device);
+                trackIdMap,
+                devicePath);
     }
 
     qDebug() << "Found: " << audioFilesCount << " audio files in Rekordbox device " << device;
@@ -678,8 +665,8 @@ void buildPlaylistTree(
         QMap<uint32_t, bool>& playlistIsFolderMap,
         QMap<uint32_t, QMap<uint32_t, uint32_t>>& playlistTreeMap,
         QMap<uint32_t, QMap<uint32_t, uint32_t>>& playlistTrackMap,
-        const QString& playlistPath,
-        const QString& device) {
+        const QHash<uint32_t, int>& trackIdMap,
+        const QString& playlistPath) {
     for (uint32_t childIndex = 0;
             childIndex < (uint32_t)playlistTreeMap[parentID].size();
             childIndex++) {
@@ -709,21 +696,7 @@ void buildPlaylistTree(
                     << "currentPath" << currentPath;
             return;
         }
-
-        QSqlQuery idQuery(database);
-        idQuery.prepare("select id from " + kRekordboxPlaylistsTable + " where name=:path");
-        idQuery.bindValue(":path", currentPath);
-
-        if (!idQuery.exec()) {
-            LOG_FAILED_QUERY(idQuery)
-                    << "currentPath" << currentPath;
-            return;
-        }
-
-        int playlistID = -1;
-        while (idQuery.next()) {
-            playlistID = idQuery.value(idQuery.record().indexOf("id")).toInt();
-        }
+        const int playlistID = queryInsertIntoPlaylist.lastInsertId().toInt();
 
         QSqlQuery queryInsertIntoPlaylistTracks(database);
         queryInsertIntoPlaylistTracks.prepare(
@@ -738,23 +711,7 @@ void buildPlaylistTree(
                     trackIndex++) {
                 uint32_t rbTrackID = playlistTrackMap[childID][trackIndex];
 
-                int trackID = -1;
-                QSqlQuery finderQuery(database);
-                finderQuery.prepare("select id from " + kRekordboxLibraryTable +
-                        " where rb_id=:rb_id and device=:device");
-                finderQuery.bindValue(":rb_id", rbTrackID);
-                finderQuery.bindValue(":device", device);
-
-                if (!finderQuery.exec()) {
-                    LOG_FAILED_QUERY(finderQuery)
-                            << "rbTrackID:" << rbTrackID
-                            << "device:" << device;
-                    return;
-                }
-
-                if (finderQuery.next()) {
-                    trackID = finderQuery.value(finderQuery.record().indexOf("id")).toInt();
-                }
+                const int trackID = trackIdMap.value(rbTrackID, -1);
 
                 queryInsertIntoPlaylistTracks.bindValue(":playlist_id", playlistID);
                 queryInsertIntoPlaylistTracks.bindValue(":track_id", trackID);
@@ -780,8 +737,8 @@ void buildPlaylistTree(
                     playlistIsFolderMap,
                     playlistTreeMap,
                     playlistTrackMap,
-                    currentPath,
-                    device);
+                    trackIdMap,
+                    currentPath);
         }
     }
 }
@@ -900,8 +857,13 @@ void readAnalyze(TrackPointer track,
 
     qDebug() << "Rekordbox ANLZ path:" << anlzPath << " for: " << track->getTitle();
 
-    std::ifstream ifs(anlzPath.toStdString(), std::ifstream::binary);
-    kaitai::kstream ks(&ifs);
+    mixxx::MappedFile anlzFile;
+    if (!anlzFile.open(anlzPath)) {
+        return;
+    }
+    mixxx::MappedFileStreamBuf anlzStreamBuf(anlzFile);
+    std::istream anlzStream(&anlzStreamBuf);
+    kaitai::kstream ks(&anlzStream);
 
     rekordbox_anlz_t anlz = rekordbox_anlz_t(&ks);
 
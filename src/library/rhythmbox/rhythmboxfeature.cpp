@@ -7,6 +7,7 @@
 
 #include "library/baseexternalplaylistmodel.h"
 #include "library/baseexternaltrackmodel.h"
+#include "library/batchinsertquery.h"
 #include "library/library.h"
 #include "library/queryutil.h"
 #include "library/trackcollection.h"
@@ -14,6 +15,27 @@
 #include "library/treeitem.h"
 #include "moc_rhythmboxfeature.cpp"
 
+namespace {
+
+// Returns the path of the given file in the Rhythmbox data directory or
+// an empty string if it doesn't exist. An API call which tells us where
+// the file is would be nice.
+QString rhythmboxFilePath(const QString& fileName) {
+    const QStringList dataDirs = {
+            QDir::homePath() + QStringLiteral("/.gnome2/rhythmbox/"),
+            QDir::homePath() + QStringLiteral("/.local/share/rhythmbox/"),
+    };
+    for (const auto& dataDir : dataDirs) {
+        const QString filePath = dataDir + fileName;
+        if (QFile::exists(filePath)) {
+            return filePath;
+        }
+    }
+    return QString();
+}
+
+} // anonymous namespace
+
 RhythmboxFeature::RhythmboxFeature(Library* pLibrary, UserSettingsPointer pConfig)
         : BaseExternalLibraryFeature(pLibrary, pConfig, QStringLiteral("rhythmbox")),
           m_pSidebarModel(make_parented<TreeItemModel>(this)),
@@ -144,37 +166,51 @@ void RhythmboxFeature::activateChild(const QModelIndex& index) {
 
 TreeItem* RhythmboxFeature::importMusicCollection() {
     qDebug() << "importMusicCollection Thread Id: " << QThread::currentThread();
-     // Try and open the Rhythmbox DB. An API call which tells us where
-     // the file is would be nice.
-    QFile db(QDir::homePath() + "/.gnome2/rhythmbox/rhythmdb.xml");
-    if (!db.exists()) {
-        db.setFileName(QDir::homePath() + "/.local/share/rhythmbox/rhythmdb.xml");
-        if (!db.exists()) {
-            return nullptr;
-        }
+    const QString dbFilePath = rhythmboxFilePath(QStringLiteral("rhythmdb.xml"));
+    if (dbFilePath.isEmpty()) {
+        return nullptr;
     }
+    const QString playlistsFilePath = rhythmboxFilePath(QStringLiteral("playlists.xml"));
 
+    const QString fingerprint = importFingerprint({dbFilePath, playlistsFilePath});
+    std::unique_ptr<TreeItem> pRestoredRootItem = restoreImportState(m_database, fingerprint);
+    if (pRestoredRootItem) {
+        qDebug() << "Rhythmbox music collection is unchanged";
+        return pRestoredRootItem.release();
+    }
+
+    QFile db(dbFilePath);
     mixxx::FileInfo fileInfo(db);
     if (!Sandbox::askForAccess(&fileInfo) ||
             !db.open(QIODevice::ReadOnly)) {
         return nullptr;
     }
 
-    //Delete all table entries of Traktor feature
+    //Delete all table entries of Rhythmbox feature
     ScopedTransaction transaction(m_database);
+    resetImportState(m_database);
     clearTable("rhythmbox_playlist_tracks");
     clearTable("rhythmbox_library");
     clearTable("rhythmbox_playlists");
-    transaction.commit();
-
-    transaction.transaction();
-    QSqlQuery query(m_database);
-    query.prepare("INSERT INTO rhythmbox_library (artist, title, album, year, "
-                  "genre, comment, tracknumber, bpm, bitrate,"
-                  "duration, location, rating ) "
-                  "VALUES (:artist, :title, :album, :year, :genre, :comment, "
-                  ":tracknumber, :bpm, :bitrate, :duration, :location, :rating )");
 
+    // The ids are assigned here to resolve the tracks of the playlists
+    // without querying them
+    BatchInsertQuery trackInserter(m_database,
+            QStringLiteral("rhythmbox_library"),
+            {QStringLiteral("id"),
+                    QStringLiteral("artist"),
+                    QStringLiteral("title"),
+                    QStringLiteral("album"),
+                    QStringLiteral("year"),
+                    QStringLiteral("genre"),
+                    QStringLiteral("comment"),
+                    QStringLiteral("tracknumber"),
+                    QStringLiteral("bpm"),
+                    QStringLiteral("bitrate"),
+                    QStringLiteral("duration"),
+                    QStringLiteral("location"),
+                    QStringLiteral("rating")});
+    QHash<QString, int> trackIdsByLocation;
 
     QXmlStreamReader xml(&db);
     while (!xml.atEnd() && !m_cancelImport) {
@@ -183,11 +219,11 @@ TreeItem* RhythmboxFeature::importMusicCollection() {
             QXmlStreamAttributes attr = xml.attributes();
             //Check if we really parse a track and not album art information
             if (attr.value("type").toString() == "song") {
-                importTrack(xml, query);
+                importTrack(xml, &trackInserter, &trackIdsByLocation);
             }
         }
     }
-    transaction.commit();
+    trackInserter.flush();
 
     if (xml.hasError()) {
         // do error handling
@@ -197,21 +233,30 @@ TreeItem* RhythmboxFeature::importMusicCollection() {
     }
 
     db.close();
+    // Leave the transaction uncommitted on cancel, so the tables of the
+    // previous import are restored.
     if (m_cancelImport) {
         return nullptr;
     }
-    return importPlaylists();
+    TreeItem* root = importPlaylists(playlistsFilePath, trackIdsByLocation);
+    if (m_cancelImport) {
+        delete root;
+        return nullptr;
+    }
+    if (root) {
+        saveImportState(m_database, fingerprint, root);
+    }
+    transaction.commit();
+    return root;
 }
 
-TreeItem* RhythmboxFeature::importPlaylists() {
-    QFile db(QDir::homePath() + "/.gnome2/rhythmbox/playlists.xml");
-    if (!db.exists()) {
-        db.setFileName(QDir::homePath() + "/.local/share/rhythmbox/playlists.xml");
-        if (!db.exists()) {
-            return nullptr;
-        }
+TreeItem* RhythmboxFeature::importPlaylists(const QString& filePath,
+        const QHash<QString, int>& trackIdsByLocation) {
+    if (filePath.isEmpty()) {
+        return nullptr;
     }
     //Open file
+    QFile db(filePath);
     if (!db.open(QIODevice::ReadOnly)) {
         return nullptr;
     }
@@ -219,11 +264,13 @@ TreeItem* RhythmboxFeature::importPlaylists() {
     QSqlQuery query_insert_to_playlists(m_database);
     query_insert_to_playlists.prepare("INSERT INTO rhythmbox_playlists (id, name) "
                                       "VALUES (:id, :name)");
+    int playlist_id = 0;
 
-    QSqlQuery query_insert_to_playlist_tracks(m_database);
-    query_insert_to_playlist_tracks.prepare(
-            "INSERT INTO rhythmbox_playlist_tracks (playlist_id, track_id, position) "
-            "VALUES (:playlist_id, :track_id, :position)");
+    BatchInsertQuery playlistTrackInserter(m_database,
+            QStringLiteral("rhythmbox_playlist_tracks"),
+            {QStringLiteral("playlist_id"),
+                    QStringLiteral("track_id"),
+                    QStringLiteral("position")});
     //The tree structure holding the playlists
     std::unique_ptr<TreeItem> rootItem = TreeItem::newRoot(this);
 
@@ -241,6 +288,7 @@ TreeItem* RhythmboxFeature::importPlaylists() {
                 rootItem->appendChild(playlist_name);
 
                 //Execute SQL statement
+                query_insert_to_playlists.bindValue(":id", ++playlist_id);
                 query_insert_to_playlists.bindValue(":name", playlist_name);
 
                 if (!query_insert_to_playlists.exec()) {
@@ -249,14 +297,12 @@ TreeItem* RhythmboxFeature::importPlaylists() {
                     continue;
                 }
 
-                // get playlist_id
-                int playlist_id = query_insert_to_playlists.lastInsertId().toInt();
-
                 //Process playlist entries
-                importPlaylist(xml, query_insert_to_playlist_tracks, playlist_id);
+                importPlaylist(xml, playlist_id, trackIdsByLocation, &playlistTrackInserter);
             }
         }
     }
+    playlistTrackInserter.flush();
 
     if (xml.hasError()) {
         // do error handling
@@ -269,7 +315,9 @@ TreeItem* RhythmboxFeature::importPlaylists() {
     return rootItem.release();
 }
 
-void RhythmboxFeature::importTrack(QXmlStreamReader &xml, QSqlQuery &query) {
+void RhythmboxFeature::importTrack(QXmlStreamReader& xml,
+        BatchInsertQuery* pTrackInserter,
+        QHash<QString, int>* pTrackIdsByLocation) {
     QString title;
     QString artist;
     QString album;
@@ -345,32 +393,34 @@ void RhythmboxFeature::importTrack(QXmlStreamReader &xml, QSqlQuery &query) {
         return;
     }
 
-    query.bindValue(":artist", artist);
-    query.bindValue(":title", title);
-    query.bindValue(":album", album);
-    query.bindValue(":genre", genre);
-    query.bindValue(":year", year);
-    query.bindValue(":duration", playtime);
-    query.bindValue(":location", location);
-    query.bindValue(":rating", rating);
-    query.bindValue(":comment", comment);
-    query.bindValue(":tracknumber", tracknumber);
-    query.bindValue(":bpm", bpm);
-    query.bindValue(":bitrate", bitrate);
-
-    bool success = query.exec();
-
-    if (!success) {
-        qDebug() << "SQL Error in rhythmboxfeature.cpp: line" << __LINE__
-                 << " " << query.lastError();
+    // The location is unique, only the first track is inserted
+    if (pTrackIdsByLocation->contains(location)) {
+        qDebug() << "Skipping duplicate Rhythmbox track" << location;
         return;
     }
+    const int id = pTrackIdsByLocation->size() + 1;
+    pTrackIdsByLocation->insert(location, id);
+
+    pTrackInserter->addRow({id,
+            artist,
+            title,
+            album,
+            year,
+            genre,
+            comment,
+            tracknumber,
+            bpm,
+            bitrate,
+            playtime,
+            location,
+            rating});
 }
 
-// reads all playlist entries and executes a SQL statement
-void RhythmboxFeature::importPlaylist(QXmlStreamReader &xml,
-                                      QSqlQuery &query_insert_to_playlist_tracks,
-                                      int playlist_id) {
+// reads all playlist entries and adds them to the batch of inserted entries
+void RhythmboxFeature::importPlaylist(QXmlStreamReader& xml,
+        int playlist_id,
+        const QHash<QString, int>& trackIdsByLocation,
+        BatchInsertQuery* pPlaylistTrackInserter) {
     int playlist_position = 1;
     while (!xml.atEnd()) {
         //read next XML element
@@ -379,33 +429,11 @@ void RhythmboxFeature::importPlaylist(QXmlStreamReader &xml,
             const auto fileInfo = mixxx::FileInfo::fromQUrl(xml.readElementText());
 
             //get the ID of the file in the rhythmbox_library table
-            int track_id = -1;
-            QSqlQuery finder_query(m_database);
-            finder_query.prepare("select id from rhythmbox_library where location=:path");
-            finder_query.bindValue(":path", fileInfo.location());
-            bool success = finder_query.exec();
-
-            if (success) {
-                const int idColumn = finder_query.record().indexOf("id");
-                while (finder_query.next()) {
-                    track_id = finder_query.value(idColumn).toInt();
-                }
-             } else {
-                qDebug() << "SQL Error in RhythmboxFeature.cpp: line"
-                         << __LINE__ << " " << finder_query.lastError();
-            }
-
-            query_insert_to_playlist_tracks.bindValue(":playlist_id", playlist_id);
-            query_insert_to_playlist_tracks.bindValue(":track_id", track_id);
-            query_insert_to_playlist_tracks.bindValue(":position", playlist_position++);
-            success = query_insert_to_playlist_tracks.exec();
-
-            if (!success) {
-                qDebug() << "SQL Error in RhythmboxFeature.cpp: line" << __LINE__ << " "
-                         << query_insert_to_playlist_tracks.lastError()
-                         << "trackid" << track_id
-                         << "playlis ID " << playlist_id
-                         << "-----------------";
+            const int track_id = trackIdsByLocation.value(fileInfo.location(), -1);
+            if (!pPlaylistTrackInserter->addRow(
+                        {playlist_id, track_id, playlist_position++})) {
+                qDebug() << "Failed to insert tracks of Rhythmbox playlist with ID"
+                         << playlist_id;
             }
         }
         // Exit the the loop if we reach the closing <playlist> tag
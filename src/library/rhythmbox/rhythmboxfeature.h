@@ -2,6 +2,7 @@
 
 #include <QFuture>
 #include <QFutureWatcher>
+#include <QHash>
 #include <QStringListModel>
 #include <QXmlStreamReader>
 #include <QtConcurrentRun>
@@ -14,6 +15,7 @@
 
 class BaseExternalTrackModel;
 class BaseExternalPlaylistModel;
+class BatchInsertQuery;
 
 class RhythmboxFeature : public BaseExternalLibraryFeature {
     Q_OBJECT
@@ -28,7 +30,8 @@ class RhythmboxFeature : public BaseExternalLibraryFeature {
     // processes the music collection
     TreeItem* importMusicCollection();
     // processes the playlist entries
-    TreeItem* importPlaylists();
+    TreeItem* importPlaylists(const QString& filePath,
+            const QHash<QString, int>& trackIdsByLocation);
 
   public slots:
     void activate();
@@ -39,10 +42,15 @@ class RhythmboxFeature : public BaseExternalLibraryFeature {
     virtual BaseSqlTableModel* getPlaylistModelForPlaylist(const QString& playlist);
     // Removes all rows from a given table
     void clearTable(const QString& table_name);
-    // reads the properties of a track and executes a SQL statement
-    void importTrack(QXmlStreamReader &xml, QSqlQuery &query);
-    // reads all playlist entries and executes a SQL statement
-    void importPlaylist(QXmlStreamReader &xml, QSqlQuery &query, int playlist_id);
+    // reads the properties of a track and adds it to the batch of inserted tracks
+    void importTrack(QXmlStreamReader& xml,
+            BatchInsertQuery* pTrackInserter,
+            QHash<QString, int>* pTrackIdsByLocation);
+    // reads all playlist entries and adds them to the batch of inserted entries
+    void importPlaylist(QXmlStreamReader& xml,
+            int playlist_id,
+            const QHash<QString, int>& trackIdsByLocation,
+            BatchInsertQuery* pPlaylistTrackInserter);
 
     BaseExternalTrackModel* m_pRhythmboxTrackModel;
     BaseExternalPlaylistModel* m_pRhythmboxPlaylistModel;
@@ -9,6 +9,7 @@
 #include "library/dao/trackschema.h"
 #include "library/library.h"
 #include "library/queryutil.h"
+#include "library/serato/seratofieldreader.h"
 #include "library/trackcollection.h"
 #include "library/trackcollectionmanager.h"
 #include "library/treeitem.h"
@@ -19,6 +20,7 @@
 #include "util/color/color.h"
 #include "util/db/dbconnectionpooled.h"
 #include "util/db/dbconnectionpooler.h"
+#include "util/mappedfile.h"
 #include "widget/wlibrary.h"
 #include "widget/wlibrarytextbrowser.h"
 
@@ -92,8 +94,6 @@ const QString kSeratoLibraryTable = QStringLiteral("serato_library");
 const QString kSeratoPlaylistsTable = QStringLiteral("serato_playlists");
 const QString kSeratoPlaylistTracksTable = QStringLiteral("serato_playlist_tracks");
 
-constexpr int kHeaderSize = 2 * sizeof(quint32);
-
 int createPlaylist(const QSqlDatabase& database, const QString& name, const QString& databasePath) {
     QSqlQuery query(database);
     query.prepare(
@@ -110,21 +110,24 @@ int createPlaylist(const QSqlDatabase& database, const QString& name, const QStr
     return query.lastInsertId().toInt();
 }
 
-int insertTrackIntoPlaylist(const QSqlDatabase& database, int playlistId, int trackId, int position) {
-    QSqlQuery query(database);
-    query.prepare(
-            "INSERT INTO serato_playlist_tracks (playlist_id, track_id, position) "
-            "VALUES (:playlist_id, :track_id, :position)");
-    query.bindValue(":playlist_id", playlistId);
-    query.bindValue(":track_id", trackId);
-    query.bindValue(":position", position);
+// The query is prepared by the caller once for all tracks
+int insertTrackIntoPlaylist(QSqlQuery* pQuery, int playlistId, int trackId, int position) {
+    pQuery->bindValue(":playlist_id", playlistId);
+    pQuery->bindValue(":track_id", trackId);
+    pQuery->bindValue(":position", position);
 
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
+    if (!pQuery->exec()) {
+        LOG_FAILED_QUERY(*pQuery);
         return -1;
     }
 
-    return query.lastInsertId().toInt();
+    return pQuery->lastInsertId().toInt();
+}
+
+void prepareInsertTrackIntoPlaylist(QSqlQuery* pQuery) {
+    pQuery->prepare(
+            "INSERT INTO serato_playlist_tracks (playlist_id, track_id, position) "
+            "VALUES (:playlist_id, :track_id, :position)");
 }
 
 inline QString utf16beToQString(const QByteArray& data, const quint32 size) {
@@ -145,23 +148,12 @@ inline quint32 bytesToUInt32(const QByteArray& data) {
     return qFromBigEndian<quint32>(data.constData());
 }
 
-inline bool parseTrack(serato_track_t* track, QIODevice* buffer) {
-    QByteArray headerData = buffer->read(kHeaderSize);
-    while (headerData.length() == kHeaderSize) {
-        quint32 fieldId = bytesToUInt32(headerData.mid(0, sizeof(quint32)));
-        quint32 fieldSize = bytesToUInt32(headerData.mid(sizeof(quint32), kHeaderSize));
-
-        // Read field data
-        QByteArray data = buffer->read(fieldSize);
-        if (static_cast<quint32>(data.length()) != fieldSize) {
-            QString fieldName = QString(headerData.mid(0, sizeof(quint32)));
-            qWarning() << "Failed to read "
-                       << fieldSize
-                       << " bytes for "
-                       << fieldName
-                       << " field.";
-            return false;
-        }
+inline bool parseTrack(serato_track_t* track, const QByteArray& trackData) {
+    SeratoFieldReader reader(trackData);
+    quint32 fieldId;
+    QByteArray data;
+    while (reader.next(&fieldId, &data)) {
+        const quint32 fieldSize = static_cast<quint32>(data.size());
 
         // Parse field data
         switch (static_cast<FieldId>(fieldId)) {
@@ -253,21 +245,24 @@ inline bool parseTrack(serato_track_t* track, QIODevice* buffer) {
             // parse the integer version, it doesn't make sense to parse this.
             break;
         default: {
-            QString fieldName = QString(headerData.mid(0, sizeof(quint32)));
             qDebug() << "Ignoring unknown field "
-                     << fieldName
+                     << SeratoFieldReader::fieldName(fieldId)
                      << " ("
                      << fieldSize
                      << " bytes).";
         }
         }
-
-        headerData = buffer->read(kHeaderSize);
     }
 
-    if (headerData.length() != 0) {
+    if (reader.isTruncated()) {
+        qWarning() << "Failed to read "
+                   << SeratoFieldReader::fieldName(fieldId)
+                   << " field.";
+        return false;
+    }
+    if (reader.remaining() != 0) {
         qWarning() << "Found "
-                   << headerData.length()
+                   << reader.remaining()
                    << " extra bytes at end of track definition.";
         return false;
     }
@@ -282,46 +277,36 @@ inline bool parseTrack(serato_track_t* track, QIODevice* buffer) {
     return true;
 }
 
-inline QString parseCrateTrackPath(QIODevice* buffer) {
+inline QString parseCrateTrackPath(const QByteArray& trackData) {
     QString location;
-    QByteArray headerData = buffer->read(kHeaderSize);
-    while (headerData.length() == kHeaderSize) {
-        quint32 fieldId = bytesToUInt32(headerData.mid(0, sizeof(quint32)));
-        quint32 fieldSize = bytesToUInt32(headerData.mid(sizeof(quint32), kHeaderSize));
-
-        // Read field data
-        QByteArray data = buffer->read(fieldSize);
-        if (static_cast<quint32>(data.length()) != fieldSize) {
-            QString fieldName = QString(headerData.mid(0, sizeof(quint32)));
-            qWarning() << "Failed to read "
-                       << fieldSize
-                       << " bytes for "
-                       << fieldName
-                       << " field.";
-            return QString();
-        }
-
+    SeratoFieldReader reader(trackData);
+    quint32 fieldId;
+    QByteArray data;
+    while (reader.next(&fieldId, &data)) {
         // Parse field data
         switch (static_cast<FieldId>(fieldId)) {
         case FieldId::TrackPath:
-            location = utf16beToQString(data, fieldSize);
+            location = utf16beToQString(data, data.size());
             break;
         default: {
-            QString fieldName = QString(headerData.mid(0, sizeof(quint32)));
             qDebug() << "Ignoring unknown field "
-                     << fieldName
+                     << SeratoFieldReader::fieldName(fieldId)
                      << " ("
-                     << fieldSize
+                     << data.size()
                      << " bytes).";
         }
         }
-
-        headerData = buffer->read(kHeaderSize);
     }
 
-    if (headerData.length() != 0) {
+    if (reader.isTruncated()) {
+        qWarning() << "Failed to read "
+                   << SeratoFieldReader::fieldName(fieldId)
+                   << " field.";
+        return QString();
+    }
+    if (reader.remaining() != 0) {
         qWarning() << "Found "
-                   << headerData.length()
+                   << reader.remaining()
                    << " extra bytes at end of track definition.";
         return QString();
     }
@@ -347,8 +332,8 @@ QString parseCrate(
     }
 
     mixxx::FileInfo fileInfo(crateFilePath);
-    QFile crateFile(crateFilePath);
-    if (!Sandbox::askForAccess(&fileInfo) || !crateFile.open(QIODevice::ReadOnly)) {
+    mixxx::MappedFile crateFile;
+    if (!Sandbox::askForAccess(&fileInfo) || !crateFile.open(crateFilePath)) {
         qWarning() << "Failed to open file "
                    << crateFilePath
                    << " for reading.";
@@ -362,25 +347,15 @@ QString parseCrate(
         return QString();
     }
 
+    QSqlQuery playlistTrackQuery(database);
+    prepareInsertTrackIntoPlaylist(&playlistTrackQuery);
+
     int trackCount = 0;
-    QByteArray headerData = crateFile.read(kHeaderSize);
-    while (headerData.length() == kHeaderSize) {
-        quint32 fieldId = bytesToUInt32(headerData.mid(0, sizeof(quint32)));
-        quint32 fieldSize = bytesToUInt32(headerData.mid(sizeof(quint32), kHeaderSize));
-
-        // Read field data
-        QByteArray data = crateFile.read(fieldSize);
-        if (static_cast<quint32>(data.length()) != fieldSize) {
-            QString fieldName = QString(headerData.mid(0, sizeof(quint32)));
-            qWarning() << "Failed to read "
-                       << fieldSize
-                       << " bytes for "
-                       << fieldName
-                       << " field from "
-                       << crateFilePath
-                       << ".";
-            return QString();
-        }
+    SeratoFieldReader reader(crateFile.bytes());
+    quint32 fieldId;
+    QByteArray data;
+    while (reader.next(&fieldId, &data)) {
+        const quint32 fieldSize = static_cast<quint32>(data.size());
 
         // Parse field data
         switch (static_cast<FieldId>(fieldId)) {
@@ -391,21 +366,18 @@ QString parseCrate(
             break;
         }
         case FieldId::Track: {
-            QBuffer buffer(&data);
-            buffer.open(QIODevice::ReadOnly);
-            QString location = parseCrateTrackPath(&buffer);
+            QString location = parseCrateTrackPath(data);
             if (!location.isEmpty()) {
                 int trackId = trackIdMap.value(location, -1);
-                insertTrackIntoPlaylist(database, playlistId, trackId, trackCount);
+                insertTrackIntoPlaylist(&playlistTrackQuery, playlistId, trackId, trackCount);
                 trackCount++;
                 break;
             }
             break;
         }
         default: {
-            QString fieldName = QString(headerData.mid(0, sizeof(quint32)));
             qDebug() << "Ignoring unknown field "
-                     << fieldName
+                     << SeratoFieldReader::fieldName(fieldId)
                      << " ("
                      << fieldSize
                      << " bytes) in database "
@@ -413,13 +385,19 @@ QString parseCrate(
                      << ".";
         }
         }
-
-        headerData = crateFile.read(kHeaderSize);
     }
 
-    if (headerData.length() != 0) {
+    if (reader.isTruncated()) {
+        qWarning() << "Failed to read "
+                   << SeratoFieldReader::fieldName(fieldId)
+                   << " field from "
+                   << crateFilePath
+                   << ".";
+        return QString();
+    }
+    if (reader.remaining() != 0) {
         qWarning() << "Found "
-                   << headerData.length()
+                   << reader.remaining()
                    << " extra bytes at end of Serato database file "
                    << crateFilePath
                    << ".";
@@ -529,8 +507,8 @@ QString parseDatabase(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* dat
             ")");
 
     mixxx::FileInfo fileInfo(databaseFilePath);
-    QFile databaseFile(databaseFilePath);
-    if (!Sandbox::askForAccess(&fileInfo) || !databaseFile.open(QIODevice::ReadOnly)) {
+    mixxx::MappedFile databaseFile;
+    if (!Sandbox::askForAccess(&fileInfo) || !databaseFile.open(databaseFilePath)) {
         qWarning() << "Failed to open file "
                    << databaseFilePath
                    << " for reading.";
@@ -544,26 +522,16 @@ QString parseDatabase(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* dat
         return QString();
     }
 
+    QSqlQuery playlistTrackQuery(database);
+    prepareInsertTrackIntoPlaylist(&playlistTrackQuery);
+
     int trackCount = 0;
     QMap<QString, int> trackIdMap;
-    QByteArray headerData = databaseFile.read(kHeaderSize);
-    while (headerData.length() == kHeaderSize) {
-        quint32 fieldId = bytesToUInt32(headerData.mid(0, sizeof(quint32)));
-        quint32 fieldSize = bytesToUInt32(headerData.mid(sizeof(quint32), kHeaderSize));
-
-        // Read field data
-        QByteArray data = databaseFile.read(fieldSize);
-        if (static_cast<quint32>(data.length()) != fieldSize) {
-            QString fieldName = QString(headerData.mid(0, sizeof(quint32)));
-            qWarning() << "Failed to read "
-                       << fieldSize
-                       << " bytes for "
-                       << fieldName
-                       << " field from "
-                       << databaseFilePath
-                       << ".";
-            return QString();
-        }
+    SeratoFieldReader reader(databaseFile.bytes());
+    quint32 fieldId;
+    QByteArray data;
+    while (reader.next(&fieldId, &data)) {
+        const quint32 fieldSize = static_cast<quint32>(data.size());
 
         // Parse field data
         switch (static_cast<FieldId>(fieldId)) {
@@ -575,9 +543,7 @@ QString parseDatabase(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* dat
         }
         case FieldId::Track: {
             serato_track_t track;
-            QBuffer buffer(&data);
-            buffer.open(QIODevice::ReadOnly);
-            if (parseTrack(&track, &buffer)) {
+            if (parseTrack(&track, data)) {
                 QString location = databaseRootDir.absoluteFilePath(track.location);
                 query.bindValue(":title", track.title);
                 query.bindValue(":artist", track.artist);
@@ -601,7 +567,7 @@ QString parseDatabase(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* dat
                     LOG_FAILED_QUERY(query);
                 } else {
                     int trackId = query.lastInsertId().toInt();
-                    insertTrackIntoPlaylist(database, playlistId, trackId, trackCount);
+                    insertTrackIntoPlaylist(&playlistTrackQuery, playlistId, trackId, trackCount);
                     trackIdMap.insert(track.location, trackId);
                     trackCount++;
                 }
@@ -610,9 +576,8 @@ QString parseDatabase(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* dat
             break;
         }
         default: {
-            QString fieldName = QString(headerData.mid(0, sizeof(quint32)));
             qDebug() << "Ignoring unknown field "
-                     << fieldName
+                     << SeratoFieldReader::fieldName(fieldId)
                      << " ("
                      << fieldSize
                      << " bytes) in database "
@@ -620,17 +585,24 @@ QString parseDatabase(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* dat
                      << ".";
         }
         }
-
-        headerData = databaseFile.read(kHeaderSize);
     }
 
-    if (headerData.length() != 0) {
+    if (reader.isTruncated()) {
+        qWarning() << "Failed to read "
+                   << SeratoFieldReader::fieldName(fieldId)
+                   << " field from "
+                   << databaseFilePath
+                   << ".";
+        return QString();
+    }
+    if (reader.remaining() != 0) {
         qWarning() << "Found "
-                   << headerData.length()
+                   << reader.remaining()
                    << " extra bytes at end of Serato database file "
                    << databaseFilePath
                    << ".";
     }
+    databaseFile.close();
 
     // Parse Crates
     QDir crateDir = QDir(databaseDir);
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QtEndian>
+
+/// Iterates over the fields of a Serato "database V2" or crate file, or of a
+/// track entry within them. Each field consists of a 4 byte ASCII field id,
+/// the size of the data as 4 byte big-endian integer and the data itself.
+///
+/// The data of the fields refers to the data that is read and is not copied,
+/// so it must outlive the reader and the fields.
+class SeratoFieldReader {
+  public:
+    static constexpr int kHeaderSize = 2 * sizeof(quint32);
+
+    explicit SeratoFieldReader(const QByteArray& data)
+            : m_data(data),
+              m_position(0),
+              m_truncated(false) {
+    }
+
+    /// Reads the next field. Returns false at the end of the data or if the
+    /// data of the field is truncated.
+    bool next(quint32* pFieldId, QByteArray* pFieldData) {
+        if (remaining() < kHeaderSize) {
+            return false;
+        }
+        const char* pHeader = m_data.constData() + m_position;
+        const quint32 fieldId = qFromBigEndian<quint32>(pHeader);
+        const quint32 fieldSize = qFromBigEndian<quint32>(pHeader + sizeof(quint32));
+        if (fieldSize > static_cast<quint32>(remaining() - kHeaderSize)) {
+            m_truncated = true;
+            *pFieldId = fieldId;
+            pFieldData->clear();
+            return false;
+        }
+        *pFieldId = fieldId;
+        *pFieldData = QByteArray::fromRawData(pHeader + kHeaderSize, fieldSize);
+        m_position += kHeaderSize + static_cast<int>(fieldSize);
+        return true;
+    }
+
+    /// The number of bytes that have not been read, including those of a
+    /// truncated field.
+    int remaining() const {
+        return m_data.size() - m_position;
+    }
+
+    /// True if reading stopped at a field with incomplete data
+    bool isTruncated() const {
+        return m_truncated;
+    }
+
+    /// The ASCII field id, e.g. "otrk"
+    static QString fieldName(quint32 fieldId) {
+        char name[sizeof(quint32)];
+        qToBigEndian(fieldId, name);
+        return QString::fromLatin1(name, sizeof(name));
+    }
+
+  private:
+    const QByteArray m_data;
+    int m_position;
+    bool m_truncated;
+};
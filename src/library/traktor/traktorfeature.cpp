@@ -8,6 +8,7 @@
 #include <QXmlStreamReader>
 #include <QtDebug>
 
+#include "library/batchinsertquery.h"
 #include "library/library.h"
 #include "library/librarytablemodel.h"
 #include "library/missingtablemodel.h"
@@ -201,20 +202,40 @@ TreeItem* TraktorFeature::importLibrary(const QString& file) {
     thisThread->setPriority(QThread::LowPriority);
     //Invisible root item of Traktor's child model
     TreeItem* root = nullptr;
+
+    const QString fingerprint = importFingerprint({file});
+    std::unique_ptr<TreeItem> pRestoredRootItem = restoreImportState(m_database, fingerprint);
+    if (pRestoredRootItem) {
+        qDebug() << "Traktor music collection is unchanged";
+        return pRestoredRootItem.release();
+    }
+
     //Delete all table entries of Traktor feature
     ScopedTransaction transaction(m_database);
+    resetImportState(m_database);
     clearTable("traktor_playlist_tracks");
     clearTable("traktor_library");
     clearTable("traktor_playlists");
-    transaction.commit();
 
-    transaction.transaction();
-    QSqlQuery query(m_database);
-    query.prepare("INSERT INTO traktor_library (artist, title, album, year,"
-                  "genre,comment,tracknumber,bpm, bitrate,duration, location,"
-                  "rating,key) VALUES (:artist, :title, :album, :year,:genre,"
-                  ":comment, :tracknumber,:bpm, :bitrate,:duration, :location,"
-                  ":rating,:key)");
+    // The ids are assigned here to resolve the tracks of the playlists
+    // without querying them
+    BatchInsertQuery trackInserter(m_database,
+            QStringLiteral("traktor_library"),
+            {QStringLiteral("id"),
+                    QStringLiteral("artist"),
+                    QStringLiteral("title"),
+                    QStringLiteral("album"),
+                    QStringLiteral("year"),
+                    QStringLiteral("genre"),
+                    QStringLiteral("comment"),
+                    QStringLiteral("tracknumber"),
+                    QStringLiteral("bpm"),
+                    QStringLiteral("bitrate"),
+                    QStringLiteral("duration"),
+                    QStringLiteral("location"),
+                    QStringLiteral("rating"),
+                    QStringLiteral("key")});
+    QHash<QString, int> trackIdsByLocation;
 
     //Parse Trakor XML file using SAX (for performance)
     mixxx::FileInfo fileInfo(file);
@@ -238,7 +259,7 @@ TreeItem* TraktorFeature::importLibrary(const QString& file) {
             // Each "ENTRY" tag in <COLLECTION> represents a track
             if (inCollectionTag && xml.name() == QLatin1String("ENTRY")) {
                 //parse track
-                parseTrack(xml, query);
+                parseTrack(xml, &trackInserter, &trackIdsByLocation);
                 ++nAudioFiles; //increment number of files in the music collection
             }
             if (xml.name() == QLatin1String("PLAYLISTS")) {
@@ -251,7 +272,8 @@ TreeItem* TraktorFeature::importLibrary(const QString& file) {
 
                 if (nodetype == "FOLDER" && name == "$ROOT") {
                     //process all playlists
-                    root = parsePlaylists(xml);
+                    trackInserter.flush();
+                    root = parsePlaylists(xml, trackIdsByLocation);
                     isRootFolderParsed = true;
                 }
             }
@@ -274,14 +296,26 @@ TreeItem* TraktorFeature::importLibrary(const QString& file) {
          return nullptr;
     }
 
+    if (m_cancelImport) {
+        // Roll back to the tables of the previous import
+        delete root;
+        return nullptr;
+    }
+
+    trackInserter.flush();
     qDebug() << "Found: " << nAudioFiles << " audio files in Traktor";
+    if (root) {
+        saveImportState(m_database, fingerprint, root);
+    }
     //initialize TraktorTableModel
     transaction.commit();
 
     return root;
 }
 
-void TraktorFeature::parseTrack(QXmlStreamReader &xml, QSqlQuery &query) {
+void TraktorFeature::parseTrack(QXmlStreamReader& xml,
+        BatchInsertQuery* pTrackInserter,
+        QHash<QString, int>* pTrackIdsByLocation) {
     QString title;
     QString artist;
     QString album;
@@ -377,28 +411,30 @@ void TraktorFeature::parseTrack(QXmlStreamReader &xml, QSqlQuery &query) {
         }
     }
 
-    // If we reach the end of ENTRY within the COLLECTION tag
-    // Save parsed track to database
-    query.bindValue(":artist", artist);
-    query.bindValue(":title", title);
-    query.bindValue(":album", album);
-    query.bindValue(":genre", genre);
-    query.bindValue(":year", year);
-    query.bindValue(":duration", playtime);
-    query.bindValue(":location", location);
-    query.bindValue(":rating", rating);
-    query.bindValue(":comment", comment);
-    query.bindValue(":tracknumber", tracknumber);
-    query.bindValue(":key", key);
-    query.bindValue(":bpm", bpm);
-    query.bindValue(":bitrate", bitrate);
-
-    bool success = query.exec();
-    if (!success) {
-        qDebug() << "SQL Error in TraktorTableModel.cpp: line"
-                 << __LINE__ << " " << query.lastError();
+    // The location is unique, only the first track is inserted
+    if (pTrackIdsByLocation->contains(location)) {
+        qDebug() << "Skipping duplicate Traktor track" << location;
         return;
     }
+    const int id = pTrackIdsByLocation->size() + 1;
+    pTrackIdsByLocation->insert(location, id);
+
+    // If we reach the end of ENTRY within the COLLECTION tag
+    // Save parsed track to database
+    pTrackInserter->addRow({id,
+            artist,
+            title,
+            album,
+            year,
+            genre,
+            comment,
+            tracknumber,
+            bpm,
+            bitrate,
+            playtime,
+            location,
+            rating,
+            key});
 }
 
 // Purpose: Parsing all the folder and playlists of Traktor
@@ -406,7 +442,8 @@ void TraktorFeature::parseTrack(QXmlStreamReader &xml, QSqlQuery &query) {
 // A folder can contain folders and playlists. A playlist contains entries but no folders.
 // In other words, Traktor uses a tree structure to organize music.
 // Inner nodes represent folders while leaves are playlists.
-TreeItem* TraktorFeature::parsePlaylists(QXmlStreamReader &xml) {
+TreeItem* TraktorFeature::parsePlaylists(QXmlStreamReader& xml,
+        const QHash<QString, int>& trackIdsByLocation) {
 
     qDebug() << "Process RootFolder";
     //Each playlist is unique and can be identified by a path in the tree structure.
@@ -419,13 +456,15 @@ TreeItem* TraktorFeature::parsePlaylists(QXmlStreamReader &xml) {
     TreeItem* parent = rootItem.get();
 
     QSqlQuery query_insert_to_playlists(m_database);
-    query_insert_to_playlists.prepare("INSERT INTO traktor_playlists (name) "
-                  "VALUES (:name)");
+    query_insert_to_playlists.prepare("INSERT INTO traktor_playlists (id, name) "
+                  "VALUES (:id, :name)");
+    int playlist_id = 0;
 
-    QSqlQuery query_insert_to_playlist_tracks(m_database);
-    query_insert_to_playlist_tracks.prepare(
-        "INSERT INTO traktor_playlist_tracks (playlist_id, track_id, position) "
-        "VALUES (:playlist_id, :track_id, :position)");
+    BatchInsertQuery playlistTrackInserter(m_database,
+            QStringLiteral("traktor_playlist_tracks"),
+            {QStringLiteral("playlist_id"),
+                    QStringLiteral("track_id"),
+                    QStringLiteral("position")});
 
     while (!xml.atEnd() && !m_cancelImport) {
         //read next XML element
@@ -451,11 +490,24 @@ TreeItem* TraktorFeature::parsePlaylists(QXmlStreamReader &xml) {
                     map.insert(current_path, "PLAYLIST");
 
                     parent->appendChild(name, current_path);
+
+                    // In the database, the name of a playlist is specified by the unique path,
+                    // e.g., /someFolderA/someFolderB/playlistA"
+                    query_insert_to_playlists.bindValue(":id", ++playlist_id);
+                    query_insert_to_playlists.bindValue(":name", current_path);
+                    if (!query_insert_to_playlists.exec()) {
+                        LOG_FAILED_QUERY(query_insert_to_playlists)
+                                << "Failed to insert playlist in TraktorTableModel:"
+                                << current_path;
+                        continue;
+                    }
+
                     // process all the entries within the playlist 'name' having path 'current_path'
                     parsePlaylistEntries(xml,
                             current_path,
-                            std::move(query_insert_to_playlists),
-                            std::move(query_insert_to_playlist_tracks));
+                            playlist_id,
+                            trackIdsByLocation,
+                            &playlistTrackInserter);
                 }
             }
         }
@@ -478,43 +530,16 @@ TreeItem* TraktorFeature::parsePlaylists(QXmlStreamReader &xml) {
             }
         }
     }
+    playlistTrackInserter.flush();
     return rootItem.release();
 }
 
 void TraktorFeature::parsePlaylistEntries(
         QXmlStreamReader& xml,
         const QString& playlist_path,
-        QSqlQuery query_insert_into_playlist,
-        QSqlQuery query_insert_into_playlisttracks) {
-    // In the database, the name of a playlist is specified by the unique path,
-    // e.g., /someFolderA/someFolderB/playlistA"
-    query_insert_into_playlist.bindValue(":name", playlist_path);
-
-    if (!query_insert_into_playlist.exec()) {
-        LOG_FAILED_QUERY(query_insert_into_playlist)
-                << "Failed to insert playlist in TraktorTableModel:"
-                << playlist_path;
-        return;
-    }
-
-    // Get playlist id
-    QSqlQuery id_query(m_database);
-    id_query.prepare("select id from traktor_playlists where name=:path");
-    id_query.bindValue(":path", playlist_path);
-
-    if (!id_query.exec()) {
-        LOG_FAILED_QUERY(id_query) << "Could not get inserted playlist id for Traktor playlist::"
-                                   << playlist_path;
-        return;
-    }
-
-    //playlist_id = id_query.lastInsertId().toInt();
-    int playlist_id = -1;
-    const int idColumn = id_query.record().indexOf("id");
-    while (id_query.next()) {
-        playlist_id = id_query.value(idColumn).toInt();
-    }
-
+        int playlist_id,
+        const QHash<QString, int>& trackIdsByLocation,
+        BatchInsertQuery* pPlaylistTrackInserter) {
     int playlist_position = 1;
     while (!xml.atEnd() && !m_cancelImport) {
         //read next XML element
@@ -531,27 +556,11 @@ void TraktorFeature::parsePlaylistEntries(
                     #endif
 
                     //insert to database
-                    int track_id = -1;
-                    QSqlQuery finder_query(m_database);
-                    finder_query.prepare("select id from traktor_library where location=:path");
-                    finder_query.bindValue(":path", key);
-
-                    if (!finder_query.exec()) {
-                        LOG_FAILED_QUERY(finder_query) << "Could not get track id:" << key;
-                        continue;
-                    }
-
-                    if (finder_query.next()) {
-                        track_id = finder_query.value(finder_query.record().indexOf("id")).toInt();
-                    }
-
-                    query_insert_into_playlisttracks.bindValue(":playlist_id", playlist_id);
-                    query_insert_into_playlisttracks.bindValue(":track_id", track_id);
-                    query_insert_into_playlisttracks.bindValue(":position", playlist_position++);
-                    if (!query_insert_into_playlisttracks.exec()) {
-                        LOG_FAILED_QUERY(query_insert_into_playlisttracks)
-                                << "trackid" << track_id << " with path " << key
-                                << "playlistname; " << playlist_path <<" with ID " << playlist_id;
+                    const int track_id = trackIdsByLocation.value(key, -1);
+                    if (!pPlaylistTrackInserter->addRow(
+                                {playlist_id, track_id, playlist_position++})) {
+                        qDebug() << "Failed to insert tracks of Traktor playlist"
+                                 << playlist_path << "with ID" << playlist_id;
                     }
                 }
             }
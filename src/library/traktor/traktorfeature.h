@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QHash>
 #include <QStringListModel>
 #include <QtSql>
 #include <QXmlStreamReader>
@@ -12,6 +13,8 @@
 #include "library/baseexternalplaylistmodel.h"
 #include "library/treeitemmodel.h"
 
+class BatchInsertQuery;
+
 class TraktorTrackModel : public BaseExternalTrackModel {
     Q_OBJECT
   public:
@@ -51,14 +54,18 @@ class TraktorFeature : public BaseExternalLibraryFeature {
     BaseSqlTableModel* getPlaylistModelForPlaylist(const QString& playlist) override;
     TreeItem* importLibrary(const QString& file);
     // parses a track in the music collection
-    void parseTrack(QXmlStreamReader &xml, QSqlQuery &query);
+    void parseTrack(QXmlStreamReader& xml,
+            BatchInsertQuery* pTrackInserter,
+            QHash<QString, int>* pTrackIdsByLocation);
     // Iterates over all playliost and folders and constructs the childmodel
-    TreeItem* parsePlaylists(QXmlStreamReader &xml);
+    TreeItem* parsePlaylists(QXmlStreamReader& xml,
+            const QHash<QString, int>& trackIdsByLocation);
     // processes a particular playlist
     void parsePlaylistEntries(QXmlStreamReader& xml,
             const QString& playlist_path,
-            QSqlQuery query_insert_into_playlist,
-            QSqlQuery query_insert_into_playlisttracks);
+            int playlist_id,
+            const QHash<QString, int>& trackIdsByLocation,
+            BatchInsertQuery* pPlaylistTrackInserter);
     void clearTable(const QString& table_name);
     static QString getTraktorMusicDatabase();
     // private fields
@@ -11,6 +11,7 @@
 #include "engine/enginemaster.h"
 #include "engine/sidechain/enginerecord.h"
 #include "engine/sidechain/enginesidechain.h"
+#include "engine/sidechain/enginestemrecord.h"
 #include "errordialoghandler.h"
 #include "moc_recordingmanager.cpp"
 #include "recording/defs_recording.h"
@@ -59,9 +60,23 @@ RecordingManager::RecordingManager(UserSettingsPointer pConfig, EngineMaster* pE
                 this,
                 &RecordingManager::slotDurationRecorded);
         pSidechain->addSideChainWorker(pEngineRecord);
+        // Registered after EngineRecord, which opens the file of the master
+        // mix the stems are recorded next to.
+        pSidechain->addSideChainWorker(new EngineStemRecord(
+                m_pConfig, pEngine, pSidechain, pEngineRecord));
     }
 }
 
+QList<RecordingStem> RecordingManager::getRecordingStems() const {
+    return RecordingStem::parseList(
+            m_pConfig->getValueString(ConfigKey(RECORDING_PREF_KEY, "Stems")));
+}
+
+void RecordingManager::setRecordingStems(const QList<RecordingStem>& stems) {
+    m_pConfig->setValue(ConfigKey(RECORDING_PREF_KEY, "Stems"),
+            RecordingStem::formatList(stems));
+}
+
 QString RecordingManager::formatDateTimeForFilename(const QDateTime& dateTime) const {
     // Use a format based on ISO 8601. Windows does not support colons in
     // filenames so we can't use them anywhere.
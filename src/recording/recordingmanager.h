@@ -9,6 +9,7 @@
 #include "encoder/encoder.h"
 #include "preferences/usersettings.h"
 #include "recording/defs_recording.h"
+#include "recording/recordingstem.h"
 
 class EngineMaster;
 class ControlPushButton;
@@ -39,6 +40,10 @@ class RecordingManager : public QObject {
     // Returns the currently recording file
     const QString& getRecordingFile() const;
     const QString& getRecordingLocation() const;
+    // The channels that are recorded as separate stems next to the master
+    // mix. Changes take effect when the next recording starts.
+    QList<RecordingStem> getRecordingStems() const;
+    void setRecordingStems(const QList<RecordingStem>& stems);
 
   signals:
     // Emits the cumulative number of bytes currently recorded.
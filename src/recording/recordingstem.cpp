@@ -0,0 +1,66 @@
+#include "recording/recordingstem.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QStringList>
+
+namespace {
+
+const QString kPreFaderSuffix = QStringLiteral(":pre");
+const QString kPostFaderSuffix = QStringLiteral(":post");
+
+} // anonymous namespace
+
+//static
+QList<RecordingStem> RecordingStem::parseList(const QString& text) {
+    QList<RecordingStem> stems;
+    const QStringList items = text.split(QChar(','),
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+            Qt::SkipEmptyParts);
+#else
+            QString::SkipEmptyParts);
+#endif
+    for (const QString& item : items) {
+        const QString trimmed = item.trimmed();
+        RecordingStem stem;
+        if (trimmed.endsWith(kPostFaderSuffix)) {
+            stem.group = trimmed.chopped(kPostFaderSuffix.size());
+            stem.postFader = true;
+        } else if (trimmed.endsWith(kPreFaderSuffix)) {
+            stem.group = trimmed.chopped(kPreFaderSuffix.size());
+            stem.postFader = false;
+        } else {
+            // Pre-fader by default
+            stem.group = trimmed;
+            stem.postFader = false;
+        }
+        if (!stem.group.isEmpty() && !stems.contains(stem)) {
+            stems.append(stem);
+        }
+    }
+    return stems;
+}
+
+//static
+QString RecordingStem::formatList(const QList<RecordingStem>& stems) {
+    QStringList items;
+    items.reserve(stems.size());
+    for (const auto& stem : stems) {
+        items.append(stem.group + (stem.postFader ? kPostFaderSuffix : kPreFaderSuffix));
+    }
+    return items.join(QChar(','));
+}
+
+QString RecordingStem::filePath(const QString& masterFilePath) const {
+    const QFileInfo fileInfo(masterFilePath);
+    // "[Channel1]" -> "Channel1"
+    QString name = group;
+    name.remove(QRegularExpression(QStringLiteral("[^A-Za-z0-9]")));
+    name += postFader ? QStringLiteral("_post") : QStringLiteral("_pre");
+    QString fileName = fileInfo.completeBaseName() + QChar('_') + name;
+    if (!fileInfo.suffix().isEmpty()) {
+        fileName += QChar('.') + fileInfo.suffix();
+    }
+    return fileInfo.dir().filePath(fileName);
+}
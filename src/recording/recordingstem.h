@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QList>
+#include <QString>
+
+/// A channel that is recorded into a separate file in addition to the
+/// master mix. Pre-fader stems are taken after the equalizers and pre-fader
+/// effects of the channel, post-fader stems after the volume fader, the
+/// crossfader and the post-fader effects.
+struct RecordingStem {
+    QString group;
+    bool postFader;
+
+    bool operator==(const RecordingStem& other) const {
+        return group == other.group && postFader == other.postFader;
+    }
+
+    /// The stems are stored in the preferences as a comma separated list of
+    /// groups with a ":pre" or ":post" suffix, e.g. "[Channel1]:pre,[Aux1]:post".
+    static QList<RecordingStem> parseList(const QString& text);
+    static QString formatList(const QList<RecordingStem>& stems);
+
+    /// The file of the stem next to the file of the master mix, e.g.
+    /// "2022-01-01_20h00m00s_Channel1_pre.wav" for
+    /// "2022-01-01_20h00m00s.wav".
+    QString filePath(const QString& masterFilePath) const;
+};
@@ -395,6 +395,14 @@ QWidget* LegacySkinParser::parseSkin(const QString& skinPath, QWidget* pParent)
 
     ColorSchemeParser::setupLegacyColorSchemes(skinDocument, m_pConfig, &m_style, m_pContext.get());
 
+    // The rasterized SVG images depend on the skin files and the filters
+    // of the color scheme.
+    auto pPixmapCache = QSharedPointer<SkinPixmapCache>::create(
+            QDir(m_pConfig->getSettingsPath()).filePath(QStringLiteral("cache/skins")),
+            skinPath,
+            m_pConfig->getValueString(ConfigKey("[Config]", "Scheme")));
+    WPixmapStore::setPixmapCache(pPixmapCache);
+
     // don't parent till here so the first opengl waveform doesn't screw
     // up --bkgood
     // I'm disregarding this return value because I want to return the
@@ -402,6 +410,8 @@ QWidget* LegacySkinParser::parseSkin(const QString& skinPath, QWidget* pParent)
     // (fullscreen mostly) --bkgood
     m_pParent = pParent;
     QList<QWidget*> widgets = parseNode(skinDocument);
+    qDebug() << "LegacySkinParser: Rendered SVG images loaded from cache:"
+             << pPixmapCache->hits() << "rendered:" << pPixmapCache->misses();
 
     if (widgets.empty()) {
         SKIN_WARNING(skinDocument, *m_pContext) << "Skin produced no widgets!";
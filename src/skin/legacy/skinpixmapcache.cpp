@@ -0,0 +1,112 @@
+#include "skin/legacy/skinpixmapcache.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtDebug>
+#include <algorithm>
+
+namespace {
+
+const QString kFileSuffix = QStringLiteral(".png");
+
+// Length of a hex encoded SHA-1 hash
+constexpr int kHashLength = 40;
+
+} // anonymous namespace
+
+SkinPixmapCache::SkinPixmapCache(const QString& cacheBasePath,
+        const QString& skinPath,
+        const QString& variant)
+        : m_hits(0),
+          m_misses(0) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(hashSkinFiles(skinPath));
+    // Images outside of the skin directory are shipped with Mixxx, the
+    // rendering might change with Qt.
+    hash.addData(QCoreApplication::applicationVersion().toUtf8());
+    hash.addData(QByteArray(qVersion()));
+    const QString skinName = QFileInfo(skinPath).fileName();
+    const QString skinDirectory = QDir(cacheBasePath).filePath(
+            skinName + QChar('-') + QString::fromLatin1(hash.result().toHex()));
+    // The name of a variant may contain characters that are not allowed
+    // in file names
+    const QByteArray variantHash = QCryptographicHash::hash(
+            variant.toUtf8(), QCryptographicHash::Sha1);
+    m_directory = QDir(skinDirectory).filePath(QString::fromLatin1(variantHash.toHex()));
+    if (!QFileInfo::exists(skinDirectory)) {
+        removeOutdatedDirectories(skinName, skinDirectory);
+    }
+    if (!QFileInfo::exists(m_directory) && !QDir().mkpath(m_directory)) {
+        qWarning() << "SkinPixmapCache: Failed to create" << m_directory;
+    }
+}
+
+// static
+QByteArray SkinPixmapCache::hashSkinFiles(const QString& skinPath) {
+    const QDir skinDir(skinPath);
+    QStringList entries;
+    QDirIterator it(skinPath, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        const QFileInfo fileInfo = it.fileInfo();
+        entries.append(skinDir.relativeFilePath(fileInfo.filePath()) + QChar('|') +
+                QString::number(fileInfo.size()) + QChar('|') +
+                QString::number(fileInfo.lastModified().toMSecsSinceEpoch()));
+    }
+    // The order of the iterator is not defined
+    std::sort(entries.begin(), entries.end());
+    return QCryptographicHash::hash(
+            entries.join(QChar('\n')).toUtf8(), QCryptographicHash::Sha1);
+}
+
+QString SkinPixmapCache::filePath(const PixmapSource& source, double scaleFactor) const {
+    const QByteArray key = source.getId().toUtf8() + '|' +
+            QByteArray::number(scaleFactor, 'g', 6);
+    return QDir(m_directory).filePath(QString::fromLatin1(
+            QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex() +
+            kFileSuffix));
+}
+
+QImage SkinPixmapCache::loadImage(const PixmapSource& source, double scaleFactor) {
+    QImage image(filePath(source, scaleFactor), "PNG");
+    if (image.isNull()) {
+        ++m_misses;
+    } else {
+        ++m_hits;
+    }
+    return image;
+}
+
+void SkinPixmapCache::saveImage(const PixmapSource& source,
+        double scaleFactor,
+        const QImage& image) const {
+    const QString path = filePath(source, scaleFactor);
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) ||
+            !image.save(&file, "PNG") ||
+            !file.commit()) {
+        qWarning() << "SkinPixmapCache: Failed to save" << path;
+    }
+}
+
+void SkinPixmapCache::removeOutdatedDirectories(
+        const QString& skinName, const QString& skinDirectory) {
+    const QFileInfo directoryInfo(skinDirectory);
+    const QDir baseDir = directoryInfo.dir();
+    const QStringList outdated = baseDir.entryList(
+            QStringList{skinName + QStringLiteral("-*")},
+            QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString& name : outdated) {
+        // Don't touch skins with names like "<skinName>-Variant"
+        if (name.size() != skinName.size() + 1 + kHashLength ||
+                name == directoryInfo.fileName()) {
+            continue;
+        }
+        QDir(baseDir.filePath(name)).removeRecursively();
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QByteArray>
+#include <QImage>
+#include <QString>
+
+#include "skin/legacy/pixmapsource.h"
+
+/// Persistent store of SVG skin images that have been rasterized
+///
+/// Rendering the SVG images of a skin with QSvgRenderer takes a large
+/// part of the time for loading a skin. The rendered images are stored
+/// as PNG files and reused on the next start.
+///
+/// The images of a skin are stored in a separate directory whose name
+/// contains a hash of all files of the skin, with a subdirectory for each
+/// variant, e.g. the selected color scheme. Any modification of the skin
+/// thus invalidates all images at once. Directories of outdated versions
+/// of the skin are removed when a new one is created, the images of the
+/// other variants of the current version are kept.
+class SkinPixmapCache {
+  public:
+    SkinPixmapCache(const QString& cacheBasePath,
+            const QString& skinPath,
+            const QString& variant);
+
+    const QString& directory() const {
+        return m_directory;
+    }
+
+    /// Returns a null image on a cache miss.
+    QImage loadImage(const PixmapSource& source, double scaleFactor);
+    void saveImage(const PixmapSource& source,
+            double scaleFactor,
+            const QImage& image) const;
+
+    int hits() const {
+        return m_hits;
+    }
+    int misses() const {
+        return m_misses;
+    }
+
+    /// Hash of the relative path, size and modification time of all
+    /// files in the skin directory.
+    static QByteArray hashSkinFiles(const QString& skinPath);
+
+  private:
+    QString filePath(const PixmapSource& source, double scaleFactor) const;
+    static void removeOutdatedDirectories(
+            const QString& skinName, const QString& skinDirectory);
+
+    QString m_directory;
+    int m_hits;
+    int m_misses;
+};
@@ -0,0 +1,193 @@
+#include "soundio/driftresampler.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#include "util/assert.h"
+#include "util/math.h"
+
+namespace {
+
+constexpr int kPhases = 128;
+// The filter is centered between these frames around the output position
+constexpr int kTapsBefore = DriftResampler::kTaps / 2 - 1;
+constexpr int kTapsAfter = DriftResampler::kTaps / 2;
+
+// The fill level jitters by up to one buffer while the callbacks of the
+// two devices drift past each other, so it is smoothed before the PI
+// controller to keep the ratio, and with it the pitch, steady.
+// The gains are per callback and give a well damped loop that settles
+// within a few hundred callbacks.
+constexpr double kErrorSmoothing = 0.02;
+constexpr double kProportionalGain = 0.003;
+constexpr double kIntegralGain = 1e-6;
+
+using Coefficients = std::array<float, DriftResampler::kTaps>;
+
+// Kaiser windowed sinc, one set of coefficients for each fractional
+// position between two frames plus one for the position 1.0, so
+// interpolating between two phases never needs a wrap around.
+const std::array<Coefficients, kPhases + 1>& filterTable() {
+    static const auto s_table = [] {
+        constexpr double kBeta = 7.0;
+        // Slightly below Nyquist, because there are no frequencies to spare
+        // in a resampler that is always close to a ratio of 1.
+        constexpr double kCutoff = 0.92;
+        const auto besselI0 = [](double x) {
+            double sum = 1.0;
+            double term = 1.0;
+            for (int k = 1; k < 32; ++k) {
+                term *= (x / (2.0 * k)) * (x / (2.0 * k));
+                sum += term;
+            }
+            return sum;
+        };
+        std::array<Coefficients, kPhases + 1> table;
+        for (int phase = 0; phase <= kPhases; ++phase) {
+            const double fraction = static_cast<double>(phase) / kPhases;
+            double sum = 0.0;
+            std::array<double, DriftResampler::kTaps> coefficients;
+            for (int tap = 0; tap < DriftResampler::kTaps; ++tap) {
+                const double x = tap - kTapsBefore - fraction;
+                const double sinc = x == 0.0
+                        ? 1.0
+                        : std::sin(M_PI * kCutoff * x) / (M_PI * kCutoff * x);
+                const double w = x / (kTapsAfter + 1);
+                const double window = std::abs(w) >= 1.0
+                        ? 0.0
+                        : besselI0(kBeta * std::sqrt(1.0 - w * w)) / besselI0(kBeta);
+                coefficients[tap] = sinc * window;
+                sum += coefficients[tap];
+            }
+            // Unity gain for DC in every phase
+            for (int tap = 0; tap < DriftResampler::kTaps; ++tap) {
+                table[phase][tap] = static_cast<float>(coefficients[tap] / sum);
+            }
+        }
+        return table;
+    }();
+    return s_table;
+}
+
+} // anonymous namespace
+
+DriftResampler::DriftResampler(int channelCount, SINT maxInputFrames)
+        : m_channelCount(channelCount),
+          // The filter history, the input of one call and what is left from
+          // the previous call if the output was limited
+          m_capacityFrames(kTaps + 2 * maxInputFrames),
+          m_buffer(m_capacityFrames * channelCount),
+          m_bufferFrames(0),
+          m_position(0.0),
+          m_ratio(1.0),
+          m_filteredError(0.0),
+          m_integral(0.0) {
+    // Initialize the table outside of the audio callback
+    filterTable();
+    reset();
+}
+
+void DriftResampler::reset() {
+    // Start with silence as history, the first output frame is centered
+    // on the last frame of it.
+    std::fill(m_buffer.begin(), m_buffer.end(), CSAMPLE_ZERO);
+    m_bufferFrames = kTaps - 1;
+    m_position = kTapsBefore;
+    m_ratio = 1.0;
+    m_filteredError = 0.0;
+    m_integral = 0.0;
+}
+
+void DriftResampler::updateRatio(SINT fifoFrames, SINT targetFrames, SINT framesPerBuffer) {
+    VERIFY_OR_DEBUG_ASSERT(framesPerBuffer > 0) {
+        return;
+    }
+    // A positive error means the FIFO fills up: consume more input per
+    // output frame.
+    const double error = static_cast<double>(fifoFrames - targetFrames) / framesPerBuffer;
+    m_filteredError += kErrorSmoothing * (error - m_filteredError);
+    // Anti windup: The integral alone never exceeds the maximum correction
+    m_integral = math_clamp(m_integral + kIntegralGain * m_filteredError,
+            -kMaxRatioDeviation,
+            kMaxRatioDeviation);
+    setRatio(1.0 + kProportionalGain * m_filteredError + m_integral);
+}
+
+void DriftResampler::setRatio(double ratio) {
+    m_ratio = math_clamp(ratio, 1.0 - kMaxRatioDeviation, 1.0 + kMaxRatioDeviation);
+}
+
+SINT DriftResampler::inputFramesRequired(SINT outputFrames) const {
+    if (outputFrames <= 0) {
+        return 0;
+    }
+    const double lastPosition = m_position + (outputFrames - 1) * m_ratio;
+    const SINT required = static_cast<SINT>(std::floor(lastPosition)) +
+            kTapsAfter + 1 - m_bufferFrames;
+    return math_max<SINT>(required, 0);
+}
+
+SINT DriftResampler::process(const CSAMPLE* pInput,
+        SINT inputFrames,
+        CSAMPLE* pOutput,
+        SINT maxOutputFrames) {
+    VERIFY_OR_DEBUG_ASSERT(m_bufferFrames + inputFrames <= m_capacityFrames) {
+        inputFrames = m_capacityFrames - m_bufferFrames;
+    }
+    std::memcpy(&m_buffer[m_bufferFrames * m_channelCount],
+            pInput,
+            sizeof(CSAMPLE) * inputFrames * m_channelCount);
+    m_bufferFrames += inputFrames;
+
+    SINT outputFrames = 0;
+    while (outputFrames < maxOutputFrames) {
+        const SINT frame = static_cast<SINT>(m_position);
+        if (frame + kTapsAfter >= m_bufferFrames) {
+            break;
+        }
+        interpolateFrame(frame, m_position - frame, &pOutput[outputFrames * m_channelCount]);
+        ++outputFrames;
+        m_position += m_ratio;
+    }
+
+    // Keep the history that is needed for the next output frame
+    const SINT consumed = static_cast<SINT>(m_position) - kTapsBefore;
+    if (consumed > 0) {
+        const SINT remaining = m_bufferFrames - consumed;
+        if (remaining > 0) {
+            std::memmove(m_buffer.data(),
+                    &m_buffer[consumed * m_channelCount],
+                    sizeof(CSAMPLE) * remaining * m_channelCount);
+        }
+        m_bufferFrames = math_max<SINT>(remaining, 0);
+        m_position -= consumed;
+    }
+    return outputFrames;
+}
+
+void DriftResampler::interpolateFrame(
+        SINT frame, double fraction, CSAMPLE* pOutput) const {
+    const auto& table = filterTable();
+    const double phase = fraction * kPhases;
+    const int phaseIndex = static_cast<int>(phase);
+    const float weight = static_cast<float>(phase - phaseIndex);
+    const Coefficients& lower = table[phaseIndex];
+    const Coefficients& upper = table[phaseIndex + 1];
+
+    // Interpolated coefficients first, so the inner loops over the taps
+    // can be vectorized by the compiler.
+    Coefficients coefficients;
+    for (int tap = 0; tap < kTaps; ++tap) {
+        coefficients[tap] = lower[tap] + weight * (upper[tap] - lower[tap]);
+    }
+    const CSAMPLE* pFirst = &m_buffer[(frame - kTapsBefore) * m_channelCount];
+    for (int channel = 0; channel < m_channelCount; ++channel) {
+        CSAMPLE sum = CSAMPLE_ZERO;
+        for (int tap = 0; tap < kTaps; ++tap) {
+            sum += coefficients[tap] * pFirst[tap * m_channelCount + channel];
+        }
+        pOutput[channel] = sum;
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vector>
+
+#include "util/types.h"
+
+/// Compensates the clock drift between the clock reference device and
+/// another sound device by resampling the audio of the other device.
+///
+/// Two sound cards driven by independent crystals run at slightly different
+/// rates, so the FIFO between the engine and the device slowly fills up or
+/// runs empty. Instead of skipping or duplicating a single frame when the
+/// fill level leaves the reserve, which is audible as a click, the ratio of
+/// input to output frames is adjusted continuously by a PI controller that
+/// keeps the fill level at its target.
+///
+/// The resampling is done by a windowed sinc polyphase filter. All
+/// allocations are done in the constructor, the other functions are real
+/// time safe.
+class DriftResampler {
+  public:
+    /// The length of the filter
+    static constexpr int kTaps = 16;
+    /// The latency of process() in frames at a ratio of 1
+    static constexpr int kDelayFrames = kTaps / 2;
+    /// The maximum correction, about 9 cents. The drift between two
+    /// crystals is usually below 200 ppm, the remainder is for the
+    /// jitter of the callbacks.
+    static constexpr double kMaxRatioDeviation = 0.005;
+
+    /// maxInputFrames is the maximum number of frames passed to process() at
+    /// once.
+    DriftResampler(int channelCount, SINT maxInputFrames);
+
+    void reset();
+
+    /// Updates the ratio from the fill level of the FIFO, measured once per
+    /// callback. The error is normalized by framesPerBuffer, which is the
+    /// step the fill level jumps by with each callback of either device.
+    void updateRatio(SINT fifoFrames, SINT targetFrames, SINT framesPerBuffer);
+
+    /// The number of input frames consumed per output frame
+    double ratio() const {
+        return m_ratio;
+    }
+    void setRatio(double ratio);
+
+    /// The number of input frames process() needs to produce outputFrames
+    SINT inputFramesRequired(SINT outputFrames) const;
+
+    /// Consumes all inputFrames and writes as many output frames as possible,
+    /// but not more than maxOutputFrames. Input that is not used yet is kept
+    /// for the next call. Returns the number of output frames written.
+    SINT process(const CSAMPLE* pInput,
+            SINT inputFrames,
+            CSAMPLE* pOutput,
+            SINT maxOutputFrames);
+
+  private:
+    void interpolateFrame(SINT frame, double fraction, CSAMPLE* pOutput) const;
+
+    const int m_channelCount;
+    const SINT m_capacityFrames;
+
+    // The frames of the filter history followed by the pending input
+    std::vector<CSAMPLE> m_buffer;
+    SINT m_bufferFrames;
+    // The position of the next output frame in m_buffer
+    double m_position;
+
+    double m_ratio;
+    // State of the PI controller
+    double m_filteredError;
+    double m_integral;
+};
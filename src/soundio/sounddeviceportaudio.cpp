@@ -30,8 +30,26 @@ namespace {
 // Buffer for drift correction 1 full, 1 for r/w, 1 empty
 constexpr int kDriftReserve = 1;
 
-// Buffer for drift correction 1 full, 1 for r/w, 1 empty
-constexpr int kFifoSize = 2 * kDriftReserve + 1;
+// Buffer for drift correction 1 full, 1 for r/w, 1 empty and one for the
+// jitter of the callbacks, which is not corrected at once by the resampler
+constexpr int kFifoSize = 2 * kDriftReserve + 2;
+
+// The fill levels of the FIFOs in frames the drift correction aims at,
+// measured when the callback of the device reads from the output FIFO or
+// writes to the input FIFO. The fill level swings by one buffer around it
+// depending on which callback fires first.
+SINT outputFifoTargetFrames(SINT framesPerBuffer) {
+    return (kDriftReserve + 1) * framesPerBuffer + framesPerBuffer / 2;
+}
+
+SINT inputFifoTargetFrames(SINT framesPerBuffer) {
+    return kDriftReserve * framesPerBuffer + framesPerBuffer / 2;
+}
+
+// The resamplers consume or produce at most this many frames per callback
+SINT resamplerMaxFrames(SINT framesPerBuffer) {
+    return 2 * framesPerBuffer;
+}
 
 constexpr int kCpuUsageUpdateRate = 30; // in 1/s, fits to display frame rate
 
@@ -257,11 +275,11 @@ SoundDeviceStatus SoundDevicePortAudio::open(bool isClkRefDevice, int syncBuffer
             m_outputFifo = new FIFO<CSAMPLE>(
                     m_outputParams.channelCount * m_framesPerBuffer
                             * kFifoSize);
-            // Clear first 1.5 chunks on for the required artificial delaly to
-            // a allow jitter and a half, because we can't predict which
-            // callback fires first.
-            int writeCount = m_outputParams.channelCount * m_framesPerBuffer *
-                    kFifoSize / 2;
+            // Clear the first chunks up to the target fill level for the
+            // required artificial delay to allow jitter, because we can't
+            // predict which callback fires first.
+            int writeCount = m_outputParams.channelCount *
+                    outputFifoTargetFrames(m_framesPerBuffer);
             CSAMPLE* dataPtr1;
             ring_buffer_size_t size1;
             CSAMPLE* dataPtr2;
@@ -271,13 +289,16 @@ SoundDeviceStatus SoundDevicePortAudio::open(bool isClkRefDevice, int syncBuffer
             SampleUtil::clear(dataPtr1, size1);
             SampleUtil::clear(dataPtr2, size2);
             m_outputFifo->releaseWriteRegions(writeCount);
+            m_pOutputResampler = std::make_unique<DriftResampler>(
+                    m_outputParams.channelCount,
+                    resamplerMaxFrames(m_framesPerBuffer));
         }
         if (m_inputParams.channelCount) {
             m_inputFifo = new FIFO<CSAMPLE>(
                     m_inputParams.channelCount * m_framesPerBuffer * kFifoSize);
-            // Clear first 1.5 chunks (see above)
-            int writeCount = m_inputParams.channelCount * m_framesPerBuffer *
-                    kFifoSize / 2;
+            // Clear the first chunks up to the target fill level (see above)
+            int writeCount = m_inputParams.channelCount *
+                    inputFifoTargetFrames(m_framesPerBuffer);
             CSAMPLE* dataPtr1;
             ring_buffer_size_t size1;
             CSAMPLE* dataPtr2;
@@ -287,7 +308,16 @@ SoundDeviceStatus SoundDevicePortAudio::open(bool isClkRefDevice, int syncBuffer
             SampleUtil::clear(dataPtr1, size1);
             SampleUtil::clear(dataPtr2, size2);
             m_inputFifo->releaseWriteRegions(writeCount);
+            m_pInputResampler = std::make_unique<DriftResampler>(
+                    m_inputParams.channelCount,
+                    resamplerMaxFrames(m_framesPerBuffer));
         }
+        // Shared by the input and the output, they are resampled one
+        // after the other in callbackProcessDrift()
+        mixxx::SampleBuffer(
+                math_max(m_outputParams.channelCount, m_inputParams.channelCount) *
+                resamplerMaxFrames(m_framesPerBuffer))
+                .swap(m_resamplerBuffer);
     } else if (m_syncBuffers == 1) { // "Disabled (short delay)"
         // this can be used on a second device when it is driven by the Clock
         // reference device clock
@@ -429,6 +459,8 @@ SoundDeviceStatus SoundDevicePortAudio::close() {
 
     m_outputFifo = nullptr;
     m_inputFifo = nullptr;
+    m_pOutputResampler.reset();
+    m_pInputResampler.reset();
     m_bSetThreadPriority = false;
 
     return SoundDeviceStatus::Ok;
@@ -709,101 +741,72 @@ int SoundDevicePortAudio::callbackProcessDrift(
     //
     // I the tests it turns out that it only happens in the opposite direction, so
     // 3 chunks are just fine.
+    //
+    // The drift itself is corrected by resampling the audio of this device
+    // with a ratio that keeps the fill level of the FIFOs at their target.
+    // Unlike skipping or duplicating a frame, this does not click. The ratio
+    // follows the fill level slowly, so one additional chunk is reserved for
+    // the jitter.
 
     if (m_inputParams.channelCount) {
-        int inChunkSize = framesPerBuffer * m_inputParams.channelCount;
-        int readAvailable = m_inputFifo->readAvailable();
-        int writeAvailable = m_inputFifo->writeAvailable();
-        if (readAvailable < inChunkSize * kDriftReserve) {
-            // risk of an underflow, duplicate one frame
-            m_inputFifo->write(in, inChunkSize);
-            if (m_inputDrift) {
-                // Do not compensate the first delay, because it is likely a jitter
-                // corrected in the next cycle
-                // Duplicate one frame
-                m_inputFifo->write(
-                        &in[inChunkSize - m_inputParams.channelCount],
-                        m_inputParams.channelCount);
-                //qDebug() << "callbackProcessDrift write:" << (float)readAvailable / inChunkSize << "Skip";
-            } else {
-                m_inputDrift = true;
-                //qDebug() << "callbackProcessDrift write:" << (float)readAvailable / inChunkSize << "Jitter Skip";
-            }
-        } else if (readAvailable == inChunkSize * kDriftReserve) {
-            // Everything Ok
-            m_inputFifo->write(in, inChunkSize);
-            m_inputDrift = false;
-            //qDebug() << "callbackProcess write:" << (float) readAvailable / inChunkSize << "Normal";
-        } else if (writeAvailable >= inChunkSize) {
-            // Risk of overflow, skip one frame
-            if (m_inputDrift) {
-                m_inputFifo->write(in, inChunkSize - m_inputParams.channelCount);
-                //qDebug() << "callbackProcessDrift write:" << (float)readAvailable / inChunkSize << "Skip";
-            } else {
-                m_inputFifo->write(in, inChunkSize);
-                m_inputDrift = true;
-                //qDebug() << "callbackProcessDrift write:" << (float)readAvailable / inChunkSize << "Jitter Skip";
-            }
+        const int channelCount = m_inputParams.channelCount;
+        CSAMPLE* pResampled = m_resamplerBuffer.data();
+        const SINT resampledFrames = m_pInputResampler->process(in,
+                framesPerBuffer,
+                pResampled,
+                resamplerMaxFrames(framesPerBuffer));
+        const int resampledSize = static_cast<int>(resampledFrames) * channelCount;
+        const int readAvailable = m_inputFifo->readAvailable();
+        const int writeAvailable = m_inputFifo->writeAvailable();
+        if (writeAvailable >= resampledSize) {
+            m_inputFifo->write(pResampled, resampledSize);
         } else if (writeAvailable) {
             // Fifo Overflow
-            m_inputFifo->write(in, writeAvailable);
+            m_inputFifo->write(pResampled, writeAvailable);
             m_pSoundManager->underflowHappened(8);
-            //qDebug() << "callbackProcessDrift write:" << (float) readAvailable / inChunkSize << "Overflow";
+            //qDebug() << "callbackProcessDrift write:" << readAvailable / channelCount << "Overflow";
         } else {
             // Buffer full
             m_pSoundManager->underflowHappened(9);
-            //qDebug() << "callbackProcessDrift write:" << (float) readAvailable / inChunkSize << "Buffer full";
+            //qDebug() << "callbackProcessDrift write:" << readAvailable / channelCount << "Buffer full";
         }
+        // A high fill level means this device is faster than the clock
+        // reference device, so fewer frames need to be produced.
+        m_pInputResampler->updateRatio(readAvailable / channelCount,
+                inputFifoTargetFrames(framesPerBuffer),
+                framesPerBuffer);
     }
 
     if (m_outputParams.channelCount) {
-        int outChunkSize = framesPerBuffer * m_outputParams.channelCount;
+        const int channelCount = m_outputParams.channelCount;
+        int outChunkSize = framesPerBuffer * channelCount;
         int readAvailable = m_outputFifo->readAvailable();
-
-        if (readAvailable > outChunkSize * (kDriftReserve + 1)) {
-            m_outputFifo->read(out, outChunkSize);
-            if (m_outputDrift) {
-                // Risk of overflow, skip one frame
-                m_outputFifo->releaseReadRegions(m_outputParams.channelCount);
-                //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Skip";
-            } else {
-                m_outputDrift = true;
-                //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Jitter Skip";
-            }
-        } else if (readAvailable == outChunkSize * (kDriftReserve + 1)) {
-            m_outputFifo->read(out, outChunkSize);
-            m_outputDrift = false;
-            //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Normal";
-        } else if (readAvailable >= outChunkSize) {
-            if (m_outputDrift) {
-                // Risk of underflow, duplicate one frame
-                m_outputFifo->read(out,
-                        outChunkSize - m_outputParams.channelCount);
-                SampleUtil::copy(
-                        &out[outChunkSize - m_outputParams.channelCount],
-                        &out[outChunkSize - (2 * m_outputParams.channelCount)],
-                        m_outputParams.channelCount);
-                //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Save";
+        // A high fill level means this device is slower than the clock
+        // reference device, so more frames need to be consumed.
+        m_pOutputResampler->updateRatio(readAvailable / channelCount,
+                outputFifoTargetFrames(framesPerBuffer),
+                framesPerBuffer);
+
+        const SINT framesRequired = m_pOutputResampler->inputFramesRequired(framesPerBuffer);
+        const int readCount = math_min(
+                static_cast<int>(framesRequired) * channelCount, readAvailable);
+        CSAMPLE* pInput = m_resamplerBuffer.data();
+        m_outputFifo->read(pInput, readCount);
+        const SINT outputFrames = m_pOutputResampler->process(
+                pInput, readCount / channelCount, out, framesPerBuffer);
+        if (outputFrames < framesPerBuffer) {
+            // underflow
+            SampleUtil::clear(&out[outputFrames * channelCount],
+                    outChunkSize - outputFrames * channelCount);
+            if (readAvailable) {
+                m_pSoundManager->underflowHappened(10);
+                //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Underflow";
             } else {
-                m_outputFifo->read(out, outChunkSize);
-                m_outputDrift = true;
-                //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Jitter Save";
+                m_pSoundManager->underflowHappened(11);
+                //qDebug() << "callbackProcess read:" << (float)readAvailable / outChunkSize << "Buffer empty";
             }
-        } else if (readAvailable) {
-            m_outputFifo->read(out,
-                    readAvailable);
-            // underflow
-            SampleUtil::clear(&out[readAvailable],
-                    outChunkSize - readAvailable);
-            m_pSoundManager->underflowHappened(10);
-            //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Underflow";
-        } else {
-            // underflow
-            SampleUtil::clear(out, outChunkSize);
-            m_pSoundManager->underflowHappened(11);
-            //qDebug() << "callbackProcess read:" << (float)readAvailable / outChunkSize << "Buffer empty";
         }
-     }
+    }
     return paContinue;
 }
 
@@ -3,11 +3,14 @@
 #include <portaudio.h>
 
 #include <QString>
+#include <memory>
 
 #include "control/pollingcontrolproxy.h"
+#include "soundio/driftresampler.h"
 #include "soundio/sounddevice.h"
 #include "util/duration.h"
 #include "util/performancetimer.h"
+#include "util/samplebuffer.h"
 
 class SoundManager;
 class ControlProxy;
@@ -68,6 +71,10 @@ class SoundDevicePortAudio : public SoundDevice {
     FIFO<CSAMPLE>* m_inputFifo;
     bool m_outputDrift;
     bool m_inputDrift;
+    // Drift correction of callbackProcessDrift()
+    std::unique_ptr<DriftResampler> m_pOutputResampler;
+    std::unique_ptr<DriftResampler> m_pInputResampler;
+    mixxx::SampleBuffer m_resamplerBuffer;
 
     // A string describing the last PortAudio error to occur.
     QString m_lastError;
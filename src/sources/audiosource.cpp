@@ -17,7 +17,8 @@ constexpr SINT kVerifyReadableMaxFrameCount = 1;
 } // anonymous namespace
 
 AudioSource::AudioSource(const QUrl& url)
-        : UrlResource(url) {
+        : UrlResource(url),
+          m_readsStereo(false) {
 }
 
 AudioSource::AudioSource(
@@ -25,6 +26,8 @@ AudioSource::AudioSource(
         const audio::SignalInfo& signalInfo)
         : UrlResource(inner),
           m_signalInfo(signalInfo),
+          // A proxy that changes the signal converts the samples itself
+          m_readsStereo(inner.m_readsStereo && signalInfo == inner.m_signalInfo),
           m_bitrate(inner.m_bitrate),
           m_frameIndexRange(inner.m_frameIndexRange) {
 }
@@ -194,7 +197,7 @@ bool AudioSource::verifyReadable() {
     const SINT numSampleFrames =
             math_min(kVerifyReadableMaxFrameCount, frameIndexRange().length());
     SampleBuffer sampleBuffer(
-            m_signalInfo.frames2samples(numSampleFrames));
+            getReadSignalInfo().frames2samples(numSampleFrames));
     WritableSampleFrames writableSampleFrames(
             frameIndexRange().splitAndShrinkFront(numSampleFrames),
             SampleBuffer::WritableSlice(sampleBuffer));
@@ -223,6 +226,7 @@ std::optional<WritableSampleFrames> AudioSource::clampWritableSampleFrames(
         return std::nullopt;
     }
     const auto readableFrameIndexRange = *clampedFrameIndexRange;
+    const auto readSignalInfo = getReadSignalInfo();
 
     // adjust offset and length of the sample buffer
     DEBUG_ASSERT(
@@ -233,7 +237,7 @@ std::optional<WritableSampleFrames> AudioSource::clampWritableSampleFrames(
                     sampleFrames.frameIndexRange().start(),
                     readableFrameIndexRange.end());
     const SINT minSampleBufferCapacity =
-            m_signalInfo.frames2samples(
+            readSignalInfo.frames2samples(
                     writableFrameIndexRange.length());
     VERIFY_OR_DEBUG_ASSERT(
             sampleFrames.writableLength() >=
@@ -249,7 +253,7 @@ std::optional<WritableSampleFrames> AudioSource::clampWritableSampleFrames(
                 << writableFrameIndexRange;
         writableFrameIndexRange =
                 writableFrameIndexRange.splitAndShrinkFront(
-                        m_signalInfo.samples2frames(
+                        readSignalInfo.samples2frames(
                                 sampleFrames.writableLength()));
         kLogger.warning()
                 << "Reduced writable sample frames"
@@ -267,8 +271,8 @@ std::optional<WritableSampleFrames> AudioSource::clampWritableSampleFrames(
             writableFrameIndexRange,
             SampleBuffer::WritableSlice(
                     sampleFrames.writableData(
-                            m_signalInfo.frames2samples(writableFrameOffset)),
-                    m_signalInfo.frames2samples(
+                            readSignalInfo.frames2samples(writableFrameOffset)),
+                    readSignalInfo.frames2samples(
                             writableFrameIndexRange.length())));
 }
 
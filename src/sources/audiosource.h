@@ -242,6 +242,24 @@ class AudioSource : public UrlResource, public virtual /*implements*/ IAudioSour
         return m_signalInfo;
     }
 
+    // Some sources convert mono or multi-channel streams into stereo
+    // while decoding if stereo has been requested by the OpenParams.
+    // The signal info still describes the stream, but the buffers of
+    // readSampleFrames() are then filled with stereo samples.
+    bool readsStereo() const {
+        return m_readsStereo;
+    }
+
+    // The signal layout of the buffers of readSampleFrames()
+    audio::SignalInfo getReadSignalInfo() const {
+        if (!m_readsStereo) {
+            return m_signalInfo;
+        }
+        return audio::SignalInfo(
+                audio::ChannelCount::stereo(),
+                m_signalInfo.getSampleRate());
+    }
+
     const audio::Bitrate getBitrate() const {
         return m_bitrate;
     }
@@ -321,6 +339,12 @@ class AudioSource : public UrlResource, public virtual /*implements*/ IAudioSour
 
     bool initFrameIndexRangeOnce(
             IndexRange frameIndexRange);
+
+    // Only allowed while opening if stereo has been requested
+    void setReadsStereo(bool readsStereo) {
+        m_readsStereo = readsStereo;
+    }
+
     // The frame index range needs to be adjusted while
     // reading. This virtual function is an ugly hack!!!
     // It needs to be overridden in derived proxy classes
@@ -376,6 +400,7 @@ class AudioSource : public UrlResource, public virtual /*implements*/ IAudioSour
             const WritableSampleFrames& sampleFrames) const;
 
     audio::SignalInfo m_signalInfo;
+    bool m_readsStereo;
 
     audio::Bitrate m_bitrate;
 
@@ -0,0 +1,128 @@
+#include "sources/audiosourceparallelproxy.h"
+
+#include <QtConcurrentRun>
+#include <algorithm>
+
+#include "util/logger.h"
+#include "util/sample.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("AudioSourceParallelProxy");
+
+} // anonymous namespace
+
+AudioSourceParallelProxy::AudioSourceParallelProxy(
+        std::vector<AudioSourcePointer> audioSources,
+        SINT segmentFrames)
+        : AudioSourceProxy(AudioSourcePointer(audioSources.front())),
+          m_segmentFrames(segmentFrames) {
+    DEBUG_ASSERT(m_segmentFrames > 0);
+    m_slots.reserve(audioSources.size());
+    for (auto& pAudioSource : audioSources) {
+        VERIFY_OR_DEBUG_ASSERT(
+                pAudioSource->getSignalInfo() == getSignalInfo() &&
+                pAudioSource->readsStereo() == readsStereo() &&
+                pAudioSource->frameIndexRange() == frameIndexRange()) {
+            kLogger.warning()
+                    << "Ignoring audio source with a different signal or length";
+            continue;
+        }
+        m_slots.emplace_back(
+                std::move(pAudioSource),
+                getReadSignalInfo().frames2samples(m_segmentFrames));
+    }
+    m_threadPool.setMaxThreadCount(static_cast<int>(m_slots.size()));
+}
+
+AudioSourceParallelProxy::~AudioSourceParallelProxy() {
+    // The pending tasks access the slots
+    for (auto& slot : m_slots) {
+        slot.future.waitForFinished();
+    }
+}
+
+IndexRange AudioSourceParallelProxy::segmentFrameIndexRange(SINT segmentIndex) const {
+    return intersect(
+            IndexRange::forward(
+                    frameIndexMin() + segmentIndex * m_segmentFrames,
+                    m_segmentFrames),
+            frameIndexRange());
+}
+
+void AudioSourceParallelProxy::scheduleSegment(SINT segmentIndex) {
+    Slot& slot = m_slots[segmentIndex % m_slots.size()];
+    if (slot.segmentIndex == segmentIndex) {
+        return;
+    }
+    // The buffer and the audio source of the slot are reused
+    slot.future.waitForFinished();
+    slot.segmentIndex = segmentIndex;
+    slot.readableSampleFrames = ReadableSampleFrames();
+    const IndexRange segmentRange = segmentFrameIndexRange(segmentIndex);
+    if (segmentRange.empty()) {
+        slot.future = QFuture<void>();
+        return;
+    }
+    Slot* pSlot = &slot;
+    slot.future = QtConcurrent::run(&m_threadPool, [pSlot, segmentRange]() {
+        pSlot->readableSampleFrames =
+                pSlot->pAudioSource->readSampleFrames(
+                        WritableSampleFrames(
+                                segmentRange,
+                                SampleBuffer::WritableSlice(pSlot->sampleBuffer)));
+    });
+}
+
+const AudioSourceParallelProxy::Slot& AudioSourceParallelProxy::awaitSegment(
+        SINT segmentIndex) {
+    // The preceding segments are not needed anymore and their slots
+    // are reused for the following segments
+    for (SINT i = 0; i < static_cast<SINT>(m_slots.size()); ++i) {
+        scheduleSegment(segmentIndex + i);
+    }
+    Slot& slot = m_slots[segmentIndex % m_slots.size()];
+    DEBUG_ASSERT(slot.segmentIndex == segmentIndex);
+    slot.future.waitForFinished();
+    return slot;
+}
+
+ReadableSampleFrames AudioSourceParallelProxy::readSampleFramesClamped(
+        const WritableSampleFrames& sampleFrames) {
+    const IndexRange readRange = sampleFrames.frameIndexRange();
+    const auto readSignalInfo = getReadSignalInfo();
+    SINT frameIndex = readRange.start();
+    while (frameIndex < readRange.end()) {
+        const Slot& slot = awaitSegment(segmentIndexOf(frameIndex));
+        const IndexRange decodedRange = slot.readableSampleFrames.frameIndexRange();
+        const IndexRange copyRange = intersect(
+                IndexRange::between(frameIndex, readRange.end()),
+                decodedRange);
+        if (copyRange.empty() || copyRange.start() != frameIndex) {
+            kLogger.warning()
+                    << "Failed to decode frames"
+                    << IndexRange::between(frameIndex, readRange.end());
+            break;
+        }
+        if (sampleFrames.writableData()) {
+            SampleUtil::copy(
+                    sampleFrames.writableData(
+                            readSignalInfo.frames2samples(frameIndex - readRange.start())),
+                    slot.readableSampleFrames.readableData(
+                            readSignalInfo.frames2samples(frameIndex - decodedRange.start())),
+                    readSignalInfo.frames2samples(copyRange.length()));
+        }
+        frameIndex = copyRange.end();
+    }
+    const SINT numberOfSamples =
+            readSignalInfo.frames2samples(frameIndex - readRange.start());
+    return ReadableSampleFrames(
+            IndexRange::between(readRange.start(), frameIndex),
+            SampleBuffer::ReadableSlice(
+                    sampleFrames.writableData(),
+                    std::min(sampleFrames.writableLength(), numberOfSamples)));
+}
+
+} // namespace mixxx
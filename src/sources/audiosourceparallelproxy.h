@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QFuture>
+#include <QThreadPool>
+#include <vector>
+
+#include "sources/audiosourceproxy.h"
+#include "util/samplebuffer.h"
+
+namespace mixxx {
+
+/// Decodes the following segments of an audio stream concurrently while
+/// the current segment is read, e.g. for analysis that reads the whole
+/// stream from the beginning to the end.
+///
+/// Each segment is decoded by one of multiple instances of the same audio
+/// source, i.e. the same file opened by the same provider. The decoded
+/// segments are stitched together in order. The results are only identical
+/// to sequential decoding if the decoder produces the same samples after
+/// seeking, i.e. for lossless formats with independent frames like FLAC
+/// or PCM.
+class AudioSourceParallelProxy : public AudioSourceProxy {
+  public:
+    // ~1.5 sec at 44.1 kHz
+    static constexpr SINT kDefaultSegmentFrames = 65536;
+
+    /// The first audio source is wrapped. All audio sources must provide
+    /// the same signal and frame index range and are used for decoding
+    /// segments concurrently.
+    explicit AudioSourceParallelProxy(
+            std::vector<AudioSourcePointer> audioSources,
+            SINT segmentFrames = kDefaultSegmentFrames);
+    ~AudioSourceParallelProxy() override;
+
+  protected:
+    ReadableSampleFrames readSampleFramesClamped(
+            const WritableSampleFrames& sampleFrames) override;
+
+  private:
+    struct Slot {
+        Slot(AudioSourcePointer pAudioSource, SINT bufferSize)
+                : pAudioSource(std::move(pAudioSource)),
+                  segmentIndex(-1),
+                  sampleBuffer(bufferSize) {
+        }
+
+        const AudioSourcePointer pAudioSource;
+        SINT segmentIndex;
+        SampleBuffer sampleBuffer;
+        // Written by the worker thread until the future is finished
+        ReadableSampleFrames readableSampleFrames;
+        QFuture<void> future;
+    };
+
+    SINT segmentIndexOf(SINT frameIndex) const {
+        return (frameIndex - frameIndexMin()) / m_segmentFrames;
+    }
+    IndexRange segmentFrameIndexRange(SINT segmentIndex) const;
+
+    // Starts decoding the segment unless it is already decoded or pending
+    void scheduleSegment(SINT segmentIndex);
+    // Returns the decoded segment and starts decoding the following segments
+    const Slot& awaitSegment(SINT segmentIndex);
+
+    const SINT m_segmentFrames;
+
+    QThreadPool m_threadPool;
+
+    // The segment with index i is decoded in slot i % m_slots.size()
+    std::vector<Slot> m_slots;
+};
+
+} // namespace mixxx
@@ -28,7 +28,7 @@ AudioSourceStereoProxy::AudioSourceStereoProxy(
                 std::move(pAudioSource),
                 proxySignalInfo(pAudioSource->getSignalInfo())),
           m_tempSampleBuffer(
-                  (m_pAudioSource->getSignalInfo().getChannelCount() != kChannelCount) ?
+                  (m_pAudioSource->getReadSignalInfo().getChannelCount() != kChannelCount) ?
                   m_pAudioSource->getSignalInfo().frames2samples(maxReadableFrames) :
                   0),
           m_tempWritableSlice(m_tempSampleBuffer) {
@@ -65,7 +65,8 @@ inline bool isDisjunct(
 
 ReadableSampleFrames AudioSourceStereoProxy::readSampleFramesClamped(
         const WritableSampleFrames& sampleFrames) {
-    if (m_pAudioSource->getSignalInfo().getChannelCount() == kChannelCount) {
+    // Some sources convert the samples into stereo while decoding
+    if (m_pAudioSource->getReadSignalInfo().getChannelCount() == kChannelCount) {
         return readSampleFramesClampedOn(*m_pAudioSource, sampleFrames);
     }
 
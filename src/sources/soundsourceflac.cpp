@@ -93,6 +93,9 @@ SoundSourceFLAC::SoundSourceFLAC(const QUrl& url)
           m_decoder(nullptr),
           m_maxBlocksize(0),
           m_bitsPerSample(kBitsPerSampleDefault),
+          m_pDirectOutput(nullptr),
+          m_directOutputCapacity(0),
+          m_directOutputFrames(0),
           m_curFrameIndex(0) {
 }
 
@@ -102,8 +105,11 @@ SoundSourceFLAC::~SoundSourceFLAC() {
 
 SoundSource::OpenResult SoundSourceFLAC::tryOpen(
         OpenMode /*mode*/,
-        const OpenParams& /*config*/) {
+        const OpenParams& params) {
     DEBUG_ASSERT(!m_file.isOpen());
+    // Mono and multi-channel streams are converted to stereo while
+    // decoding if requested, see convertDecodedFrames()
+    m_requestedChannelCount = params.getSignalInfo().getChannelCount();
     if (!m_file.open(QIODevice::ReadOnly)) {
         kLogger.warning()
                 << "Failed to open FLAC file:"
@@ -250,7 +256,7 @@ ReadableSampleFrames SoundSourceFLAC::readSampleFramesClamped(
     DEBUG_ASSERT(m_curFrameIndex == firstFrameIndex);
 
     const SINT numberOfSamplesTotal =
-            getSignalInfo().frames2samples(
+            getReadSignalInfo().frames2samples(
                     writableSampleFrames.frameLength());
 
     SINT numberOfSamplesRemaining = numberOfSamplesTotal;
@@ -261,11 +267,20 @@ ReadableSampleFrames SoundSourceFLAC::readSampleFramesClamped(
         if (m_sampleBuffer.empty()) {
             // Save the current frame index
             const SINT curFrameIndexBeforeProcessing = m_curFrameIndex;
+            // Decode directly into the output buffer
+            if (writableSampleFrames.writableData()) {
+                m_pDirectOutput = writableSampleFrames.writableData(outputSampleOffset);
+                m_directOutputCapacity = getReadSignalInfo().samples2frames(numberOfSamplesRemaining);
+            }
+            m_directOutputFrames = 0;
             // Documentation of FLAC__stream_decoder_process_single():
             // "Depending on what was decoded, the metadata or write callback
             // will be called with the decoded metadata block or audio frame."
             // See also: https://xiph.org/flac/api/group__flac__stream__decoder.html#ga9d6df4a39892c05955122cf7f987f856
-            if (!FLAC__stream_decoder_process_single(m_decoder)) {
+            const bool processed = FLAC__stream_decoder_process_single(m_decoder);
+            m_pDirectOutput = nullptr;
+            m_directOutputCapacity = 0;
+            if (!processed) {
                 kLogger.warning()
                         << "Failed to decode FLAC file"
                         << m_file.fileName();
@@ -301,6 +316,17 @@ ReadableSampleFrames SoundSourceFLAC::readSampleFramesClamped(
                 }
             }
             DEBUG_ASSERT(curFrameIndexBeforeProcessing == m_curFrameIndex);
+            if (m_directOutputFrames > 0) {
+                const SINT numberOfSamplesDecoded =
+                        getReadSignalInfo().frames2samples(m_directOutputFrames);
+                outputSampleOffset += numberOfSamplesDecoded;
+                m_curFrameIndex += m_directOutputFrames;
+                numberOfSamplesRemaining -= numberOfSamplesDecoded;
+                m_directOutputFrames = 0;
+                // The remaining samples of the block, if any, have been
+                // buffered and are consumed below
+                continue;
+            }
         }
         if (m_sampleBuffer.empty()) {
             break; // EOF
@@ -318,7 +344,7 @@ ReadableSampleFrames SoundSourceFLAC::readSampleFramesClamped(
                     readableSlice.length());
             outputSampleOffset += numberOfSamplesRead;
         }
-        m_curFrameIndex += getSignalInfo().samples2frames(numberOfSamplesRead);
+        m_curFrameIndex += getReadSignalInfo().samples2frames(numberOfSamplesRead);
         numberOfSamplesRemaining -= numberOfSamplesRead;
     }
 
@@ -326,7 +352,7 @@ ReadableSampleFrames SoundSourceFLAC::readSampleFramesClamped(
     DEBUG_ASSERT(numberOfSamplesTotal >= numberOfSamplesRemaining);
     const SINT numberOfSamples = numberOfSamplesTotal - numberOfSamplesRemaining;
     return ReadableSampleFrames(
-            IndexRange::forward(firstFrameIndex, getSignalInfo().samples2frames(numberOfSamples)),
+            IndexRange::forward(firstFrameIndex, getReadSignalInfo().samples2frames(numberOfSamples)),
             SampleBuffer::ReadableSlice(
                     writableSampleFrames.writableData(),
                     std::min(writableSampleFrames.writableLength(), numberOfSamples)));
@@ -424,6 +450,52 @@ inline CSAMPLE convertDecodedSample(FLAC__int32 decodedSample, int bitsPerSample
 
 } // anonymous namespace
 
+void SoundSourceFLAC::convertDecodedFrames(
+        CSAMPLE* pOutput,
+        const FLAC__int32* const buffer[],
+        SINT firstFrame,
+        SINT frameCount) const {
+    const FLAC__int32* pChannel0 = buffer[0] + firstFrame;
+    const auto readChannelCount = getReadSignalInfo().getChannelCount();
+    DEBUG_ASSERT(readChannelCount == getSignalInfo().getChannelCount() || readsStereo());
+    switch (readChannelCount) {
+    case 1: {
+        // optimized code for 1 channel (mono)
+        for (SINT i = 0; i < frameCount; ++i) {
+            pOutput[i] = convertDecodedSample(pChannel0[i], m_bitsPerSample);
+        }
+        break;
+    }
+    case 2: {
+        if (getSignalInfo().getChannelCount() == 1) {
+            // mono -> dual mono, like SampleUtil::copyMonoToDualMono()
+            for (SINT i = 0; i < frameCount; ++i) {
+                const CSAMPLE sample = convertDecodedSample(pChannel0[i], m_bitsPerSample);
+                pOutput[i * 2] = sample;
+                pOutput[i * 2 + 1] = sample;
+            }
+            break;
+        }
+        // optimized code for 2 channels (stereo), additional channels
+        // are dropped like SampleUtil::copyMultiToStereo()
+        const FLAC__int32* pChannel1 = buffer[1] + firstFrame;
+        for (SINT i = 0; i < frameCount; ++i) {
+            pOutput[i * 2] = convertDecodedSample(pChannel0[i], m_bitsPerSample);
+            pOutput[i * 2 + 1] = convertDecodedSample(pChannel1[i], m_bitsPerSample);
+        }
+        break;
+    }
+    default: {
+        // generic code for multiple channels
+        for (SINT i = 0; i < frameCount; ++i) {
+            for (SINT j = 0; j < readChannelCount; ++j) {
+                *pOutput++ = convertDecodedSample(buffer[j][firstFrame + i], m_bitsPerSample);
+            }
+        }
+    }
+    }
+}
+
 FLAC__StreamDecoderWriteStatus SoundSourceFLAC::flacWrite(
         const FLAC__Frame* frame, const FLAC__int32* const buffer[]) {
     VERIFY_OR_DEBUG_ASSERT(frame->header.channels > 0) {
@@ -460,50 +532,37 @@ FLAC__StreamDecoderWriteStatus SoundSourceFLAC::flacWrite(
     // According to the API docs the decoder will always report the current
     // position in "FLAC samples" (= "Mixxx frames") for convenience
     DEBUG_ASSERT(frame->header.number_type == FLAC__FRAME_NUMBER_TYPE_SAMPLE_NUMBER);
+    const SINT expectedFrameIndex = m_curFrameIndex;
     m_curFrameIndex = frame->header.number.sample_number;
 
+    // Write directly into the output buffer of the pending read operation
+    // unless the position needs to be adjusted first
+    SINT numDirectFrames = 0;
+    if (m_pDirectOutput && m_curFrameIndex == expectedFrameIndex) {
+        numDirectFrames = math_min(numReadableFrames, m_directOutputCapacity);
+        convertDecodedFrames(m_pDirectOutput, buffer, 0, numDirectFrames);
+        m_directOutputFrames = numDirectFrames;
+    }
+    const SINT numBufferedFrames = numReadableFrames - numDirectFrames;
+    if (numBufferedFrames <= 0) {
+        return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+    }
+
     // Decode buffer should be empty before decoding the next frame
     DEBUG_ASSERT(m_sampleBuffer.empty());
     const SampleBuffer::WritableSlice writableSlice(
             m_sampleBuffer.growForWriting(
-                    getSignalInfo().frames2samples(numReadableFrames)));
+                    getReadSignalInfo().frames2samples(numBufferedFrames)));
 
     const SINT numWritableFrames =
-            getSignalInfo().samples2frames(writableSlice.length());
-    DEBUG_ASSERT(numWritableFrames <= numReadableFrames);
-    if (numWritableFrames < numReadableFrames) {
+            getReadSignalInfo().samples2frames(writableSlice.length());
+    DEBUG_ASSERT(numWritableFrames <= numBufferedFrames);
+    if (numWritableFrames < numBufferedFrames) {
         kLogger.warning()
                 << "Sample buffer has not enough free space for all decoded FLAC samples:"
-                << numWritableFrames << "<" << numReadableFrames;
-    }
-
-    CSAMPLE* pSampleBuffer = writableSlice.data();
-    DEBUG_ASSERT(getSignalInfo().getChannelCount() <= channelCount);
-    switch (getSignalInfo().getChannelCount()) {
-    case 1: {
-        // optimized code for 1 channel (mono)
-        for (SINT i = 0; i < numWritableFrames; ++i) {
-            *pSampleBuffer++ = convertDecodedSample(buffer[0][i], m_bitsPerSample);
-        }
-        break;
-    }
-    case 2: {
-        // optimized code for 2 channels (stereo)
-        for (SINT i = 0; i < numWritableFrames; ++i) {
-            *pSampleBuffer++ = convertDecodedSample(buffer[0][i], m_bitsPerSample);
-            *pSampleBuffer++ = convertDecodedSample(buffer[1][i], m_bitsPerSample);
-        }
-        break;
-    }
-    default: {
-        // generic code for multiple channels
-        for (SINT i = 0; i < numWritableFrames; ++i) {
-            for (SINT j = 0; j < getSignalInfo().getChannelCount(); ++j) {
-                *pSampleBuffer++ = convertDecodedSample(buffer[j][i], m_bitsPerSample);
-            }
-        }
-    }
+                << numWritableFrames << "<" << numBufferedFrames;
     }
+    convertDecodedFrames(writableSlice.data(), buffer, numDirectFrames, numWritableFrames);
 
     return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
 }
@@ -515,7 +574,12 @@ void SoundSourceFLAC::flacMetadata(const FLAC__StreamMetadata* metadata) {
     // "...always before the first audio frame (i.e. write callback)."
     switch (metadata->type) {
     case FLAC__METADATA_TYPE_STREAMINFO: {
-        initChannelCountOnce(metadata->data.stream_info.channels);
+        if (initChannelCountOnce(metadata->data.stream_info.channels) &&
+                m_requestedChannelCount == audio::ChannelCount::stereo() &&
+                getSignalInfo().getChannelCount() != audio::ChannelCount::stereo()) {
+            // Converted while decoding, see convertDecodedFrames()
+            setReadsStereo(true);
+        }
         initSampleRateOnce(metadata->data.stream_info.sample_rate);
         initFrameIndexRangeOnce(
                 IndexRange::forward(
@@ -548,7 +612,7 @@ void SoundSourceFLAC::flacMetadata(const FLAC__StreamMetadata* metadata) {
                 static_cast<SINT>(metadata->data.stream_info.max_blocksize));
         if (m_maxBlocksize > 0) {
             const SINT sampleBufferCapacity =
-                    m_maxBlocksize * getSignalInfo().getChannelCount();
+                    m_maxBlocksize * getReadSignalInfo().getChannelCount();
             if (m_sampleBuffer.capacity() < sampleBufferCapacity) {
                 m_sampleBuffer.adjustCapacity(sampleBufferCapacity);
             }
@@ -47,8 +47,25 @@ class SoundSourceFLAC final : public SoundSource {
     SINT m_maxBlocksize; // in time samples (audio samples = time samples * chanCount)
     SINT m_bitsPerSample;
 
+    // Mono and multi-channel streams are converted into stereo
+    // while decoding if requested, see readsStereo()
+    audio::ChannelCount m_requestedChannelCount;
+
+    void convertDecodedFrames(
+            CSAMPLE* pOutput,
+            const FLAC__int32* const buffer[],
+            SINT firstFrame,
+            SINT frameCount) const;
+
     ReadAheadSampleBuffer m_sampleBuffer;
 
+    // While decoding the next block the samples are converted directly
+    // into the output buffer of the pending read operation. Only the
+    // samples that exceed its capacity are buffered in m_sampleBuffer.
+    CSAMPLE* m_pDirectOutput;
+    SINT m_directOutputCapacity; // in frames
+    SINT m_directOutputFrames;
+
     void invalidateCurFrameIndex() {
         m_curFrameIndex = frameIndexMax();
     }
@@ -203,7 +203,7 @@ void SoundSourceMp3::finishDecoding() {
 
 SoundSource::OpenResult SoundSourceMp3::tryOpen(
         OpenMode /*mode*/,
-        const OpenParams& /*config*/) {
+        const OpenParams& params) {
     DEBUG_ASSERT(!m_file.isOpen());
     if (!m_file.open(QIODevice::ReadOnly)) {
         kLogger.warning() << "Failed to open file:" << m_file.fileName();
@@ -380,6 +380,12 @@ SoundSource::OpenResult SoundSourceMp3::tryOpen(
         return OpenResult::Failed;
     }
     initChannelCountOnce(maxChannelCount);
+    if (maxChannelCount == audio::ChannelCount::mono() &&
+            params.getSignalInfo().getChannelCount() == audio::ChannelCount::stereo()) {
+        // Mono frames are copied twice while reading, which saves
+        // the conversion by AudioSourceStereoProxy
+        setReadsStereo(true);
+    }
     if (mostCommonSampleRateIndex > kSampleRateCount) {
         kLogger.warning()
                 << "Unknown sample rate in MP3 file:"
@@ -735,7 +741,7 @@ ReadableSampleFrames SoundSourceMp3::readSampleFramesClamped(
             }
             if (madSynthChannelCount == 1) {
                 // MP3 frame contains a mono signal
-                if (getSignalInfo().getChannelCount() == 2) {
+                if (getReadSignalInfo().getChannelCount() == 2) {
                     // The reader explicitly requested a stereo signal
                     // or the AudioSource itself provides a stereo signal.
                     // Mono -> Stereo: Copy 1st channel twice
@@ -782,7 +788,7 @@ ReadableSampleFrames SoundSourceMp3::readSampleFramesClamped(
             IndexRange::forward(firstFrameIndex, numberOfFrames),
             SampleBuffer::ReadableSlice(
                     writableSampleFrames.writableData(),
-                    std::min(writableSampleFrames.writableLength(), getSignalInfo().frames2samples(numberOfFrames))));
+                    std::min(writableSampleFrames.writableLength(), getReadSignalInfo().frames2samples(numberOfFrames))));
 }
 
 } // namespace mixxx
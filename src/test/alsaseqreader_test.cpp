@@ -0,0 +1,306 @@
+#include "controllers/midi/alsaseqreader.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QList>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "controllers/controllermanager.h"
+#include "test/mixxxtest.h"
+#include "util/time.h"
+
+namespace {
+
+struct ShortMessage {
+    unsigned char status;
+    unsigned char control;
+    unsigned char value;
+    mixxx::Duration timestamp;
+};
+
+class AlsaSeqReaderTest : public MixxxTest {
+  protected:
+    AlsaSeqReaderTest()
+            : m_reader(QStringLiteral("Mixxx Test")) {
+        // Direct connections, the reader thread is not started
+        QObject::connect(&m_reader,
+                &AlsaSeqReader::receivedShortMessage,
+                [this](unsigned char status,
+                        unsigned char control,
+                        unsigned char value,
+                        mixxx::Duration timestamp) {
+                    m_shortMessages.append({status, control, value, timestamp});
+                });
+        QObject::connect(&m_reader,
+                &AlsaSeqReader::receivedSysex,
+                [this](const QByteArray& data, mixxx::Duration timestamp) {
+                    Q_UNUSED(timestamp);
+                    m_sysexMessages.append(data);
+                });
+    }
+
+    static snd_seq_event_t timestampedEvent(int seconds, int nanos) {
+        snd_seq_event_t event;
+        snd_seq_ev_clear(&event);
+        event.flags = SND_SEQ_TIME_STAMP_REAL | SND_SEQ_TIME_MODE_ABS;
+        event.time.time.tv_sec = seconds;
+        event.time.time.tv_nsec = nanos;
+        return event;
+    }
+
+    AlsaSeqReader m_reader;
+    QList<ShortMessage> m_shortMessages;
+    QList<QByteArray> m_sysexMessages;
+};
+
+TEST_F(AlsaSeqReaderTest, NoteOnWithTimestamp) {
+    snd_seq_event_t event = timestampedEvent(1, 500000000);
+    snd_seq_ev_set_noteon(&event, 2, 60, 100);
+    m_reader.processEvent(event);
+
+    ASSERT_EQ(1, m_shortMessages.size());
+    EXPECT_EQ(0x92, m_shortMessages[0].status);
+    EXPECT_EQ(60, m_shortMessages[0].control);
+    EXPECT_EQ(100, m_shortMessages[0].value);
+    // The queue has not been started, the time base is 0
+    EXPECT_EQ(mixxx::Duration::fromMillis(1500), m_shortMessages[0].timestamp);
+}
+
+TEST_F(AlsaSeqReaderTest, ShortMessagesHaveNoRunningStatus) {
+    snd_seq_event_t event = timestampedEvent(0, 0);
+    snd_seq_ev_set_controller(&event, 0, 7, 64);
+    m_reader.processEvent(event);
+    m_reader.processEvent(event);
+    // Centered pitch bend on channel 2
+    snd_seq_ev_set_pitchbend(&event, 1, 0);
+    m_reader.processEvent(event);
+    // System real-time messages have a single byte
+    snd_seq_ev_clear(&event);
+    event.type = SND_SEQ_EVENT_CLOCK;
+    m_reader.processEvent(event);
+
+    ASSERT_EQ(4, m_shortMessages.size());
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_EQ(0xB0, m_shortMessages[i].status);
+        EXPECT_EQ(7, m_shortMessages[i].control);
+        EXPECT_EQ(64, m_shortMessages[i].value);
+    }
+    EXPECT_EQ(0xE1, m_shortMessages[2].status);
+    EXPECT_EQ(0x00, m_shortMessages[2].control);
+    EXPECT_EQ(0x40, m_shortMessages[2].value);
+    EXPECT_EQ(0xF8, m_shortMessages[3].status);
+    EXPECT_EQ(0, m_shortMessages[3].control);
+    EXPECT_EQ(0, m_shortMessages[3].value);
+}
+
+TEST_F(AlsaSeqReaderTest, SysexIsReassembled) {
+    unsigned char part1[] = {0xF0, 0x00, 0x20};
+    unsigned char part2[] = {0x29, 0xF7};
+    snd_seq_event_t event = timestampedEvent(0, 0);
+    snd_seq_ev_set_sysex(&event, sizeof(part1), part1);
+    m_reader.processEvent(event);
+    EXPECT_TRUE(m_sysexMessages.isEmpty());
+    snd_seq_ev_set_sysex(&event, sizeof(part2), part2);
+    m_reader.processEvent(event);
+
+    ASSERT_EQ(1, m_sysexMessages.size());
+    EXPECT_EQ(QByteArray::fromHex("F0002029F7"), m_sysexMessages[0]);
+    EXPECT_TRUE(m_shortMessages.isEmpty());
+}
+
+TEST_F(AlsaSeqReaderTest, SequencerEventsAreIgnored) {
+    snd_seq_event_t event = timestampedEvent(0, 0);
+    event.type = SND_SEQ_EVENT_PORT_SUBSCRIBED;
+    m_reader.processEvent(event);
+    EXPECT_TRUE(m_shortMessages.isEmpty());
+    EXPECT_TRUE(m_sysexMessages.isEmpty());
+}
+
+// Latency and jitter of MIDI input through a virtual loopback port. The
+// sender is a second sequencer client with a port that the reader is
+// subscribed to, like a physical device.
+
+class AlsaSeqLoopback {
+  public:
+    AlsaSeqLoopback()
+            : m_pSeq(nullptr),
+              m_port(-1) {
+        if (snd_seq_open(&m_pSeq, "default", SND_SEQ_OPEN_OUTPUT, 0) < 0) {
+            m_pSeq = nullptr;
+            return;
+        }
+        snd_seq_set_client_name(m_pSeq, "Mixxx Loopback");
+        m_port = snd_seq_create_simple_port(m_pSeq,
+                "Loopback",
+                SND_SEQ_PORT_CAP_READ | SND_SEQ_PORT_CAP_SUBS_READ,
+                SND_SEQ_PORT_TYPE_MIDI_GENERIC);
+    }
+    ~AlsaSeqLoopback() {
+        if (m_pSeq) {
+            snd_seq_close(m_pSeq);
+        }
+    }
+
+    bool isValid() const {
+        return m_pSeq && m_port >= 0;
+    }
+    int client() const {
+        return snd_seq_client_id(m_pSeq);
+    }
+    int port() const {
+        return m_port;
+    }
+
+    void sendNoteOn(unsigned char note) {
+        snd_seq_event_t event;
+        snd_seq_ev_clear(&event);
+        snd_seq_ev_set_noteon(&event, 0, note, 127);
+        snd_seq_ev_set_source(&event, m_port);
+        snd_seq_ev_set_subs(&event);
+        snd_seq_ev_set_direct(&event);
+        snd_seq_event_output_direct(m_pSeq, &event);
+    }
+
+  private:
+    snd_seq_t* m_pSeq;
+    int m_port;
+};
+
+// Collects the delay between sending and receiving each message
+class LatencyStats {
+  public:
+    void add(double micros) {
+        m_latencies.push_back(micros);
+    }
+    void report(benchmark::State& state) const {
+        if (m_latencies.empty()) {
+            return;
+        }
+        double sum = 0;
+        double max = 0;
+        for (double latency : m_latencies) {
+            sum += latency;
+            max = std::max(max, latency);
+        }
+        const double mean = sum / m_latencies.size();
+        double variance = 0;
+        for (double latency : m_latencies) {
+            variance += (latency - mean) * (latency - mean);
+        }
+        variance /= m_latencies.size();
+        state.counters["latency_us"] = mean;
+        state.counters["jitter_us"] = std::sqrt(variance);
+        state.counters["max_us"] = max;
+    }
+
+  private:
+    std::vector<double> m_latencies;
+};
+
+double microsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - start)
+            .count();
+}
+
+// Spacing of the messages, similar to a jog wheel that is turned fast
+constexpr auto kMessageInterval = std::chrono::microseconds(1000);
+
+static void BM_AlsaSeqReaderLatency(benchmark::State& state) {
+    mixxx::Time::start();
+    AlsaSeqLoopback loopback;
+    AlsaSeqReader reader(QStringLiteral("Mixxx Benchmark"));
+    if (!loopback.isValid() || !reader.open(loopback.client(), loopback.port())) {
+        state.SkipWithError("ALSA sequencer not available");
+        return;
+    }
+    std::atomic<int> received(0);
+    std::atomic<qint64> timestampError(0);
+    std::atomic<qint64> sendTime(0);
+    QObject::connect(&reader,
+            &AlsaSeqReader::receivedShortMessage,
+            &reader,
+            [&](unsigned char, unsigned char, unsigned char, mixxx::Duration timestamp) {
+                timestampError.fetch_add(
+                        (timestamp - mixxx::Duration::fromNanos(sendTime.load()))
+                                .toIntegerMicros());
+                received.fetch_add(1);
+            },
+            Qt::DirectConnection);
+    reader.start(QThread::TimeCriticalPriority);
+
+    LatencyStats stats;
+    int sent = 0;
+    for (auto _ : state) {
+        std::this_thread::sleep_for(kMessageInterval);
+        const auto start = std::chrono::steady_clock::now();
+        sendTime.store(mixxx::Time::elapsed().toIntegerNanos());
+        loopback.sendNoteOn(static_cast<unsigned char>(sent++ & 0x7F));
+        while (received.load() < sent) {
+        }
+        stats.add(microsSince(start));
+    }
+    reader.close();
+    stats.report(state);
+    if (sent > 0) {
+        // How far the time stamps are off from the actual time of sending
+        state.counters["timestamp_error_us"] =
+                static_cast<double>(timestampError.load()) / sent;
+    }
+}
+BENCHMARK(BM_AlsaSeqReaderLatency)->Iterations(2000)->UseRealTime();
+
+// The same with a reader that polls every ControllerManager::kPollInterval
+// like PortMidiController, for comparison.
+static void BM_AlsaSeqPolledLatency(benchmark::State& state) {
+    AlsaSeqLoopback loopback;
+    snd_seq_t* pSeq = nullptr;
+    if (!loopback.isValid() ||
+            snd_seq_open(&pSeq, "default", SND_SEQ_OPEN_INPUT, SND_SEQ_NONBLOCK) < 0) {
+        state.SkipWithError("ALSA sequencer not available");
+        return;
+    }
+    const int port = snd_seq_create_simple_port(pSeq,
+            "Input",
+            SND_SEQ_PORT_CAP_WRITE | SND_SEQ_PORT_CAP_SUBS_WRITE,
+            SND_SEQ_PORT_TYPE_MIDI_GENERIC | SND_SEQ_PORT_TYPE_APPLICATION);
+    snd_seq_connect_from(pSeq, port, loopback.client(), loopback.port());
+
+    std::atomic<int> received(0);
+    std::atomic<bool> stop(false);
+    std::thread poller([&] {
+        const auto interval = std::chrono::nanoseconds(
+                ControllerManager::kPollInterval.toIntegerNanos());
+        while (!stop.load()) {
+            std::this_thread::sleep_for(interval);
+            snd_seq_event_t* pEvent;
+            while (snd_seq_event_input(pSeq, &pEvent) >= 0) {
+                received.fetch_add(1);
+            }
+        }
+    });
+
+    LatencyStats stats;
+    int sent = 0;
+    for (auto _ : state) {
+        std::this_thread::sleep_for(kMessageInterval);
+        const auto start = std::chrono::steady_clock::now();
+        loopback.sendNoteOn(static_cast<unsigned char>(sent++ & 0x7F));
+        while (received.load() < sent) {
+        }
+        stats.add(microsSince(start));
+    }
+    stop = true;
+    poller.join();
+    snd_seq_close(pSeq);
+    stats.report(state);
+}
+BENCHMARK(BM_AlsaSeqPolledLatency)->Iterations(500)->UseRealTime();
+
+} // namespace
@@ -2,12 +2,15 @@
 
 #include <QDir>
 #include <QtDebug>
+#include <cmath>
 #include <vector>
 
 #include "analyzer/analyzerwaveform.h"
 #include "library/dao/analysisdao.h"
 #include "test/mixxxtest.h"
 #include "track/track.h"
+#include "util/math.h"
+#include "waveform/waveform.h"
 
 #define BIGBUF_SIZE (1024 * 1024) //Megabyte
 #define CANARY_SIZE (1024 * 4)
@@ -81,4 +84,72 @@ TEST_F(AnalyzerWaveformTest, canary) {
     }
 }
 
+// Every visual sample of a pyramid level must hold the maximum of the
+// visual samples of level 0 that it covers.
+void expectPyramidMatchesWaveformData(const Waveform& waveform) {
+    ASSERT_GT(waveform.getPyramidLevelCount(), 1);
+    const WaveformData* pData = waveform.data();
+    const int frameCount = waveform.getDataSize() / ChannelCount;
+    for (int level = 1; level < waveform.getPyramidLevelCount(); ++level) {
+        const WaveformData* pLevelData = waveform.getPyramidData(level);
+        const int levelFrameCount = waveform.getPyramidDataSize(level) / ChannelCount;
+        const int framesPerLevelFrame = 1 << level;
+        ASSERT_EQ((frameCount + framesPerLevelFrame - 1) / framesPerLevelFrame,
+                levelFrameCount);
+        for (int levelFrame = 0; levelFrame < levelFrameCount; ++levelFrame) {
+            for (int channel = 0; channel < ChannelCount; ++channel) {
+                WaveformData expected(0);
+                for (int frame = levelFrame * framesPerLevelFrame;
+                        frame < math_min((levelFrame + 1) * framesPerLevelFrame, frameCount);
+                        ++frame) {
+                    const auto& filtered = pData[frame * ChannelCount + channel].filtered;
+                    expected.filtered.low = math_max(expected.filtered.low, filtered.low);
+                    expected.filtered.mid = math_max(expected.filtered.mid, filtered.mid);
+                    expected.filtered.high = math_max(expected.filtered.high, filtered.high);
+                    expected.filtered.all = math_max(expected.filtered.all, filtered.all);
+                }
+                const int index = levelFrame * ChannelCount + channel;
+                ASSERT_EQ(expected.m_i, pLevelData[index].m_i)
+                        << "level " << level << " index " << index;
+            }
+        }
+    }
+}
+
+TEST_F(AnalyzerWaveformTest, pyramidIsBuiltIncrementally) {
+    std::vector<CSAMPLE> buffer(BIGBUF_SIZE);
+    for (int i = 0; i < BIGBUF_SIZE; i++) {
+        // Some varying content for all bands
+        buffer[i] = static_cast<CSAMPLE>(
+                std::sin(i * 0.01) * std::sin(i * 0.00003) +
+                0.3 * std::sin(i * 0.5) * std::sin(i * 0.0001));
+    }
+    aw.initialize(tio, tio->getSampleRate(), BIGBUF_SIZE);
+    constexpr int kChunkSize = 4096;
+    for (int i = 0; i < BIGBUF_SIZE; i += kChunkSize) {
+        aw.processSamples(&buffer[i], kChunkSize);
+    }
+    aw.storeResults(tio);
+    aw.cleanup();
+
+    ConstWaveformPointer pWaveform = tio->getWaveform();
+    ASSERT_FALSE(pWaveform.isNull());
+    expectPyramidMatchesWaveformData(*pWaveform);
+    ConstWaveformPointer pWaveformSummary = tio->getWaveformSummary();
+    ASSERT_FALSE(pWaveformSummary.isNull());
+    expectPyramidMatchesWaveformData(*pWaveformSummary);
+}
+
+TEST_F(AnalyzerWaveformTest, pyramidLevelForZoom) {
+    const Waveform waveform(44100, 44100 * 60, 441, -1);
+    const int levelCount = waveform.getPyramidLevelCount();
+    ASSERT_GT(levelCount, 4);
+    EXPECT_EQ(0, waveform.getPyramidLevel(0.5));
+    EXPECT_EQ(0, waveform.getPyramidLevel(3.9));
+    EXPECT_EQ(1, waveform.getPyramidLevel(4.0));
+    EXPECT_EQ(1, waveform.getPyramidLevel(7.9));
+    EXPECT_EQ(2, waveform.getPyramidLevel(8.0));
+    EXPECT_EQ(levelCount - 1, waveform.getPyramidLevel(1e9));
+}
+
 } // namespace
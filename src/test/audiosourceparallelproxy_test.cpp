@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include "analyzer/constants.h"
+#include "sources/audiosourceparallelproxy.h"
+#include "sources/soundsourceproxy.h"
+#include "test/mixxxtest.h"
+#include "test/soundsourceproviderregistration.h"
+#include "track/track.h"
+#include "util/samplebuffer.h"
+
+namespace {
+
+// Not a multiple of the analysis chunk size to read across segment
+// boundaries
+constexpr SINT kSegmentFrames = 10000;
+
+class AudioSourceParallelProxyTest : public MixxxTest, SoundSourceProviderRegistration {
+  protected:
+    QStringList getFilePaths() const {
+        QStringList filePaths;
+        for (const auto& fileNameSuffix : {
+                     QStringLiteral(".aiff"),
+                     QStringLiteral(".flac"),
+                     QStringLiteral(".wav"),
+             }) {
+            const QString filePath = getTestDir().filePath(
+                    QStringLiteral("id3-test-data/cover-test") + fileNameSuffix);
+            if (SoundSourceProxy::isFileNameSupported(filePath)) {
+                filePaths.append(filePath);
+            }
+        }
+        return filePaths;
+    }
+
+    static mixxx::AudioSourcePointer openAudioSource(
+            const QString& filePath,
+            const mixxx::SoundSourceProviderPointer& pProvider) {
+        mixxx::AudioSource::OpenParams openParams;
+        openParams.setChannelCount(mixxx::kAnalysisChannels);
+        return SoundSourceProxy(Track::newTemporary(filePath), pProvider)
+                .openAudioSource(openParams);
+    }
+
+    // Reads the whole audio source in chunks like AnalyzerThread
+    static std::vector<CSAMPLE> readAll(const mixxx::AudioSourcePointer& pAudioSource) {
+        std::vector<CSAMPLE> samples;
+        mixxx::SampleBuffer sampleBuffer(
+                pAudioSource->getSignalInfo().frames2samples(
+                        mixxx::kAnalysisFramesPerChunk));
+        mixxx::IndexRange remainingFrameRange = pAudioSource->frameIndexRange();
+        while (!remainingFrameRange.empty()) {
+            const auto chunkFrameRange = remainingFrameRange.splitAndShrinkFront(
+                    math_min(mixxx::kAnalysisFramesPerChunk, remainingFrameRange.length()));
+            const auto readableSampleFrames = pAudioSource->readSampleFrames(
+                    mixxx::WritableSampleFrames(
+                            chunkFrameRange,
+                            mixxx::SampleBuffer::WritableSlice(sampleBuffer)));
+            EXPECT_EQ(chunkFrameRange, readableSampleFrames.frameIndexRange());
+            samples.insert(samples.end(),
+                    readableSampleFrames.readableData(),
+                    readableSampleFrames.readableData() +
+                            readableSampleFrames.readableLength());
+        }
+        return samples;
+    }
+};
+
+TEST_F(AudioSourceParallelProxyTest, bitExactComparedToSequentialDecoding) {
+    const QStringList filePaths = getFilePaths();
+    for (const auto& filePath : filePaths) {
+        const auto providerRegistrations =
+                SoundSourceProxy::allProviderRegistrationsForUrl(
+                        QUrl::fromLocalFile(filePath));
+        for (const auto& providerRegistration : providerRegistrations) {
+            const auto pProvider = providerRegistration.getProvider();
+            const auto pSequentialSource = openAudioSource(filePath, pProvider);
+            if (!pSequentialSource) {
+                // skip test file
+                continue;
+            }
+            qInfo() << "Decoding" << filePath
+                    << "in parallel using provider" << pProvider->getDisplayName();
+            ASSERT_GT(pSequentialSource->frameLength(), 2 * kSegmentFrames);
+
+            std::vector<mixxx::AudioSourcePointer> audioSources;
+            for (int i = 0; i < 3; ++i) {
+                audioSources.push_back(openAudioSource(filePath, pProvider));
+                ASSERT_TRUE(audioSources.back() != nullptr);
+            }
+            const auto pParallelSource =
+                    std::make_shared<mixxx::AudioSourceParallelProxy>(
+                            std::move(audioSources), kSegmentFrames);
+            EXPECT_EQ(pSequentialSource->getSignalInfo(), pParallelSource->getSignalInfo());
+            EXPECT_EQ(pSequentialSource->frameIndexRange(), pParallelSource->frameIndexRange());
+
+            const auto sequentialSamples = readAll(pSequentialSource);
+            const auto parallelSamples = readAll(pParallelSource);
+            ASSERT_EQ(sequentialSamples.size(), parallelSamples.size());
+            for (std::size_t i = 0; i < sequentialSamples.size(); ++i) {
+                // Bit-exact
+                ASSERT_EQ(sequentialSamples[i], parallelSamples[i]) << "sample" << i;
+            }
+        }
+    }
+}
+
+TEST_F(AudioSourceParallelProxyTest, seekBackward) {
+    const QStringList filePaths = getFilePaths();
+    for (const auto& filePath : filePaths) {
+        const auto pProvider = SoundSourceProxy::getPrimaryProviderForFileType(
+                mixxx::FileInfo(filePath).suffix());
+        const auto pSequentialSource = openAudioSource(filePath, pProvider);
+        ASSERT_TRUE(pSequentialSource != nullptr);
+        std::vector<mixxx::AudioSourcePointer> audioSources;
+        for (int i = 0; i < 2; ++i) {
+            audioSources.push_back(openAudioSource(filePath, pProvider));
+        }
+        mixxx::AudioSourceParallelProxy parallelSource(std::move(audioSources), kSegmentFrames);
+
+        // Read the end before the beginning, across a segment boundary
+        const auto readRanges = {
+                mixxx::IndexRange::forward(
+                        pSequentialSource->frameIndexMax() - kSegmentFrames - 100, 200),
+                mixxx::IndexRange::forward(
+                        pSequentialSource->frameIndexMin() + kSegmentFrames - 100, 200),
+        };
+        for (const auto& readRange : readRanges) {
+            mixxx::SampleBuffer expected(
+                    pSequentialSource->getSignalInfo().frames2samples(readRange.length()));
+            mixxx::SampleBuffer actual(
+                    pSequentialSource->getSignalInfo().frames2samples(readRange.length()));
+            ASSERT_EQ(readRange,
+                    pSequentialSource
+                            ->readSampleFrames(mixxx::WritableSampleFrames(
+                                    readRange, mixxx::SampleBuffer::WritableSlice(expected)))
+                            .frameIndexRange());
+            ASSERT_EQ(readRange,
+                    parallelSource
+                            .readSampleFrames(mixxx::WritableSampleFrames(
+                                    readRange, mixxx::SampleBuffer::WritableSlice(actual)))
+                            .frameIndexRange());
+            for (SINT i = 0; i < expected.size(); ++i) {
+                ASSERT_EQ(expected[i], actual[i]) << "sample" << i;
+            }
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,140 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QSqlQuery>
+
+#include "library/batchinsertquery.h"
+#include "library/queryutil.h"
+#include "test/mixxxdbtest.h"
+
+namespace {
+
+const QStringList kColumns = {
+        QStringLiteral("id"),
+        QStringLiteral("name"),
+        QStringLiteral("value")};
+
+bool createTable(const QSqlDatabase& database) {
+    QSqlQuery query(database);
+    return query.exec(QStringLiteral(
+            "CREATE TABLE batch_test ("
+            "id INTEGER PRIMARY KEY, name TEXT UNIQUE, value INTEGER)"));
+}
+
+class BatchInsertQueryTest : public MixxxDbTest {
+  protected:
+    BatchInsertQueryTest()
+            : MixxxDbTest(true) {
+        EXPECT_TRUE(createTable(dbConnection()));
+    }
+
+    int rowCount() const {
+        QSqlQuery query(dbConnection());
+        EXPECT_TRUE(query.exec(QStringLiteral("SELECT COUNT(*) FROM batch_test")));
+        EXPECT_TRUE(query.next());
+        return query.value(0).toInt();
+    }
+};
+
+TEST_F(BatchInsertQueryTest, InsertFullBatchesAndRemainder) {
+    BatchInsertQuery inserter(dbConnection(), QStringLiteral("batch_test"), kColumns, 4);
+    EXPECT_EQ(4, inserter.rowsPerBatch());
+    for (int i = 1; i <= 10; ++i) {
+        EXPECT_TRUE(inserter.addRow({i, QString::number(i), i * 10}));
+    }
+    // Only the full batches have been inserted
+    EXPECT_EQ(8, inserter.insertedRows());
+    EXPECT_EQ(8, rowCount());
+
+    EXPECT_TRUE(inserter.flush());
+    EXPECT_EQ(10, inserter.insertedRows());
+    EXPECT_EQ(10, rowCount());
+
+    QSqlQuery query(dbConnection());
+    ASSERT_TRUE(query.exec(QStringLiteral("SELECT name, value FROM batch_test WHERE id=7")));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(QStringLiteral("7"), query.value(0).toString());
+    EXPECT_EQ(70, query.value(1).toInt());
+}
+
+TEST_F(BatchInsertQueryTest, FlushOnDestruction) {
+    {
+        BatchInsertQuery inserter(dbConnection(), QStringLiteral("batch_test"), kColumns);
+        EXPECT_TRUE(inserter.addRow({1, QStringLiteral("a"), 1}));
+        EXPECT_TRUE(inserter.addRow({2, QStringLiteral("b"), 2}));
+        EXPECT_EQ(0, rowCount());
+    }
+    EXPECT_EQ(2, rowCount());
+}
+
+TEST_F(BatchInsertQueryTest, ConstraintViolationOnlySkipsOffendingRow) {
+    BatchInsertQuery inserter(dbConnection(), QStringLiteral("batch_test"), kColumns, 3);
+    EXPECT_TRUE(inserter.addRow({1, QStringLiteral("a"), 1}));
+    EXPECT_TRUE(inserter.addRow({2, QStringLiteral("a"), 2}));
+    EXPECT_FALSE(inserter.addRow({3, QStringLiteral("c"), 3}));
+    EXPECT_EQ(2, inserter.insertedRows());
+    EXPECT_EQ(2, rowCount());
+}
+
+TEST_F(BatchInsertQueryTest, RowsPerBatchIsLimitedByBoundValues) {
+    BatchInsertQuery inserter(dbConnection(), QStringLiteral("batch_test"), kColumns, 1000);
+    EXPECT_EQ(BatchInsertQuery::kMaxBoundValues / 3, inserter.rowsPerBatch());
+    for (int i = 1; i <= 1000; ++i) {
+        inserter.addRow({i, QString::number(i), i});
+    }
+    EXPECT_TRUE(inserter.flush());
+    EXPECT_EQ(1000, rowCount());
+}
+
+QSqlDatabase benchmarkDatabase() {
+    const QString connectionName = QStringLiteral("BatchInsertQueryBenchmark");
+    if (QSqlDatabase::contains(connectionName)) {
+        return QSqlDatabase::database(connectionName);
+    }
+    QSqlDatabase database = QSqlDatabase::addDatabase(
+            QStringLiteral("QSQLITE"), connectionName);
+    database.setDatabaseName(QStringLiteral(":memory:"));
+    database.open();
+    createTable(database);
+    return database;
+}
+
+static void BM_InsertRowsOneByOne(benchmark::State& state) {
+    const QSqlDatabase database = benchmarkDatabase();
+    for (auto _ : state) {
+        ScopedTransaction transaction(database);
+        QSqlQuery query(database);
+        query.prepare(QStringLiteral(
+                "INSERT INTO batch_test (id, name, value) VALUES (:id, :name, :value)"));
+        for (int i = 0; i < state.range(0); ++i) {
+            query.bindValue(":id", i);
+            query.bindValue(":name", QString::number(i));
+            query.bindValue(":value", i);
+            query.exec();
+        }
+        // Discards the rows for the next iteration
+        transaction.rollback();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_InsertRowsOneByOne)->Range(1 << 10, 1 << 14);
+
+static void BM_InsertRowsBatched(benchmark::State& state) {
+    const QSqlDatabase database = benchmarkDatabase();
+    for (auto _ : state) {
+        ScopedTransaction transaction(database);
+        BatchInsertQuery inserter(database,
+                QStringLiteral("batch_test"),
+                kColumns);
+        for (int i = 0; i < state.range(0); ++i) {
+            inserter.addRow({i, QString::number(i), i});
+        }
+        inserter.flush();
+        // Discards the rows for the next iteration
+        transaction.rollback();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_InsertRowsBatched)->Range(1 << 10, 1 << 14);
+
+} // namespace
@@ -1,6 +1,9 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 
 #include <QtDebug>
+#include <array>
+#include <cmath>
 
 #include "audio/types.h"
 #include "track/beats.h"
@@ -537,4 +540,117 @@ TEST(BeatsTest, ConstTempoFindPrevNextBeatWhenNotOnBeat) {
     EXPECT_NEAR(nextBeat.value(), foundNextBeat.value(), kMaxBeatError);
 }
 
+// The cursor only speeds up lookups, results must be the same as without.
+TEST(BeatsTest, NonConstTempoCursorLookupsMatchRegularLookups) {
+    const audio::FramePos firstPosition = kStartPosition - 4 * kSampleRate.value();
+    const audio::FramePos lastPosition = kNonConstTempoBeats.getLastMarkerPosition() +
+            4 * kSampleRate.value();
+    const audio::FrameDiff_t stepFrames = kSampleRate.value() / 7.0;
+
+    Beats::Cursor forwardCursor;
+    for (auto position = firstPosition; position < lastPosition; position += stepFrames) {
+        EXPECT_EQ(kNonConstTempoBeats.iteratorFrom(position),
+                kNonConstTempoBeats.iteratorFrom(position, &forwardCursor));
+    }
+
+    // Backwards and with jumps
+    Beats::Cursor cursor;
+    for (auto position = lastPosition; position > firstPosition; position -= stepFrames * 5) {
+        audio::FramePos prevBeatPosition, nextBeatPosition;
+        audio::FramePos cursorPrevBeatPosition, cursorNextBeatPosition;
+        EXPECT_EQ(kNonConstTempoBeats.findPrevNextBeats(
+                          position, &prevBeatPosition, &nextBeatPosition, true),
+                kNonConstTempoBeats.findPrevNextBeats(position,
+                        &cursorPrevBeatPosition,
+                        &cursorNextBeatPosition,
+                        true,
+                        &cursor));
+        EXPECT_EQ(prevBeatPosition, cursorPrevBeatPosition);
+        EXPECT_EQ(nextBeatPosition, cursorNextBeatPosition);
+        EXPECT_EQ(kNonConstTempoBeats.findClosestBeat(position),
+                kNonConstTempoBeats.findClosestBeat(position, &cursor));
+        EXPECT_EQ(kNonConstTempoBeats.findNthBeat(position, 3),
+                kNonConstTempoBeats.findNthBeat(position, 3, &cursor));
+        EXPECT_EQ(kNonConstTempoBeats.findNthBeat(position, -3),
+                kNonConstTempoBeats.findNthBeat(position, -3, &cursor));
+    }
+}
+
+TEST(BeatsTest, NonConstTempoCursorOnBeats) {
+    Beats::Cursor cursor;
+    for (auto it = kNonConstTempoBeats.cfirstmarker();
+            it != kNonConstTempoBeats.clastmarker() + 1;
+            ++it) {
+        EXPECT_EQ(it, kNonConstTempoBeats.iteratorFrom(*it, &cursor));
+        EXPECT_EQ(*it, kNonConstTempoBeats.findNextBeat(*it, &cursor));
+        EXPECT_EQ(*it, kNonConstTempoBeats.findPrevBeat(*it, &cursor));
+    }
+}
+
+TEST(BeatsTest, CursorCanBeReusedWithOtherBeats) {
+    Beats::Cursor cursor;
+    const auto position = kNonConstTempoBeats.getLastMarkerPosition() - 100;
+    const auto it = kNonConstTempoBeats.iteratorFrom(position, &cursor);
+    EXPECT_EQ(kNonConstTempoBeats.clastmarker(), it);
+
+    const auto it2 = kConstTempoBeats.iteratorFrom(position, &cursor);
+    EXPECT_EQ(kConstTempoBeats.iteratorFrom(position), it2);
+}
+
+// A beat map with a slightly varying tempo, similar to a live recording.
+Beats makeVariableTempoBeats(int beatCount) {
+    std::vector<BeatMarker> markers;
+    double position = kStartPosition.value();
+    for (int i = 0; i < beatCount; ++i) {
+        markers.push_back(BeatMarker{audio::FramePos(std::round(position)), 1});
+        position += 60.0 * kSampleRate.value() / (120.0 + 2.0 * std::sin(i * 0.1));
+    }
+    return Beats(std::move(markers),
+            audio::FramePos(std::round(position)),
+            kBpm,
+            kSampleRate,
+            QString());
+}
+
+// 8 decks playing through variable tempo tracks, each looking up the
+// surrounding beats once per audio buffer like QuantizeControl does.
+void runDeckLookups(benchmark::State& state, bool useCursor) {
+    constexpr int kDeckCount = 8;
+    constexpr audio::FrameDiff_t kBufferFrames = 256;
+    const auto beats = makeVariableTempoBeats(static_cast<int>(state.range(0)));
+    const auto endPosition = beats.getLastMarkerPosition();
+    std::array<Beats::Cursor, kDeckCount> cursors;
+    std::array<audio::FramePos, kDeckCount> positions;
+    for (int deck = 0; deck < kDeckCount; ++deck) {
+        positions[deck] = kStartPosition + deck * 10000;
+    }
+    for (auto _ : state) {
+        for (int deck = 0; deck < kDeckCount; ++deck) {
+            audio::FramePos prevBeatPosition, nextBeatPosition;
+            beats.findPrevNextBeats(positions[deck],
+                    &prevBeatPosition,
+                    &nextBeatPosition,
+                    true,
+                    useCursor ? &cursors[deck] : nullptr);
+            benchmark::DoNotOptimize(prevBeatPosition);
+            benchmark::DoNotOptimize(nextBeatPosition);
+            positions[deck] += kBufferFrames;
+            if (positions[deck] >= endPosition) {
+                positions[deck] = kStartPosition;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kDeckCount);
+}
+
+static void BM_BeatsFindPrevNextBeats(benchmark::State& state) {
+    runDeckLookups(state, false);
+}
+BENCHMARK(BM_BeatsFindPrevNextBeats)->Arg(500)->Arg(5000);
+
+static void BM_BeatsFindPrevNextBeatsWithCursor(benchmark::State& state) {
+    runDeckLookups(state, true);
+}
+BENCHMARK(BM_BeatsFindPrevNextBeatsWithCursor)->Arg(500)->Arg(5000);
+
 } // namespace
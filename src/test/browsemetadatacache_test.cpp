@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <QDataStream>
+#include <QFile>
+#include <QTemporaryDir>
+#include <limits>
+
+#include "library/browse/browsemetadatacache.h"
+
+namespace {
+
+class BrowseMetadataCacheTest : public testing::Test {
+  protected:
+    mixxx::FileInfo writeFile(const QString& fileName, const QByteArray& contents) {
+        const QString filePath = m_tempDir.filePath(fileName);
+        QFile file(filePath);
+        EXPECT_TRUE(file.open(QIODevice::WriteOnly));
+        EXPECT_EQ(contents.size(), file.write(contents));
+        file.close();
+        return mixxx::FileInfo(filePath);
+    }
+
+    QString cacheFilePath() const {
+        return m_tempDir.filePath("cache");
+    }
+
+    static mixxx::TrackMetadata trackMetadata(const QString& title) {
+        mixxx::TrackMetadata trackMetadata;
+        trackMetadata.refTrackInfo().setTitle(title);
+        trackMetadata.refTrackInfo().setArtist(QStringLiteral("Artist"));
+        trackMetadata.refTrackInfo().setBpm(mixxx::Bpm(124.5));
+        trackMetadata.refTrackInfo().setReplayGain(mixxx::ReplayGain(0.5, 0.25));
+        trackMetadata.refAlbumInfo().setArtist(QStringLiteral("Album Artist"));
+        trackMetadata.refStreamInfo().setDuration(mixxx::Duration::fromMillis(183500));
+        trackMetadata.refStreamInfo().setBitrate(mixxx::audio::Bitrate(320));
+        return trackMetadata;
+    }
+
+    QTemporaryDir m_tempDir;
+};
+
+TEST_F(BrowseMetadataCacheTest, LookupInsertedEntry) {
+    BrowseMetadataCache cache(cacheFilePath());
+    const auto fileInfo = writeFile("a.mp3", "a");
+    mixxx::TrackMetadata cached;
+    EXPECT_FALSE(cache.lookup(fileInfo, &cached));
+
+    cache.insert(fileInfo, trackMetadata("A"));
+    ASSERT_TRUE(cache.lookup(mixxx::FileInfo(fileInfo.location()), &cached));
+    EXPECT_EQ(QStringLiteral("A"), cached.getTrackInfo().getTitle());
+    EXPECT_EQ(1, cache.size());
+}
+
+TEST_F(BrowseMetadataCacheTest, ModifiedFileIsNotFound) {
+    BrowseMetadataCache cache(cacheFilePath());
+    const auto fileInfo = writeFile("a.mp3", "a");
+    cache.insert(fileInfo, trackMetadata("A"));
+
+    const auto modifiedFileInfo = writeFile("a.mp3", "modified");
+    mixxx::TrackMetadata cached;
+    EXPECT_FALSE(cache.lookup(modifiedFileInfo, &cached));
+
+    cache.insert(modifiedFileInfo, trackMetadata("B"));
+    ASSERT_TRUE(cache.lookup(modifiedFileInfo, &cached));
+    EXPECT_EQ(QStringLiteral("B"), cached.getTrackInfo().getTitle());
+    EXPECT_EQ(1, cache.size());
+}
+
+TEST_F(BrowseMetadataCacheTest, SaveAndLoad) {
+    const auto fileInfo = writeFile("a.mp3", "a");
+    const auto expected = trackMetadata("A");
+    {
+        BrowseMetadataCache cache(cacheFilePath());
+        EXPECT_FALSE(cache.load());
+        cache.insert(fileInfo, expected);
+        EXPECT_TRUE(cache.save());
+    }
+
+    BrowseMetadataCache cache(cacheFilePath());
+    ASSERT_TRUE(cache.load());
+    mixxx::TrackMetadata cached;
+    ASSERT_TRUE(cache.lookup(fileInfo, &cached));
+    EXPECT_EQ(expected.getTrackInfo().getTitle(), cached.getTrackInfo().getTitle());
+    EXPECT_EQ(expected.getTrackInfo().getArtist(), cached.getTrackInfo().getArtist());
+    EXPECT_EQ(expected.getTrackInfo().getBpm(), cached.getTrackInfo().getBpm());
+    EXPECT_EQ(expected.getTrackInfo().getReplayGain(), cached.getTrackInfo().getReplayGain());
+    EXPECT_EQ(expected.getAlbumInfo().getArtist(), cached.getAlbumInfo().getArtist());
+    EXPECT_EQ(expected.getStreamInfo().getDuration(), cached.getStreamInfo().getDuration());
+    EXPECT_EQ(expected.getStreamInfo().getBitrate().value(),
+            cached.getStreamInfo().getBitrate().value());
+}
+
+TEST_F(BrowseMetadataCacheTest, InvalidFileIsNotLoaded) {
+    QFile file(cacheFilePath());
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("garbage");
+    file.close();
+
+    BrowseMetadataCache cache(cacheFilePath());
+    EXPECT_FALSE(cache.load());
+    EXPECT_EQ(0, cache.size());
+}
+
+TEST_F(BrowseMetadataCacheTest, CorruptCountIsNotLoaded) {
+    for (const qint32 count : {-1, std::numeric_limits<qint32>::max()}) {
+        QFile file(cacheFilePath());
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_12);
+        // The header of version 1 without any entries
+        stream << quint32(0x4d584243) << quint32(1) << count;
+        file.close();
+
+        BrowseMetadataCache cache(cacheFilePath());
+        EXPECT_FALSE(cache.load());
+        EXPECT_EQ(0, cache.size());
+    }
+}
+
+TEST_F(BrowseMetadataCacheTest, SaveDiscardsLeastRecentlyUsed) {
+    const auto fileInfoA = writeFile("a.mp3", "a");
+    const auto fileInfoB = writeFile("b.mp3", "b");
+    const auto fileInfoC = writeFile("c.mp3", "c");
+    {
+        BrowseMetadataCache cache(cacheFilePath(), 2);
+        cache.insert(fileInfoA, trackMetadata("A"));
+        cache.insert(fileInfoB, trackMetadata("B"));
+        cache.insert(fileInfoC, trackMetadata("C"));
+        mixxx::TrackMetadata cached;
+        ASSERT_TRUE(cache.lookup(fileInfoA, &cached));
+        EXPECT_TRUE(cache.save());
+        EXPECT_EQ(2, cache.size());
+    }
+
+    BrowseMetadataCache cache(cacheFilePath(), 2);
+    ASSERT_TRUE(cache.load());
+    mixxx::TrackMetadata cached;
+    EXPECT_TRUE(cache.lookup(fileInfoA, &cached));
+    EXPECT_FALSE(cache.lookup(fileInfoB, &cached));
+    EXPECT_TRUE(cache.lookup(fileInfoC, &cached));
+}
+
+} // namespace
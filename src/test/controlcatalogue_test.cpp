@@ -0,0 +1,179 @@
+#include "controllers/controlcatalogue.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QSet>
+#include <algorithm>
+#include <vector>
+
+#include "control/controlobject.h"
+#include "controllers/controlpickermenu.h"
+#include "test/mixxxtest.h"
+
+namespace {
+
+// Creates the controls the catalogue reads the number of players from
+class PlayerCountControls {
+  public:
+    PlayerCountControls(int numDecks, int numSamplers)
+            : m_numDecks(ConfigKey("[Master]", "num_decks")),
+              m_numSamplers(ConfigKey("[Master]", "num_samplers")),
+              m_numPreviewDecks(ConfigKey("[Master]", "num_preview_decks")),
+              m_numMicrophones(ConfigKey("[Master]", "num_microphones")),
+              m_numAuxiliaries(ConfigKey("[Master]", "num_auxiliaries")) {
+        m_numDecks.set(numDecks);
+        m_numSamplers.set(numSamplers);
+        m_numPreviewDecks.set(1);
+        m_numMicrophones.set(1);
+        m_numAuxiliaries.set(1);
+    }
+
+    ControlObject m_numDecks;
+    ControlObject m_numSamplers;
+    ControlObject m_numPreviewDecks;
+    ControlObject m_numMicrophones;
+    ControlObject m_numAuxiliaries;
+};
+
+void collectControlIndices(const ControlCatalogue::Menu& menu, QSet<int>* pIndices) {
+    for (const auto& entry : menu.entries()) {
+        if (entry.pSubmenu) {
+            EXPECT_FALSE(entry.pSubmenu->entries().empty()) << entry.pSubmenu->title();
+            collectControlIndices(*entry.pSubmenu, pIndices);
+        } else if (!entry.isSeparator()) {
+            pIndices->insert(entry.controlIndex);
+        }
+    }
+}
+
+class ControlCatalogueTest : public MixxxTest {
+  protected:
+    ControlCatalogueTest()
+            : m_playerCounts(2, 4) {
+    }
+
+    int indexOf(const ControlCatalogue& catalogue, const ConfigKey& key) {
+        return catalogue.controlsAvailable().indexOf(key);
+    }
+
+    PlayerCountControls m_playerCounts;
+};
+
+TEST_F(ControlCatalogueTest, ContainsControlsOfAllPlayers) {
+    ControlCatalogue catalogue;
+    EXPECT_TRUE(catalogue.controlExists(ConfigKey("[Channel1]", "play")));
+    EXPECT_TRUE(catalogue.controlExists(ConfigKey("[Channel2]", "play")));
+    EXPECT_FALSE(catalogue.controlExists(ConfigKey("[Channel3]", "play")));
+    EXPECT_TRUE(catalogue.controlExists(ConfigKey("[Sampler4]", "play")));
+    EXPECT_FALSE(catalogue.controlExists(ConfigKey("[Sampler5]", "play")));
+    EXPECT_TRUE(catalogue.controlExists(ConfigKey("[PreviewDeck1]", "play")));
+    EXPECT_TRUE(catalogue.controlExists(ConfigKey("[Microphone]", "talkover")));
+    EXPECT_EQ(QStringLiteral("Deck 1: Play"),
+            catalogue.controlTitleForConfigKey(ConfigKey("[Channel1]", "play")));
+    EXPECT_EQ(QStringLiteral("Deck 1: Play button"),
+            catalogue.descriptionForConfigKey(ConfigKey("[Channel1]", "play")));
+}
+
+TEST_F(ControlCatalogueTest, MenuContainsEveryControl) {
+    ControlCatalogue catalogue;
+    QSet<int> indices;
+    collectControlIndices(catalogue.rootMenu(), &indices);
+    EXPECT_EQ(catalogue.controlsAvailable().size(), indices.size());
+}
+
+TEST_F(ControlCatalogueTest, ControlsSortedByTitle) {
+    ControlCatalogue catalogue;
+    const std::vector<int>& indices = catalogue.controlIndicesByTitle();
+    ASSERT_EQ(static_cast<std::size_t>(catalogue.controlsAvailable().size()), indices.size());
+    for (std::size_t i = 1; i < indices.size(); ++i) {
+        EXPECT_LE(catalogue.controlTitleForConfigKey(catalogue.control(indices[i - 1]).key),
+                catalogue.controlTitleForConfigKey(catalogue.control(indices[i]).key));
+    }
+}
+
+TEST_F(ControlCatalogueTest, SearchMatchesAllWordPrefixes) {
+    ControlCatalogue catalogue;
+    const int play2 = indexOf(catalogue, ConfigKey("[Channel2]", "play"));
+    ASSERT_LE(0, play2);
+
+    const std::vector<int> result = catalogue.search(QStringLiteral("DECK 2 pla"));
+    EXPECT_NE(result.end(), std::find(result.begin(), result.end(), play2));
+    EXPECT_EQ(result.end(),
+            std::find(result.begin(),
+                    result.end(),
+                    indexOf(catalogue, ConfigKey("[Channel1]", "play"))));
+    for (const int controlIndex : result) {
+        const QString title = catalogue.control(controlIndex).title.toLower();
+        const QString description = catalogue.control(controlIndex).description.toLower();
+        EXPECT_TRUE(title.contains("deck") || description.contains("deck"));
+    }
+}
+
+TEST_F(ControlCatalogueTest, SearchByGroup) {
+    ControlCatalogue catalogue;
+    const std::vector<int> result = catalogue.search(QStringLiteral("sampler4 play"));
+    EXPECT_NE(result.end(),
+            std::find(result.begin(),
+                    result.end(),
+                    indexOf(catalogue, ConfigKey("[Sampler4]", "play"))));
+    EXPECT_TRUE(catalogue.search(QStringLiteral("nosuchcontrol")).empty());
+    EXPECT_TRUE(catalogue.search(QString()).empty());
+}
+
+TEST_F(ControlCatalogueTest, InstanceIsShared) {
+    const auto pCatalogue = ControlCatalogue::instance();
+    EXPECT_EQ(pCatalogue, ControlCatalogue::instance());
+
+    // Adding a deck requires a new catalogue, the old one stays valid
+    m_playerCounts.m_numDecks.set(3);
+    const auto pRebuiltCatalogue = ControlCatalogue::instance();
+    EXPECT_NE(pCatalogue, pRebuiltCatalogue);
+    EXPECT_FALSE(pCatalogue->controlExists(ConfigKey("[Channel3]", "play")));
+    EXPECT_TRUE(pRebuiltCatalogue->controlExists(ConfigKey("[Channel3]", "play")));
+}
+
+TEST_F(ControlCatalogueTest, PickerMenuIsPopulatedLazily) {
+    ControlPickerMenu menu(nullptr);
+    ASSERT_FALSE(menu.actions().isEmpty());
+    QMenu* pSubmenu = menu.actions().first()->menu();
+    ASSERT_NE(nullptr, pSubmenu);
+    EXPECT_TRUE(pSubmenu->isEmpty());
+    emit pSubmenu->aboutToShow();
+    EXPECT_FALSE(pSubmenu->isEmpty());
+    EXPECT_EQ(ControlCatalogue::instance()->controlsAvailable().size(),
+            menu.controlsAvailable().size());
+}
+
+// Compares building the whole catalogue, as every ControlPickerMenu did
+// before, with creating another picker as a view of the shared catalogue.
+
+static void BM_ControlCatalogueBuild(benchmark::State& state) {
+    PlayerCountControls playerCounts(4, 16);
+    for (auto _ : state) {
+        ControlCatalogue catalogue;
+        benchmark::DoNotOptimize(catalogue.controlsAvailable().size());
+    }
+}
+BENCHMARK(BM_ControlCatalogueBuild)->Unit(benchmark::kMillisecond);
+
+static void BM_ControlPickerMenuCreate(benchmark::State& state) {
+    PlayerCountControls playerCounts(4, 16);
+    ControlCatalogue::instance();
+    for (auto _ : state) {
+        ControlPickerMenu menu(nullptr);
+        benchmark::DoNotOptimize(menu.actions().size());
+    }
+}
+BENCHMARK(BM_ControlPickerMenuCreate)->Unit(benchmark::kMicrosecond);
+
+static void BM_ControlCatalogueSearch(benchmark::State& state) {
+    PlayerCountControls playerCounts(4, 16);
+    ControlCatalogue catalogue;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(catalogue.search(QStringLiteral("deck 3 hotcue")));
+    }
+}
+BENCHMARK(BM_ControlCatalogueSearch)->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -46,6 +46,14 @@ class ControllerScriptEngineLegacyTest : public MixxxTest {
         return cEngine->evaluateScriptFile(scriptFile);
     }
 
+    void warmUpInputHandlers() {
+        cEngine->warmUpInputHandlers();
+    }
+
+    const QHash<QString, QJSValue>& scriptWrappedFunctionCache() const {
+        return cEngine->m_scriptWrappedFunctionCache;
+    }
+
     QJSValue evaluate(const QString& code) {
         return cEngine->jsEngine()->evaluate(code);
     }
@@ -620,3 +628,71 @@ TEST_F(ControllerScriptEngineLegacyTest, connectionExecutesWithCorrectThisObject
     // The counter should have been incremented exactly once.
     EXPECT_DOUBLE_EQ(1.0, pass->get());
 }
+
+TEST_F(ControllerScriptEngineLegacyTest, warmUpCompilesInputHandlers) {
+    EXPECT_TRUE(evaluateAndAssert(
+            "var MyController = {};"
+            "MyController.play = function () {};"));
+    cEngine->setInputHandlers({
+            QStringLiteral("MyController.play"),
+            QStringLiteral("MyController.play"),
+            QStringLiteral("function (channel, control, value) {}"),
+    });
+    warmUpInputHandlers();
+    EXPECT_EQ(2, scriptWrappedFunctionCache().size());
+    EXPECT_TRUE(scriptWrappedFunctionCache()
+                        .value(QStringLiteral("MyController.play"))
+                        .isCallable());
+}
+
+TEST_F(ControllerScriptEngineLegacyTest, profilerHandlerName) {
+    EXPECT_EQ(QStringLiteral("namedHandler"),
+            ControllerScriptProfiler::handlerName(
+                    evaluate("(function namedHandler() { return 1; })")));
+    // Anonymous functions are identified by their source code, how much of
+    // it is available depends on the Qt version
+    const QString anonymousName = ControllerScriptProfiler::handlerName(
+            evaluate("var MyController = {};"
+                     "MyController.handler = function () {\n"
+                     "    return 1;\n"
+                     "};"));
+    EXPECT_TRUE(anonymousName.startsWith(QStringLiteral("function")));
+    EXPECT_FALSE(anonymousName.contains('\n'));
+}
+
+TEST_F(ControllerScriptEngineLegacyTest, profilerHistogramBucket) {
+    using mixxx::Duration;
+    EXPECT_EQ(Duration::fromMicros(1), ControllerScriptProfiler::histogramBucket(Duration()));
+    EXPECT_EQ(Duration::fromMicros(1),
+            ControllerScriptProfiler::histogramBucket(Duration::fromMicros(1)));
+    EXPECT_EQ(Duration::fromMicros(2),
+            ControllerScriptProfiler::histogramBucket(Duration::fromNanos(1001)));
+    EXPECT_EQ(Duration::fromMicros(1024),
+            ControllerScriptProfiler::histogramBucket(Duration::fromMicros(1000)));
+}
+
+TEST_F(ControllerScriptEngineLegacyTest, profilerStatKey) {
+    ControllerScriptProfiler profiler(QStringLiteral("Test Controller"));
+    const QString& key = profiler.statKey(
+            ControllerScriptProfiler::HandlerType::Timer, QStringLiteral("blink"));
+    EXPECT_EQ(QStringLiteral("JS timer blink (Test Controller)"), key);
+    // Cached for every callback
+    EXPECT_EQ(&key,
+            &profiler.statKey(ControllerScriptProfiler::HandlerType::Timer,
+                    QStringLiteral("blink")));
+}
+
+TEST_F(ControllerScriptEngineLegacyTest, profiledConnectionIsExecuted) {
+    cEngine->profiler()->setEnabled(true);
+    auto co = std::make_unique<ControlObject>(ConfigKey("[Test]", "co"));
+    auto counter = std::make_unique<ControlObject>(ConfigKey("[Test]", "counter"));
+
+    EXPECT_TRUE(evaluateAndAssert(
+            "var connection = engine.makeConnection('[Test]', 'co', function () {"
+            "    engine.setValue('[Test]', 'counter', "
+            "                    engine.getValue('[Test]', 'counter') + 1);"
+            "});"
+            "connection.trigger();"));
+    processEvents();
+    EXPECT_DOUBLE_EQ(1.0, counter->get());
+}
@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
+#include <QDateTime>
+#include <QFile>
 #include <QFileInfo>
+#include <QTemporaryDir>
+#include <array>
 
 #include "library/coverartcache.h"
 #include "library/coverartutils.h"
@@ -92,3 +96,144 @@ TEST_F(CoverArtCacheTest, loadCoverFromFileAbsolute) {
             getTestDir().filePath(kCoverLocationTest),
             getTestDir().filePath(kCoverLocationTest));
 }
+
+TEST_F(CoverArtCacheTest, loadScaledCoverFromDiskCache) {
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+    const CoverArtDiskCache diskCache(tempDir.path());
+
+    CoverInfo info;
+    info.type = CoverInfo::FILE;
+    info.source = CoverInfo::GUESSED;
+    info.coverLocation = getTestDir().filePath(kCoverLocationTest);
+    CoverArtCache::FutureResult res = CoverArtCache::loadCover(
+            nullptr, TrackPointer(), info, 50, false, &diskCache);
+    EXPECT_FALSE(res.loadedFromDiskCache);
+    ASSERT_EQ(50, res.coverArt.loadedImage.image.width());
+    const auto cacheKey = res.coverArt.cacheKey();
+    ASSERT_TRUE(mixxx::isValidCacheKey(cacheKey));
+    EXPECT_TRUE(QFileInfo::exists(diskCache.filePath(cacheKey, 50)));
+    // Only the requested size is stored
+    EXPECT_FALSE(QFileInfo::exists(diskCache.filePath(cacheKey, 100)));
+
+    // The source is not accessed again
+    info = res.coverArt;
+    info.coverLocation = getTestDir().filePath(QStringLiteral("id3-test-data/missing.jpg"));
+    res = CoverArtCache::loadCover(
+            nullptr, TrackPointer(), info, 50, false, &diskCache);
+    EXPECT_TRUE(res.loadedFromDiskCache);
+    EXPECT_FALSE(res.coverInfoUpdated);
+    EXPECT_EQ(CoverInfo::LoadedImage::Result::Ok, res.coverArt.loadedImage.result);
+    EXPECT_EQ(50, res.coverArt.loadedImage.image.width());
+    EXPECT_EQ(cacheKey, res.coverArt.cacheKey());
+
+    // Other sizes are loaded from the source
+    res = CoverArtCache::loadCover(
+            nullptr, TrackPointer(), info, 100, false, &diskCache);
+    EXPECT_FALSE(res.loadedFromDiskCache);
+    EXPECT_TRUE(res.coverArt.loadedImage.image.isNull());
+}
+
+TEST_F(CoverArtCacheTest, diskCacheIgnoresReplacedCover) {
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+    const CoverArtDiskCache diskCache(tempDir.path());
+    const QString coverLocation = tempDir.filePath(QStringLiteral("cover.png"));
+    QImage image(100, 100, QImage::Format_RGB32);
+    image.fill(QColor(255, 0, 0));
+    ASSERT_TRUE(image.save(coverLocation));
+
+    CoverInfo info;
+    info.type = CoverInfo::FILE;
+    info.source = CoverInfo::GUESSED;
+    info.coverLocation = coverLocation;
+    CoverArtCache::FutureResult res = CoverArtCache::loadCover(
+            nullptr, TrackPointer(), info, 50, false, &diskCache);
+    EXPECT_FALSE(res.loadedFromDiskCache);
+    info = res.coverArt;
+    const auto cacheKey = info.cacheKey();
+    ASSERT_TRUE(mixxx::isValidCacheKey(cacheKey));
+    {
+        QFile file(diskCache.filePath(cacheKey, 50));
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        ASSERT_TRUE(file.setFileTime(
+                QDateTime::currentDateTimeUtc().addDays(-1),
+                QFileDevice::FileModificationTime));
+    }
+
+    // The thumbnail is newer than the unmodified cover file
+    res = CoverArtCache::loadCover(
+            nullptr, TrackPointer(), info, 50, false, &diskCache);
+    EXPECT_TRUE(res.loadedFromDiskCache);
+    EXPECT_EQ(cacheKey, res.coverArt.cacheKey());
+
+    // Replace the cover file, which makes the thumbnail outdated
+    image.fill(QColor(0, 0, 255));
+    ASSERT_TRUE(image.save(coverLocation));
+    res = CoverArtCache::loadCover(
+            nullptr, TrackPointer(), info, 50, false, &diskCache);
+    EXPECT_FALSE(res.loadedFromDiskCache);
+    EXPECT_TRUE(res.coverInfoUpdated);
+    EXPECT_NE(cacheKey, res.coverArt.cacheKey());
+    EXPECT_EQ(QColor(0, 0, 255).rgb(), res.coverArt.loadedImage.image.pixel(0, 0));
+    EXPECT_TRUE(QFileInfo::exists(diskCache.filePath(res.coverArt.cacheKey(), 50)));
+}
+
+TEST_F(CoverArtCacheTest, diskCacheKeepsAlphaChannel) {
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+    const CoverArtDiskCache diskCache(tempDir.path());
+    constexpr mixxx::cache_key_t kCacheKey = 0x0123456789abcdef;
+
+    QImage image(20, 10, QImage::Format_ARGB32);
+    image.fill(QColor(255, 0, 0, 128));
+    ASSERT_TRUE(diskCache.saveImage(kCacheKey, image));
+    EXPECT_TRUE(diskCache.filePath(kCacheKey, 20).endsWith(
+            QStringLiteral("/01/0123456789abcdef_20")));
+
+    const QImage loadedImage = diskCache.loadImage(kCacheKey, 20);
+    ASSERT_FALSE(loadedImage.isNull());
+    EXPECT_EQ(image.convertToFormat(QImage::Format_ARGB32),
+            loadedImage.convertToFormat(QImage::Format_ARGB32));
+    EXPECT_TRUE(diskCache.loadImage(kCacheKey, 30).isNull());
+}
+
+TEST_F(CoverArtCacheTest, diskCachePrunesLeastRecentlyUsed) {
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+    QImage image(20, 10, QImage::Format_RGB32);
+    image.fill(QColor(255, 0, 0));
+    const std::array<mixxx::cache_key_t, 4> cacheKeys = {1, 2, 3, 4};
+    {
+        const CoverArtDiskCache diskCache(tempDir.path());
+        for (const auto cacheKey : cacheKeys) {
+            ASSERT_TRUE(diskCache.saveImage(cacheKey, image));
+        }
+    }
+    // The same image, so all files have the same size
+    const qint64 fileSize = QFileInfo(
+            CoverArtDiskCache(tempDir.path()).filePath(cacheKeys[0], 20))
+                                    .size();
+    ASSERT_GT(fileSize, 0);
+
+    // Within the default limit
+    EXPECT_EQ(0, CoverArtDiskCache(tempDir.path()).prune());
+
+    // Room for 3 files, pruned down to 2.25 files
+    const CoverArtDiskCache diskCache(tempDir.path(), 3 * fileSize);
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    for (int i = 0; i < 3; ++i) {
+        QFile file(diskCache.filePath(cacheKeys[i], 20));
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        ASSERT_TRUE(file.setFileTime(now.addDays(i - 4), QFileDevice::FileModificationTime));
+    }
+    // Loading marks the oldest file as used
+    ASSERT_FALSE(diskCache.loadImage(cacheKeys[0], 20).isNull());
+
+    EXPECT_EQ(2, diskCache.prune());
+    EXPECT_TRUE(QFileInfo::exists(diskCache.filePath(cacheKeys[0], 20)));
+    EXPECT_FALSE(QFileInfo::exists(diskCache.filePath(cacheKeys[1], 20)));
+    EXPECT_FALSE(QFileInfo::exists(diskCache.filePath(cacheKeys[2], 20)));
+    EXPECT_TRUE(QFileInfo::exists(diskCache.filePath(cacheKeys[3], 20)));
+    EXPECT_EQ(0, diskCache.prune());
+}
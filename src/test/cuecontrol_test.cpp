@@ -184,6 +184,36 @@ TEST_F(CueControlTest, LoadTrackWithIntroEndAndOutroStart) {
     EXPECT_FALSE(m_pOutroEndEnabled->toBool());
 }
 
+TEST_F(CueControlTest, SeekToOutroStartIsAccountedToPrefetchHint) {
+    // Far away from the read ahead of the current position
+    constexpr auto kOutroStartPosition = mixxx::audio::FramePos(20 * 44100);
+
+    TrackPointer pTrack = createTestTrack();
+    auto pOutro = pTrack->createAndAddCue(
+            mixxx::CueType::Outro,
+            Cue::kNoHotCue,
+            kOutroStartPosition,
+            mixxx::audio::kInvalidFramePos);
+
+    loadTrack(pTrack);
+    // Issue the hints for the loaded cues
+    ProcessBuffer();
+
+    CachingReader* pReader = m_pChannel1->getEngineBuffer()->m_pReader;
+    auto statistics = pReader->getHintStatistics(Hint::Type::OutroStart);
+    EXPECT_EQ(0, statistics.hits + statistics.misses);
+    EXPECT_EQ(0, statistics.dropped);
+
+    setCurrentFramePos(kOutroStartPosition);
+
+    // Whether the chunk was already read by the worker depends on timing,
+    // but the seek must be accounted to the outro hint either way.
+    statistics = pReader->getHintStatistics(Hint::Type::OutroStart);
+    EXPECT_EQ(1, statistics.hits + statistics.misses);
+    statistics = pReader->getHintStatistics(Hint::Type::CurrentPosition);
+    EXPECT_EQ(0, statistics.hits + statistics.misses);
+}
+
 TEST_F(CueControlTest, LoadAutodetectedCues_QuantizeEnabled) {
     m_pQuantizeEnabled->set(1);
 
@@ -0,0 +1,190 @@
+#include "soundio/driftresampler.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "util/fifo.h"
+#include "util/math.h"
+
+namespace {
+
+constexpr int kChannelCount = 2;
+constexpr double kSampleRate = 48000.0;
+constexpr double kFrequency = 1000.0;
+
+void fillSine(std::vector<CSAMPLE>* pBuffer, SINT frames, SINT* pPhase) {
+    for (SINT i = 0; i < frames; ++i) {
+        const auto value = static_cast<CSAMPLE>(
+                std::sin(2.0 * M_PI * kFrequency * (*pPhase)++ / kSampleRate));
+        for (int channel = 0; channel < kChannelCount; ++channel) {
+            (*pBuffer)[i * kChannelCount + channel] = value;
+        }
+    }
+}
+
+TEST(DriftResamplerTest, UnityRatioDelaysInput) {
+    constexpr SINT kFrames = 256;
+    DriftResampler resampler(kChannelCount, kFrames);
+    std::vector<CSAMPLE> input(kFrames * kChannelCount);
+    std::vector<CSAMPLE> output(kFrames * kChannelCount);
+    SINT phase = 0;
+    fillSine(&input, kFrames, &phase);
+    ASSERT_EQ(kFrames, resampler.process(input.data(), kFrames, output.data(), kFrames));
+    for (SINT i = DriftResampler::kDelayFrames; i < kFrames; ++i) {
+        const SINT inputFrame = i - DriftResampler::kDelayFrames;
+        EXPECT_NEAR(input[inputFrame * kChannelCount],
+                output[i * kChannelCount],
+                5e-3);
+        EXPECT_EQ(output[i * kChannelCount], output[i * kChannelCount + 1]);
+    }
+}
+
+TEST(DriftResamplerTest, InputFramesRequiredAreSufficient) {
+    constexpr SINT kFrames = 512;
+    for (double ratio : {1.0 - DriftResampler::kMaxRatioDeviation, 0.9999, 1.0003,
+                 1.0 + DriftResampler::kMaxRatioDeviation}) {
+        DriftResampler resampler(kChannelCount, 2 * kFrames);
+        resampler.setRatio(ratio);
+        std::vector<CSAMPLE> input(2 * kFrames * kChannelCount);
+        std::vector<CSAMPLE> output(kFrames * kChannelCount);
+        SINT phase = 0;
+        for (int i = 0; i < 100; ++i) {
+            const SINT required = resampler.inputFramesRequired(kFrames);
+            fillSine(&input, required, &phase);
+            ASSERT_EQ(kFrames,
+                    resampler.process(input.data(), required, output.data(), kFrames))
+                    << "ratio " << ratio;
+        }
+    }
+}
+
+TEST(DriftResamplerTest, RatioIsLimited) {
+    DriftResampler resampler(kChannelCount, 64);
+    resampler.setRatio(2.0);
+    EXPECT_DOUBLE_EQ(1.0 + DriftResampler::kMaxRatioDeviation, resampler.ratio());
+    resampler.setRatio(0.5);
+    EXPECT_DOUBLE_EQ(1.0 - DriftResampler::kMaxRatioDeviation, resampler.ratio());
+
+    // A FIFO that runs over for a long time must not wind up the controller
+    resampler.reset();
+    for (int i = 0; i < 100000; ++i) {
+        resampler.updateRatio(1000, 0, 64);
+    }
+    EXPECT_DOUBLE_EQ(1.0 + DriftResampler::kMaxRatioDeviation, resampler.ratio());
+    int callbacks = 0;
+    while (resampler.ratio() > 1.0 && callbacks < 100000) {
+        resampler.updateRatio(0, 64, 64);
+        ++callbacks;
+    }
+    EXPECT_LT(callbacks, 5000);
+}
+
+struct SimulationResult {
+    int underflows = 0;
+    int overflows = 0;
+    double maxSampleDelta = 0.0;
+};
+
+// Two callbacks with independent clocks around a FIFO, like the engine
+// driven by the clock reference device and the output of another device in
+// SoundDevicePortAudio::callbackProcessDrift(). The device clock is off by
+// ppm and both callbacks are delayed randomly by up to jitter periods.
+SimulationResult simulateOutput(
+        SINT framesPerBuffer, double ppm, double jitter, double seconds) {
+    constexpr double kSettleSeconds = 10.0;
+    const SINT targetFrames = 2 * framesPerBuffer + framesPerBuffer / 2;
+    FIFO<CSAMPLE> fifo(kChannelCount * framesPerBuffer * 4);
+    std::vector<CSAMPLE> buffer(kChannelCount * framesPerBuffer * 2);
+    fifo.write(buffer.data(), static_cast<int>(kChannelCount * targetFrames));
+    DriftResampler resampler(kChannelCount, 2 * framesPerBuffer);
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<double> jitterDistribution(-jitter, jitter);
+    const double period = framesPerBuffer / kSampleRate;
+    double engineTime = 0.0;
+    double deviceTime = period / 2;
+    double nextEngineCallback = engineTime + jitterDistribution(random) * period;
+    double nextDeviceCallback = deviceTime + jitterDistribution(random) * period;
+
+    SimulationResult result;
+    SINT phase = 0;
+    std::vector<CSAMPLE> output(kChannelCount * framesPerBuffer);
+    CSAMPLE lastSample = CSAMPLE_ZERO;
+    while (engineTime < seconds) {
+        const bool settled = engineTime > kSettleSeconds;
+        if (nextEngineCallback <= nextDeviceCallback) {
+            fillSine(&buffer, framesPerBuffer, &phase);
+            const int size = static_cast<int>(kChannelCount * framesPerBuffer);
+            if (fifo.writeAvailable() < size && settled) {
+                ++result.overflows;
+            }
+            fifo.write(buffer.data(), size);
+            engineTime += period;
+            nextEngineCallback = engineTime + jitterDistribution(random) * period;
+        } else {
+            const int readAvailable = fifo.readAvailable();
+            resampler.updateRatio(readAvailable / kChannelCount, targetFrames, framesPerBuffer);
+            const int readCount = math_min(
+                    static_cast<int>(resampler.inputFramesRequired(framesPerBuffer)) *
+                            kChannelCount,
+                    readAvailable);
+            fifo.read(buffer.data(), readCount);
+            const SINT outputFrames = resampler.process(buffer.data(),
+                    readCount / kChannelCount,
+                    output.data(),
+                    framesPerBuffer);
+            if (outputFrames < framesPerBuffer && settled) {
+                ++result.underflows;
+            }
+            for (SINT i = 0; i < outputFrames; ++i) {
+                const CSAMPLE sample = output[i * kChannelCount];
+                if (settled) {
+                    result.maxSampleDelta = math_max(result.maxSampleDelta,
+                            static_cast<double>(std::abs(sample - lastSample)));
+                }
+                lastSample = sample;
+            }
+            deviceTime += period * (1.0 - ppm * 1e-6);
+            nextDeviceCallback = deviceTime + jitterDistribution(random) * period;
+        }
+    }
+    return result;
+}
+
+TEST(DriftResamplerTest, TwoClocksWithoutDropouts) {
+    // The largest difference between two samples of the sine, plus the
+    // ripple of the filter
+    const double maxSampleDelta = 2.0 * M_PI * kFrequency / kSampleRate * 1.02;
+    for (double ppm : {200.0, -200.0, 50.0}) {
+        for (SINT framesPerBuffer : {64, 480, 1024}) {
+            const SimulationResult result = simulateOutput(framesPerBuffer, ppm, 0.2, 60.0);
+            EXPECT_EQ(0, result.underflows) << ppm << " ppm " << framesPerBuffer << " frames";
+            EXPECT_EQ(0, result.overflows) << ppm << " ppm " << framesPerBuffer << " frames";
+            EXPECT_LE(result.maxSampleDelta, maxSampleDelta)
+                    << ppm << " ppm " << framesPerBuffer << " frames";
+        }
+    }
+}
+
+static void BM_DriftResamplerProcess(benchmark::State& state) {
+    const SINT framesPerBuffer = state.range(0);
+    DriftResampler resampler(kChannelCount, 2 * framesPerBuffer);
+    resampler.setRatio(1.0001);
+    std::vector<CSAMPLE> input(kChannelCount * framesPerBuffer * 2);
+    std::vector<CSAMPLE> output(kChannelCount * framesPerBuffer);
+    SINT phase = 0;
+    fillSine(&input, framesPerBuffer * 2, &phase);
+    for (auto _ : state) {
+        const SINT required = resampler.inputFramesRequired(framesPerBuffer);
+        benchmark::DoNotOptimize(resampler.process(
+                input.data(), required, output.data(), framesPerBuffer));
+    }
+    state.SetItemsProcessed(state.iterations() * framesPerBuffer);
+}
+BENCHMARK(BM_DriftResamplerProcess)->Arg(64)->Arg(512)->Arg(2048);
+
+} // namespace
@@ -1,3 +1,4 @@
+#include <benchmark/benchmark.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -79,6 +80,10 @@ class EngineBufferScaleLinearTest : public MixxxTest {
                 1.0, &tempoRatio, &pitchRatio);
     }
 
+    void SetInterpolator(EngineBufferScaleLinear::Interpolator interpolator) {
+        m_pScaler->setInterpolator(interpolator);
+    }
+
     void SetRateNoLerp(double rate) {
         // Set it twice to prevent rate LERP'ing
         SetRate(rate);
@@ -126,6 +131,31 @@ class EngineBufferScaleLinearTest : public MixxxTest {
         }
     }
 
+    // Returns the RMS error of the left channel against a sine wave with a
+    // period of 10 frames that is played at rate, skipping the first frames
+    // that are interpolated from the cleared history.
+    double SineRmsError(const CSAMPLE* pBuffer, int iBufferLen, double rate) {
+        double sum = 0.0;
+        int count = 0;
+        for (int frame = kSkipFrames; frame < iBufferLen / 2; ++frame) {
+            const double expected = sin(2 * M_PI * frame * rate / 10.0);
+            const double error = pBuffer[frame * 2] - expected;
+            sum += error * error;
+            ++count;
+        }
+        return sqrt(sum / count);
+    }
+
+    void FillSine(QVector<CSAMPLE>* pBuffer) {
+        for (int frame = 0; frame < 10; ++frame) {
+            const CSAMPLE value = static_cast<CSAMPLE>(sin(2 * M_PI * frame / 10.0));
+            pBuffer->push_back(value);
+            pBuffer->push_back(value);
+        }
+    }
+
+    static constexpr int kSkipFrames = 4 * EngineBufferScaleLinear::kMaxHalfTaps;
+
     StrictMock<ReadAheadManagerMock>* m_pReadAheadMock;
     EngineBufferScaleLinear* m_pScaler;
 };
@@ -296,4 +326,133 @@ TEST_F(EngineBufferScaleLinearTest, TestRepeatedScaleCalls) {
     SampleUtil::free(pOutput);
 }
 
+TEST_F(EngineBufferScaleLinearTest, InterpolatorsPreserveConstant) {
+    for (auto interpolator : {EngineBufferScaleLinear::Interpolator::Linear,
+                 EngineBufferScaleLinear::Interpolator::Hermite,
+                 EngineBufferScaleLinear::Interpolator::Sinc}) {
+        m_pScaler->clear();
+        SetInterpolator(interpolator);
+        SetRateNoLerp(0.77);
+
+        CSAMPLE readBuffer[1] = {1.0f};
+        m_pReadAheadMock->setReadBuffer(readBuffer, 1);
+
+        EXPECT_CALL(*m_pReadAheadMock, getNextSamples(_, _, _))
+                .WillRepeatedly(Invoke(m_pReadAheadMock,
+                        &ReadAheadManagerMock::getNextSamplesFake));
+
+        CSAMPLE* pOutput = SampleUtil::alloc(kiLinearScaleReadAheadLength);
+        m_pScaler->scaleBuffer(pOutput, kiLinearScaleReadAheadLength);
+        for (int i = kSkipFrames * 2; i < kiLinearScaleReadAheadLength; ++i) {
+            EXPECT_NEAR(1.0f, pOutput[i], 1e-4);
+        }
+        SampleUtil::free(pOutput);
+    }
+}
+
+TEST_F(EngineBufferScaleLinearTest, InterpolatorQuality) {
+    QVector<CSAMPLE> readBuffer;
+    FillSine(&readBuffer);
+
+    double errors[3];
+    int index = 0;
+    for (auto interpolator : {EngineBufferScaleLinear::Interpolator::Linear,
+                 EngineBufferScaleLinear::Interpolator::Hermite,
+                 EngineBufferScaleLinear::Interpolator::Sinc}) {
+        m_pScaler->clear();
+        SetInterpolator(interpolator);
+        SetRateNoLerp(0.77);
+        m_pReadAheadMock->setReadBuffer(readBuffer.data(), readBuffer.size());
+
+        EXPECT_CALL(*m_pReadAheadMock, getNextSamples(_, _, _))
+                .WillRepeatedly(Invoke(m_pReadAheadMock,
+                        &ReadAheadManagerMock::getNextSamplesFake));
+
+        CSAMPLE* pOutput = SampleUtil::alloc(kiLinearScaleReadAheadLength);
+        m_pScaler->scaleBuffer(pOutput, kiLinearScaleReadAheadLength);
+        errors[index++] = SineRmsError(pOutput, kiLinearScaleReadAheadLength, 0.77);
+        SampleUtil::free(pOutput);
+    }
+    // A sine at a fifth of the Nyquist frequency
+    EXPECT_LT(errors[1], errors[0] / 4);
+    EXPECT_LT(errors[2], errors[1] / 4);
+    EXPECT_LT(errors[2], 1e-3);
+}
+
+TEST_F(EngineBufferScaleLinearTest, SwitchingInterpolatorIsClickFree) {
+    QVector<CSAMPLE> readBuffer;
+    FillSine(&readBuffer);
+    m_pReadAheadMock->setReadBuffer(readBuffer.data(), readBuffer.size());
+
+    EXPECT_CALL(*m_pReadAheadMock, getNextSamples(_, _, _))
+            .WillRepeatedly(Invoke(m_pReadAheadMock,
+                    &ReadAheadManagerMock::getNextSamplesFake));
+
+    constexpr int kBufferSize = 256;
+    CSAMPLE* pOutput = SampleUtil::alloc(kBufferSize * 6);
+    int offset = 0;
+    m_pScaler->clear();
+    for (auto interpolator : {EngineBufferScaleLinear::Interpolator::Linear,
+                 EngineBufferScaleLinear::Interpolator::Sinc,
+                 EngineBufferScaleLinear::Interpolator::Hermite,
+                 EngineBufferScaleLinear::Interpolator::Sinc,
+                 EngineBufferScaleLinear::Interpolator::Linear,
+                 EngineBufferScaleLinear::Interpolator::Hermite}) {
+        SetInterpolator(interpolator);
+        // Ramp the rate, too
+        SetRate(0.5 + offset / (kBufferSize * 24.0));
+        m_pScaler->scaleBuffer(pOutput + offset, kBufferSize);
+        offset += kBufferSize;
+    }
+    // The steepest slope of the sine is 2 * pi / 10 per frame at rate 1.0,
+    // a click would be a much larger step.
+    for (int i = 2; i < kBufferSize * 6; i += 2) {
+        EXPECT_LT(fabs(pOutput[i] - pOutput[i - 2]), 0.6f) << "frame " << i / 2;
+    }
+    SampleUtil::free(pOutput);
+}
+
+class ReadAheadManagerSine : public ReadAheadManager {
+  public:
+    SINT getNextSamples(double dRate, CSAMPLE* buffer, SINT requested_samples) override {
+        Q_UNUSED(dRate);
+        for (SINT i = 0; i < requested_samples; i += 2) {
+            const CSAMPLE value = static_cast<CSAMPLE>(sin(m_phase));
+            buffer[i] = value;
+            buffer[i + 1] = value;
+            m_phase += 0.1;
+        }
+        return requested_samples;
+    }
+
+  private:
+    double m_phase = 0.0;
+};
+
+static void BM_ScaleBuffer(benchmark::State& state) {
+    ReadAheadManagerSine readAheadManager;
+    EngineBufferScaleLinear scaler(&readAheadManager);
+    scaler.setSampleRate(mixxx::audio::SampleRate(44100));
+    scaler.setInterpolator(static_cast<EngineBufferScaleLinear::Interpolator>(state.range(0)));
+    const SINT size = static_cast<SINT>(state.range(1));
+    CSAMPLE* pOutput = SampleUtil::alloc(size);
+    double rate = 0.9;
+    while (state.KeepRunning()) {
+        // Alternate the rate like a slow scratch, so that the ramp and not
+        // the copy path is measured.
+        rate = rate > 1.0 ? 0.9 : 1.1;
+        double tempoRatio = rate;
+        double pitchRatio = rate;
+        scaler.setScaleParameters(1.0, &tempoRatio, &pitchRatio);
+        scaler.scaleBuffer(pOutput, size);
+    }
+    state.SetItemsProcessed(state.iterations() * size / 2);
+    SampleUtil::free(pOutput);
+}
+BENCHMARK(BM_ScaleBuffer)
+        ->ArgsProduct({{static_cast<int>(EngineBufferScaleLinear::Interpolator::Linear),
+                               static_cast<int>(EngineBufferScaleLinear::Interpolator::Hermite),
+                               static_cast<int>(EngineBufferScaleLinear::Interpolator::Sinc)},
+                {256, 2048}});
+
 }  // namespace
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <QThread>
+#include <QtDebug>
+#include <cmath>
+#include <functional>
+#include <memory>
+
+#include "engine/bufferscalers/enginebufferscalerubberband.h"
+#include "engine/engineworkerscheduler.h"
+#include "engine/readaheadmanager.h"
+#include "test/mixxxtest.h"
+#include "util/sample.h"
+#include "util/types.h"
+
+namespace {
+
+constexpr SINT kBufferFrames = 256;
+
+class ReadAheadManagerSine : public ReadAheadManager {
+  public:
+    SINT getNextSamples(double dRate, CSAMPLE* buffer, SINT requested_samples) override {
+        Q_UNUSED(dRate);
+        for (SINT i = 0; i < requested_samples; i += 2) {
+            const CSAMPLE value = static_cast<CSAMPLE>(sin(m_phase));
+            buffer[i] = value;
+            buffer[i + 1] = value;
+            m_phase += 0.1;
+        }
+        return requested_samples;
+    }
+
+  private:
+    double m_phase = 0.0;
+};
+
+bool isSilent(const CSAMPLE* pBuffer, SINT samples) {
+    for (SINT i = 0; i < samples; ++i) {
+        if (pBuffer[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+class EngineBufferScaleRubberBandTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        m_pWorkerScheduler = std::make_unique<EngineWorkerScheduler>();
+        m_pWorkerScheduler->start(QThread::HighPriority);
+        m_pScaler = std::make_unique<EngineBufferScaleRubberBand>(&m_readAheadManager);
+        m_pScaler->setSampleRate(mixxx::audio::SampleRate(44100));
+        setTempo(1.0);
+        m_pScaler->setScheduler(m_pWorkerScheduler.get());
+        m_pOutput = SampleUtil::alloc(2 * kBufferFrames);
+    }
+
+    void TearDown() override {
+        SampleUtil::free(m_pOutput);
+        // Same order as in ~EngineMaster()
+        m_pWorkerScheduler.reset();
+        m_pScaler.reset();
+    }
+
+    void setTempo(double tempo) {
+        double tempoRatio = tempo;
+        double pitchRatio = 1.0;
+        m_pScaler->setScaleParameters(1.0, &tempoRatio, &pitchRatio);
+    }
+
+    // One audio callback, returns the unstretched frames read
+    double process(SINT frames = kBufferFrames) {
+        const double framesRead = m_pScaler->scaleBuffer(m_pOutput, 2 * frames);
+        m_pWorkerScheduler->runWorkers();
+        return framesRead;
+    }
+
+    // Runs small audio callbacks until condition is met, gives up after
+    // about 5 seconds.
+    bool processUntil(const std::function<bool()>& condition) {
+        for (int i = 0; i < 5000; ++i) {
+            if (condition()) {
+                return true;
+            }
+            process(32);
+            QThread::msleep(1);
+        }
+        return condition();
+    }
+
+    bool fillLookAhead() {
+        return processUntil([this] {
+            return lookAheadFrames() >= 1024;
+        });
+    }
+
+    // The worker only runs when woken by runWorkers(), give it time to
+    // finish its current pass.
+    void waitForWorkerIdle() {
+        QThread::msleep(50);
+    }
+
+    SINT lookAheadFrames() const {
+        return m_pScaler->m_lookAheadOutput.readAvailable() / 2;
+    }
+
+    bool isWorkerRunning() const {
+        return m_pScaler->m_pWorker && m_pScaler->m_pWorker->isRunning();
+    }
+
+    ReadAheadManagerSine m_readAheadManager;
+    std::unique_ptr<EngineWorkerScheduler> m_pWorkerScheduler;
+    std::unique_ptr<EngineBufferScaleRubberBand> m_pScaler;
+    CSAMPLE* m_pOutput;
+};
+
+TEST_F(EngineBufferScaleRubberBandTest, LookAheadFillsInBackground) {
+    m_pScaler->setLookAheadEnabled(true);
+    ASSERT_TRUE(isWorkerRunning());
+    ASSERT_TRUE(fillLookAhead());
+
+    EXPECT_DOUBLE_EQ(kBufferFrames, process());
+    EXPECT_FALSE(isSilent(m_pOutput, 2 * kBufferFrames));
+}
+
+TEST_F(EngineBufferScaleRubberBandTest, TempoChangeAppliesToNewBlocksOnly) {
+    m_pScaler->setLookAheadEnabled(true);
+    ASSERT_TRUE(fillLookAhead());
+
+    // The queued frames have been rendered at the old tempo
+    setTempo(2.0);
+    EXPECT_DOUBLE_EQ(kBufferFrames, process());
+
+    // Once they have been played, the new tempo is accounted
+    ASSERT_TRUE(processUntil([this] {
+        return process() == 2.0 * kBufferFrames;
+    }));
+}
+
+TEST_F(EngineBufferScaleRubberBandTest, ClearDropsLookAheadWithoutGap) {
+    m_pScaler->setLookAheadEnabled(true);
+    ASSERT_TRUE(fillLookAhead());
+    waitForWorkerIdle();
+
+    // The stale audio is dropped, and the audio thread stretches the new
+    // audio itself until the worker has caught up.
+    m_pScaler->clear();
+    EXPECT_DOUBLE_EQ(kBufferFrames, process());
+    EXPECT_FALSE(isSilent(m_pOutput, 2 * kBufferFrames));
+
+    ASSERT_TRUE(fillLookAhead());
+    EXPECT_DOUBLE_EQ(kBufferFrames, process());
+}
+
+TEST_F(EngineBufferScaleRubberBandTest, DisablingStopsWorker) {
+    m_pScaler->setLookAheadEnabled(true);
+    ASSERT_TRUE(fillLookAhead());
+
+    m_pScaler->setLookAheadEnabled(false);
+    EXPECT_FALSE(isWorkerRunning());
+
+    // The queued frames are played first, then the stretcher runs
+    // synchronously again without a gap.
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_DOUBLE_EQ(kBufferFrames, process());
+    }
+    EXPECT_EQ(0, lookAheadFrames());
+
+    m_pScaler->setLookAheadEnabled(true);
+    EXPECT_TRUE(isWorkerRunning());
+    ASSERT_TRUE(fillLookAhead());
+}
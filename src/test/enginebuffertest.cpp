@@ -183,6 +183,27 @@ TEST_F(EngineBufferTest, ReadFadeOut) {
     EXPECT_EQ(m_pMockScaleVinyl1->getProcessedTempo(), 1.0);
 }
 
+TEST_F(EngineBufferTest, PausedOutputIsSilent) {
+    ControlObject::set(ConfigKey(m_sGroup1, "play"), 1.0);
+    ProcessBuffer();
+    EXPECT_FALSE(m_pChannel1->getEngineBuffer()->isOutputSilent());
+    EXPECT_FALSE(m_pChannel1->isSilent());
+
+    // The first buffer after pausing still fades out the old rate
+    ControlObject::set(ConfigKey(m_sGroup1, "play"), 0.0);
+    ProcessBuffer();
+    EXPECT_FALSE(m_pChannel1->getEngineBuffer()->isOutputSilent());
+    ProcessBuffer();
+    EXPECT_TRUE(m_pChannel1->getEngineBuffer()->isOutputSilent());
+    // Without effects the deck is silent at once
+    EXPECT_TRUE(m_pChannel1->isSilent());
+
+    ControlObject::set(ConfigKey(m_sGroup1, "play"), 1.0);
+    ProcessBuffer();
+    EXPECT_FALSE(m_pChannel1->getEngineBuffer()->isOutputSilent());
+    EXPECT_FALSE(m_pChannel1->isSilent());
+}
+
 TEST_F(EngineBufferTest, ResetPitchAdjustUsesLinear) {
     // If the key was adjusted, but keylock is off, and then the key is
     // reset, then the engine should be using the linear scaler.
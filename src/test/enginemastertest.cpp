@@ -30,6 +30,10 @@ class EngineChannelMock : public EngineChannel {
         Q_UNUSED(iBufferSize);
     }
 
+    void setSilent(bool silent) {
+        m_bSilent = silent;
+    }
+
     MOCK_METHOD0(isActive, bool());
     MOCK_CONST_METHOD0(isMasterEnabled, bool());
     MOCK_CONST_METHOD0(isPflEnabled, bool());
@@ -391,4 +395,38 @@ TEST_F(EngineMasterTest, ThreeChannelPFLOutputWorks) {
     assertHeadphoneBufferMatchesGolden(testName);
 }
 
+TEST_F(EngineMasterTest, SilentChannelIsNotMixed) {
+    EngineChannelMock* pChannel = new EngineChannelMock(
+            "[Test1]", EngineChannel::CENTER, m_pEngineMaster);
+    m_pEngineMaster->addChannel(pChannel);
+
+    // The buffer is not inspected, the silent flag of the channel is
+    // trusted. Fill it anyway to see whether it has been mixed.
+    CSAMPLE* pChannelBuffer = const_cast<CSAMPLE*>(m_pEngineMaster->getChannelBuffer("[Test1]"));
+    SampleUtil::fill(pChannelBuffer, 0.1f, MAX_BUFFER_LEN);
+    pChannel->setSilent(true);
+
+    EXPECT_CALL(*pChannel, isActive())
+            .Times(1)
+            .WillOnce(Return(true));
+    EXPECT_CALL(*pChannel, isMasterEnabled())
+            .Times(1)
+            .WillOnce(Return(true));
+    EXPECT_CALL(*pChannel, isPflEnabled())
+            .Times(1)
+            .WillOnce(Return(true));
+    EXPECT_CALL(*pChannel, process(_, _))
+            .Times(1)
+            .WillOnce(Return());
+
+    m_pEngineMaster->process(MAX_BUFFER_LEN);
+
+    const CSAMPLE* pMaster = m_pEngineMaster->getMasterBuffer();
+    const CSAMPLE* pHeadphone = m_pEngineMaster->getHeadphoneBuffer();
+    for (unsigned int i = 0; i < MAX_BUFFER_LEN; ++i) {
+        ASSERT_EQ(CSAMPLE_ZERO, pMaster[i]);
+        ASSERT_EQ(CSAMPLE_ZERO, pHeadphone[i]);
+    }
+}
+
 }  // namespace
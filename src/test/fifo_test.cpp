@@ -0,0 +1,290 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QMutex>
+#include <QWaitCondition>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "util/eventcount.h"
+#include "util/fifo.h"
+
+namespace {
+
+TEST(FifoTest, CapacityIsRoundedUpToPowerOf2) {
+    FIFO<int> fifo(1000);
+    EXPECT_EQ(0, fifo.readAvailable());
+    EXPECT_EQ(1024, fifo.writeAvailable());
+}
+
+TEST(FifoTest, WriteUntilFullAndReadBack) {
+    FIFO<int> fifo(8);
+    std::vector<int> input(10);
+    std::iota(input.begin(), input.end(), 0);
+
+    EXPECT_EQ(8, fifo.write(input.data(), 10));
+    EXPECT_EQ(0, fifo.write(input.data(), 1));
+    EXPECT_EQ(8, fifo.readAvailable());
+    EXPECT_EQ(0, fifo.writeAvailable());
+
+    std::vector<int> output(10);
+    EXPECT_EQ(8, fifo.read(output.data(), 10));
+    EXPECT_EQ(0, fifo.read(output.data(), 1));
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(i, output[i]);
+    }
+}
+
+TEST(FifoTest, RegionsWrapAround) {
+    FIFO<int> fifo(8);
+    const int input[6] = {1, 2, 3, 4, 5, 6};
+    ASSERT_EQ(6, fifo.write(input, 6));
+    int output[6];
+    ASSERT_EQ(4, fifo.read(output, 4));
+
+    // Write position 6, 2 items until the end of the buffer
+    int* pData1;
+    ring_buffer_size_t size1;
+    int* pData2;
+    ring_buffer_size_t size2;
+    EXPECT_EQ(5, fifo.aquireWriteRegions(5, &pData1, &size1, &pData2, &size2));
+    EXPECT_EQ(2, size1);
+    EXPECT_EQ(3, size2);
+    for (int i = 0; i < size1; ++i) {
+        pData1[i] = 7 + i;
+    }
+    for (int i = 0; i < size2; ++i) {
+        pData2[i] = 9 + i;
+    }
+    // Nothing is visible before the regions have been released
+    EXPECT_EQ(2, fifo.readAvailable());
+    fifo.releaseWriteRegions(5);
+    EXPECT_EQ(7, fifo.readAvailable());
+
+    // Zero-copy read of both segments
+    EXPECT_EQ(7, fifo.aquireReadRegions(8, &pData1, &size1, &pData2, &size2));
+    EXPECT_EQ(4, size1);
+    EXPECT_EQ(3, size2);
+    int expected = 5;
+    for (int i = 0; i < size1; ++i) {
+        EXPECT_EQ(expected++, pData1[i]);
+    }
+    for (int i = 0; i < size2; ++i) {
+        EXPECT_EQ(expected++, pData2[i]);
+    }
+    fifo.releaseReadRegions(7);
+    EXPECT_EQ(0, fifo.readAvailable());
+    EXPECT_EQ(8, fifo.writeAvailable());
+}
+
+TEST(FifoTest, FlushReadData) {
+    FIFO<int> fifo(8);
+    const int input[4] = {1, 2, 3, 4};
+    fifo.write(input, 4);
+    EXPECT_EQ(3, fifo.flushReadData(3));
+    EXPECT_EQ(1, fifo.flushReadData(3));
+    EXPECT_EQ(0, fifo.readAvailable());
+}
+
+TEST(FifoTest, ReadAfterFlushReadData) {
+    FIFO<int> fifo(8);
+    const int input[4] = {1, 2, 3, 4};
+    fifo.write(input, 4);
+    EXPECT_EQ(3, fifo.flushReadData(3));
+    int output[4] = {};
+    EXPECT_EQ(1, fifo.read(output, 4));
+    EXPECT_EQ(4, output[0]);
+    EXPECT_EQ(0, fifo.read(output, 4));
+
+    // Flushing must also work after the cached write index has been
+    // loaded by a preceding read
+    fifo.write(input, 4);
+    EXPECT_EQ(1, fifo.read(output, 1));
+    EXPECT_EQ(2, fifo.flushReadData(2));
+    fifo.write(input, 2);
+    EXPECT_EQ(3, fifo.read(output, 4));
+    EXPECT_EQ(4, output[0]);
+    EXPECT_EQ(1, output[1]);
+    EXPECT_EQ(2, output[2]);
+    EXPECT_EQ(0, fifo.readAvailable());
+}
+
+TEST(FifoTest, ProducerConsumerPreservesOrder) {
+    constexpr int kCount = 1 << 18;
+    FIFO<int> fifo(256);
+    EventCount dataAvailable;
+
+    std::thread producer([&fifo, &dataAvailable] {
+        int buffer[37];
+        int next = 0;
+        while (next < kCount) {
+            const int count = std::min(37, kCount - next);
+            for (int i = 0; i < count; ++i) {
+                buffer[i] = next + i;
+            }
+            int written = 0;
+            while (written < count) {
+                const int result = fifo.write(buffer + written, count - written);
+                if (result == 0) {
+                    // Full, give the consumer a chance on single core machines
+                    std::this_thread::yield();
+                }
+                written += result;
+            }
+            dataAvailable.notify();
+            next += count;
+        }
+    });
+
+    int expected = 0;
+    bool inOrder = true;
+    int buffer[64];
+    while (expected < kCount) {
+        const auto key = dataAvailable.prepareWait();
+        if (fifo.readAvailable() > 0) {
+            dataAvailable.cancelWait();
+        } else {
+            dataAvailable.wait(key);
+        }
+        const int count = fifo.read(buffer, 64);
+        for (int i = 0; i < count; ++i) {
+            inOrder &= buffer[i] == expected++;
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(inOrder);
+    EXPECT_EQ(kCount, expected);
+}
+
+// Throughput of passing stereo buffers from one thread to another.
+static void BM_FifoThroughput(benchmark::State& state) {
+    const int blockSize = static_cast<int>(state.range(0));
+    FIFO<float> fifo(65536);
+    std::atomic<bool> stop(false);
+
+    std::thread consumer([&fifo, &stop] {
+        float* pData1;
+        ring_buffer_size_t size1;
+        float* pData2;
+        ring_buffer_size_t size2;
+        while (!stop.load(std::memory_order_relaxed)) {
+            const int count = fifo.aquireReadRegions(
+                    65536, &pData1, &size1, &pData2, &size2);
+            if (count == 0) {
+                std::this_thread::yield();
+            }
+            fifo.releaseReadRegions(count);
+        }
+    });
+
+    std::vector<float> block(blockSize, 0.5f);
+    int64_t items = 0;
+    for (auto _ : state) {
+        int written = 0;
+        while (written < blockSize) {
+            const int result = fifo.write(block.data() + written, blockSize - written);
+            if (result == 0) {
+                std::this_thread::yield();
+            }
+            written += result;
+        }
+        items += blockSize;
+    }
+    stop = true;
+    consumer.join();
+    state.SetItemsProcessed(items);
+    state.SetBytesProcessed(items * static_cast<int64_t>(sizeof(float)));
+}
+BENCHMARK(BM_FifoThroughput)->Arg(128)->Arg(1024)->Arg(8192)->UseRealTime();
+
+// Round trip latency of waking up a sleeping consumer with EventCount.
+static void BM_EventCountWakeLatency(benchmark::State& state) {
+    EventCount request;
+    EventCount response;
+    std::atomic<int> requests(0);
+    std::atomic<int> responses(0);
+    std::atomic<bool> stop(false);
+
+    std::thread consumer([&] {
+        int handled = 0;
+        while (true) {
+            const auto key = request.prepareWait();
+            if (requests.load() > handled || stop.load()) {
+                request.cancelWait();
+            } else {
+                request.wait(key);
+            }
+            if (stop.load()) {
+                return;
+            }
+            while (handled < requests.load()) {
+                ++handled;
+                responses.store(handled);
+                response.notify();
+            }
+        }
+    });
+
+    int sent = 0;
+    for (auto _ : state) {
+        requests.store(++sent);
+        request.notify();
+        while (responses.load() < sent) {
+            const auto key = response.prepareWait();
+            if (responses.load() >= sent) {
+                response.cancelWait();
+            } else {
+                response.wait(key);
+            }
+        }
+    }
+    stop = true;
+    request.notify();
+    consumer.join();
+}
+BENCHMARK(BM_EventCountWakeLatency)->UseRealTime();
+
+// The same round trip with QWaitCondition for comparison, as used before.
+static void BM_QWaitConditionWakeLatency(benchmark::State& state) {
+    QMutex mutex;
+    QWaitCondition request;
+    QWaitCondition response;
+    int requests = 0;
+    int responses = 0;
+    bool stop = false;
+
+    std::thread consumer([&] {
+        mutex.lock();
+        while (true) {
+            while (requests == responses && !stop) {
+                request.wait(&mutex);
+            }
+            if (stop) {
+                break;
+            }
+            responses = requests;
+            response.wakeAll();
+        }
+        mutex.unlock();
+    });
+
+    for (auto _ : state) {
+        mutex.lock();
+        ++requests;
+        request.wakeAll();
+        while (responses < requests) {
+            response.wait(&mutex);
+        }
+        mutex.unlock();
+    }
+    mutex.lock();
+    stop = true;
+    request.wakeAll();
+    mutex.unlock();
+    consumer.join();
+}
+BENCHMARK(BM_QWaitConditionWakeLatency)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,176 @@
+#include "controllers/hid/hidiomultiplexer.h"
+
+#include <benchmark/benchmark.h>
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include "util/time.h"
+
+namespace {
+
+// A device with a pipe instead of a hidraw file descriptor
+class FakeDevice : public HidIoMultiplexer::Device {
+  public:
+    FakeDevice()
+            : m_inputActive(true),
+              m_stopRequested(false),
+              m_removed(false),
+              m_reportsRead(0),
+              m_outputBatches(0),
+              m_lastLatencyNanos(0) {
+        int fds[2];
+        EXPECT_EQ(0, pipe2(fds, O_NONBLOCK | O_CLOEXEC));
+        m_readFd = fds[0];
+        m_writeFd = fds[1];
+    }
+    ~FakeDevice() override {
+        close(m_readFd);
+        close(m_writeFd);
+    }
+
+    void sendInputReport() {
+        m_lastWriteTime = mixxx::Time::elapsed().toIntegerNanos();
+        const char report[4] = {1, 2, 3, 4};
+        EXPECT_EQ(4, write(m_writeFd, report, sizeof(report)));
+    }
+
+    int fileDescriptor() const override {
+        return m_readFd;
+    }
+    bool isInputActive() const override {
+        return m_inputActive;
+    }
+    void readInputReports(mixxx::Duration timestamp) override {
+        char report[4];
+        while (read(m_readFd, report, sizeof(report)) == sizeof(report)) {
+            m_lastLatencyNanos = timestamp.toIntegerNanos() - m_lastWriteTime;
+            ++m_reportsRead;
+        }
+    }
+    bool sendOutputReports(const std::function<void()>& pollInput) override {
+        ++m_outputBatches;
+        pollInput();
+        return false;
+    }
+    bool checkStopped(const std::function<void()>& pollInput) override {
+        Q_UNUSED(pollInput);
+        return m_stopRequested;
+    }
+    void removed() override {
+        m_removed = true;
+    }
+
+    std::atomic<bool> m_inputActive;
+    std::atomic<bool> m_stopRequested;
+    std::atomic<bool> m_removed;
+    std::atomic<int> m_reportsRead;
+    std::atomic<int> m_outputBatches;
+    std::atomic<qint64> m_lastWriteTime;
+    std::atomic<qint64> m_lastLatencyNanos;
+
+  private:
+    int m_readFd;
+    int m_writeFd;
+};
+
+bool waitFor(const std::function<bool()>& condition) {
+    for (int i = 0; i < 1000; ++i) {
+        if (condition()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+class HidIoMultiplexerTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        m_multiplexer.start();
+    }
+
+    void TearDown() override {
+        m_multiplexer.removeDevice(&m_device);
+    }
+
+    HidIoMultiplexer m_multiplexer;
+    FakeDevice m_device;
+};
+
+TEST_F(HidIoMultiplexerTest, InputReportsAreRead) {
+    m_multiplexer.addDevice(&m_device);
+    m_device.sendInputReport();
+    EXPECT_TRUE(waitFor([this] { return m_device.m_reportsRead == 1; }));
+    m_device.sendInputReport();
+    m_device.sendInputReport();
+    EXPECT_TRUE(waitFor([this] { return m_device.m_reportsRead == 3; }));
+}
+
+TEST_F(HidIoMultiplexerTest, InputReportsAreKeptWhileInactive) {
+    m_device.m_inputActive = false;
+    m_multiplexer.addDevice(&m_device);
+    m_device.sendInputReport();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(0, m_device.m_reportsRead);
+
+    // Like a state change of the HidIoThread
+    m_device.m_inputActive = true;
+    m_multiplexer.wake();
+    EXPECT_TRUE(waitFor([this] { return m_device.m_reportsRead == 1; }));
+}
+
+TEST_F(HidIoMultiplexerTest, OutputRequestsAreCoalesced) {
+    m_multiplexer.addDevice(&m_device);
+    for (int i = 0; i < 100; ++i) {
+        m_multiplexer.requestOutput();
+    }
+    EXPECT_TRUE(waitFor([this] { return m_device.m_outputBatches > 0; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    // One batch for the first request and at most one for all others
+    // in the next output frame
+    EXPECT_LE(m_device.m_outputBatches, 2);
+}
+
+TEST_F(HidIoMultiplexerTest, StoppedDeviceIsRemoved) {
+    m_multiplexer.addDevice(&m_device);
+    m_device.m_stopRequested = true;
+    m_multiplexer.wake();
+    EXPECT_TRUE(waitFor([this] { return m_device.m_removed.load(); }));
+
+    // No longer read after removal
+    m_device.sendInputReport();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(0, m_device.m_reportsRead);
+}
+
+// Time from writing into the file descriptor until the multiplexer thread
+// has woken up, compared with the 250 us idle sleep of the polling
+// HidIoThread.
+static void BM_HidIoMultiplexerInputLatency(benchmark::State& state) {
+    HidIoMultiplexer multiplexer;
+    multiplexer.start();
+    FakeDevice device;
+    multiplexer.addDevice(&device);
+    double latencySum = 0;
+    int count = 0;
+    for (auto _ : state) {
+        const int expected = device.m_reportsRead + 1;
+        device.sendInputReport();
+        while (device.m_reportsRead < expected) {
+            std::this_thread::yield();
+        }
+        latencySum += device.m_lastLatencyNanos / 1000.0;
+        ++count;
+    }
+    multiplexer.removeDevice(&device);
+    state.counters["latency_us"] = count > 0 ? latencySum / count : 0.0;
+}
+BENCHMARK(BM_HidIoMultiplexerInputLatency)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,305 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QBuffer>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtEndian>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <vector>
+
+#include "library/serato/seratofieldreader.h"
+#include "util/mappedfile.h"
+
+namespace {
+
+QByteArray seratoField(const char* pFieldName, const QByteArray& data) {
+    QByteArray field(SeratoFieldReader::kHeaderSize, '\0');
+    memcpy(field.data(), pFieldName, sizeof(quint32));
+    qToBigEndian(static_cast<quint32>(data.size()), field.data() + sizeof(quint32));
+    return field + data;
+}
+
+quint32 seratoFieldId(const char* pFieldName) {
+    return qFromBigEndian<quint32>(pFieldName);
+}
+
+// A Serato "database V2" file with tracks that have a path and a title
+QByteArray seratoDatabase(int trackCount) {
+    QByteArray database = seratoField("vrsn", QByteArray(60, 'v'));
+    for (int i = 0; i < trackCount; ++i) {
+        const QByteArray track =
+                seratoField("pfil", QByteArray(80, 'p')) +
+                seratoField("tsng", QByteArray(40, 't')) +
+                seratoField("uadd", QByteArray(4, '\0'));
+        database += seratoField("otrk", track);
+    }
+    return database;
+}
+
+class MappedFileTest : public testing::Test {
+  protected:
+    QString writeFile(const QString& fileName, const QByteArray& contents) {
+        const QString filePath = m_tempDir.filePath(fileName);
+        QFile file(filePath);
+        EXPECT_TRUE(file.open(QIODevice::WriteOnly));
+        EXPECT_EQ(contents.size(), file.write(contents));
+        return filePath;
+    }
+
+    QTemporaryDir m_tempDir;
+};
+
+TEST_F(MappedFileTest, ReadContents) {
+    const QByteArray contents("0123456789");
+    mixxx::MappedFile file;
+    ASSERT_TRUE(file.open(writeFile("file", contents)));
+    EXPECT_TRUE(file.isOpen());
+    EXPECT_EQ(contents.size(), file.size());
+    EXPECT_EQ(contents, file.bytes());
+
+    file.close();
+    EXPECT_FALSE(file.isOpen());
+    EXPECT_EQ(0, file.size());
+}
+
+TEST_F(MappedFileTest, EmptyFile) {
+    mixxx::MappedFile file;
+    ASSERT_TRUE(file.open(writeFile("empty", QByteArray())));
+    EXPECT_TRUE(file.isOpen());
+    EXPECT_EQ(0, file.size());
+    EXPECT_TRUE(file.bytes().isEmpty());
+
+    mixxx::MappedFileStreamBuf streamBuf(file);
+    std::istream stream(&streamBuf);
+    char c;
+    EXPECT_FALSE(stream.read(&c, 1));
+    EXPECT_TRUE(stream.eof());
+}
+
+TEST_F(MappedFileTest, MissingFile) {
+    mixxx::MappedFile file;
+    EXPECT_FALSE(file.open(m_tempDir.filePath("missing")));
+    EXPECT_FALSE(file.isOpen());
+}
+
+TEST_F(MappedFileTest, StreamReadAndSeek) {
+    mixxx::MappedFile file;
+    ASSERT_TRUE(file.open(writeFile("file", QByteArray("0123456789"))));
+    mixxx::MappedFileStreamBuf streamBuf(file);
+    std::istream stream(&streamBuf);
+
+    char buffer[4] = {};
+    ASSERT_TRUE(stream.read(buffer, 3));
+    EXPECT_EQ(QByteArray("012"), QByteArray(buffer, 3));
+    EXPECT_EQ(3, static_cast<std::streamoff>(stream.tellg()));
+
+    ASSERT_TRUE(stream.seekg(7));
+    ASSERT_TRUE(stream.read(buffer, 2));
+    EXPECT_EQ(QByteArray("78"), QByteArray(buffer, 2));
+
+    ASSERT_TRUE(stream.seekg(-6, std::ios_base::cur));
+    EXPECT_EQ(3, static_cast<std::streamoff>(stream.tellg()));
+    ASSERT_TRUE(stream.seekg(-1, std::ios_base::end));
+    EXPECT_EQ(9, static_cast<std::streamoff>(stream.tellg()));
+
+    // Seeking to the end is allowed, but reading fails
+    ASSERT_TRUE(stream.seekg(0, std::ios_base::end));
+    EXPECT_EQ(10, static_cast<std::streamoff>(stream.tellg()));
+    EXPECT_FALSE(stream.read(buffer, 1));
+    EXPECT_TRUE(stream.eof());
+
+    // Seeking beyond the end fails
+    stream.clear();
+    EXPECT_FALSE(stream.seekg(11));
+    stream.clear();
+    EXPECT_FALSE(stream.seekg(-1));
+}
+
+TEST(SeratoFieldReaderTest, ReadNestedFields) {
+    const QByteArray track =
+            seratoField("pfil", QByteArray("path")) +
+            seratoField("bmis", QByteArray(1, '\1'));
+    const QByteArray database =
+            seratoField("vrsn", QByteArray("1.0")) +
+            seratoField("otrk", track);
+
+    SeratoFieldReader reader(database);
+    quint32 fieldId;
+    QByteArray data;
+    ASSERT_TRUE(reader.next(&fieldId, &data));
+    EXPECT_EQ(seratoFieldId("vrsn"), fieldId);
+    EXPECT_EQ(QStringLiteral("vrsn"), SeratoFieldReader::fieldName(fieldId));
+    EXPECT_EQ(QByteArray("1.0"), data);
+
+    ASSERT_TRUE(reader.next(&fieldId, &data));
+    EXPECT_EQ(seratoFieldId("otrk"), fieldId);
+    EXPECT_EQ(track, data);
+    // The data of the field is not copied
+    EXPECT_EQ(database.constData() + database.size() - track.size(), data.constData());
+
+    SeratoFieldReader trackReader(data);
+    ASSERT_TRUE(trackReader.next(&fieldId, &data));
+    EXPECT_EQ(seratoFieldId("pfil"), fieldId);
+    EXPECT_EQ(QByteArray("path"), data);
+    ASSERT_TRUE(trackReader.next(&fieldId, &data));
+    EXPECT_EQ(seratoFieldId("bmis"), fieldId);
+    EXPECT_EQ(QByteArray(1, '\1'), data);
+    EXPECT_FALSE(trackReader.next(&fieldId, &data));
+    EXPECT_FALSE(trackReader.isTruncated());
+    EXPECT_EQ(0, trackReader.remaining());
+
+    EXPECT_FALSE(reader.next(&fieldId, &data));
+    EXPECT_FALSE(reader.isTruncated());
+    EXPECT_EQ(0, reader.remaining());
+}
+
+TEST(SeratoFieldReaderTest, TruncatedField) {
+    const QByteArray database =
+            seratoField("vrsn", QByteArray("1.0")) +
+            seratoField("otrk", QByteArray("track")).left(10);
+
+    SeratoFieldReader reader(database);
+    quint32 fieldId;
+    QByteArray data;
+    ASSERT_TRUE(reader.next(&fieldId, &data));
+    EXPECT_FALSE(reader.next(&fieldId, &data));
+    EXPECT_TRUE(reader.isTruncated());
+    EXPECT_EQ(seratoFieldId("otrk"), fieldId);
+    EXPECT_EQ(10, reader.remaining());
+}
+
+TEST(SeratoFieldReaderTest, ExtraBytesAtEnd) {
+    const QByteArray database = seratoField("vrsn", QByteArray("1.0")) + "xyz";
+
+    SeratoFieldReader reader(database);
+    quint32 fieldId;
+    QByteArray data;
+    ASSERT_TRUE(reader.next(&fieldId, &data));
+    EXPECT_FALSE(reader.next(&fieldId, &data));
+    EXPECT_FALSE(reader.isTruncated());
+    EXPECT_EQ(3, reader.remaining());
+}
+
+// Page sized random access, as done by the Rekordbox PDB parser
+constexpr int kPageSize = 4096;
+constexpr int kPageCount = 2048;
+
+QString writePagesFile(const QTemporaryDir& tempDir) {
+    const QString filePath = tempDir.filePath("pages");
+    QFile file(filePath);
+    file.open(QIODevice::WriteOnly);
+    for (int i = 0; i < kPageCount; ++i) {
+        file.write(QByteArray(kPageSize, static_cast<char>(i)));
+    }
+    return filePath;
+}
+
+void readPages(std::istream* pStream) {
+    char row[16];
+    for (int i = 0; i < kPageCount; ++i) {
+        // Jump around between the pages like the linked page lists do
+        const int page = (i * 7919) % kPageCount;
+        for (int offset = 0; offset < kPageSize; offset += 256) {
+            pStream->seekg(page * kPageSize + offset);
+            pStream->read(row, sizeof(row));
+            benchmark::DoNotOptimize(row);
+        }
+    }
+}
+
+static void BM_IfstreamPageReads(benchmark::State& state) {
+    QTemporaryDir tempDir;
+    const QString filePath = writePagesFile(tempDir);
+    for (auto _ : state) {
+        std::ifstream stream(filePath.toStdString(), std::ifstream::binary);
+        readPages(&stream);
+    }
+    state.SetBytesProcessed(
+            static_cast<int64_t>(state.iterations()) * kPageCount * kPageSize);
+}
+BENCHMARK(BM_IfstreamPageReads);
+
+static void BM_MappedFilePageReads(benchmark::State& state) {
+    QTemporaryDir tempDir;
+    const QString filePath = writePagesFile(tempDir);
+    for (auto _ : state) {
+        mixxx::MappedFile file;
+        file.open(filePath);
+        mixxx::MappedFileStreamBuf streamBuf(file);
+        std::istream stream(&streamBuf);
+        readPages(&stream);
+    }
+    state.SetBytesProcessed(
+            static_cast<int64_t>(state.iterations()) * kPageCount * kPageSize);
+}
+BENCHMARK(BM_MappedFilePageReads);
+
+constexpr int kSeratoTrackCount = 10000;
+
+// The field by field reading that was used before
+static void BM_SeratoDatabaseQFileRead(benchmark::State& state) {
+    QTemporaryDir tempDir;
+    const QString filePath = tempDir.filePath("database V2");
+    QFile file(filePath);
+    file.open(QIODevice::WriteOnly);
+    file.write(seratoDatabase(kSeratoTrackCount));
+    file.close();
+
+    for (auto _ : state) {
+        QFile databaseFile(filePath);
+        databaseFile.open(QIODevice::ReadOnly);
+        int fieldCount = 0;
+        QByteArray headerData = databaseFile.read(SeratoFieldReader::kHeaderSize);
+        while (headerData.length() == SeratoFieldReader::kHeaderSize) {
+            const quint32 fieldSize =
+                    qFromBigEndian<quint32>(headerData.constData() + sizeof(quint32));
+            QByteArray data = databaseFile.read(fieldSize);
+            QBuffer buffer(&data);
+            buffer.open(QIODevice::ReadOnly);
+            QByteArray trackHeaderData = buffer.read(SeratoFieldReader::kHeaderSize);
+            while (trackHeaderData.length() == SeratoFieldReader::kHeaderSize) {
+                const quint32 trackFieldSize = qFromBigEndian<quint32>(
+                        trackHeaderData.constData() + sizeof(quint32));
+                benchmark::DoNotOptimize(buffer.read(trackFieldSize));
+                ++fieldCount;
+                trackHeaderData = buffer.read(SeratoFieldReader::kHeaderSize);
+            }
+            headerData = databaseFile.read(SeratoFieldReader::kHeaderSize);
+        }
+        benchmark::DoNotOptimize(fieldCount);
+    }
+}
+BENCHMARK(BM_SeratoDatabaseQFileRead);
+
+static void BM_SeratoDatabaseMappedRead(benchmark::State& state) {
+    QTemporaryDir tempDir;
+    const QString filePath = tempDir.filePath("database V2");
+    QFile file(filePath);
+    file.open(QIODevice::WriteOnly);
+    file.write(seratoDatabase(kSeratoTrackCount));
+    file.close();
+
+    for (auto _ : state) {
+        mixxx::MappedFile databaseFile;
+        databaseFile.open(filePath);
+        int fieldCount = 0;
+        SeratoFieldReader reader(databaseFile.bytes());
+        quint32 fieldId;
+        QByteArray data;
+        while (reader.next(&fieldId, &data)) {
+            SeratoFieldReader trackReader(data);
+            QByteArray trackData;
+            while (trackReader.next(&fieldId, &trackData)) {
+                benchmark::DoNotOptimize(trackData);
+                ++fieldCount;
+            }
+        }
+        benchmark::DoNotOptimize(fieldCount);
+    }
+}
+BENCHMARK(BM_SeratoDatabaseMappedRead);
+
+} // namespace
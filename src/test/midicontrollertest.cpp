@@ -1,10 +1,17 @@
+#include <benchmark/benchmark.h>
 #include <gmock/gmock.h>
 
 #include <QScopedPointer>
+#include <QTemporaryDir>
+#include <QTemporaryFile>
+#include <array>
+#include <memory>
+#include <vector>
 
 #include "control/controlpotmeter.h"
 #include "control/controlpushbutton.h"
 #include "controllers/midi/legacymidicontrollermapping.h"
+#include "controllers/midi/legacymidicontrollermappingfilehandler.h"
 #include "controllers/midi/midicontroller.h"
 #include "controllers/midi/midimessage.h"
 #include "controllers/midi/midiutils.h"
@@ -34,6 +41,20 @@ class MidiControllerTest : public MixxxTest {
         m_pMapping = std::make_shared<LegacyMidiControllerMapping>();
     }
 
+    void TearDown() override {
+        // MidiController names the protected members of Controller
+        MidiController* pController = m_pController.data();
+        if (pController->getScriptEngine()) {
+            pController->stopEngine();
+        }
+    }
+
+    void startScriptEngine() {
+        MidiController* pController = m_pController.data();
+        pController->startEngine();
+        pController->getScriptEngine()->initialize();
+    }
+
     void addMapping(const MidiInputMapping& mapping) {
         m_pMapping->addInputMapping(mapping.key.key, mapping);
     }
@@ -596,3 +617,247 @@ TEST_F(MidiControllerTest, ReceiveMessage_PotMeterCO_14BitPitchBend) {
     receivedShortMessage(MidiOpCode::PitchBendChange, channel, 0x01, 0x40);
     EXPECT_LT(kMiddleValue, potmeter.get());
 }
+
+TEST_F(MidiControllerTest, ReceiveMessage_ScaleTransform_Absolute) {
+    ConfigKey key("[Channel1]", "pregain");
+    ControlPotmeter potmeter(key, 0.0, 4.0);
+    unsigned char channel = 0x01;
+    unsigned char control = 0x10;
+
+    MidiInputMapping mapping(
+            MidiKey(MidiUtils::statusFromOpCodeAndChannel(
+                            MidiOpCode::ControlChange, channel),
+                    control),
+            MidiOptions(),
+            key);
+    mapping.transform.type = MidiInputTransform::Type::Scale;
+    mapping.transform.min = 0.5;
+    mapping.transform.max = 2.5;
+    addMapping(mapping);
+    m_pController->setMapping(m_pMapping->clone());
+
+    // Linear onto [min, max] of the value, unlike the parameter of the
+    // potmeter without a transform
+    receivedShortMessage(MidiOpCode::ControlChange, channel, control, 0x00);
+    EXPECT_DOUBLE_EQ(0.5, potmeter.get());
+    receivedShortMessage(MidiOpCode::ControlChange, channel, control, 0x7F);
+    EXPECT_DOUBLE_EQ(2.5, potmeter.get());
+    receivedShortMessage(MidiOpCode::ControlChange, channel, control, 127 / 2);
+    EXPECT_DOUBLE_EQ(0.5 + 2.0 * (127 / 2) / 127.0, potmeter.get());
+}
+
+TEST_F(MidiControllerTest, ReceiveMessage_ScaleTransform_RelativeEncoder) {
+    ConfigKey key("[Channel1]", "pregain");
+    ControlPotmeter potmeter(key, 0.0, 4.0);
+    potmeter.set(1.0);
+    unsigned char channel = 0x01;
+    unsigned char control = 0x10;
+
+    MidiInputMapping mapping(
+            MidiKey(MidiUtils::statusFromOpCodeAndChannel(
+                            MidiOpCode::ControlChange, channel),
+                    control),
+            MidiOptions(),
+            key);
+    mapping.transform.type = MidiInputTransform::Type::Scale;
+    mapping.transform.encoder = MidiInputTransform::Encoder::TwosComplement;
+    mapping.transform.min = 0.0;
+    mapping.transform.max = 2.0;
+    mapping.transform.step = 0.25;
+    addMapping(mapping);
+    m_pController->setMapping(m_pMapping->clone());
+
+    receivedShortMessage(MidiOpCode::ControlChange, channel, control, 0x02);
+    EXPECT_DOUBLE_EQ(1.5, potmeter.get());
+    receivedShortMessage(MidiOpCode::ControlChange, channel, control, 0x7F);
+    EXPECT_DOUBLE_EQ(1.25, potmeter.get());
+    // Clamped to the range of the transform, not the control
+    receivedShortMessage(MidiOpCode::ControlChange, channel, control, 0x3F);
+    EXPECT_DOUBLE_EQ(2.0, potmeter.get());
+}
+
+TEST_F(MidiControllerTest, ReceiveMessage_ScratchJogTransform_NotScratching) {
+    ConfigKey key("[Channel1]", "jog");
+    ControlObject jog(key);
+    unsigned char channel = 0x01;
+    unsigned char control = 0x20;
+
+    MidiInputMapping mapping(
+            MidiKey(MidiUtils::statusFromOpCodeAndChannel(
+                            MidiOpCode::ControlChange, channel),
+                    control),
+            MidiOptions(),
+            key);
+    mapping.transform.type = MidiInputTransform::Type::ScratchJog;
+    mapping.transform.encoder = MidiInputTransform::Encoder::Offset64;
+    mapping.transform.step = 0.5;
+    addMapping(mapping);
+    m_pController->setMapping(m_pMapping->clone());
+
+    // Without touching the jog wheel it bends the pitch
+    receivedShortMessage(MidiOpCode::ControlChange, channel, control, 0x44);
+    EXPECT_DOUBLE_EQ(2.0, jog.get());
+    receivedShortMessage(MidiOpCode::ControlChange, channel, control, 0x3F);
+    EXPECT_DOUBLE_EQ(-0.5, jog.get());
+}
+
+TEST_F(MidiControllerTest, ReceiveMessage_ScratchTouchTransform) {
+    ControlObject scratch2Enable(ConfigKey("[Channel1]", "scratch2_enable"));
+    unsigned char channel = 0x01;
+    unsigned char control = 0x21;
+
+    MidiInputMapping mapping;
+    mapping.control = ConfigKey("[Channel1]", "jog");
+    mapping.transform.type = MidiInputTransform::Type::ScratchTouch;
+    mapping.transform.ramp = false;
+    for (const auto opCode : {MidiOpCode::NoteOn, MidiOpCode::NoteOff}) {
+        mapping.key = MidiKey(MidiUtils::statusFromOpCodeAndChannel(opCode, channel), control);
+        addMapping(mapping);
+    }
+    m_pController->setMapping(m_pMapping->clone());
+    startScriptEngine();
+
+    receivedShortMessage(MidiOpCode::NoteOn, channel, control, 0x7F);
+    EXPECT_EQ(1.0, scratch2Enable.get());
+    // Release with NoteOn and velocity 0
+    receivedShortMessage(MidiOpCode::NoteOn, channel, control, 0x00);
+    EXPECT_EQ(0.0, scratch2Enable.get());
+
+    receivedShortMessage(MidiOpCode::NoteOn, channel, control, 0x7F);
+    EXPECT_EQ(1.0, scratch2Enable.get());
+    receivedShortMessage(MidiOpCode::NoteOff, channel, control, 0x00);
+    EXPECT_EQ(0.0, scratch2Enable.get());
+
+    // NoteOff with a release velocity is not a touch
+    receivedShortMessage(MidiOpCode::NoteOn, channel, control, 0x7F);
+    EXPECT_EQ(1.0, scratch2Enable.get());
+    receivedShortMessage(MidiOpCode::NoteOff, channel, control, 0x40);
+    EXPECT_EQ(0.0, scratch2Enable.get());
+}
+
+TEST_F(MidiControllerTest, InputTransform_SaveAndLoad) {
+    MidiInputMapping scale(MidiKey(0xB0, 0x10),
+            MidiOptions(MidiOption::SoftTakeover),
+            ConfigKey("[Channel1]", "pregain"));
+    scale.transform.type = MidiInputTransform::Type::Scale;
+    scale.transform.min = -1.0;
+    scale.transform.max = 3.5;
+    addMapping(scale);
+    MidiInputMapping touch(MidiKey(0x90, 0x20),
+            MidiOptions(),
+            ConfigKey("[Channel2]", "scratch2_enable"));
+    touch.transform.type = MidiInputTransform::Type::ScratchTouch;
+    touch.transform.intervalsPerRev = 2048;
+    touch.transform.rpm = 45.0;
+    touch.transform.ramp = false;
+    addMapping(touch);
+    MidiInputMapping jog(MidiKey(0xB0, 0x21), MidiOptions(), ConfigKey("[Channel2]", "jog"));
+    jog.transform.type = MidiInputTransform::Type::ScratchJog;
+    jog.transform.encoder = MidiInputTransform::Encoder::Offset64;
+    jog.transform.step = 0.1;
+    addMapping(jog);
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString filePath = dir.filePath(QStringLiteral("test.midi.xml"));
+    LegacyMidiControllerMappingFileHandler handler;
+    ASSERT_TRUE(handler.save(*m_pMapping, filePath));
+
+    const auto pLoaded = std::dynamic_pointer_cast<LegacyMidiControllerMapping>(
+            LegacyControllerMappingFileHandler::loadMapping(
+                    QFileInfo(filePath), QDir(dir.path())));
+    ASSERT_TRUE(pLoaded);
+    EXPECT_EQ(m_pMapping->getInputMappings(), pLoaded->getInputMappings());
+}
+
+namespace {
+
+class BenchmarkMidiController : public MockMidiController {
+  public:
+    ~BenchmarkMidiController() override {
+        stopEngine();
+    }
+
+    using MidiController::receivedShortMessage;
+
+    bool startScriptEngine() {
+        startEngine();
+        return Controller::applyMapping();
+    }
+};
+
+// Like the traffic recorded from a mixer section: Four faders that are moved
+// up and down, one step at a time.
+std::vector<std::array<unsigned char, 3>> faderTraffic() {
+    std::vector<std::array<unsigned char, 3>> messages;
+    for (int i = 0; i < 254; ++i) {
+        const unsigned char value = static_cast<unsigned char>(i < 127 ? i : 254 - i);
+        for (unsigned char fader = 0; fader < 4; ++fader) {
+            messages.push_back({0xB0, static_cast<unsigned char>(0x10 + fader), value});
+        }
+    }
+    return messages;
+}
+
+void runFaderTraffic(benchmark::State& state, bool native) {
+    std::vector<std::unique_ptr<ControlPotmeter>> potmeters;
+    auto pMapping = std::make_shared<LegacyMidiControllerMapping>();
+    for (unsigned char fader = 0; fader < 4; ++fader) {
+        const ConfigKey key(QStringLiteral("[Channel%1]").arg(fader + 1),
+                QStringLiteral("pregain"));
+        potmeters.push_back(std::make_unique<ControlPotmeter>(key, 0.0, 4.0));
+        MidiInputMapping mapping(MidiKey(0xB0, 0x10 + fader), MidiOptions(), key);
+        if (native) {
+            mapping.transform.type = MidiInputTransform::Type::Scale;
+            mapping.transform.min = 0.0;
+            mapping.transform.max = 4.0;
+        } else {
+            mapping.options = MidiOptions(MidiOption::Script);
+            mapping.control.item = QStringLiteral("Bench.fader");
+        }
+        pMapping->addInputMapping(mapping.key.key, mapping);
+    }
+
+    // The script binding that the Scale transform replaces
+    QTemporaryFile script;
+    script.open();
+    script.write(
+            "var Bench = {};\n"
+            "Bench.init = function() {};\n"
+            "Bench.shutdown = function() {};\n"
+            "Bench.fader = function(channel, control, value, status, group) {\n"
+            "    engine.setValue(group, 'pregain', 4.0 * value / 127);\n"
+            "};\n");
+    script.close();
+    pMapping->addScriptFile(QStringLiteral("bench"),
+            QStringLiteral("Bench"),
+            QFileInfo(script.fileName()));
+
+    BenchmarkMidiController controller;
+    controller.setMapping(std::move(pMapping));
+    if (!controller.startScriptEngine()) {
+        state.SkipWithError("Failed to start the script engine");
+        return;
+    }
+
+    const auto messages = faderTraffic();
+    const auto timestamp = mixxx::Time::elapsed();
+    for (auto _ : state) {
+        for (const auto& message : messages) {
+            controller.receivedShortMessage(message[0], message[1], message[2], timestamp);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(messages.size()));
+}
+
+static void BM_MidiControllerReceive_ScriptBinding(benchmark::State& state) {
+    runFaderTraffic(state, false);
+}
+BENCHMARK(BM_MidiControllerReceive_ScriptBinding)->Unit(benchmark::kMicrosecond);
+
+static void BM_MidiControllerReceive_ScaleTransform(benchmark::State& state) {
+    runFaderTraffic(state, true);
+}
+BENCHMARK(BM_MidiControllerReceive_ScaleTransform)->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -0,0 +1,82 @@
+#include "util/rtaudit.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <pthread.h>
+#include <thread>
+
+namespace {
+
+class RtAuditTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        if (!mixxx::rtaudit::isEnabled()) {
+            GTEST_SKIP() << "Mixxx was built without RT_AUDIT";
+        }
+        mixxx::rtaudit::reset();
+    }
+
+    void TearDown() override {
+        mixxx::rtaudit::reset();
+    }
+};
+
+TEST_F(RtAuditTest, NoViolationOutsideRealtimeSection) {
+    auto pValue = std::make_unique<int>(42);
+    pValue.reset();
+    EXPECT_FALSE(mixxx::rtaudit::isRealtimeThread());
+    EXPECT_EQ(0, mixxx::rtaudit::violationCount());
+}
+
+TEST_F(RtAuditTest, AllocationIsReported) {
+    std::unique_ptr<int> pValue;
+    {
+        mixxx::rtaudit::ScopedRealtimeSection realtimeSection;
+        EXPECT_TRUE(mixxx::rtaudit::isRealtimeThread());
+        pValue = std::make_unique<int>(42);
+    }
+    EXPECT_EQ(1, mixxx::rtaudit::violationCount());
+    EXPECT_EQ(1, mixxx::rtaudit::violationReports().size());
+
+    // Freeing outside of the section is fine
+    pValue.reset();
+    EXPECT_EQ(1, mixxx::rtaudit::violationCount());
+}
+
+TEST_F(RtAuditTest, PthreadMutexLockIsReported) {
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    {
+        mixxx::rtaudit::ScopedRealtimeSection realtimeSection;
+        pthread_mutex_lock(&mutex);
+        pthread_mutex_unlock(&mutex);
+    }
+    EXPECT_EQ(1, mixxx::rtaudit::violationCount());
+}
+
+TEST_F(RtAuditTest, AllowBlockingSuppressesReports) {
+    mixxx::rtaudit::ScopedRealtimeSection realtimeSection;
+    {
+        mixxx::rtaudit::ScopedAllowBlocking allowBlocking;
+        auto pValue = std::make_unique<int>(42);
+    }
+    EXPECT_EQ(0, mixxx::rtaudit::violationCount());
+}
+
+TEST_F(RtAuditTest, OtherThreadsAreNotAudited) {
+    mixxx::rtaudit::ScopedRealtimeSection realtimeSection;
+    // Spawning the thread allocates, so do it outside of the audit
+    std::unique_ptr<std::thread> pThread;
+    {
+        mixxx::rtaudit::ScopedAllowBlocking allowBlocking;
+        pThread = std::make_unique<std::thread>([] {
+            EXPECT_FALSE(mixxx::rtaudit::isRealtimeThread());
+            auto pValue = std::make_unique<int>(42);
+        });
+        pThread->join();
+        pThread.reset();
+    }
+    EXPECT_EQ(0, mixxx::rtaudit::violationCount());
+}
+
+} // namespace
@@ -26,6 +26,7 @@
 #include "track/track.h"
 #include "util/defs.h"
 #include "util/memory.h"
+#include "util/rtaudit.h"
 #include "util/sample.h"
 #include "util/types.h"
 
@@ -242,7 +243,14 @@ class BaseSignalPathTest : public MixxxTest, SoundSourceProviderRegistration {
 
     void ProcessBuffer() {
         qDebug() << "------- Process Buffer -------";
+        mixxx::rtaudit::reset();
         m_pEngineMaster->process(kProcessBufferSize);
+        if (mixxx::rtaudit::isEnabled()) {
+            EXPECT_EQ(0, mixxx::rtaudit::violationCount())
+                    << "The engine allocated or locked in the real-time "
+                       "thread:\n"
+                    << mixxx::rtaudit::violationReports().join('\n').toStdString();
+        }
     }
 
     ChannelHandleFactoryPointer m_pChannelHandleFactory;
@@ -0,0 +1,95 @@
+#include "skin/legacy/skinpixmapcache.h"
+
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include "test/mixxxtest.h"
+
+namespace {
+
+class SkinPixmapCacheTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_skinDir.isValid());
+        ASSERT_TRUE(m_cacheDir.isValid());
+        writeSkinFile(QStringLiteral("skin.xml"), "<skin/>");
+        writeSkinFile(QStringLiteral("knob.svg"), "<svg/>");
+    }
+
+    void writeSkinFile(const QString& fileName, const QByteArray& content) {
+        QFile file(QDir(m_skinDir.path()).filePath(fileName));
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(content);
+    }
+
+    QTemporaryDir m_skinDir;
+    QTemporaryDir m_cacheDir;
+};
+
+TEST_F(SkinPixmapCacheTest, ImagesAreStoredPerScaleFactor) {
+    const PixmapSource source(QDir(m_skinDir.path()).filePath(QStringLiteral("knob.svg")));
+    QImage image(10, 20, QImage::Format_ARGB32);
+    image.fill(qRgba(10, 20, 30, 40));
+
+    {
+        SkinPixmapCache cache(m_cacheDir.path(), m_skinDir.path(), QString());
+        EXPECT_TRUE(cache.loadImage(source, 1.0).isNull());
+        cache.saveImage(source, 1.0, image);
+        EXPECT_EQ(1, cache.misses());
+    }
+
+    // The next start
+    SkinPixmapCache cache(m_cacheDir.path(), m_skinDir.path(), QString());
+    const QImage loadedImage = cache.loadImage(source, 1.0);
+    EXPECT_EQ(image.convertToFormat(QImage::Format_ARGB32),
+            loadedImage.convertToFormat(QImage::Format_ARGB32));
+    EXPECT_TRUE(cache.loadImage(source, 2.0).isNull());
+    EXPECT_EQ(1, cache.hits());
+    EXPECT_EQ(1, cache.misses());
+}
+
+TEST_F(SkinPixmapCacheTest, ModifiedSkinInvalidatesImages) {
+    const PixmapSource source(QDir(m_skinDir.path()).filePath(QStringLiteral("knob.svg")));
+    QImage image(10, 10, QImage::Format_ARGB32);
+    image.fill(Qt::red);
+    QString oldDirectory;
+    {
+        SkinPixmapCache cache(m_cacheDir.path(), m_skinDir.path(), QString());
+        cache.saveImage(source, 1.0, image);
+        oldDirectory = cache.directory();
+    }
+
+    // A different color scheme keeps the images of the other one
+    QString oldSchemeDirectory;
+    {
+        SkinPixmapCache cache(m_cacheDir.path(), m_skinDir.path(), QStringLiteral("Dark"));
+        EXPECT_NE(oldDirectory, cache.directory());
+        EXPECT_TRUE(cache.loadImage(source, 1.0).isNull());
+        cache.saveImage(source, 1.0, image);
+        oldSchemeDirectory = cache.directory();
+    }
+    ASSERT_TRUE(QFileInfo::exists(oldDirectory));
+    {
+        SkinPixmapCache cache(m_cacheDir.path(), m_skinDir.path(), QString());
+        EXPECT_EQ(oldDirectory, cache.directory());
+        EXPECT_FALSE(cache.loadImage(source, 1.0).isNull());
+    }
+
+    const QByteArray oldHash = SkinPixmapCache::hashSkinFiles(m_skinDir.path());
+    writeSkinFile(QStringLiteral("knob.svg"), "<svg width=\"10\"/>");
+    EXPECT_NE(oldHash, SkinPixmapCache::hashSkinFiles(m_skinDir.path()));
+
+    SkinPixmapCache cache(m_cacheDir.path(), m_skinDir.path(), QString());
+    EXPECT_NE(oldDirectory, cache.directory());
+    EXPECT_TRUE(cache.loadImage(source, 1.0).isNull());
+    // The images of the old version have been removed, for all schemes
+    EXPECT_FALSE(QFileInfo::exists(oldDirectory));
+    EXPECT_FALSE(QFileInfo::exists(oldSchemeDirectory));
+    EXPECT_TRUE(QFileInfo::exists(cache.directory()));
+}
+
+} // namespace
@@ -1,7 +1,10 @@
+#include <benchmark/benchmark.h>
+
 #include <QTemporaryDir>
 #include <QTemporaryFile>
 #include <QtDebug>
 
+#include "engine/cachingreader/cachingreaderchunk.h"
 #include "sources/audiosourcestereoproxy.h"
 #include "sources/soundsourceproxy.h"
 #include "test/mixxxtest.h"
@@ -395,6 +398,102 @@ TEST_F(SoundSourceProxyTest, seekForwardBackward) {
     }
 }
 
+TEST_F(SoundSourceProxyTest, stereoConversionWhileDecoding) {
+    // Decoders that provide the requested stereo signal themselves must
+    // decode the same samples as AudioSourceStereoProxy
+    const QStringList filePaths = getFilePaths();
+    for (const auto& filePath : filePaths) {
+        ASSERT_TRUE(SoundSourceProxy::isFileNameSupported(filePath));
+
+        const auto fileUrl = QUrl::fromLocalFile(filePath);
+        const auto providerRegistrations =
+                SoundSourceProxy::allProviderRegistrationsForUrl(fileUrl);
+        for (const auto& providerRegistration : providerRegistrations) {
+            mixxx::AudioSourcePointer pStereoSource = openAudioSource(
+                    filePath,
+                    providerRegistration.getProvider());
+            if (!pStereoSource) {
+                // skip test file
+                continue;
+            }
+
+            auto pTrack = Track::newTemporary(filePath);
+            SoundSourceProxy proxy(pTrack, providerRegistration.getProvider());
+            mixxx::AudioSourcePointer pProxySource = proxy.openAudioSource();
+            ASSERT_TRUE(pProxySource != nullptr);
+            pProxySource = mixxx::AudioSourceStereoProxy::create(
+                    pProxySource,
+                    CachingReaderChunk::kFrames);
+            ASSERT_EQ(pStereoSource->frameIndexRange(), pProxySource->frameIndexRange());
+
+            mixxx::SampleBuffer stereoData(CachingReaderChunk::kSamples);
+            mixxx::SampleBuffer proxyData(CachingReaderChunk::kSamples);
+            SINT frameIndex = pStereoSource->frameIndexMin();
+            while (pStereoSource->frameIndexRange().containsIndex(frameIndex)) {
+                const auto readFrameIndexRange = intersect(
+                        mixxx::IndexRange::forward(frameIndex, CachingReaderChunk::kFrames),
+                        pStereoSource->frameIndexRange());
+                const auto stereoSampleFrames =
+                        pStereoSource->readSampleFrames(
+                                mixxx::WritableSampleFrames(
+                                        readFrameIndexRange,
+                                        mixxx::SampleBuffer::WritableSlice(stereoData)));
+                const auto proxySampleFrames =
+                        pProxySource->readSampleFrames(
+                                mixxx::WritableSampleFrames(
+                                        readFrameIndexRange,
+                                        mixxx::SampleBuffer::WritableSlice(proxyData)));
+                ASSERT_FALSE(stereoSampleFrames.frameIndexRange().empty());
+                ASSERT_EQ(stereoSampleFrames.frameIndexRange(),
+                        proxySampleFrames.frameIndexRange());
+                expectDecodedSamplesEqual(
+                        stereoSampleFrames.readableLength(),
+                        stereoSampleFrames.readableData(),
+                        proxySampleFrames.readableData(),
+                        "Decoding mismatch of stereo conversion");
+                frameIndex += stereoSampleFrames.frameLength();
+            }
+        }
+    }
+}
+
+TEST_F(SoundSourceProxyTest, stereoConversionKeepsStreamInfo) {
+    // The stream info is stored in the track and must not depend on
+    // the requested channel count
+    const QStringList filePaths = getFilePaths();
+    for (const auto& filePath : filePaths) {
+        ASSERT_TRUE(SoundSourceProxy::isFileNameSupported(filePath));
+
+        const auto fileUrl = QUrl::fromLocalFile(filePath);
+        const auto providerRegistrations =
+                SoundSourceProxy::allProviderRegistrationsForUrl(fileUrl);
+        for (const auto& providerRegistration : providerRegistrations) {
+            SoundSourceProxy defaultProxy(
+                    Track::newTemporary(filePath), providerRegistration.getProvider());
+            const auto pDefaultSource = defaultProxy.openAudioSource();
+            if (!pDefaultSource) {
+                // skip test file
+                continue;
+            }
+
+            mixxx::AudioSource::OpenParams openParams;
+            openParams.setChannelCount(mixxx::audio::ChannelCount::stereo());
+            SoundSourceProxy stereoProxy(
+                    Track::newTemporary(filePath), providerRegistration.getProvider());
+            const auto pStereoSource = stereoProxy.openAudioSource(openParams);
+            ASSERT_TRUE(pStereoSource != nullptr);
+            EXPECT_EQ(pDefaultSource->getSignalInfo(), pStereoSource->getSignalInfo());
+            EXPECT_FALSE(pDefaultSource->readsStereo());
+            if (pStereoSource->readsStereo()) {
+                EXPECT_NE(mixxx::audio::ChannelCount::stereo(),
+                        pStereoSource->getSignalInfo().getChannelCount());
+                EXPECT_EQ(mixxx::audio::ChannelCount::stereo(),
+                        pStereoSource->getReadSignalInfo().getChannelCount());
+            }
+        }
+    }
+}
+
 TEST_F(SoundSourceProxyTest, skipAndRead) {
     for (auto kReadFrameCount : kBufferSizes) {
         const QStringList filePaths = getFilePaths();
@@ -944,3 +1043,71 @@ TEST_F(SoundSourceProxyTest, fileSuffixWithDifferingType) {
                 SoundSourceProxy::isFileSuffixSupported(fileSuffix));
     }
 }
+
+namespace {
+
+const QString kBenchmarkFileNameSuffixes[] = {
+        QStringLiteral(".aiff"),
+        QStringLiteral(".flac"),
+        QStringLiteral("-ffmpeg-aac.m4a"),
+        QStringLiteral("-vbr.mp3"),
+        QStringLiteral(".ogg"),
+        QStringLiteral(".opus"),
+        QStringLiteral(".wav"),
+        QStringLiteral(".wv"),
+};
+
+// Decodes a whole test file chunk by chunk like CachingReaderWorker.
+// The counter "stereoProxy" reports if the samples are decoded into a
+// temporary buffer and then copied into the chunk by AudioSourceStereoProxy
+// instead of being decoded directly into the chunk.
+static void BM_ReadCachingReaderChunks(benchmark::State& state) {
+    // Benchmarks run without a test fixture that registers the providers
+    if (!SoundSourceProxy::isFileSuffixSupported(QStringLiteral("wav"))) {
+        SoundSourceProxy::registerProviders();
+    }
+    const QString fileNameSuffix = kBenchmarkFileNameSuffixes[state.range(0)];
+    const QString filePath = MixxxTest::getOrInitTestDir().filePath(
+            QStringLiteral("id3-test-data/cover-test") + fileNameSuffix);
+    state.SetLabel(fileNameSuffix.toStdString());
+    if (!SoundSourceProxy::isFileNameSupported(filePath)) {
+        state.SkipWithError("Unsupported file type");
+        return;
+    }
+
+    mixxx::AudioSource::OpenParams openParams;
+    openParams.setChannelCount(CachingReaderChunk::kChannels);
+    const auto pAudioSource =
+            SoundSourceProxy(Track::newTemporary(filePath)).openAudioSource(openParams);
+    if (!pAudioSource) {
+        state.SkipWithError("Failed to open file");
+        return;
+    }
+    state.counters["stereoProxy"] =
+            pAudioSource->getReadSignalInfo().getChannelCount() != CachingReaderChunk::kChannels;
+
+    mixxx::SampleBuffer chunkBuffer(CachingReaderChunk::kSamples);
+    mixxx::SampleBuffer tempBuffer(
+            pAudioSource->getSignalInfo().frames2samples(CachingReaderChunk::kFrames));
+    CachingReaderChunkForOwner chunk{mixxx::SampleBuffer::WritableSlice(chunkBuffer)};
+    const SINT chunkCount = CachingReaderChunk::indexForFrame(
+                                    pAudioSource->frameLength() - 1) +
+            1;
+    SINT frameCount = 0;
+    for (auto _ : state) {
+        for (SINT index = 0; index < chunkCount; ++index) {
+            chunk.init(index);
+            frameCount += chunk.bufferSampleFrames(
+                                       pAudioSource,
+                                       mixxx::SampleBuffer::WritableSlice(tempBuffer))
+                                  .length();
+            chunk.free();
+        }
+    }
+    state.SetItemsProcessed(frameCount);
+}
+BENCHMARK(BM_ReadCachingReaderChunks)
+        ->DenseRange(0,
+                sizeof(kBenchmarkFileNameSuffixes) / sizeof(kBenchmarkFileNameSuffixes[0]) - 1);
+
+} // anonymous namespace
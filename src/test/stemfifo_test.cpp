@@ -0,0 +1,244 @@
+#include <gtest/gtest.h>
+
+#include <QVector>
+#include <limits>
+#include <vector>
+
+#include "engine/sidechain/stemfifo.h"
+#include "recording/recordingstem.h"
+
+namespace {
+
+constexpr int kSamplesPerStem = 64;
+
+std::vector<CSAMPLE> constantBuffer(int samples, CSAMPLE value) {
+    return std::vector<CSAMPLE>(samples, value);
+}
+
+class StemFifoTest : public testing::Test {
+  protected:
+    StemFifoTest()
+            : m_fifo(kSamplesPerStem) {
+    }
+
+    // Reads the next block, or the rest of it, up to endFramePosition and
+    // returns the samples of each stem
+    bool readBlock(StemFifo::BlockHeader* pHeader,
+            std::vector<std::vector<CSAMPLE>>* pStems,
+            quint64 endFramePosition = std::numeric_limits<quint64>::max()) {
+        pStems->clear();
+        return m_fifo.readBlock(endFramePosition,
+                pHeader,
+                &m_readFramePosition,
+                [pStems](int stem, const CSAMPLE* pSamples, int samples) {
+                    if (stem >= static_cast<int>(pStems->size())) {
+                        pStems->resize(stem + 1);
+                    }
+                    (*pStems)[stem].insert((*pStems)[stem].end(), pSamples, pSamples + samples);
+                });
+    }
+
+    StemFifo m_fifo;
+    quint64 m_readFramePosition = 0;
+};
+
+TEST_F(StemFifoTest, NoBlockWithoutStems) {
+    EXPECT_FALSE(m_fifo.beginBlock(16, 0));
+    StemFifo::BlockHeader header;
+    std::vector<std::vector<CSAMPLE>> stems;
+    EXPECT_FALSE(readBlock(&header, &stems));
+}
+
+TEST_F(StemFifoTest, PreFaderStemsAreWrittenFirst) {
+    QVector<StemFifo::Stem> stems{{2, true}, {0, false}, {1, true}, {3, false}};
+    m_fifo.setStems(&stems);
+    const QVector<StemFifo::Stem> expected{{0, false}, {3, false}, {2, true}, {1, true}};
+    EXPECT_EQ(expected, stems);
+
+    ASSERT_TRUE(m_fifo.beginBlock(16, 0));
+    ASSERT_EQ(4, m_fifo.stemCount());
+    for (int i = 0; i < m_fifo.stemCount(); ++i) {
+        EXPECT_EQ(expected[i], m_fifo.stem(i));
+    }
+    m_fifo.commitBlock();
+}
+
+TEST_F(StemFifoTest, BlocksAreSampleAligned) {
+    QVector<StemFifo::Stem> stems{{0, false}, {1, true}, {2, false}};
+    const quint32 generation = m_fifo.setStems(&stems);
+
+    // Blocks of an odd size wrap around at the end of the ring buffer
+    constexpr int kSamples = 22;
+    constexpr int kBlocks = 50;
+    int blocksRead = 0;
+    for (int block = 0; block < kBlocks; ++block) {
+        ASSERT_TRUE(m_fifo.beginBlock(kSamples, block * kSamples / 2));
+        const auto pre0 = constantBuffer(kSamples, block + 0.1f);
+        const auto pre2 = constantBuffer(kSamples, block + 0.2f);
+        m_fifo.writeStem(pre0.data());
+        m_fifo.writeStem(pre2.data());
+        const auto post1 = constantBuffer(kSamples, block + 0.3f);
+        m_fifo.writeStem(post1.data());
+        m_fifo.commitBlock();
+
+        StemFifo::BlockHeader header;
+        std::vector<std::vector<CSAMPLE>> samples;
+        ASSERT_TRUE(readBlock(&header, &samples));
+        EXPECT_EQ(generation, header.generation);
+        EXPECT_EQ(3, header.stemCount);
+        EXPECT_EQ(kSamples, header.samples);
+        EXPECT_EQ(static_cast<quint64>(block * kSamples / 2), header.framePosition);
+        EXPECT_EQ(header.framePosition, m_readFramePosition);
+        ASSERT_EQ(3u, samples.size());
+        EXPECT_EQ(pre0, samples[0]);
+        EXPECT_EQ(pre2, samples[1]);
+        EXPECT_EQ(post1, samples[2]);
+        ++blocksRead;
+    }
+    EXPECT_EQ(kBlocks, blocksRead);
+}
+
+TEST_F(StemFifoTest, BlocksAreSplitAtFramePosition) {
+    QVector<StemFifo::Stem> stems{{0, false}, {1, false}};
+    m_fifo.setStems(&stems);
+
+    // 8 stereo frames starting at frame 100
+    std::vector<CSAMPLE> stem0(16);
+    std::vector<CSAMPLE> stem1(16);
+    for (int i = 0; i < 16; ++i) {
+        stem0[i] = static_cast<CSAMPLE>(i);
+        stem1[i] = static_cast<CSAMPLE>(-i);
+    }
+    ASSERT_TRUE(m_fifo.beginBlock(16, 100));
+    m_fifo.writeStem(stem0.data());
+    m_fifo.writeStem(stem1.data());
+    m_fifo.commitBlock();
+
+    StemFifo::BlockHeader header;
+    std::vector<std::vector<CSAMPLE>> samples;
+    EXPECT_FALSE(readBlock(&header, &samples, 100));
+
+    // The first 3 frames
+    ASSERT_TRUE(readBlock(&header, &samples, 103));
+    EXPECT_EQ(100u, header.framePosition);
+    EXPECT_EQ(100u, m_readFramePosition);
+    ASSERT_EQ(2u, samples.size());
+    EXPECT_EQ(std::vector<CSAMPLE>(stem0.begin(), stem0.begin() + 6), samples[0]);
+    EXPECT_EQ(std::vector<CSAMPLE>(stem1.begin(), stem1.begin() + 6), samples[1]);
+    EXPECT_FALSE(readBlock(&header, &samples, 103));
+
+    // The rest of the block
+    ASSERT_TRUE(readBlock(&header, &samples, 200));
+    EXPECT_EQ(100u, header.framePosition);
+    EXPECT_EQ(103u, m_readFramePosition);
+    ASSERT_EQ(2u, samples.size());
+    EXPECT_EQ(std::vector<CSAMPLE>(stem0.begin() + 6, stem0.end()), samples[0]);
+    EXPECT_EQ(std::vector<CSAMPLE>(stem1.begin() + 6, stem1.end()), samples[1]);
+    EXPECT_FALSE(readBlock(&header, &samples, 200));
+}
+
+TEST_F(StemFifoTest, MissingStemsAreSilent) {
+    QVector<StemFifo::Stem> stems{{0, false}, {1, false}, {2, true}};
+    m_fifo.setStems(&stems);
+
+    ASSERT_TRUE(m_fifo.beginBlock(16, 0));
+    const auto pre0 = constantBuffer(16, 0.5f);
+    m_fifo.writeStem(pre0.data());
+    // Inactive channel
+    m_fifo.writeStem(nullptr);
+    // The post-fader stem is not written at all
+    m_fifo.commitBlock();
+
+    StemFifo::BlockHeader header;
+    std::vector<std::vector<CSAMPLE>> samples;
+    ASSERT_TRUE(readBlock(&header, &samples));
+    ASSERT_EQ(3u, samples.size());
+    EXPECT_EQ(pre0, samples[0]);
+    EXPECT_EQ(constantBuffer(16, 0), samples[1]);
+    EXPECT_EQ(constantBuffer(16, 0), samples[2]);
+}
+
+TEST_F(StemFifoTest, StaleBlocksHaveOldGeneration) {
+    QVector<StemFifo::Stem> stems{{0, false}};
+    const quint32 oldGeneration = m_fifo.setStems(&stems);
+    ASSERT_TRUE(m_fifo.beginBlock(16, 0));
+    m_fifo.writeStem(nullptr);
+    m_fifo.commitBlock();
+
+    QVector<StemFifo::Stem> newStems{{1, false}, {2, false}};
+    const quint32 newGeneration = m_fifo.setStems(&newStems);
+    EXPECT_NE(oldGeneration, newGeneration);
+    ASSERT_TRUE(m_fifo.beginBlock(16, 0));
+    m_fifo.commitBlock();
+
+    StemFifo::BlockHeader header;
+    std::vector<std::vector<CSAMPLE>> samples;
+    ASSERT_TRUE(readBlock(&header, &samples));
+    EXPECT_EQ(oldGeneration, header.generation);
+    EXPECT_EQ(1, header.stemCount);
+    ASSERT_TRUE(readBlock(&header, &samples));
+    EXPECT_EQ(newGeneration, header.generation);
+    EXPECT_EQ(2, header.stemCount);
+    EXPECT_FALSE(readBlock(&header, &samples));
+
+    EXPECT_NE(newGeneration, m_fifo.clearStems());
+    EXPECT_FALSE(m_fifo.beginBlock(16, 0));
+}
+
+TEST_F(StemFifoTest, OverrunSkipsBlock) {
+    QVector<StemFifo::Stem> stems;
+    for (int i = 0; i < StemFifo::kMaxStems; ++i) {
+        stems.append(StemFifo::Stem{i, false});
+    }
+    m_fifo.setStems(&stems);
+
+    // Fill the ring buffer
+    ASSERT_TRUE(m_fifo.beginBlock(kSamplesPerStem, 0));
+    m_fifo.commitBlock();
+    EXPECT_FALSE(m_fifo.beginBlock(16, 0));
+
+    StemFifo::BlockHeader header;
+    std::vector<std::vector<CSAMPLE>> samples;
+    ASSERT_TRUE(readBlock(&header, &samples));
+    EXPECT_EQ(kSamplesPerStem, header.samples);
+    EXPECT_FALSE(readBlock(&header, &samples));
+    EXPECT_TRUE(m_fifo.beginBlock(16, 0));
+    m_fifo.commitBlock();
+}
+
+TEST_F(StemFifoTest, StemsAreLimited) {
+    QVector<StemFifo::Stem> stems;
+    for (int i = 0; i < StemFifo::kMaxStems + 4; ++i) {
+        stems.append(StemFifo::Stem{i, false});
+    }
+    m_fifo.setStems(&stems);
+    EXPECT_EQ(StemFifo::kMaxStems, stems.size());
+    ASSERT_TRUE(m_fifo.beginBlock(4, 0));
+    EXPECT_EQ(StemFifo::kMaxStems, m_fifo.stemCount());
+    m_fifo.commitBlock();
+}
+
+TEST(RecordingStemTest, ParseAndFormatList) {
+    const auto stems = RecordingStem::parseList(
+            QStringLiteral(" [Channel1]:pre, [Aux1]:post,,[Channel2],[Channel1]:pre"));
+    const QList<RecordingStem> expected{
+            {QStringLiteral("[Channel1]"), false},
+            {QStringLiteral("[Aux1]"), true},
+            {QStringLiteral("[Channel2]"), false}};
+    EXPECT_EQ(expected, stems);
+    EXPECT_EQ(QStringLiteral("[Channel1]:pre,[Aux1]:post,[Channel2]:pre"),
+            RecordingStem::formatList(stems));
+    EXPECT_EQ(expected, RecordingStem::parseList(RecordingStem::formatList(stems)));
+    EXPECT_TRUE(RecordingStem::parseList(QString()).isEmpty());
+}
+
+TEST(RecordingStemTest, FilePath) {
+    const RecordingStem stem{QStringLiteral("[Channel1]"), false};
+    EXPECT_EQ(QStringLiteral("/music/2022-01-01_20h00m00s_Channel1_pre.wav"),
+            stem.filePath(QStringLiteral("/music/2022-01-01_20h00m00s.wav")));
+    const RecordingStem micStem{QStringLiteral("[Microphone2]"), true};
+    EXPECT_EQ(QStringLiteral("/music/mix_Microphone2_post.ogg"),
+            micStem.filePath(QStringLiteral("/music/mix.ogg")));
+}
+
+} // namespace
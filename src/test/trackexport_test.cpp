@@ -300,3 +300,45 @@ TEST_F(TrackExporterTest, MungeFilename) {
     // Remove the track we created.
     tempPath.remove("cover-test.ogg");
 }
+
+TEST_F(TrackExporterTest, ResumeSkipsUnchangedFiles) {
+    // Export the same tracks twice, the second export must neither ask nor
+    // copy the files again.
+    mixxx::FileInfo fileinfo1(m_testDataDir.filePath("cover-test.ogg"));
+    TrackPointer track1(Track::newTemporary(mixxx::FileAccess(fileinfo1)));
+    mixxx::FileInfo fileinfo2(m_testDataDir.filePath("cover-test.flac"));
+    TrackPointer track2(Track::newTemporary(mixxx::FileAccess(fileinfo2)));
+
+    TrackPointerList tracks;
+    tracks.append(track1);
+    tracks.append(track2);
+    {
+        TrackExportWorker worker(m_exportDir.canonicalPath(), tracks);
+        m_answerer.reset(new FakeOverwriteAnswerer(&worker));
+        worker.run();
+        EXPECT_TRUE(worker.wait(10000));
+        EXPECT_EQ(2, m_answerer->currentProgress());
+    }
+
+    // The exported files keep the modification time of the source files
+    const QFileInfo exported1(m_exportDir.filePath("cover-test.ogg"));
+    EXPECT_EQ(fileinfo1.sizeInBytes(), exported1.size());
+    EXPECT_EQ(fileinfo1.lastModified(), exported1.lastModified());
+    const QDateTime exportedLastModified2 =
+            QFileInfo(m_exportDir.filePath("cover-test.flac")).lastModified();
+
+    // No answers are set, any overwrite question fails the test
+    TrackExportWorker worker(m_exportDir.canonicalPath(), tracks);
+    m_answerer.reset(new FakeOverwriteAnswerer(&worker));
+    worker.run();
+    EXPECT_TRUE(worker.wait(10000));
+    EXPECT_EQ(2, m_answerer->currentProgress());
+    EXPECT_EQ(2, m_answerer->currentProgressCount());
+    EXPECT_EQ(exportedLastModified2,
+            QFileInfo(m_exportDir.filePath("cover-test.flac")).lastModified());
+
+    // No partially copied files are left behind
+    QFileInfoList files =
+            m_exportDir.entryInfoList(QDir::NoDotAndDotDot | QDir::Files);
+    EXPECT_EQ(2, files.size());
+}
@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QtDebug>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "track/track.h"
+
+namespace {
+
+TEST(TrackSnapshotTest, VersionIsIncrementedOnModification) {
+    auto pTrack = Track::newTemporary();
+    const auto initialVersion = pTrack->getRecordVersion();
+    EXPECT_EQ(initialVersion, pTrack->getRecordSnapshot()->version);
+
+    pTrack->setTitle(QStringLiteral("Title"));
+    const auto modifiedVersion = pTrack->getRecordVersion();
+    EXPECT_LT(initialVersion, modifiedVersion);
+    EXPECT_EQ(modifiedVersion, pTrack->getRecordSnapshot()->version);
+    EXPECT_EQ(QStringLiteral("Title"), pTrack->getTitle());
+
+    // Setting the same value again doesn't publish a new snapshot
+    pTrack->setTitle(QStringLiteral("Title"));
+    EXPECT_EQ(modifiedVersion, pTrack->getRecordVersion());
+
+    pTrack->setRating(3);
+    EXPECT_LT(modifiedVersion, pTrack->getRecordVersion());
+    EXPECT_EQ(3, pTrack->getRating());
+}
+
+TEST(TrackSnapshotTest, SnapshotIsImmutable) {
+    auto pTrack = Track::newTemporary();
+    pTrack->setArtist(QStringLiteral("Old Artist"));
+    const auto pSnapshot = pTrack->getRecordSnapshot();
+
+    pTrack->setArtist(QStringLiteral("New Artist"));
+    EXPECT_EQ(QStringLiteral("New Artist"), pTrack->getArtist());
+    EXPECT_EQ(QStringLiteral("Old Artist"),
+            pSnapshot->record.getMetadata().getTrackInfo().getArtist());
+    EXPECT_NE(pSnapshot, pTrack->getRecordSnapshot());
+}
+
+TEST(TrackSnapshotTest, IdIsPublished) {
+    auto pTrack = Track::newDummy(QStringLiteral("dummy.mp3"), TrackId(1));
+    EXPECT_EQ(TrackId(1), pTrack->getId());
+    EXPECT_EQ(TrackId(1), pTrack->getRecordSnapshot()->record.getId());
+}
+
+TEST(TrackSnapshotTest, ConcurrentReadersSeeConsistentRecords) {
+    auto pTrack = Track::newTemporary();
+    constexpr int kWrites = 2000;
+    std::atomic<bool> done = false;
+    std::atomic<int> inconsistentReads = 0;
+    std::atomic<int> versionsGoingBack = 0;
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; ++i) {
+        readers.emplace_back([&] {
+            quint64 lastVersion = 0;
+            while (!done.load()) {
+                // Title and artist are only ever replaced together
+                const auto pSnapshot = pTrack->getRecordSnapshot();
+                const auto& trackInfo = pSnapshot->record.getMetadata().getTrackInfo();
+                if (trackInfo.getTitle() != trackInfo.getArtist()) {
+                    ++inconsistentReads;
+                }
+                if (pSnapshot->version < lastVersion) {
+                    ++versionsGoingBack;
+                }
+                lastVersion = pSnapshot->version;
+            }
+        });
+    }
+
+    for (int i = 0; i < kWrites; ++i) {
+        auto record = pTrack->getRecord();
+        const auto value = QString::number(i);
+        record.refMetadata().refTrackInfo().setTitle(value);
+        record.refMetadata().refTrackInfo().setArtist(value);
+        pTrack->replaceRecord(std::move(record));
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(0, inconsistentReads.load());
+    EXPECT_EQ(0, versionsGoingBack.load());
+    EXPECT_EQ(QString::number(kWrites - 1), pTrack->getTitle());
+}
+
+static void BM_TrackGetTitle(benchmark::State& state) {
+    static TrackPointer s_pTrack;
+    if (state.thread_index() == 0) {
+        s_pTrack = Track::newTemporary();
+        s_pTrack->setTitle(QStringLiteral("Title"));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(s_pTrack->getTitle());
+    }
+    if (state.thread_index() == 0) {
+        s_pTrack.reset();
+    }
+}
+BENCHMARK(BM_TrackGetTitle)->ThreadRange(1, 4);
+
+} // namespace
@@ -0,0 +1,250 @@
+#include "waveform/renderers/waveformrasterizer.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QColor>
+#include <QImage>
+#include <QLineF>
+#include <QPainter>
+#include <QPen>
+#include <cmath>
+#include <vector>
+
+#include "test/mixxxtest.h"
+
+namespace {
+
+class WaveformRasterizerTest : public MixxxTest {
+  protected:
+    // Draws the rasterized image into a fresh image, like a renderer does
+    // with the painter of the waveform widget.
+    QImage paint(int length, int breadth) {
+        QImage target(length, breadth, QImage::Format_ARGB32_Premultiplied);
+        target.fill(0);
+        QPainter painter(&target);
+        m_rasterizer.end(&painter);
+        return target;
+    }
+
+    WaveformRasterizer m_rasterizer;
+};
+
+TEST_F(WaveformRasterizerTest, SpanIsFilled) {
+    m_rasterizer.begin(10, 20, 1.0);
+    // The order of the end points does not matter
+    m_rasterizer.setSpan(3, 10, 5, qRgb(255, 0, 0));
+    m_rasterizer.blendLayer();
+
+    const QImage image = paint(10, 20);
+    EXPECT_EQ(0u, image.pixel(3, 4));
+    EXPECT_EQ(qRgb(255, 0, 0), image.pixel(3, 5));
+    EXPECT_EQ(qRgb(255, 0, 0), image.pixel(3, 9));
+    EXPECT_EQ(0u, image.pixel(3, 10));
+    EXPECT_EQ(0u, image.pixel(2, 7));
+    EXPECT_EQ(0u, image.pixel(4, 7));
+}
+
+TEST_F(WaveformRasterizerTest, SpansAreClipped) {
+    m_rasterizer.begin(10, 20, 1.0);
+    m_rasterizer.setSpan(-1, 0, 20, qRgb(255, 0, 0));
+    m_rasterizer.setSpan(10, 0, 20, qRgb(255, 0, 0));
+    m_rasterizer.setSpan(9, -100, 100, qRgb(0, 255, 0));
+    m_rasterizer.blendLayer();
+
+    const QImage image = paint(10, 20);
+    EXPECT_EQ(0u, image.pixel(0, 10));
+    EXPECT_EQ(qRgb(0, 255, 0), image.pixel(9, 0));
+    EXPECT_EQ(qRgb(0, 255, 0), image.pixel(9, 19));
+}
+
+TEST_F(WaveformRasterizerTest, LayersAreBlendedLikeQPainter) {
+    const QColor lowColor(0, 0, 255);
+    const QColor midColor(255, 0, 0, 128);
+    const QColor highColor(0, 255, 0, 64);
+
+    m_rasterizer.begin(4, 10, 1.0);
+    m_rasterizer.setSpan(1, 0, 10, lowColor.rgba());
+    m_rasterizer.blendLayer();
+    m_rasterizer.setSpan(1, 2, 8, midColor.rgba());
+    m_rasterizer.setSpan(2, 2, 8, midColor.rgba());
+    m_rasterizer.blendLayer();
+    m_rasterizer.setSpan(1, 4, 6, highColor.rgba());
+    m_rasterizer.blendLayer();
+    const QImage image = paint(4, 10);
+
+    QImage expected(4, 10, QImage::Format_ARGB32_Premultiplied);
+    expected.fill(0);
+    {
+        QPainter painter(&expected);
+        painter.fillRect(1, 0, 1, 10, lowColor);
+        painter.fillRect(1, 2, 2, 6, midColor);
+        painter.fillRect(1, 4, 1, 2, highColor);
+    }
+
+    for (int x = 0; x < 4; ++x) {
+        for (int y = 0; y < 10; ++y) {
+            const QRgb pixel = image.pixel(x, y);
+            const QRgb expectedPixel = expected.pixel(x, y);
+            // Rounding may differ by one
+            EXPECT_NEAR(qRed(expectedPixel), qRed(pixel), 1) << x << "," << y;
+            EXPECT_NEAR(qGreen(expectedPixel), qGreen(pixel), 1) << x << "," << y;
+            EXPECT_NEAR(qBlue(expectedPixel), qBlue(pixel), 1) << x << "," << y;
+            EXPECT_NEAR(qAlpha(expectedPixel), qAlpha(pixel), 1) << x << "," << y;
+        }
+    }
+}
+
+TEST_F(WaveformRasterizerTest, HighDpi) {
+    m_rasterizer.begin(10, 20, 2.0);
+    m_rasterizer.setSpan(3, 5, 10, qRgb(255, 0, 0));
+    m_rasterizer.blendLayer();
+
+    const QImage& image = m_rasterizer.image();
+    EXPECT_EQ(20, image.width());
+    EXPECT_EQ(40, image.height());
+    EXPECT_EQ(0u, image.pixel(5, 15));
+    EXPECT_EQ(qRgb(255, 0, 0), image.pixel(6, 10));
+    EXPECT_EQ(qRgb(255, 0, 0), image.pixel(7, 19));
+    EXPECT_EQ(0u, image.pixel(7, 20));
+    EXPECT_EQ(0u, image.pixel(8, 15));
+}
+
+TEST_F(WaveformRasterizerTest, ImageIsReused) {
+    m_rasterizer.begin(100, 50, 1.0);
+    const uchar* pBits = m_rasterizer.image().constBits();
+    m_rasterizer.setSpan(3, 5, 10, qRgb(255, 0, 0));
+    m_rasterizer.blendLayer();
+
+    // The next frame starts transparent in the same buffer
+    m_rasterizer.begin(100, 50, 1.0);
+    EXPECT_EQ(pBits, m_rasterizer.image().constBits());
+    EXPECT_EQ(0u, m_rasterizer.image().pixel(3, 7));
+}
+
+// Benchmarks for a single frame of each software renderer type, comparing
+// the rasterizer with the QPainter::drawLine() calls used before.
+
+constexpr int kLength = 1920;
+constexpr int kBreadth = 200;
+
+enum class RendererType {
+    RGB,
+    HSV,
+    Filtered,
+};
+
+// Synthetic column heights similar to a music track
+int columnHeight(int x, int band) {
+    const double value = std::abs(std::sin(x * 0.05 + band) * std::sin(x * 0.003));
+    return static_cast<int>(value * (kBreadth / 2 - 1)) + 1;
+}
+
+QColor columnColor(RendererType type, int x) {
+    QColor color;
+    const float low = static_cast<float>(columnHeight(x, 0)) / kBreadth;
+    const float high = static_cast<float>(columnHeight(x, 2)) / kBreadth;
+    if (type == RendererType::HSV) {
+        color.setHsvF(0.6, 1.0 - high, 1.0 - low);
+    } else {
+        color.setRgbF(low, 0.5, high);
+    }
+    return color;
+}
+
+const QColor kFilteredColors[3] = {
+        QColor(255, 0, 0, 200),
+        QColor(0, 255, 0, 160),
+        QColor(0, 0, 255, 120),
+};
+
+void runRasterizerFrames(benchmark::State& state, RendererType type) {
+    QImage target(kLength, kBreadth, QImage::Format_ARGB32_Premultiplied);
+    WaveformRasterizer rasterizer;
+    for (auto _ : state) {
+        target.fill(Qt::black);
+        QPainter painter(&target);
+        rasterizer.begin(kLength, kBreadth, 1.0);
+        if (type == RendererType::Filtered) {
+            for (int band = 0; band < 3; ++band) {
+                const QRgb color = kFilteredColors[band].rgba();
+                for (int x = 0; x < kLength; ++x) {
+                    const int height = columnHeight(x, band);
+                    rasterizer.setSpan(x, kBreadth / 2 - height, kBreadth / 2 + height, color);
+                }
+                rasterizer.blendLayer();
+            }
+        } else {
+            for (int x = 0; x < kLength; ++x) {
+                const int height = columnHeight(x, 1);
+                rasterizer.setSpan(x,
+                        kBreadth / 2 - height,
+                        kBreadth / 2 + height,
+                        columnColor(type, x).rgba());
+            }
+            rasterizer.blendLayer();
+        }
+        rasterizer.end(&painter);
+    }
+}
+
+void runQPainterFrames(benchmark::State& state, RendererType type) {
+    QImage target(kLength, kBreadth, QImage::Format_ARGB32_Premultiplied);
+    std::vector<QLineF> lines(kLength);
+    for (auto _ : state) {
+        target.fill(Qt::black);
+        QPainter painter(&target);
+        painter.setRenderHints(QPainter::Antialiasing, false);
+        if (type == RendererType::Filtered) {
+            for (int band = 0; band < 3; ++band) {
+                for (int x = 0; x < kLength; ++x) {
+                    const int height = columnHeight(x, band);
+                    lines[x].setLine(x, kBreadth / 2 - height, x, kBreadth / 2 + height);
+                }
+                painter.setPen(QPen(QBrush(kFilteredColors[band]), 1.0, Qt::SolidLine, Qt::FlatCap));
+                painter.drawLines(lines.data(), kLength);
+            }
+        } else {
+            QPen pen;
+            pen.setCapStyle(Qt::FlatCap);
+            for (int x = 0; x < kLength; ++x) {
+                const int height = columnHeight(x, 1);
+                pen.setColor(columnColor(type, x));
+                painter.setPen(pen);
+                painter.drawLine(x, kBreadth / 2 - height, x, kBreadth / 2 + height);
+            }
+        }
+    }
+}
+
+static void BM_WaveformRasterizerRGB(benchmark::State& state) {
+    runRasterizerFrames(state, RendererType::RGB);
+}
+BENCHMARK(BM_WaveformRasterizerRGB)->Unit(benchmark::kMillisecond);
+
+static void BM_WaveformQPainterRGB(benchmark::State& state) {
+    runQPainterFrames(state, RendererType::RGB);
+}
+BENCHMARK(BM_WaveformQPainterRGB)->Unit(benchmark::kMillisecond);
+
+static void BM_WaveformRasterizerHSV(benchmark::State& state) {
+    runRasterizerFrames(state, RendererType::HSV);
+}
+BENCHMARK(BM_WaveformRasterizerHSV)->Unit(benchmark::kMillisecond);
+
+static void BM_WaveformQPainterHSV(benchmark::State& state) {
+    runQPainterFrames(state, RendererType::HSV);
+}
+BENCHMARK(BM_WaveformQPainterHSV)->Unit(benchmark::kMillisecond);
+
+static void BM_WaveformRasterizerFiltered(benchmark::State& state) {
+    runRasterizerFrames(state, RendererType::Filtered);
+}
+BENCHMARK(BM_WaveformRasterizerFiltered)->Unit(benchmark::kMillisecond);
+
+static void BM_WaveformQPainterFiltered(benchmark::State& state) {
+    runQPainterFrames(state, RendererType::Filtered);
+}
+BENCHMARK(BM_WaveformQPainterFiltered)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -1,5 +1,6 @@
 #include "track/beats.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iterator>
 #include <vector>
@@ -20,6 +21,10 @@ struct BeatGridV1Data {
 
 constexpr double kEpsilon = 0.01;
 
+// The number of beats a Beats::Cursor is moved linearly before falling back
+// to a binary search.
+constexpr int kMaxCursorSteps = 4;
+
 } // namespace
 
 namespace mixxx {
@@ -375,11 +380,82 @@ QString Beats::getVersion() const {
     }
 };
 
+void Beats::initBeatPositions() {
+    if (m_markers.empty()) {
+        return;
+    }
+    m_markerBeatIndices.reserve(m_markers.size());
+    int beatCount = 0;
+    for (const auto& marker : m_markers) {
+        m_markerBeatIndices.push_back(beatCount);
+        beatCount += marker.beatsTillNextMarker();
+    }
+    // Use the iterator for calculating the positions, so the results are
+    // exactly the same as before.
+    m_beatPositions.reserve(beatCount + 1);
+    auto it = cfirstmarker();
+    for (int i = 0; i < beatCount; ++i, ++it) {
+        m_beatPositions.push_back(*it);
+    }
+    DEBUG_ASSERT(it == clastmarker());
+    m_beatPositions.push_back(*it);
+}
+
+int Beats::lowerBoundBeatIndex(audio::FramePos position, Cursor* pCursor) const {
+    DEBUG_ASSERT(!m_beatPositions.empty());
+    const int size = static_cast<int>(m_beatPositions.size());
+    if (pCursor) {
+        int index = std::clamp(pCursor->m_beatIndex, 0, size - 1);
+        if (m_beatPositions[index] >= position) {
+            for (int step = 0; step <= kMaxCursorSteps; ++step) {
+                if (index == 0 || m_beatPositions[index - 1] < position) {
+                    pCursor->m_beatIndex = index;
+                    return index;
+                }
+                --index;
+            }
+        } else {
+            for (int step = 0; step < kMaxCursorSteps; ++step) {
+                ++index;
+                if (index == size || m_beatPositions[index] >= position) {
+                    pCursor->m_beatIndex = index;
+                    return index;
+                }
+            }
+        }
+    }
+    const int index = static_cast<int>(std::lower_bound(m_beatPositions.cbegin(),
+                                               m_beatPositions.cend(),
+                                               position) -
+            m_beatPositions.cbegin());
+    if (pCursor) {
+        pCursor->m_beatIndex = index;
+    }
+    return index;
+}
+
+Beats::ConstIterator Beats::iteratorAtBeatIndex(int beatIndex) const {
+    DEBUG_ASSERT(beatIndex >= 0);
+    DEBUG_ASSERT(beatIndex < static_cast<int>(m_beatPositions.size()));
+    if (beatIndex == static_cast<int>(m_beatPositions.size()) - 1) {
+        return clastmarker();
+    }
+    const auto markerIndexIt = std::upper_bound(
+                                       m_markerBeatIndices.cbegin(),
+                                       m_markerBeatIndices.cend(),
+                                       beatIndex) -
+            1;
+    const auto markerIndex = markerIndexIt - m_markerBeatIndices.cbegin();
+    const int beatOffset = beatIndex - *markerIndexIt;
+    return ConstIterator(this, m_markers.cbegin() + markerIndex, beatOffset);
+}
+
 bool Beats::findPrevNextBeats(audio::FramePos position,
         audio::FramePos* prevBeatPosition,
         audio::FramePos* nextBeatPosition,
-        bool snapToNearBeats) const {
-    auto it = iteratorFrom(position);
+        bool snapToNearBeats,
+        Cursor* pCursor) const {
+    auto it = iteratorFrom(position, pCursor);
     if (it == cend()) {
         *prevBeatPosition = *it;
         *nextBeatPosition = audio::kInvalidFramePos;
@@ -416,7 +492,7 @@ bool Beats::findPrevNextBeats(audio::FramePos position,
     return true;
 }
 
-Beats::ConstIterator Beats::iteratorFrom(audio::FramePos position) const {
+Beats::ConstIterator Beats::iteratorFrom(audio::FramePos position, Cursor* pCursor) const {
     DEBUG_ASSERT(isValid());
     auto it = cfirstmarker();
     if (position > m_lastMarkerPosition) {
@@ -443,8 +519,12 @@ Beats::ConstIterator Beats::iteratorFrom(audio::FramePos position) const {
             return cbegin();
         }
         it -= static_cast<int>(n);
-    } else {
+    } else if (m_beatPositions.empty()) {
+        // Constant tempo, the position is exactly at the only marker
         it = std::lower_bound(cfirstmarker(), clastmarker() + 1, position);
+    } else {
+        // Lookup position is between the first and the last marker
+        it = iteratorAtBeatIndex(lowerBoundBeatIndex(position, pCursor));
     }
     DEBUG_ASSERT(it == cbegin() || it == cend() || *it >= position);
     DEBUG_ASSERT(it == cbegin() || it == cend() ||
@@ -452,12 +532,12 @@ Beats::ConstIterator Beats::iteratorFrom(audio::FramePos position) const {
     return it;
 }
 
-audio::FramePos Beats::findNthBeat(audio::FramePos position, int n) const {
+audio::FramePos Beats::findNthBeat(audio::FramePos position, int n, Cursor* pCursor) const {
     if (n == 0) {
         return audio::kInvalidFramePos;
     }
 
-    auto it = iteratorFrom(position);
+    auto it = iteratorFrom(position, pCursor);
     const bool searchForward = n > 0;
     if (searchForward) {
         n--;
@@ -720,21 +800,21 @@ int Beats::numBeatsInRange(audio::FramePos startPosition, audio::FramePos endPos
     return i - 2;
 };
 
-audio::FramePos Beats::findNextBeat(audio::FramePos position) const {
-    return findNthBeat(position, 1);
+audio::FramePos Beats::findNextBeat(audio::FramePos position, Cursor* pCursor) const {
+    return findNthBeat(position, 1, pCursor);
 }
 
-audio::FramePos Beats::findPrevBeat(audio::FramePos position) const {
-    return findNthBeat(position, -1);
+audio::FramePos Beats::findPrevBeat(audio::FramePos position, Cursor* pCursor) const {
+    return findNthBeat(position, -1, pCursor);
 }
 
-audio::FramePos Beats::findClosestBeat(audio::FramePos position) const {
+audio::FramePos Beats::findClosestBeat(audio::FramePos position, Cursor* pCursor) const {
     if (!isValid()) {
         return audio::kInvalidFramePos;
     }
     audio::FramePos prevBeatPosition;
     audio::FramePos nextBeatPosition;
-    findPrevNextBeats(position, &prevBeatPosition, &nextBeatPosition, false);
+    findPrevNextBeats(position, &prevBeatPosition, &nextBeatPosition, false, pCursor);
     if (!prevBeatPosition.isValid()) {
         // If both positions are invalid, we correctly return an invalid position.
         return nextBeatPosition;
@@ -151,6 +151,25 @@ class Beats : private std::enable_shared_from_this<Beats> {
         int m_beatOffset;
     };
 
+    /// Remembers the result of the previous lookup to speed up the next
+    /// lookup close to it. During playback subsequent lookups are usually
+    /// only a few beats apart, which then only takes a few steps instead of
+    /// a binary search.
+    ///
+    /// Each consumer should own a separate cursor. A cursor may be reused
+    /// with different Beats objects, e.g. after the beats of a track have
+    /// been changed. A mismatching cursor only costs a regular lookup.
+    class Cursor {
+      public:
+        Cursor()
+                : m_beatIndex(0) {
+        }
+
+      private:
+        friend class Beats;
+        int m_beatIndex;
+    };
+
     Beats(std::vector<BeatMarker> markers,
             mixxx::audio::FramePos lastMarkerPosition,
             mixxx::Bpm lastMarkerBpm,
@@ -165,6 +184,7 @@ class Beats : private std::enable_shared_from_this<Beats> {
         DEBUG_ASSERT(!m_lastMarkerPosition.isFractional());
         DEBUG_ASSERT(m_lastMarkerBpm.isValid());
         DEBUG_ASSERT(m_sampleRate.isValid());
+        initBeatPositions();
     }
 
     Beats(mixxx::audio::FramePos lastMarkerPosition,
@@ -209,7 +229,9 @@ class Beats : private std::enable_shared_from_this<Beats> {
         return ConstIterator(this, m_markers.cend(), std::numeric_limits<int>::max());
     }
 
-    ConstIterator iteratorFrom(audio::FramePos position) const;
+    /// Returns an iterator pointing to the first beat at or after `position`.
+    ConstIterator iteratorFrom(audio::FramePos position,
+            Cursor* pCursor = nullptr) const;
 
     friend bool operator==(const Beats& lhs, const Beats& rhs) {
         return lhs.m_markers == rhs.m_markers &&
@@ -304,12 +326,14 @@ class Beats : private std::enable_shared_from_this<Beats> {
     /// Starting from frame position `position`, return the frame position of
     /// the next beat in the track, or an invalid position if none exists. If
     /// `position` refers to the location of a beat, `position` is returned.
-    audio::FramePos findNextBeat(audio::FramePos position) const;
+    audio::FramePos findNextBeat(audio::FramePos position,
+            Cursor* pCursor = nullptr) const;
 
     /// Starting from frame position `position`, return the frame position of
     /// the previous beat in the track, or an invalid position if none exists.
     /// If `position` refers to the location of beat, `position` is returned.
-    audio::FramePos findPrevBeat(audio::FramePos position) const;
+    audio::FramePos findPrevBeat(audio::FramePos position,
+            Cursor* pCursor = nullptr) const;
 
     /// Starting from frame position `position`, fill the frame position of the
     /// previous beat and next beat. Either can be invalid if none exists. If
@@ -319,7 +343,8 @@ class Beats : private std::enable_shared_from_this<Beats> {
     bool findPrevNextBeats(audio::FramePos position,
             audio::FramePos* prevBeatPosition,
             audio::FramePos* nextBeatPosition,
-            bool snapToNearBeats) const;
+            bool snapToNearBeats,
+            Cursor* pCursor = nullptr) const;
 
     /// Return the frame position of the first beat in the track, or an invalid
     /// position if none exists.
@@ -329,7 +354,8 @@ class Beats : private std::enable_shared_from_this<Beats> {
 
     /// Starting from frame position `position`, return the frame position of
     /// the closest beat in the track, or an invalid position if none exists.
-    audio::FramePos findClosestBeat(audio::FramePos position) const;
+    audio::FramePos findClosestBeat(audio::FramePos position,
+            Cursor* pCursor = nullptr) const;
 
     /// Find the Nth beat from frame position `position`. Works with both
     /// positive and negative values of n. Calling findNthBeat with `n=0` is
@@ -338,7 +364,9 @@ class Beats : private std::enable_shared_from_this<Beats> {
     /// `findNextBeat` and `findPrevBeat`, respectively. If `position` refers
     /// to the location of a beat, then `position` is returned. If no beat can
     /// be found, returns an invalid frame position.
-    audio::FramePos findNthBeat(audio::FramePos position, int n) const;
+    audio::FramePos findNthBeat(audio::FramePos position,
+            int n,
+            Cursor* pCursor = nullptr) const;
 
     /// This function snaps the position to a beat if near.
     /// This is used for beat loops, where start and end positions might be slightly off
@@ -427,11 +455,24 @@ class Beats : private std::enable_shared_from_this<Beats> {
     mixxx::audio::FrameDiff_t firstBeatLengthFrames() const;
     mixxx::audio::FrameDiff_t lastBeatLengthFrames() const;
 
+    void initBeatPositions();
+    /// Index of the first beat in m_beatPositions at or after `position`
+    int lowerBoundBeatIndex(audio::FramePos position, Cursor* pCursor) const;
+    ConstIterator iteratorAtBeatIndex(int beatIndex) const;
+
     std::vector<BeatMarker> m_markers;
     mixxx::audio::FramePos m_lastMarkerPosition;
     mixxx::Bpm m_lastMarkerBpm;
     mixxx::audio::SampleRate m_sampleRate;
 
+    // The positions of all beats from the first beat marker up to and
+    // including the last marker, for replacing the iterator based binary
+    // search by a binary search on a flat array. Beats are immutable, so
+    // this is built once on construction. Empty for a constant tempo.
+    std::vector<mixxx::audio::FramePos> m_beatPositions;
+    // The index of the first beat of each marker in m_beatPositions
+    std::vector<int> m_markerBeatIndices;
+
     // The sub-version of this beatgrid.
     const QString m_subVersion;
 };
@@ -85,8 +85,10 @@ Track::Track(
         : m_qMutex(QT_RECURSIVE_MUTEX_INIT),
           m_fileAccess(std::move(fileAccess)),
           m_record(trackId),
+          m_recordVersion(0),
           m_bDirty(false),
           m_bMarkedForMetadataExport(false) {
+    publishRecordWhileLocked();
     if (kLogStats && kLogger.debugEnabled()) {
         long numberOfInstancesBefore = s_numberOfInstances.fetch_add(1);
         kLogger.debug()
@@ -185,7 +187,7 @@ void Track::replaceMetadataFromSource(
         auto beatsAndBpmModified = false;
         if (importedBpm.isValid() &&
                 (!m_pBeats ||
-                        !getBeatsPointerBpm(m_pBeats, getDuration())
+                        !getBeatsPointerBpm(m_pBeats, getDurationWhileLocked())
                                  .isValid())) {
             // Only use the imported BPM if the current beat grid is either
             // missing or not valid! The BPM value in the metadata might be
@@ -261,6 +263,9 @@ bool Track::mergeExtraMetadataFromSource(
 
 mixxx::TrackMetadata Track::getMetadata(
         mixxx::TrackRecord::SourceSyncStatus* pSourceSyncStatus) const {
+    if (!pSourceSyncStatus) {
+        return getRecordSnapshot()->record.getMetadata();
+    }
     const auto locked = lockMutex(&m_qMutex);
     if (pSourceSyncStatus) {
         *pSourceSyncStatus =
@@ -271,13 +276,25 @@ mixxx::TrackMetadata Track::getMetadata(
 
 mixxx::TrackRecord Track::getRecord(
         bool* pDirty) const {
-    const auto locked = lockMutex(&m_qMutex);
-    if (pDirty) {
-        *pDirty = m_bDirty;
+    if (!pDirty) {
+        return getRecordSnapshot()->record;
     }
+    const auto locked = lockMutex(&m_qMutex);
+    *pDirty = m_bDirty;
     return m_record;
 }
 
+void Track::publishRecordWhileLocked() {
+    // The version is only modified while locked, no need for an atomic
+    // read-modify-write operation. Store the snapshot first, so that a
+    // reader who sees the new version always gets a snapshot that is at
+    // least as recent.
+    const quint64 version = m_recordVersion.load(std::memory_order_relaxed) + 1;
+    m_pRecordSnapshot.store(std::make_shared<const RecordSnapshot>(
+            RecordSnapshot{m_record, version}));
+    m_recordVersion.store(version, std::memory_order_release);
+}
+
 bool Track::replaceRecord(
         mixxx::TrackRecord newRecord,
         mixxx::BeatsPointer pOptionalBeats) {
@@ -335,8 +352,7 @@ bool Track::replaceRecord(
 }
 
 mixxx::ReplayGain Track::getReplayGain() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMetadata().getTrackInfo().getReplayGain();
+    return getRecordSnapshot()->record.getMetadata().getTrackInfo().getReplayGain();
 }
 
 void Track::setReplayGain(const mixxx::ReplayGain& replayGain) {
@@ -360,7 +376,7 @@ void Track::adjustReplayGainFromPregain(double gain) {
 mixxx::Bpm Track::getBpmWhileLocked() const {
     // BPM values must be synchronized at all times!
     DEBUG_ASSERT(m_record.getMetadata().getTrackInfo().getBpm() ==
-            getBeatsPointerBpm(m_pBeats, getDuration()));
+            getBeatsPointerBpm(m_pBeats, getDurationWhileLocked()));
     return m_record.getMetadata().getTrackInfo().getBpm();
 }
 
@@ -375,11 +391,12 @@ bool Track::trySetBpmWhileLocked(mixxx::Bpm bpm) {
         if (!cuePosition.isValid()) {
             cuePosition = mixxx::audio::kStartFramePos;
         }
-        auto pBeats = mixxx::Beats::fromConstTempo(getSampleRate(),
+        auto pBeats = mixxx::Beats::fromConstTempo(
+                m_record.getMetadata().getStreamInfo().getSignalInfo().getSampleRate(),
                 cuePosition,
                 bpm);
         return trySetBeatsWhileLocked(std::move(pBeats));
-    } else if (getBeatsPointerBpm(m_pBeats, getDuration()) != bpm) {
+    } else if (getBeatsPointerBpm(m_pBeats, getDurationWhileLocked()) != bpm) {
         // Continue with the regular cases
         const auto newBeats = m_pBeats->trySetBpm(bpm);
         if (newBeats) {
@@ -394,8 +411,9 @@ bool Track::trySetBpmWhileLocked(mixxx::Bpm bpm) {
 }
 
 double Track::getBpm() const {
-    const auto locked = lockMutex(&m_qMutex);
-    const mixxx::Bpm bpm = getBpmWhileLocked();
+    // The bpm of the record is always kept in sync with the beats
+    const mixxx::Bpm bpm =
+            getRecordSnapshot()->record.getMetadata().getTrackInfo().getBpm();
     return bpm.isValid() ? bpm.value() : mixxx::Bpm::kValueUndefined;
 }
 
@@ -423,7 +441,8 @@ bool Track::setBeatsWhileLocked(mixxx::BeatsPointer pBeats) {
         return false;
     }
     m_pBeats = std::move(pBeats);
-    m_record.refMetadata().refTrackInfo().setBpm(getBeatsPointerBpm(m_pBeats, getDuration()));
+    m_record.refMetadata().refTrackInfo().setBpm(
+            getBeatsPointerBpm(m_pBeats, getDurationWhileLocked()));
     return true;
 }
 
@@ -513,43 +532,46 @@ void Track::setSourceSynchronizedAt(const QDateTime& sourceSynchronizedAt) {
 }
 
 QDateTime Track::getSourceSynchronizedAt() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getSourceSynchronizedAt();
+    return getRecordSnapshot()->record.getSourceSynchronizedAt();
 }
 
 QString Track::getInfo() const {
-    const auto locked = lockMutex(&m_qMutex);
-    if (m_record.getMetadata().getTrackInfo().getArtist().trimmed().isEmpty()) {
-        if (m_record.getMetadata().getTrackInfo().getTitle().trimmed().isEmpty()) {
+    const auto pSnapshot = getRecordSnapshot();
+    const auto& trackInfo = pSnapshot->record.getMetadata().getTrackInfo();
+    if (trackInfo.getArtist().trimmed().isEmpty()) {
+        if (trackInfo.getTitle().trimmed().isEmpty()) {
+            const auto locked = lockMutex(&m_qMutex);
             return m_fileAccess.info().fileName();
         } else {
-            return m_record.getMetadata().getTrackInfo().getTitle();
+            return trackInfo.getTitle();
         }
     } else {
-        return m_record.getMetadata().getTrackInfo().getArtist() +
+        return trackInfo.getArtist() +
                 kArtistTitleSeparator +
-                m_record.getMetadata().getTrackInfo().getTitle();
+                trackInfo.getTitle();
     }
 }
 
 QString Track::getTitleInfo() const {
-    const auto locked = lockMutex(&m_qMutex);
-    if (m_record.getMetadata().getTrackInfo().getArtist().trimmed().isEmpty() &&
-            m_record.getMetadata().getTrackInfo().getTitle().trimmed().isEmpty()) {
+    const auto pSnapshot = getRecordSnapshot();
+    const auto& trackInfo = pSnapshot->record.getMetadata().getTrackInfo();
+    if (trackInfo.getArtist().trimmed().isEmpty() &&
+            trackInfo.getTitle().trimmed().isEmpty()) {
+        const auto locked = lockMutex(&m_qMutex);
         return m_fileAccess.info().fileName();
     } else {
-        return m_record.getMetadata().getTrackInfo().getTitle();
+        return trackInfo.getTitle();
     }
 }
 
 QDateTime Track::getDateAdded() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getDateAdded();
+    return getRecordSnapshot()->record.getDateAdded();
 }
 
 void Track::setDateAdded(const QDateTime& dateAdded) {
     auto locked = lockMutex(&m_qMutex);
     m_record.setDateAdded(dateAdded);
+    publishRecordWhileLocked();
 }
 
 void Track::setDuration(mixxx::Duration duration) {
@@ -578,24 +600,29 @@ void Track::setDuration(double duration) {
 }
 
 double Track::getDuration() const {
-    const auto locked = lockMutex(&m_qMutex);
+    return getRecordSnapshot()
+            ->record.getMetadata()
+            .getStreamInfo()
+            .getDuration()
+            .toDoubleSeconds();
+}
+
+double Track::getDurationWhileLocked() const {
     return m_record.getMetadata().getStreamInfo().getDuration().toDoubleSeconds();
 }
 
 int Track::getDurationSecondsInt() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return static_cast<int>(m_record.getMetadata().getDurationSecondsRounded());
+    return static_cast<int>(
+            getRecordSnapshot()->record.getMetadata().getDurationSecondsRounded());
 }
 
 QString Track::getDurationText(
         mixxx::Duration::Precision precision) const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMetadata().getDurationText(precision);
+    return getRecordSnapshot()->record.getMetadata().getDurationText(precision);
 }
 
 QString Track::getTitle() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMetadata().getTrackInfo().getTitle();
+    return getRecordSnapshot()->record.getMetadata().getTrackInfo().getTitle();
 }
 
 void Track::setTitle(const QString& s) {
@@ -609,8 +636,7 @@ void Track::setTitle(const QString& s) {
 }
 
 QString Track::getArtist() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMetadata().getTrackInfo().getArtist();
+    return getRecordSnapshot()->record.getMetadata().getTrackInfo().getArtist();
 }
 
 void Track::setArtist(const QString& s) {
@@ -624,8 +650,7 @@ void Track::setArtist(const QString& s) {
 }
 
 QString Track::getAlbum() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMetadata().getAlbumInfo().getTitle();
+    return getRecordSnapshot()->record.getMetadata().getAlbumInfo().getTitle();
 }
 
 void Track::setAlbum(const QString& s) {
@@ -638,8 +663,7 @@ void Track::setAlbum(const QString& s) {
 }
 
 QString Track::getAlbumArtist()  const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMetadata().getAlbumInfo().getArtist();
+    return getRecordSnapshot()->record.getMetadata().getAlbumInfo().getArtist();
 }
 
 void Track::setAlbumArtist(const QString& s) {
@@ -652,8 +676,7 @@ void Track::setAlbumArtist(const QString& s) {
 }
 
 QString Track::getYear()  const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMetadata().getTrackInfo().getYear();
+    return getRecordSnapshot()->record.getMetadata().getTrackInfo().getYear();
 }
 
 void Track::setYear(const QString& s) {
@@ -666,8 +689,7 @@ void Track::setYear(const QString& s) {
 }
 
 QString Track::getComposer() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMetadata().getTrackInfo().getComposer();
+    return getRecordSnapshot()->record.getMetadata().getTrackInfo().getComposer();
 }
 
 void Track::setComposer(const QString& s) {
@@ -680,8 +702,7 @@ void Track::setComposer(const QString& s) {
 }
 
 QString Track::getGrouping()  const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMetadata().getTrackInfo().getGrouping();
+    return getRecordSnapshot()->record.getMetadata().getTrackInfo().getGrouping();
 }
 
 void Track::setGrouping(const QString& s) {
@@ -694,13 +715,11 @@ void Track::setGrouping(const QString& s) {
 }
 
 QString Track::getTrackNumber()  const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMetadata().getTrackInfo().getTrackNumber();
+    return getRecordSnapshot()->record.getMetadata().getTrackInfo().getTrackNumber();
 }
 
 QString Track::getTrackTotal()  const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMetadata().getTrackInfo().getTrackTotal();
+    return getRecordSnapshot()->record.getMetadata().getTrackInfo().getTrackTotal();
 }
 
 void Track::setTrackNumber(const QString& s) {
@@ -722,8 +741,7 @@ void Track::setTrackTotal(const QString& s) {
 }
 
 PlayCounter Track::getPlayCounter() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getPlayCounter();
+    return getRecordSnapshot()->record.getPlayCounter();
 }
 
 void Track::setPlayCounter(const PlayCounter& playCounter) {
@@ -745,8 +763,7 @@ void Track::updatePlayCounter(bool bPlayed) {
 }
 
 mixxx::RgbColor::optional_t Track::getColor() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getColor();
+    return getRecordSnapshot()->record.getColor();
 }
 
 void Track::setColor(const mixxx::RgbColor::optional_t& color) {
@@ -758,8 +775,7 @@ void Track::setColor(const mixxx::RgbColor::optional_t& color) {
 }
 
 QString Track::getComment() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMetadata().getTrackInfo().getComment();
+    return getRecordSnapshot()->record.getMetadata().getTrackInfo().getComment();
 }
 
 void Track::setComment(const QString& s) {
@@ -771,8 +787,7 @@ void Track::setComment(const QString& s) {
 }
 
 QString Track::getType() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getFileType();
+    return getRecordSnapshot()->record.getFileType();
 }
 
 QString Track::setType(const QString& newType) {
@@ -785,23 +800,19 @@ QString Track::setType(const QString& newType) {
 }
 
 mixxx::audio::SampleRate Track::getSampleRate() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMetadata().getStreamInfo().getSignalInfo().getSampleRate();
+    return getRecordSnapshot()->record.getMetadata().getStreamInfo().getSignalInfo().getSampleRate();
 }
 
 int Track::getChannels() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMetadata().getStreamInfo().getSignalInfo().getChannelCount();
+    return getRecordSnapshot()->record.getMetadata().getStreamInfo().getSignalInfo().getChannelCount();
 }
 
 int Track::getBitrate() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMetadata().getStreamInfo().getBitrate();
+    return getRecordSnapshot()->record.getMetadata().getStreamInfo().getBitrate();
 }
 
 QString Track::getBitrateText() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMetadata().getBitrateText();
+    return getRecordSnapshot()->record.getMetadata().getBitrateText();
 }
 
 void Track::setBitrate(int iBitrate) {
@@ -826,8 +837,7 @@ void Track::setBitrate(int iBitrate) {
 }
 
 TrackId Track::getId() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getId();
+    return getRecordSnapshot()->record.getId();
 }
 
 void Track::initId(TrackId id) {
@@ -844,6 +854,7 @@ void Track::initId(TrackId id) {
         return; // abort
     }
     m_record.setId(id);
+    publishRecordWhileLocked();
     // Changing the Id does not make the track dirty because the Id is always
     // generated by the database itself.
 }
@@ -851,6 +862,7 @@ void Track::initId(TrackId id) {
 void Track::resetId() {
     const auto locked = lockMutex(&m_qMutex);
     m_record.setId(TrackId());
+    publishRecordWhileLocked();
 }
 
 void Track::setURL(const QString& url) {
@@ -861,8 +873,7 @@ void Track::setURL(const QString& url) {
 }
 
 QString Track::getURL() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getUrl();
+    return getRecordSnapshot()->record.getUrl();
 }
 
 ConstWaveformPointer Track::getWaveform() const {
@@ -940,8 +951,7 @@ void Track::analysisFinished() {
 }
 
 mixxx::audio::FramePos Track::getMainCuePosition() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMainCuePosition();
+    return getRecordSnapshot()->record.getMainCuePosition();
 }
 
 void Track::slotCueUpdated() {
@@ -1308,6 +1318,11 @@ void Track::setDirtyAndUnlock(QT_RECURSIVE_MUTEX_LOCKER* pLock, bool bDirty) {
     const bool dirtyChanged = m_bDirty != bDirty;
     m_bDirty = bDirty;
 
+    if (bDirty) {
+        // All modifications of the record end here
+        publishRecordWhileLocked();
+    }
+
     const auto trackId = m_record.getId();
 
     // Unlock before emitting any signals!
@@ -1347,8 +1362,7 @@ bool Track::isMarkedForMetadataExport() const {
 }
 
 int Track::getRating() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getRating();
+    return getRecordSnapshot()->record.getRating();
 }
 
 void Track::setRating (int rating) {
@@ -1376,8 +1390,7 @@ void Track::resetKeys() {
 }
 
 Keys Track::getKeys() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getKeys();
+    return getRecordSnapshot()->record.getKeys();
 }
 
 void Track::setKey(mixxx::track::io::key::ChromaticKey key,
@@ -1389,13 +1402,11 @@ void Track::setKey(mixxx::track::io::key::ChromaticKey key,
 }
 
 mixxx::track::io::key::ChromaticKey Track::getKey() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getGlobalKey();
+    return getRecordSnapshot()->record.getGlobalKey();
 }
 
 QString Track::getKeyText() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getGlobalKeyText();
+    return getRecordSnapshot()->record.getGlobalKeyText();
 }
 
 void Track::setKeyText(const QString& keyText,
@@ -1414,8 +1425,7 @@ void Track::setBpmLocked(bool bpmLocked) {
 }
 
 bool Track::isBpmLocked() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getBpmLocked();
+    return getRecordSnapshot()->record.getBpmLocked();
 }
 
 void Track::setCoverInfo(const CoverInfoRelative& coverInfo) {
@@ -1429,8 +1439,7 @@ void Track::setCoverInfo(const CoverInfoRelative& coverInfo) {
 }
 
 CoverInfoRelative Track::getCoverInfo() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getCoverInfo();
+    return getRecordSnapshot()->record.getCoverInfo();
 }
 
 CoverInfo Track::getCoverInfoWithLocation() const {
@@ -1525,8 +1534,8 @@ ExportTrackMetadataResult Track::exportMetadata(
                     << "Refusing to overwrite Serato metadata that failed to parse:"
                     << getLocation();
         } else {
-            seratoTags->setTrackColor(getColor());
-            seratoTags->setBpmLocked(isBpmLocked());
+            seratoTags->setTrackColor(m_record.getColor());
+            seratoTags->setBpmLocked(m_record.getBpmLocked());
 
             QList<mixxx::CueInfo> cueInfos;
             for (const CuePointer& pCue : qAsConst(m_cuePoints)) {
@@ -1542,6 +1551,7 @@ ExportTrackMetadataResult Track::exportMetadata(
                     streamInfo->getDuration(),
                     timingOffset);
         }
+        publishRecordWhileLocked();
     }
 
     // Check if the metadata has actually been modified. Otherwise
@@ -1569,7 +1579,9 @@ ExportTrackMetadataResult Track::exportMetadata(
         // library database! This will in turn update the current metadata
         // that is stored in the database. New columns that need to be populated
         // from file tags cannot be filled during a database migration.
-        m_record.mergeExtraMetadataFromSource(importedFromFile);
+        if (m_record.mergeExtraMetadataFromSource(importedFromFile)) {
+            publishRecordWhileLocked();
+        }
 
         // Prepare export by cloning and normalizing the metadata
         normalizedFromRecord = m_record.getMetadata();
@@ -1639,6 +1651,7 @@ ExportTrackMetadataResult Track::exportMetadata(
         // The database update will follow immediately after returning from
         // this operation!
         m_record.updateSourceSynchronizedAt(trackMetadataExported.second);
+        publishRecordWhileLocked();
         if (kLogger.debugEnabled()) {
             kLogger.debug()
                     << "Exported track metadata:"
@@ -1723,6 +1736,9 @@ void Track::updateStreamInfoFromSource(
     }
 
     if (!beatsImported && !cuesImported) {
+        if (updated) {
+            publishRecordWhileLocked();
+        }
         return;
     }
 
@@ -1738,8 +1754,7 @@ void Track::updateStreamInfoFromSource(
 }
 
 QString Track::getGenre() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMetadata().getTrackInfo().getGenre();
+    return getRecordSnapshot()->record.getMetadata().getTrackInfo().getGenre();
 }
 
 void Track::setGenreFromTrackDAO(
@@ -1769,8 +1784,7 @@ bool Track::updateGenre(
 
 #if defined(__EXTRA_METADATA__)
 QString Track::getMood() const {
-    const auto locked = lockMutex(&m_qMutex);
-    return m_record.getMetadata().getTrackInfo().getMood();
+    return getRecordSnapshot()->record.getMetadata().getTrackInfo().getMood();
 }
 
 bool Track::updateMood(
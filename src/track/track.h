@@ -3,6 +3,7 @@
 #include <QList>
 #include <QObject>
 #include <QUrl>
+#include <atomic>
 
 #include "audio/streaminfo.h"
 #include "sources/metadatasource.h"
@@ -11,6 +12,7 @@
 #include "track/cueinfoimporter.h"
 #include "track/track_decl.h"
 #include "track/trackrecord.h"
+#include "util/atomicsharedptr.h"
 #include "util/compatibility/qmutex.h"
 #include "util/fileaccess.h"
 #include "util/memory.h"
@@ -410,6 +412,29 @@ class Track : public QObject {
             mixxx::TrackRecord newRecord,
             mixxx::BeatsPointer pOptionalBeats = nullptr);
 
+    /// An immutable copy of the TrackRecord that is published after each
+    /// modification. Readers don't need to lock the track, so they are not
+    /// blocked by writers like the analysis or the import of file tags.
+    struct RecordSnapshot {
+        mixxx::TrackRecord record;
+        /// Incremented with each published snapshot
+        quint64 version;
+    };
+    using RecordSnapshotPointer = std::shared_ptr<const RecordSnapshot>;
+
+    /// The most recently published snapshot, never null. All getters that
+    /// only access the TrackRecord read from it. Use it directly to read
+    /// multiple properties consistently.
+    RecordSnapshotPointer getRecordSnapshot() const {
+        return m_pRecordSnapshot.load();
+    }
+    /// The version of the most recently published snapshot. Consumers that
+    /// cache values derived from the record can compare it with the version
+    /// of their last read to detect changes without copying anything.
+    quint64 getRecordVersion() const {
+        return m_recordVersion.load(std::memory_order_acquire);
+    }
+
     // Mark the track dirty if it isn't already.
     void markDirty();
     // Mark the track clean if it isn't already.
@@ -515,6 +540,7 @@ class Track : public QObject {
     bool importPendingCueInfosWhileLocked();
 
     mixxx::Bpm getBpmWhileLocked() const;
+    double getDurationWhileLocked() const;
     bool trySetBpmWhileLocked(mixxx::Bpm bpm);
     bool trySetBeatsWhileLocked(
             mixxx::BeatsPointer pBeats,
@@ -557,6 +583,11 @@ class Track : public QObject {
     void updateStreamInfoFromSource(
             mixxx::audio::StreamInfo&& streamInfo);
 
+    /// Publishes a new RecordSnapshot. Must be called after modifying
+    /// m_record before unlocking. setDirtyAndUnlock() does this
+    /// implicitly when marking the track dirty.
+    void publishRecordWhileLocked();
+
     // Mutex protecting access to object
     mutable QT_RECURSIVE_MUTEX m_qMutex;
 
@@ -565,6 +596,10 @@ class Track : public QObject {
 
     mixxx::TrackRecord m_record;
 
+    // Lock-free access to a copy of m_record
+    mixxx::AtomicSharedPtr<const RecordSnapshot> m_pRecordSnapshot;
+    std::atomic<quint64> m_recordVersion;
+
     // Flag that indicates whether or not the TIO has changed. This is used by
     // TrackDAO to determine whether or not to write the Track back.
     bool m_bDirty;
@@ -592,6 +627,7 @@ class Track : public QObject {
         // to lock the mutex.
         DEBUG_ASSERT(!m_record.m_headerParsed);
         m_record.m_headerParsed = headerParsed;
+        publishRecordWhileLocked();
     }
     /// Set the genre text WITHOUT updating the corresponding custom tags.
     ///
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+namespace mixxx {
+
+/// A std::shared_ptr that can be loaded and replaced concurrently by
+/// multiple threads without an external mutex.
+///
+/// This is std::atomic<std::shared_ptr<T>> if the standard library
+/// provides it. Otherwise the atomic free functions for std::shared_ptr
+/// are used, which are deprecated since C++20 but still available.
+template<typename T>
+class AtomicSharedPtr {
+  public:
+    AtomicSharedPtr() = default;
+    explicit AtomicSharedPtr(std::shared_ptr<T> pValue)
+            : m_pValue(std::move(pValue)) {
+    }
+    AtomicSharedPtr(const AtomicSharedPtr&) = delete;
+    AtomicSharedPtr& operator=(const AtomicSharedPtr&) = delete;
+
+    std::shared_ptr<T> load() const {
+#if defined(__cpp_lib_atomic_shared_ptr)
+        return m_pValue.load(std::memory_order_acquire);
+#else
+        return std::atomic_load_explicit(&m_pValue, std::memory_order_acquire);
+#endif
+    }
+
+    void store(std::shared_ptr<T> pValue) {
+#if defined(__cpp_lib_atomic_shared_ptr)
+        m_pValue.store(std::move(pValue), std::memory_order_release);
+#else
+        std::atomic_store_explicit(&m_pValue, std::move(pValue), std::memory_order_release);
+#endif
+    }
+
+  private:
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::atomic<std::shared_ptr<T>> m_pValue;
+#else
+    std::shared_ptr<T> m_pValue;
+#endif
+};
+
+} // namespace mixxx
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#ifdef __APPLE__
+#include <dispatch/dispatch.h>
+#endif
+
+// Lets a consumer thread sleep until a producer signals new work, without
+// ever taking a mutex on the producer side. notify() is wait-free and only
+// issues a system call (a futex wake on Linux) while a consumer is actually
+// sleeping, so it is safe to call from the audio callback.
+//
+// std::atomic::wait() requires macOS 11, so on macOS sleeping consumers
+// wait on a libdispatch semaphore instead, which does not lock either.
+//
+// Unlike QWaitCondition this does not lose wakeups: A notify() between
+// prepareWait() and wait() makes wait() return immediately.
+//
+// Consumer loop:
+//
+//     while (!stop) {
+//         const auto key = eventCount.prepareWait();
+//         if (fifo.readAvailable() > 0 || stop) {
+//             eventCount.cancelWait();
+//         } else {
+//             eventCount.wait(key);
+//         }
+//         // consume ...
+//     }
+//
+// Multiple producers may call notify() concurrently.
+class EventCount {
+  public:
+    typedef std::uint32_t Key;
+
+    EventCount()
+            : m_epoch(0),
+              m_waiters(0) {
+#ifdef __APPLE__
+        m_semaphore = dispatch_semaphore_create(0);
+#endif
+    }
+#ifdef __APPLE__
+    ~EventCount() {
+        dispatch_release(m_semaphore);
+    }
+#endif
+
+    Key prepareWait() {
+        m_waiters.fetch_add(1, std::memory_order_seq_cst);
+        return m_epoch.load(std::memory_order_seq_cst);
+    }
+
+    void cancelWait() {
+        m_waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Blocks until notify() has been called after prepareWait() returned
+    // the given key.
+    void wait(Key key) {
+#ifdef __APPLE__
+        // Signals of earlier notify() calls might still be pending
+        while (m_epoch.load(std::memory_order_acquire) == key) {
+            dispatch_semaphore_wait(m_semaphore, DISPATCH_TIME_FOREVER);
+        }
+#else
+        m_epoch.wait(key, std::memory_order_acquire);
+#endif
+        m_waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void notify() {
+        // The sequentially consistent increment orders the preceding writes
+        // of the producer (e.g. into a FIFO) before the load of m_waiters.
+        // Either a concurrent consumer sees the new epoch in prepareWait()
+        // or we see it waiting here.
+        m_epoch.fetch_add(1, std::memory_order_seq_cst);
+        const int waiters = m_waiters.load(std::memory_order_seq_cst);
+        if (waiters > 0) {
+#ifdef __APPLE__
+            for (int i = 0; i < waiters; ++i) {
+                dispatch_semaphore_signal(m_semaphore);
+            }
+#else
+            m_epoch.notify_all();
+#endif
+        }
+    }
+
+  private:
+    std::atomic<Key> m_epoch;
+    std::atomic<int> m_waiters;
+#ifdef __APPLE__
+    dispatch_semaphore_t m_semaphore;
+#endif
+};
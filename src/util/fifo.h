@@ -1,37 +1,86 @@
 #pragma once
 
-#include "pa_ringbuffer.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
 
 #include "util/class.h"
 #include "util/math.h"
 
-template <class DataType>
+// Kept from the PortAudio ring buffer that was used before, all region sizes
+// are reported with this type.
+typedef long ring_buffer_size_t;
+
+namespace mixxx {
+
+// std::hardware_destructive_interference_size is not used on purpose, GCC
+// warns that its value depends on the compiler flags.
+constexpr std::size_t kCacheLineSize = 64;
+
+} // namespace mixxx
+
+// Lock-free single producer, single consumer ring buffer.
+//
+// The capacity is rounded up to the next power of 2 and can be used
+// completely. The read and write indices live on separate cache lines, each
+// side also keeps a cached copy of the index of the other side. The shared
+// index is only loaded when the cached value does not suffice, which avoids
+// bouncing cache lines between the producer and the consumer core on every
+// call.
+//
+// aquireWriteRegions()/releaseWriteRegions() and aquireReadRegions()/
+// releaseReadRegions() give direct access to the (at most two) contiguous
+// segments of the buffer, so data can be produced or consumed in place.
+//
+// Use EventCount (util/eventcount.h) if the consumer needs to sleep until
+// data is available.
+template<class DataType>
 class FIFO {
   public:
     explicit FIFO(int size)
-            : m_data(roundUpToPowerOf2(size)) {
-        // If we can't represent the next higher power of 2 then bail.
-        if (m_data.size() == 0) {
-            return;
-        }
-        PaUtil_InitializeRingBuffer(&m_ringBuffer,
-                static_cast<ring_buffer_size_t>(sizeof(DataType)),
-                static_cast<ring_buffer_size_t>(m_data.size()),
-                m_data.data());
-    }
-    virtual ~FIFO() {
+            : m_data(roundUpToPowerOf2(size)),
+              m_capacity(m_data.size()),
+              m_mask(m_capacity > 0 ? m_capacity - 1 : 0) {
+        // If we can't represent the next higher power of 2 then m_capacity
+        // is 0 and all operations are no-ops.
     }
+
     int readAvailable() const {
-        return PaUtil_GetRingBufferReadAvailable(&m_ringBuffer);
+        // Load the read index first, so the result is never negative, even
+        // if called from a third thread.
+        const std::size_t readIndex = m_readIndex.load(std::memory_order_acquire);
+        const std::size_t writeIndex = m_writeIndex.load(std::memory_order_acquire);
+        return static_cast<int>(math_min(writeIndex - readIndex, m_capacity));
     }
     int writeAvailable() const {
-        return PaUtil_GetRingBufferWriteAvailable(&m_ringBuffer);
+        return static_cast<int>(m_capacity - readAvailable());
     }
+
+    // Consumer
     int read(DataType* pData, int count) {
-        return PaUtil_ReadRingBuffer(&m_ringBuffer, pData, count);
+        DataType* pData1;
+        ring_buffer_size_t size1;
+        DataType* pData2;
+        ring_buffer_size_t size2;
+        const int available = aquireReadRegions(count, &pData1, &size1, &pData2, &size2);
+        std::copy(pData1, pData1 + size1, pData);
+        std::copy(pData2, pData2 + size2, pData + size1);
+        releaseReadRegions(available);
+        return available;
     }
+
+    // Producer
     int write(const DataType* pData, int count) {
-        return PaUtil_WriteRingBuffer(&m_ringBuffer, pData, count);
+        DataType* pData1;
+        ring_buffer_size_t size1;
+        DataType* pData2;
+        ring_buffer_size_t size2;
+        const int available = aquireWriteRegions(count, &pData1, &size1, &pData2, &size2);
+        std::copy(pData, pData + size1, pData1);
+        std::copy(pData + size1, pData + size1 + size2, pData2);
+        releaseWriteRegions(available);
+        return available;
     }
     void writeBlocking(const DataType* pData, int count) {
         int written = 0;
@@ -39,31 +88,104 @@ class FIFO {
             written += write(pData + written, count - written);
         }
     }
+
+    // Producer: Returns the number of items that can be written, up to count.
+    // The items must be committed with releaseWriteRegions().
     int aquireWriteRegions(int count,
-            DataType** dataPtr1, ring_buffer_size_t* sizePtr1,
-            DataType** dataPtr2, ring_buffer_size_t* sizePtr2) {
-        return PaUtil_GetRingBufferWriteRegions(&m_ringBuffer, count,
-                (void**)dataPtr1, sizePtr1, (void**)dataPtr2, sizePtr2);
+            DataType** dataPtr1,
+            ring_buffer_size_t* sizePtr1,
+            DataType** dataPtr2,
+            ring_buffer_size_t* sizePtr2) {
+        const std::size_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+        std::size_t available = m_capacity - (writeIndex - m_cachedReadIndex);
+        if (available < static_cast<std::size_t>(count)) {
+            m_cachedReadIndex = m_readIndex.load(std::memory_order_acquire);
+            available = m_capacity - (writeIndex - m_cachedReadIndex);
+        }
+        return getRegions(writeIndex,
+                std::min(available, static_cast<std::size_t>(std::max(count, 0))),
+                dataPtr1,
+                sizePtr1,
+                dataPtr2,
+                sizePtr2);
     }
     int releaseWriteRegions(int count) {
-        return PaUtil_AdvanceRingBufferWriteIndex(&m_ringBuffer, count);
+        m_writeIndex.store(m_writeIndex.load(std::memory_order_relaxed) + count,
+                std::memory_order_release);
+        return count;
     }
+
+    // Consumer: Returns the number of items that can be read, up to count.
+    // The items must be released with releaseReadRegions().
     int aquireReadRegions(int count,
-            DataType** dataPtr1, ring_buffer_size_t* sizePtr1,
-            DataType** dataPtr2, ring_buffer_size_t* sizePtr2) {
-        return PaUtil_GetRingBufferReadRegions(&m_ringBuffer, count,
-                (void**)dataPtr1, sizePtr1, (void**)dataPtr2, sizePtr2);
+            DataType** dataPtr1,
+            ring_buffer_size_t* sizePtr1,
+            DataType** dataPtr2,
+            ring_buffer_size_t* sizePtr2) {
+        const std::size_t readIndex = m_readIndex.load(std::memory_order_relaxed);
+        std::size_t available = m_cachedWriteIndex - readIndex;
+        if (available < static_cast<std::size_t>(count)) {
+            m_cachedWriteIndex = m_writeIndex.load(std::memory_order_acquire);
+            available = m_cachedWriteIndex - readIndex;
+        }
+        return getRegions(readIndex,
+                std::min(available, static_cast<std::size_t>(std::max(count, 0))),
+                dataPtr1,
+                sizePtr1,
+                dataPtr2,
+                sizePtr2);
     }
     int releaseReadRegions(int count) {
-        return PaUtil_AdvanceRingBufferReadIndex(&m_ringBuffer, count);
+        m_readIndex.store(m_readIndex.load(std::memory_order_relaxed) + count,
+                std::memory_order_release);
+        return count;
     }
     int flushReadData(int count) {
-        int flush = math_min(readAvailable(), count);
-        return PaUtil_AdvanceRingBufferReadIndex(&m_ringBuffer, flush);
+        // The cached write index must not fall behind the read index,
+        // otherwise the next aquireReadRegions() would wrap around
+        const std::size_t readIndex = m_readIndex.load(std::memory_order_relaxed);
+        m_cachedWriteIndex = m_writeIndex.load(std::memory_order_acquire);
+        const int flush = static_cast<int>(std::min(m_cachedWriteIndex - readIndex,
+                static_cast<std::size_t>(std::max(count, 0))));
+        return releaseReadRegions(flush);
     }
 
   private:
+    int getRegions(std::size_t index,
+            std::size_t count,
+            DataType** dataPtr1,
+            ring_buffer_size_t* sizePtr1,
+            DataType** dataPtr2,
+            ring_buffer_size_t* sizePtr2) {
+        const std::size_t offset = index & m_mask;
+        const std::size_t size1 = std::min(count, m_capacity - offset);
+        *dataPtr1 = m_data.data() + offset;
+        *sizePtr1 = static_cast<ring_buffer_size_t>(size1);
+        if (size1 < count) {
+            *dataPtr2 = m_data.data();
+            *sizePtr2 = static_cast<ring_buffer_size_t>(count - size1);
+        } else {
+            *dataPtr2 = nullptr;
+            *sizePtr2 = 0;
+        }
+        return static_cast<int>(count);
+    }
+
+    // Shared, read-only after construction
     std::vector<DataType> m_data;
-    PaUtilRingBuffer m_ringBuffer;
+    const std::size_t m_capacity;
+    const std::size_t m_mask;
+
+    // Written by the producer. The indices are running counters, the position
+    // in m_data is the index masked with m_mask.
+    alignas(mixxx::kCacheLineSize) std::atomic<std::size_t> m_writeIndex{0};
+    std::size_t m_cachedReadIndex{0};
+
+    // Written by the consumer
+    alignas(mixxx::kCacheLineSize) std::atomic<std::size_t> m_readIndex{0};
+    // Subsequent members of the owner don't share this cache line, because
+    // the alignment rounds sizeof(FIFO) up to a multiple of kCacheLineSize.
+    std::size_t m_cachedWriteIndex{0};
+
     DISALLOW_COPY_AND_ASSIGN(FIFO);
 };
@@ -0,0 +1,163 @@
+#include "util/filecopy.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QtDebug>
+#include <algorithm>
+#include <vector>
+
+#ifdef __linux__
+#include <errno.h>
+#include <sys/sendfile.h>
+#include <unistd.h>
+#ifdef __GLIBC__
+#if __GLIBC_PREREQ(2, 27)
+#define MIXXX_HAVE_COPY_FILE_RANGE
+#endif
+#endif
+#endif
+
+namespace mixxx {
+
+namespace {
+
+// Large blocks for sequential copies to slow devices
+constexpr qint64 kCopyBlockSize = 8 * 1024 * 1024;
+
+constexpr int kModificationTimeToleranceMillis = 2000;
+
+const QString kPartialFileSuffix = QStringLiteral(".part");
+
+#ifdef __linux__
+// Returns the number of bytes copied in the kernel. Fewer than size if the
+// kernel can't copy these files, then the remaining bytes are copied in
+// user space.
+qint64 copyInKernel(int sourceFd, int destinationFd, qint64 size) {
+    qint64 copied = 0;
+#ifdef MIXXX_HAVE_COPY_FILE_RANGE
+    // Uses reflinks or server-side copies if supported by the file system
+    while (copied < size) {
+        const ssize_t result = copy_file_range(sourceFd,
+                nullptr,
+                destinationFd,
+                nullptr,
+                static_cast<size_t>(std::min(size - copied, kCopyBlockSize)),
+                0);
+        if (result <= 0) {
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            // ENOSYS, EXDEV, EINVAL, ... with older kernels or
+            // different file systems
+            break;
+        }
+        copied += result;
+    }
+#endif
+    while (copied < size) {
+        // The file offset of the source is advanced by sendfile()
+        const ssize_t result = sendfile(destinationFd,
+                sourceFd,
+                nullptr,
+                static_cast<size_t>(std::min(size - copied, kCopyBlockSize)));
+        if (result <= 0) {
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        copied += result;
+    }
+    return copied;
+}
+#endif
+
+bool copyContents(QFile* pSource, QFile* pDestination, QString* pErrorMessage) {
+    const qint64 size = pSource->size();
+    qint64 copied = 0;
+#ifdef __linux__
+    copied = copyInKernel(pSource->handle(), pDestination->handle(), size);
+    if (copied > 0 &&
+            (!pSource->seek(copied) || !pDestination->seek(copied))) {
+        *pErrorMessage = pDestination->errorString();
+        return false;
+    }
+#endif
+    if (copied >= size) {
+        return true;
+    }
+    std::vector<char> buffer(static_cast<size_t>(std::min(size - copied, kCopyBlockSize)));
+    while (copied < size) {
+        const qint64 read = pSource->read(buffer.data(), buffer.size());
+        if (read <= 0) {
+            *pErrorMessage = pSource->errorString();
+            return false;
+        }
+        if (pDestination->write(buffer.data(), read) != read) {
+            *pErrorMessage = pDestination->errorString();
+            return false;
+        }
+        copied += read;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+bool isFileCopyUpToDate(const QFileInfo& source, const QFileInfo& destination) {
+    if (!destination.exists() || destination.size() != source.size()) {
+        return false;
+    }
+    return destination.lastModified().msecsTo(source.lastModified()) <=
+            kModificationTimeToleranceMillis;
+}
+
+bool copyFile(const QString& sourcePath,
+        const QString& destinationPath,
+        QString* pErrorMessage) {
+    QString errorMessage;
+    if (!pErrorMessage) {
+        pErrorMessage = &errorMessage;
+    }
+
+    QFile source(sourcePath);
+    if (!source.open(QIODevice::ReadOnly)) {
+        *pErrorMessage = source.errorString();
+        return false;
+    }
+    QFile partial(destinationPath + kPartialFileSuffix);
+    if (!partial.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        *pErrorMessage = partial.errorString();
+        return false;
+    }
+    if (!copyContents(&source, &partial, pErrorMessage) || !partial.flush()) {
+        if (pErrorMessage->isEmpty()) {
+            *pErrorMessage = partial.errorString();
+        }
+        partial.close();
+        partial.remove();
+        return false;
+    }
+    const QDateTime lastModified = QFileInfo(source).lastModified();
+    if (lastModified.isValid() &&
+            !partial.setFileTime(lastModified, QFileDevice::FileModificationTime)) {
+        qWarning() << "Failed to set the modification time of"
+                   << partial.fileName() << partial.errorString();
+    }
+    partial.close();
+
+    QFile destination(destinationPath);
+    if (destination.exists() && !destination.remove()) {
+        *pErrorMessage = destination.errorString();
+        partial.remove();
+        return false;
+    }
+    if (!partial.rename(destinationPath)) {
+        *pErrorMessage = partial.errorString();
+        partial.remove();
+        return false;
+    }
+    return true;
+}
+
+} // namespace mixxx
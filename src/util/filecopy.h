@@ -0,0 +1,29 @@
+#pragma once
+
+#include <QFileInfo>
+#include <QString>
+
+namespace mixxx {
+
+/// Checks if the destination is a complete copy of the source that doesn't
+/// need to be copied again, i.e. it has the same size and hasn't been
+/// modified before the source. The modification time is compared with a
+/// tolerance of 2 seconds, which is the resolution of FAT file systems
+/// that are common on USB sticks.
+bool isFileCopyUpToDate(const QFileInfo& source, const QFileInfo& destination);
+
+/// Copies the contents of a file, replacing an existing destination file.
+///
+/// The contents are copied in the kernel with copy_file_range() or
+/// sendfile() where available, otherwise in large sequential blocks. They
+/// are first written into a temporary file next to the destination that is
+/// renamed when complete. So an interrupted copy never leaves a truncated
+/// destination file behind. The destination gets the modification time of
+/// the source for isFileCopyUpToDate().
+///
+/// Thread-safe. Returns false and sets pErrorMessage on failure.
+bool copyFile(const QString& sourcePath,
+        const QString& destinationPath,
+        QString* pErrorMessage = nullptr);
+
+} // namespace mixxx
@@ -0,0 +1,104 @@
+#include "util/mappedfile.h"
+
+#include <QtDebug>
+#include <limits>
+
+namespace mixxx {
+
+namespace {
+
+// Points to valid memory for empty files
+const char kEmptyData[1] = {};
+
+} // anonymous namespace
+
+bool MappedFile::open(const QString& filePath) {
+    close();
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Failed to open" << filePath << m_file.errorString();
+        return false;
+    }
+    const qint64 size = m_file.size();
+    if (size > std::numeric_limits<int>::max()) {
+        // QByteArray is limited to int
+        qWarning() << "File is too large to be mapped" << filePath;
+        m_file.close();
+        return false;
+    }
+    if (size == 0) {
+        m_pData = kEmptyData;
+        m_size = 0;
+        return true;
+    }
+    const uchar* pMapped = m_file.map(0, size);
+    if (pMapped) {
+        m_pData = reinterpret_cast<const char*>(pMapped);
+        m_size = size;
+        return true;
+    }
+    // Some file systems don't support mapping files
+    m_contents = m_file.readAll();
+    if (m_contents.size() != size) {
+        qWarning() << "Failed to read" << filePath << m_file.errorString();
+        close();
+        return false;
+    }
+    m_file.close();
+    m_pData = m_contents.constData();
+    m_size = m_contents.size();
+    return true;
+}
+
+void MappedFile::close() {
+    // Closing the file unmaps it
+    m_file.close();
+    m_contents.clear();
+    m_pData = nullptr;
+    m_size = 0;
+}
+
+MappedFileStreamBuf::MappedFileStreamBuf(const MappedFile& file) {
+    // The get area is never written to
+    char* pBegin = const_cast<char*>(file.data());
+    setg(pBegin, pBegin, pBegin + file.size());
+}
+
+MappedFileStreamBuf::pos_type MappedFileStreamBuf::seekoff(off_type off,
+        std::ios_base::seekdir dir,
+        std::ios_base::openmode which) {
+    if (!(which & std::ios_base::in)) {
+        return pos_type(off_type(-1));
+    }
+    off_type pos;
+    switch (dir) {
+    case std::ios_base::beg:
+        pos = off;
+        break;
+    case std::ios_base::cur:
+        pos = (gptr() - eback()) + off;
+        break;
+    case std::ios_base::end:
+        pos = (egptr() - eback()) + off;
+        break;
+    default:
+        return pos_type(off_type(-1));
+    }
+    if (pos < 0 || pos > egptr() - eback()) {
+        return pos_type(off_type(-1));
+    }
+    setg(eback(), eback() + pos, egptr());
+    return pos_type(pos);
+}
+
+MappedFileStreamBuf::pos_type MappedFileStreamBuf::seekpos(
+        pos_type pos, std::ios_base::openmode which) {
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+std::streamsize MappedFileStreamBuf::showmanyc() {
+    const std::streamsize available = egptr() - gptr();
+    return available > 0 ? available : -1;
+}
+
+} // namespace mixxx
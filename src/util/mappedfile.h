@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <streambuf>
+
+namespace mixxx {
+
+/// A read-only file that is mapped into memory.
+///
+/// Parsers of binary files that do many small reads and seeks, like those
+/// of the Rekordbox and Serato databases on USB sticks, read directly from
+/// memory instead of doing a system call for each read. Files that can't
+/// be mapped are read into memory at once.
+class MappedFile {
+  public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const QString& filePath);
+    void close();
+
+    bool isOpen() const {
+        return m_pData != nullptr;
+    }
+    const char* data() const {
+        return m_pData;
+    }
+    qint64 size() const {
+        return m_size;
+    }
+
+    /// Returns the contents without copying them. Only valid while the
+    /// file is open.
+    QByteArray bytes() const {
+        return QByteArray::fromRawData(m_pData, static_cast<int>(m_size));
+    }
+
+  private:
+    QFile m_file;
+    // Only used if the file could not be mapped
+    QByteArray m_contents;
+    const char* m_pData = nullptr;
+    qint64 m_size = 0;
+};
+
+/// A read-only std::streambuf for the contents of a MappedFile, e.g. for
+/// reading it with a std::istream.
+class MappedFileStreamBuf : public std::streambuf {
+  public:
+    explicit MappedFileStreamBuf(const MappedFile& file);
+
+  protected:
+    pos_type seekoff(off_type off,
+            std::ios_base::seekdir dir,
+            std::ios_base::openmode which) override;
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+    std::streamsize showmanyc() override;
+};
+
+} // namespace mixxx
@@ -0,0 +1,244 @@
+#include "util/rtaudit.h"
+
+#ifdef MIXXX_RT_AUDIT
+
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <malloc.h>
+#include <pthread.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+// Interposition of the glibc allocation and locking entry points. The
+// definitions below take precedence over the ones in libc.so because they
+// are linked into the executable. The allocation functions forward to the
+// glibc internal implementations, which are exported for exactly this
+// purpose. pthread_mutex_lock has no such alias and is looked up with
+// dlsym(RTLD_NEXT).
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace {
+
+constexpr int kMaxReports = 64;
+constexpr int kMaxFrames = 32;
+
+enum class Kind {
+    Allocation,
+    Deallocation,
+    Lock,
+};
+
+struct Report {
+    Kind kind;
+    int frameCount;
+    void* frames[kMaxFrames];
+};
+
+// Preallocated, so recording a violation never allocates itself.
+Report s_reports[kMaxReports];
+std::atomic<int> s_violationCount(0);
+bool s_abortOnViolation = false;
+
+typedef int (*PthreadMutexLockFunction)(pthread_mutex_t*);
+std::atomic<PthreadMutexLockFunction> s_pthreadMutexLock(nullptr);
+
+PthreadMutexLockFunction nextPthreadMutexLock() {
+    PthreadMutexLockFunction function =
+            s_pthreadMutexLock.load(std::memory_order_acquire);
+    if (!function) {
+        function = reinterpret_cast<PthreadMutexLockFunction>(
+                dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+        s_pthreadMutexLock.store(function, std::memory_order_release);
+    }
+    return function;
+}
+
+// Plain ints, so accessing them does not require a TLS wrapper function
+// that could itself allocate on first use.
+__attribute__((tls_model("initial-exec"))) thread_local int t_realtimeDepth = 0;
+__attribute__((tls_model("initial-exec"))) thread_local int t_allowDepth = 0;
+__attribute__((tls_model("initial-exec"))) thread_local bool t_inHook = false;
+
+struct Initializer {
+    Initializer() {
+        // The first call of backtrace() loads the unwinder library, which
+        // allocates. Do it once here instead of on the real-time thread.
+        void* frames[2];
+        backtrace(frames, 2);
+        nextPthreadMutexLock();
+        const char* pAbort = getenv("MIXXX_RT_AUDIT_ABORT");
+        s_abortOnViolation = pAbort && pAbort[0] != '\0' && pAbort[0] != '0';
+    }
+};
+Initializer s_initializer;
+
+inline bool isAudited() {
+    return t_realtimeDepth > 0 && t_allowDepth == 0 && !t_inHook;
+}
+
+void recordViolation(Kind kind) {
+    t_inHook = true;
+    const int index = s_violationCount.fetch_add(1, std::memory_order_relaxed);
+    if (index < kMaxReports) {
+        Report& report = s_reports[index];
+        report.kind = kind;
+        report.frameCount = backtrace(report.frames, kMaxFrames);
+    }
+    if (s_abortOnViolation) {
+        abort();
+    }
+    t_inHook = false;
+}
+
+const char* kindName(Kind kind) {
+    switch (kind) {
+    case Kind::Allocation:
+        return "allocation";
+    case Kind::Deallocation:
+        return "deallocation";
+    case Kind::Lock:
+        return "pthread_mutex_lock";
+    }
+    return "unknown";
+}
+
+} // anonymous namespace
+
+extern "C" {
+
+void* malloc(size_t size) {
+    if (isAudited()) {
+        recordViolation(Kind::Allocation);
+    }
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    if (isAudited()) {
+        recordViolation(Kind::Allocation);
+    }
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    if (isAudited()) {
+        recordViolation(Kind::Allocation);
+    }
+    return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr) {
+    if (ptr && isAudited()) {
+        recordViolation(Kind::Deallocation);
+    }
+    __libc_free(ptr);
+}
+
+int posix_memalign(void** memptr, size_t alignment, size_t size) {
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    if (isAudited()) {
+        recordViolation(Kind::Allocation);
+    }
+    void* ptr = __libc_memalign(alignment, size);
+    if (!ptr) {
+        return ENOMEM;
+    }
+    *memptr = ptr;
+    return 0;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    if (isAudited()) {
+        recordViolation(Kind::Allocation);
+    }
+    return __libc_memalign(alignment, size);
+}
+
+int pthread_mutex_lock(pthread_mutex_t* mutex) {
+    if (isAudited()) {
+        recordViolation(Kind::Lock);
+    }
+    return nextPthreadMutexLock()(mutex);
+}
+
+} // extern "C"
+
+namespace mixxx {
+
+namespace rtaudit {
+
+ScopedRealtimeSection::ScopedRealtimeSection() {
+    ++t_realtimeDepth;
+}
+
+ScopedRealtimeSection::~ScopedRealtimeSection() {
+    --t_realtimeDepth;
+}
+
+ScopedAllowBlocking::ScopedAllowBlocking() {
+    ++t_allowDepth;
+}
+
+ScopedAllowBlocking::~ScopedAllowBlocking() {
+    --t_allowDepth;
+}
+
+bool isRealtimeThread() {
+    return t_realtimeDepth > 0;
+}
+
+int violationCount() {
+    return s_violationCount.load(std::memory_order_relaxed);
+}
+
+QStringList violationReports() {
+    QStringList reports;
+    const int count = std::min(violationCount(), kMaxReports);
+    for (int i = 0; i < count; ++i) {
+        const Report& report = s_reports[i];
+        QString text = QStringLiteral("Real-time violation #%1: %2\n")
+                               .arg(QString::number(i + 1),
+                                       kindName(report.kind));
+        char** symbols = backtrace_symbols(report.frames, report.frameCount);
+        // Skip recordViolation() and the interposed function itself
+        for (int frame = 2; frame < report.frameCount; ++frame) {
+            text += QStringLiteral("    ");
+            if (symbols) {
+                text += QString::fromLocal8Bit(symbols[frame]);
+            } else {
+                text += QString::number(
+                        reinterpret_cast<quintptr>(report.frames[frame]), 16);
+            }
+            text += QChar('\n');
+        }
+        free(symbols);
+        reports.append(text);
+    }
+    if (violationCount() > kMaxReports) {
+        reports.append(QStringLiteral("... %1 more violations not recorded")
+                               .arg(violationCount() - kMaxReports));
+    }
+    return reports;
+}
+
+void reset() {
+    s_violationCount.store(0, std::memory_order_relaxed);
+}
+
+} // namespace rtaudit
+
+} // namespace mixxx
+
+#endif // MIXXX_RT_AUDIT
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+// Auditing of the real-time audio thread.
+//
+// When Mixxx is configured with -DRT_AUDIT=ON the global allocation
+// functions (malloc, calloc, realloc, free, posix_memalign, aligned_alloc)
+// and pthread_mutex_lock are interposed. Any call made from a thread that is
+// currently inside a ScopedRealtimeSection is recorded as a violation together
+// with its stack trace. This is meant for debug and CI builds to catch code
+// that allocates or blocks in SoundManager::onDeviceOutputCallback /
+// EngineMaster::process.
+//
+// Notes:
+// * QMutex on Linux is built on futexes and does not go through
+//   pthread_mutex_lock, so contended QMutex locks are not detected.
+// * The interposition is only implemented on Linux with glibc. On all other
+//   platforms and in regular builds every function in here is a no-op.
+//
+// Set the environment variable MIXXX_RT_AUDIT_ABORT=1 to abort() on the first
+// violation, which gives a full core dump at the offending call site.
+namespace mixxx {
+
+namespace rtaudit {
+
+#ifdef MIXXX_RT_AUDIT
+
+/// Marks the calling thread as real-time for the lifetime of this object.
+/// Sections may be nested.
+class ScopedRealtimeSection {
+  public:
+    ScopedRealtimeSection();
+    ~ScopedRealtimeSection();
+
+    ScopedRealtimeSection(const ScopedRealtimeSection&) = delete;
+    ScopedRealtimeSection& operator=(const ScopedRealtimeSection&) = delete;
+};
+
+/// Temporarily suspends auditing inside a real-time section, for known and
+/// accepted calls, e.g. one-time initialization on the first callback.
+class ScopedAllowBlocking {
+  public:
+    ScopedAllowBlocking();
+    ~ScopedAllowBlocking();
+
+    ScopedAllowBlocking(const ScopedAllowBlocking&) = delete;
+    ScopedAllowBlocking& operator=(const ScopedAllowBlocking&) = delete;
+};
+
+constexpr bool isEnabled() {
+    return true;
+}
+
+/// Returns true if the calling thread is inside a real-time section.
+bool isRealtimeThread();
+
+/// Number of violations since the last reset(), including those that did
+/// not fit into the report buffer.
+int violationCount();
+
+/// Symbolized reports of the recorded violations. This allocates and must
+/// not be called from the real-time thread.
+QStringList violationReports();
+
+/// Discards all recorded violations. Must not be called concurrently with
+/// a real-time section.
+void reset();
+
+#else // MIXXX_RT_AUDIT
+
+class ScopedRealtimeSection {
+  public:
+    ScopedRealtimeSection() = default;
+};
+
+class ScopedAllowBlocking {
+  public:
+    ScopedAllowBlocking() = default;
+};
+
+constexpr bool isEnabled() {
+    return false;
+}
+
+inline bool isRealtimeThread() {
+    return false;
+}
+
+inline int violationCount() {
+    return 0;
+}
+
+inline QStringList violationReports() {
+    return QStringList();
+}
+
+inline void reset() {
+}
+
+#endif // MIXXX_RT_AUDIT
+
+} // namespace rtaudit
+
+} // namespace mixxx
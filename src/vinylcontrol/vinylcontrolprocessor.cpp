@@ -39,7 +39,7 @@ VinylControlProcessor::VinylControlProcessor(QObject* pParent, UserSettingsPoint
 
 VinylControlProcessor::~VinylControlProcessor() {
     m_bQuit = true;
-    m_samplesAvailableSignal.wakeAll();
+    m_samplesAvailable.notify();
     wait();
 
     delete m_pToggle;
@@ -68,12 +68,12 @@ void VinylControlProcessor::setSignalQualityReporting(bool enable) {
 
 void VinylControlProcessor::shutdown() {
     m_bQuit = true;
-    m_samplesAvailableSignal.wakeAll();
+    m_samplesAvailable.notify();
 }
 
 void VinylControlProcessor::requestReloadConfig() {
     m_bReloadConfig = true;
-    m_samplesAvailableSignal.wakeAll();
+    m_samplesAvailable.notify();
 }
 
 void VinylControlProcessor::run() {
@@ -128,10 +128,22 @@ void VinylControlProcessor::run() {
 
         // Wait for a signal from the main thread or engine thread that we
         // should wake up and process input.
-        m_waitForSampleMutex.lock();
-        m_samplesAvailableSignal.wait(&m_waitForSampleMutex);
-        m_waitForSampleMutex.unlock();
+        const auto key = m_samplesAvailable.prepareWait();
+        if (m_bQuit || m_bReloadConfig || hasPendingSamples()) {
+            m_samplesAvailable.cancelWait();
+        } else {
+            m_samplesAvailable.wait(key);
+        }
+    }
+}
+
+bool VinylControlProcessor::hasPendingSamples() const {
+    for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
+        if (m_samplePipes[i]->readAvailable() > 0) {
+            return true;
+        }
     }
+    return false;
 }
 
 void VinylControlProcessor::reloadConfig() {
@@ -234,7 +246,7 @@ void VinylControlProcessor::receiveBuffer(const AudioInput& input,
                    << "VCIndex:" << vcIndex;
     }
 
-    m_samplesAvailableSignal.wakeAll();
+    m_samplesAvailable.notify();
 }
 
 void VinylControlProcessor::toggleDeck(double value) {
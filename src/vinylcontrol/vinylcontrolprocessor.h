@@ -4,11 +4,11 @@
 #include <QObject>
 #include <QThread>
 #include <QVector>
-#include <QWaitCondition>
 
 #include "preferences/usersettings.h"
 #include "soundio/soundmanagerutil.h"
 #include "util/compatibility/qmutex.h"
+#include "util/eventcount.h"
 #include "util/fifo.h"
 #include "vinylcontrol/vinylsignalquality.h"
 
@@ -63,6 +63,7 @@ class VinylControlProcessor : public QThread, public AudioDestination {
 
   private:
     void reloadConfig();
+    bool hasPendingSamples() const;
 
     UserSettingsPointer m_pConfig;
     ControlPushButton* m_pToggle;
@@ -71,8 +72,8 @@ class VinylControlProcessor : public QThread, public AudioDestination {
     // kMaximumVinylControlInputs pipes.
     FIFO<CSAMPLE>* m_samplePipes[kMaximumVinylControlInputs];
     CSAMPLE* m_pWorkBuffer;
-    QWaitCondition m_samplesAvailableSignal;
-    QMutex m_waitForSampleMutex;
+    // Signaled from the engine callback, must never block the producer
+    EventCount m_samplesAvailable;
     QT_RECURSIVE_MUTEX m_processorsLock;
     QVector<VinylControl*> m_processors;
     FIFO<VinylSignalQualityReport> m_signalQualityFifo;
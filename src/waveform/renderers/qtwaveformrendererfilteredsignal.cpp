@@ -107,18 +107,24 @@ int QtWaveformRendererFilteredSignal::buildPolygon() {
         return 0;
     }
 
-    const int dataSize = waveform->getDataSize();
+    const int level = getPyramidLevel(*waveform);
+    const int dataSize = waveform->getPyramidDataSize(level);
     if (dataSize <= 1) {
         return 0;
     }
 
-    const WaveformData* data = waveform->data();
+    const WaveformData* data = waveform->getPyramidData(level);
     if (data == nullptr) {
         return 0;
     }
 
-    const double firstVisualIndex = m_waveformRenderer->getFirstDisplayedPosition() * dataSize;
-    const double lastVisualIndex = m_waveformRenderer->getLastDisplayedPosition() * dataSize;
+    // The track length in visual samples of the pyramid level
+    const double levelVisualSamples =
+            static_cast<double>(waveform->getDataSize()) / (1 << level);
+    const double firstVisualIndex =
+            m_waveformRenderer->getFirstDisplayedPosition() * levelVisualSamples;
+    const double lastVisualIndex =
+            m_waveformRenderer->getLastDisplayedPosition() * levelVisualSamples;
 
     m_polygon[0].clear();
     m_polygon[1].clear();
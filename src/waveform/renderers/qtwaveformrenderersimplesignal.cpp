@@ -49,12 +49,13 @@ void QtWaveformRendererSimpleSignal::draw(QPainter* painter, QPaintEvent* /*even
         return;
     }
 
-    const int dataSize = waveform->getDataSize();
+    const int level = getPyramidLevel(*waveform);
+    const int dataSize = waveform->getPyramidDataSize(level);
     if (dataSize <= 1) {
         return;
     }
 
-    const WaveformData* data = waveform->data();
+    const WaveformData* data = waveform->getPyramidData(level);
     if (data == nullptr) {
         return;
     }
@@ -90,8 +91,13 @@ void QtWaveformRendererSimpleSignal::draw(QPainter* painter, QPaintEvent* /*even
         painter->drawLine(0,0,m_waveformRenderer->getLength(),0);
     }
 
-    const double firstVisualIndex = m_waveformRenderer->getFirstDisplayedPosition() * dataSize;
-    const double lastVisualIndex = m_waveformRenderer->getLastDisplayedPosition() * dataSize;
+    // The track length in visual samples of the pyramid level
+    const double levelVisualSamples =
+            static_cast<double>(waveform->getDataSize()) / (1 << level);
+    const double firstVisualIndex =
+            m_waveformRenderer->getFirstDisplayedPosition() * levelVisualSamples;
+    const double lastVisualIndex =
+            m_waveformRenderer->getLastDisplayedPosition() * levelVisualSamples;
     m_polygon.clear();
     m_polygon.reserve(2 * m_waveformRenderer->getLength() + 2);
     m_polygon.append(QPointF(0.0, 0.0));
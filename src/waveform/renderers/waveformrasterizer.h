@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QImage>
+#include <QRgb>
+#include <vector>
+
+#include "util/class.h"
+
+class QPainter;
+
+/// CPU rasterizer for the software waveform renderers that draw a single
+/// vertical span per pixel column.
+///
+/// Instead of issuing a QPainter::drawLine() per column, the spans of a
+/// layer are collected first and then blended row by row into a QImage.
+/// The per row loop is branch free and vectorized by the compiler. The
+/// image is reused between frames and only reallocated on resize.
+///
+/// Usage per frame:
+///
+///     rasterizer.begin(length, breadth, devicePixelRatio);
+///     for each layer:
+///         rasterizer.setSpan(x, y1, y2, color); // for each column
+///         rasterizer.blendLayer();
+///     rasterizer.end(pPainter);
+///
+/// All coordinates are in logical pixels of the horizontal orientation.
+/// Vertical waveforms are drawn by the transformation of the painter.
+class WaveformRasterizer {
+  public:
+    WaveformRasterizer();
+
+    /// Starts a new frame with a transparent image.
+    void begin(int length, int breadth, double devicePixelRatio);
+
+    /// Sets the span of column x of the current layer from y1 (inclusive)
+    /// to y2 (exclusive), in any order. The color is not premultiplied.
+    void setSpan(int x, int y1, int y2, QRgb color);
+
+    /// Blends the current layer over the image and starts a new empty
+    /// layer.
+    void blendLayer();
+
+    /// Draws the image with the top left corner at the origin.
+    void end(QPainter* pPainter);
+
+    const QImage& image() const {
+        return m_image;
+    }
+
+  private:
+    QImage m_image;
+    double m_devicePixelRatio;
+    int m_width;
+    int m_height;
+
+    // The spans of the current layer per device pixel column
+    std::vector<int> m_top;
+    std::vector<int> m_bottom;
+    std::vector<QRgb> m_colors;
+    // The rows touched by the current layer
+    int m_minTop;
+    int m_maxBottom;
+
+    DISALLOW_COPY_AND_ASSIGN(WaveformRasterizer);
+};
@@ -60,7 +60,7 @@ void WaveformRenderBeat::draw(QPainter* painter, QPaintEvent* /*event*/) {
             firstDisplayedPosition * trackSamples);
     const auto endPosition = mixxx::audio::FramePos::fromEngineSamplePos(
             lastDisplayedPosition * trackSamples);
-    auto it = trackBeats->iteratorFrom(startPosition);
+    auto it = trackBeats->iteratorFrom(startPosition, &m_beatsCursor);
 
     // if no beat do not waste time saving/restoring painter
     if (it == trackBeats->cend() || *it > endPosition) {
@@ -3,6 +3,7 @@
 #include <QColor>
 
 #include "skin/legacy/skincontext.h"
+#include "track/beats.h"
 #include "util/class.h"
 #include "waveform/renderers/waveformrendererabstract.h"
 
@@ -17,6 +18,7 @@ class WaveformRenderBeat : public WaveformRendererAbstract {
   private:
     QColor m_beatColor;
     QVector<QLineF> m_beats;
+    mixxx::Beats::Cursor m_beatsCursor;
 
     DISALLOW_COPY_AND_ASSIGN(WaveformRenderBeat);
 };
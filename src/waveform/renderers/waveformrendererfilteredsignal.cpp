@@ -40,12 +40,13 @@ void WaveformRendererFilteredSignal::draw(QPainter* painter,
         return;
     }
 
-    const int dataSize = waveform->getDataSize();
+    const int level = getPyramidLevel(*waveform);
+    const int dataSize = waveform->getPyramidDataSize(level);
     if (dataSize <= 1) {
         return;
     }
 
-    const WaveformData* data = waveform->data();
+    const WaveformData* data = waveform->getPyramidData(level);
     if (data == nullptr) {
         return;
     }
@@ -62,8 +63,13 @@ void WaveformRendererFilteredSignal::draw(QPainter* painter,
         painter->setTransform(QTransform(0, 1, 1, 0, 0, 0));
     }
 
-    const double firstVisualIndex = m_waveformRenderer->getFirstDisplayedPosition() * dataSize;
-    const double lastVisualIndex = m_waveformRenderer->getLastDisplayedPosition() * dataSize;
+    // The track length in visual samples of the pyramid level
+    const double levelVisualSamples =
+            static_cast<double>(waveform->getDataSize()) / (1 << level);
+    const double firstVisualIndex =
+            m_waveformRenderer->getFirstDisplayedPosition() * levelVisualSamples;
+    const double lastVisualIndex =
+            m_waveformRenderer->getLastDisplayedPosition() * levelVisualSamples;
 
     // Represents the # of waveform data points per horizontal pixel.
     const double gain = (lastVisualIndex - firstVisualIndex) /
@@ -222,18 +228,30 @@ void WaveformRendererFilteredSignal::draw(QPainter* painter,
         }
     }
 
-    double lineThickness = math_max(1.0, 1.0 / m_waveformRenderer->getVisualSamplePerPixel());
-
-    painter->setPen(QPen(QBrush(m_pColors->getLowColor()), lineThickness, Qt::SolidLine, Qt::FlatCap));
+    m_rasterizer.begin(m_waveformRenderer->getLength(),
+            m_waveformRenderer->getBreadth(),
+            m_waveformRenderer->getDevicePixelRatio());
     if (m_pLowKillControlObject && m_pLowKillControlObject->get() == 0.0) {
-       painter->drawLines(&m_lowLines[0], actualLowLineNumber);
+        rasterizeLines(m_lowLines, actualLowLineNumber, m_pColors->getLowColor());
     }
-    painter->setPen(QPen(QBrush(m_pColors->getMidColor()), lineThickness, Qt::SolidLine, Qt::FlatCap));
     if (m_pMidKillControlObject && m_pMidKillControlObject->get() == 0.0) {
-        painter->drawLines(&m_midLines[0], actualMidLineNumber);
+        rasterizeLines(m_midLines, actualMidLineNumber, m_pColors->getMidColor());
     }
-    painter->setPen(QPen(QBrush(m_pColors->getHighColor()), lineThickness, Qt::SolidLine, Qt::FlatCap));
     if (m_pHighKillControlObject && m_pHighKillControlObject->get() == 0.0) {
-        painter->drawLines(&m_highLines[0], actualHighLineNumber);
+        rasterizeLines(m_highLines, actualHighLineNumber, m_pColors->getHighColor());
+    }
+    m_rasterizer.end(painter);
+}
+
+void WaveformRendererFilteredSignal::rasterizeLines(
+        const std::vector<QLineF>& lines, int lineCount, const QColor& color) {
+    const QRgb rgba = color.rgba();
+    for (int i = 0; i < lineCount; ++i) {
+        const QLineF& line = lines[i];
+        m_rasterizer.setSpan(static_cast<int>(line.x1()),
+                static_cast<int>(line.y1()),
+                static_cast<int>(line.y2()),
+                rgba);
     }
+    m_rasterizer.blendLayer();
 }
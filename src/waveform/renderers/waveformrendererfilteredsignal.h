@@ -4,6 +4,7 @@
 #include <QLineF>
 
 #include "util/class.h"
+#include "waveform/renderers/waveformrasterizer.h"
 #include "waveform/renderers/waveformrenderersignalbase.h"
 
 class WaveformRendererFilteredSignal : public WaveformRendererSignalBase {
@@ -19,9 +20,12 @@ class WaveformRendererFilteredSignal : public WaveformRendererSignalBase {
     virtual void onResize();
 
   private:
+    void rasterizeLines(const std::vector<QLineF>& lines, int lineCount, const QColor& color);
+
     std::vector<QLineF> m_lowLines;
     std::vector<QLineF> m_midLines;
     std::vector<QLineF> m_highLines;
+    WaveformRasterizer m_rasterizer;
 
     DISALLOW_COPY_AND_ASSIGN(WaveformRendererFilteredSignal);
 };
@@ -33,12 +33,13 @@ void WaveformRendererHSV::draw(QPainter* painter,
         return;
     }
 
-    const int dataSize = waveform->getDataSize();
+    const int level = getPyramidLevel(*waveform);
+    const int dataSize = waveform->getPyramidDataSize(level);
     if (dataSize <= 1) {
         return;
     }
 
-    const WaveformData* data = waveform->data();
+    const WaveformData* data = waveform->getPyramidData(level);
     if (data == nullptr) {
         return;
     }
@@ -55,8 +56,13 @@ void WaveformRendererHSV::draw(QPainter* painter,
         painter->setTransform(QTransform(0, 1, 1, 0, 0, 0));
     }
 
-    const double firstVisualIndex = m_waveformRenderer->getFirstDisplayedPosition() * dataSize;
-    const double lastVisualIndex = m_waveformRenderer->getLastDisplayedPosition() * dataSize;
+    // The track length in visual samples of the pyramid level
+    const double levelVisualSamples =
+            static_cast<double>(waveform->getDataSize()) / (1 << level);
+    const double firstVisualIndex =
+            m_waveformRenderer->getFirstDisplayedPosition() * levelVisualSamples;
+    const double lastVisualIndex =
+            m_waveformRenderer->getLastDisplayedPosition() * levelVisualSamples;
 
     const double offset = firstVisualIndex;
 
@@ -78,10 +84,6 @@ void WaveformRendererHSV::draw(QPainter* painter,
     QColor color;
     float lo, hi, total;
 
-    QPen pen;
-    pen.setCapStyle(Qt::FlatCap);
-    pen.setWidthF(math_max(1.0, 1.0 / m_waveformRenderer->getVisualSamplePerPixel()));
-
     const int breadth = m_waveformRenderer->getBreadth();
     const float halfBreadth = static_cast<float>(breadth) / 2.0f;
 
@@ -91,6 +93,10 @@ void WaveformRendererHSV::draw(QPainter* painter,
     painter->setPen(m_pColors->getAxesColor());
     painter->drawLine(QLineF(0, halfBreadth, m_waveformRenderer->getLength(), halfBreadth));
 
+    m_rasterizer.begin(m_waveformRenderer->getLength(),
+            breadth,
+            m_waveformRenderer->getDevicePixelRatio());
+
     for (int x = 0; x < m_waveformRenderer->getLength(); ++x) {
         // Width of the x position in visual indices.
         const double xSampleWidth = gain * x;
@@ -161,27 +167,30 @@ void WaveformRendererHSV::draw(QPainter* painter,
             // Set color
             color.setHsvF(h, 1.0-hi, 1.0-lo);
 
-            pen.setColor(color);
-
-            painter->setPen(pen);
             switch (m_alignment) {
                 case Qt::AlignBottom :
                 case Qt::AlignRight :
-                    painter->drawLine(
-                        x, breadth,
-                        x, breadth - (int)(heightFactor * (float)math_max(maxAll[0],maxAll[1])));
+                    m_rasterizer.setSpan(x,
+                            breadth,
+                            breadth - (int)(heightFactor * (float)math_max(maxAll[0], maxAll[1])),
+                            color.rgba());
                     break;
                 case Qt::AlignTop :
                 case Qt::AlignLeft :
-                    painter->drawLine(
-                        x, 0,
-                        x, (int)(heightFactor * (float)math_max(maxAll[0],maxAll[1])));
+                    m_rasterizer.setSpan(x,
+                            0,
+                            (int)(heightFactor * (float)math_max(maxAll[0], maxAll[1])),
+                            color.rgba());
                     break;
                 default :
-                    painter->drawLine(
-                        x, (int)(halfBreadth - heightFactor * (float)maxAll[0]),
-                        x, (int)(halfBreadth + heightFactor * (float)maxAll[1]));
+                    m_rasterizer.setSpan(x,
+                            (int)(halfBreadth - heightFactor * (float)maxAll[0]),
+                            (int)(halfBreadth + heightFactor * (float)maxAll[1]),
+                            color.rgba());
             }
         }
     }
+
+    m_rasterizer.blendLayer();
+    m_rasterizer.end(painter);
 }
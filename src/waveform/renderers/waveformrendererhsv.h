@@ -1,6 +1,7 @@
 #pragma once
 
 #include "util/class.h"
+#include "waveformrasterizer.h"
 #include "waveformrenderersignalbase.h"
 
 class WaveformRendererHSV : public WaveformRendererSignalBase {
@@ -14,5 +15,7 @@ class WaveformRendererHSV : public WaveformRendererSignalBase {
     virtual void draw(QPainter* painter, QPaintEvent* event);
 
   private:
+    WaveformRasterizer m_rasterizer;
+
     DISALLOW_COPY_AND_ASSIGN(WaveformRendererHSV);
 };
@@ -32,12 +32,13 @@ void WaveformRendererRGB::draw(QPainter* painter,
         return;
     }
 
-    const int dataSize = waveform->getDataSize();
+    const int level = getPyramidLevel(*waveform);
+    const int dataSize = waveform->getPyramidDataSize(level);
     if (dataSize <= 1) {
         return;
     }
 
-    const WaveformData* data = waveform->data();
+    const WaveformData* data = waveform->getPyramidData(level);
     if (data == nullptr) {
         return;
     }
@@ -54,8 +55,13 @@ void WaveformRendererRGB::draw(QPainter* painter,
         painter->setTransform(QTransform(0, 1, 1, 0, 0, 0));
     }
 
-    const double firstVisualIndex = m_waveformRenderer->getFirstDisplayedPosition() * dataSize;
-    const double lastVisualIndex = m_waveformRenderer->getLastDisplayedPosition() * dataSize;
+    // The track length in visual samples of the pyramid level
+    const double levelVisualSamples =
+            static_cast<double>(waveform->getDataSize()) / (1 << level);
+    const double firstVisualIndex =
+            m_waveformRenderer->getFirstDisplayedPosition() * levelVisualSamples;
+    const double lastVisualIndex =
+            m_waveformRenderer->getLastDisplayedPosition() * levelVisualSamples;
 
     const double offset = firstVisualIndex;
 
@@ -69,10 +75,6 @@ void WaveformRendererRGB::draw(QPainter* painter,
 
     QColor color;
 
-    QPen pen;
-    pen.setCapStyle(Qt::FlatCap);
-    pen.setWidthF(math_max(1.0, 1.0 / m_waveformRenderer->getVisualSamplePerPixel()));
-
     const int breadth = m_waveformRenderer->getBreadth();
     const float halfBreadth = static_cast<float>(breadth) / 2.0f;
 
@@ -82,6 +84,10 @@ void WaveformRendererRGB::draw(QPainter* painter,
     painter->setPen(m_pColors->getAxesColor());
     painter->drawLine(QLineF(0, halfBreadth, m_waveformRenderer->getLength(), halfBreadth));
 
+    m_rasterizer.begin(m_waveformRenderer->getLength(),
+            breadth,
+            m_waveformRenderer->getDevicePixelRatio());
+
     for (int x = 0; x < m_waveformRenderer->getLength(); ++x) {
         // Width of the x position in visual indices.
         const double xSampleWidth = gain * x;
@@ -153,27 +159,30 @@ void WaveformRendererRGB::draw(QPainter* painter,
             // Set color
             color.setRgbF(red / max, green / max, blue / max);
 
-            pen.setColor(color);
-
-            painter->setPen(pen);
             switch (m_alignment) {
                 case Qt::AlignBottom:
                 case Qt::AlignRight:
-                    painter->drawLine(
-                        x, breadth,
-                        x, breadth - (int)(heightFactor * sqrtf(math_max(maxAll, maxAllNext))));
+                    m_rasterizer.setSpan(x,
+                            breadth,
+                            breadth - (int)(heightFactor * sqrtf(math_max(maxAll, maxAllNext))),
+                            color.rgba());
                     break;
                 case Qt::AlignTop:
                 case Qt::AlignLeft:
-                    painter->drawLine(
-                        x, 0,
-                        x, (int)(heightFactor * sqrtf(math_max(maxAll, maxAllNext))));
+                    m_rasterizer.setSpan(x,
+                            0,
+                            (int)(heightFactor * sqrtf(math_max(maxAll, maxAllNext))),
+                            color.rgba());
                     break;
                 default:
-                    painter->drawLine(
-                        x, (int)(halfBreadth - heightFactor * sqrtf(maxAll)),
-                        x, (int)(halfBreadth + heightFactor * sqrtf(maxAllNext)));
+                    m_rasterizer.setSpan(x,
+                            (int)(halfBreadth - heightFactor * sqrtf(maxAll)),
+                            (int)(halfBreadth + heightFactor * sqrtf(maxAllNext)),
+                            color.rgba());
             }
         }
     }
+
+    m_rasterizer.blendLayer();
+    m_rasterizer.end(painter);
 }
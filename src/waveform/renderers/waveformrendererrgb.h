@@ -1,6 +1,7 @@
 #pragma once
 
 #include "util/class.h"
+#include "waveformrasterizer.h"
 #include "waveformrenderersignalbase.h"
 
 class WaveformRendererRGB : public WaveformRendererSignalBase {
@@ -13,5 +14,7 @@ class WaveformRendererRGB : public WaveformRendererSignalBase {
     virtual void draw(QPainter* painter, QPaintEvent* event);
 
   private:
+    WaveformRasterizer m_rasterizer;
+
     DISALLOW_COPY_AND_ASSIGN(WaveformRendererRGB);
 };
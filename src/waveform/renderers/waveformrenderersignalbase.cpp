@@ -2,6 +2,7 @@
 
 #include <QDomNode>
 
+#include "waveform/waveform.h"
 #include "waveform/waveformwidgetfactory.h"
 #include "waveformwidgetrenderer.h"
 #include "control/controlobject.h"
@@ -226,3 +227,11 @@ void WaveformRendererSignalBase::getGains(float* pAllGain, float* pLowGain,
         }
     }
 }
+
+int WaveformRendererSignalBase::getPyramidLevel(const Waveform& waveform) const {
+    const double visualSamplesPerPixel =
+            (m_waveformRenderer->getLastDisplayedPosition() -
+                    m_waveformRenderer->getFirstDisplayedPosition()) *
+            waveform.getDataSize() / m_waveformRenderer->getLength();
+    return waveform.getPyramidLevel(visualSamplesPerPixel);
+}
@@ -6,6 +6,7 @@
 
 class ControlObject;
 class ControlProxy;
+class Waveform;
 
 class WaveformRendererSignalBase : public WaveformRendererAbstract {
 public:
@@ -24,6 +25,10 @@ public:
     void getGains(float* pAllGain, float* pLowGain, float* pMidGain,
                   float* highGain);
 
+    // Returns the level of the waveform pyramid with one or two visual
+    // frames per pixel at the current zoom level.
+    int getPyramidLevel(const Waveform& waveform) const;
+
   protected:
     ControlProxy* m_pEQEnabled;
     ControlProxy* m_pLowFilterControlObject;
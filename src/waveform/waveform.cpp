@@ -1,7 +1,9 @@
 #include <QtDebug>
+#include <cmath>
 
 #include "waveform/waveform.h"
 #include "proto/waveform.pb.h"
+#include "util/math.h"
 
 using namespace mixxx::track;
 
@@ -195,12 +197,14 @@ void Waveform::readByteArray(const QByteArray& data) {
     }
     m_completion = dataSize;
     m_saveState = SaveState::Saved;
+    updatePyramid();
 }
 
 void Waveform::resize(int size) {
     m_dataSize = size;
     m_textureStride = computeTextureStride(size);
     m_data.resize(m_textureStride * m_textureStride);
+    allocatePyramid();
 }
 
 void Waveform::assign(int size, int value) {
@@ -208,6 +212,69 @@ void Waveform::assign(int size, int value) {
     m_textureStride = computeTextureStride(size);
     m_data.assign(m_textureStride * m_textureStride, value);
     m_saveState = SaveState::SavePending;
+    allocatePyramid();
+}
+
+void Waveform::allocatePyramid() {
+    m_pyramidMax.clear();
+    m_pyramidDataSizes.clear();
+    int frames = m_dataSize / kNumChannels;
+    while (frames > 1) {
+        frames = (frames + 1) / 2;
+        m_pyramidDataSizes.push_back(frames * kNumChannels);
+        m_pyramidMax.emplace_back(frames * kNumChannels, WaveformData(0));
+    }
+    m_pyramidCompletedFrames.assign(m_pyramidDataSizes.size(), 0);
+}
+
+int Waveform::getPyramidLevel(double visualSamplesPerPixel) const {
+    const double visualFramesPerPixel = visualSamplesPerPixel / kNumChannels;
+    if (!(visualFramesPerPixel >= 2.0) || std::isinf(visualFramesPerPixel)) {
+        return 0;
+    }
+    return math_min(std::ilogb(visualFramesPerPixel), getPyramidLevelCount() - 1);
+}
+
+void Waveform::updatePyramid() {
+    const int completion = math_min(getCompletion(), m_dataSize);
+    if (completion <= 0) {
+        return;
+    }
+    // The trailing visual frame of a level with an odd number of frames has
+    // only a single child. It is calculated once the waveform is complete.
+    const bool complete = completion == m_dataSize;
+
+    const WaveformData* pChildMax = data();
+    int childFrames = m_dataSize / kNumChannels;
+    int childCompletedFrames = completion / kNumChannels;
+    for (std::size_t i = 0; i < m_pyramidDataSizes.size(); ++i) {
+        const int frames = m_pyramidDataSizes[i] / kNumChannels;
+        const int completedFrames = complete ? frames : childCompletedFrames / 2;
+        WaveformData* pMax = m_pyramidMax[i].data();
+        for (int frame = m_pyramidCompletedFrames[i]; frame < completedFrames; ++frame) {
+            const bool hasSecondChild = 2 * frame + 1 < childFrames;
+            for (int channel = 0; channel < kNumChannels; ++channel) {
+                const int index = frame * kNumChannels + channel;
+                const int firstChild = 2 * frame * kNumChannels + channel;
+                if (!hasSecondChild) {
+                    pMax[index] = pChildMax[firstChild];
+                    continue;
+                }
+                const int secondChild = firstChild + kNumChannels;
+                const auto& firstMax = pChildMax[firstChild].filtered;
+                const auto& secondMax = pChildMax[secondChild].filtered;
+                auto& max = pMax[index].filtered;
+                max.low = math_max(firstMax.low, secondMax.low);
+                max.mid = math_max(firstMax.mid, secondMax.mid);
+                max.high = math_max(firstMax.high, secondMax.high);
+                max.all = math_max(firstMax.all, secondMax.all);
+            }
+        }
+        m_pyramidCompletedFrames[i] = math_max(m_pyramidCompletedFrames[i], completedFrames);
+        pChildMax = pMax;
+        childFrames = frames;
+        childCompletedFrames = completedFrames;
+    }
 }
 
 void Waveform::dump() const {
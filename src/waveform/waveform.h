@@ -130,12 +130,47 @@ class Waveform {
     // constructor runs.
     const WaveformData* data() const { return &m_data[0];}
 
+    // The waveform pyramid holds downsampled copies of the waveform data,
+    // each level has half the number of visual frames of the level before.
+    // Level 0 is the waveform data itself. Renderers pick the level
+    // matching the displayed density, so the number of visual samples
+    // scanned per pixel does not depend on the zoom level.
+    //
+    // Like the waveform data, the levels are not resized after the
+    // constructor runs and are written while the analysis is running.
+
+    // The number of levels including level 0.
+    int getPyramidLevelCount() const {
+        return static_cast<int>(m_pyramidMax.size()) + 1;
+    }
+
+    // Returns the highest level that still has at least one visual frame
+    // per pixel for the given density of level 0.
+    int getPyramidLevel(double visualSamplesPerPixel) const;
+
+    // The number of visual samples in the level. Like for level 0 the left
+    // and right channels are interleaved.
+    int getPyramidDataSize(int level) const {
+        return level == 0 ? m_dataSize : m_pyramidDataSizes[level - 1];
+    }
+
+    // The per band maximum of the visual samples of level 0 that are
+    // combined in each visual sample.
+    const WaveformData* getPyramidData(int level) const {
+        return level == 0 ? data() : m_pyramidMax[level - 1].data();
+    }
+
+    // Updates the pyramid levels up to the current completion. Called by
+    // the thread that writes the waveform data.
+    void updatePyramid();
+
     void dump() const;
 
   private:
     void readByteArray(const QByteArray& data);
     void resize(int size);
     void assign(int size, int value = 0);
+    void allocatePyramid();
 
     inline WaveformData& at(int i) { return m_data[i];}
     inline unsigned char& low(int i) { return m_data[i].filtered.low;}
@@ -175,6 +210,14 @@ class Waveform {
     // the mutex. The completion of the waveform calculation.
     QAtomicInt m_completion;
 
+    // Level n of the pyramid is stored at index n - 1. Not allowed to change
+    // size after the constructor runs.
+    std::vector<std::vector<WaveformData>> m_pyramidMax;
+    std::vector<int> m_pyramidDataSizes;
+    // The number of visual frames of each level that have been calculated.
+    // Only accessed by the thread calling updatePyramid().
+    std::vector<int> m_pyramidCompletedFrames;
+
     mutable QMutex m_mutex;
 
     DISALLOW_COPY_AND_ASSIGN(Waveform);
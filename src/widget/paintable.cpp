@@ -52,6 +52,27 @@ Paintable::Paintable(const PixmapSource& source, DrawMode mode, double scaleFact
     if (!source.isSVG()) {
         m_pPixmap.reset(WPixmapStore::getPixmapNoCache(source.getPath(), scaleFactor));
     } else {
+#ifdef __APPLE__
+        // Apple does Retina scaling behind the scenes, so we also pass a
+        // Paintable::FIXED image. On the other targets, it is better to
+        // cache the pixmap. We do not do this for TILE and color schemas.
+        // which can result in a correct but possibly blurry picture at a
+        // Retina display. This can be fixed when switching to QT5
+        const bool renderToPixmap = mode == TILE || WPixmapStore::willCorrectColors();
+#else
+        const bool renderToPixmap = mode == TILE || mode == Paintable::FIXED ||
+                WPixmapStore::willCorrectColors();
+#endif
+        const auto& pPixmapCache = WPixmapStore::pixmapCache();
+        if (renderToPixmap && pPixmapCache) {
+            // Skip parsing and rendering the SVG if it has been rendered
+            // on a previous start.
+            const QImage cachedImage = pPixmapCache->loadImage(source, scaleFactor);
+            if (!cachedImage.isNull()) {
+                m_pPixmap.reset(new QPixmap(QPixmap::fromImage(cachedImage)));
+                return;
+            }
+        }
         auto pSvg = std::make_unique<QSvgRenderer>();
         if (!source.getSvgSourceData().isEmpty()) {
             // Call here the different overload for svg content
@@ -68,16 +89,7 @@ Paintable::Paintable(const PixmapSource& source, DrawMode mode, double scaleFact
             return;
         }
         m_pSvg.reset(pSvg.release());
-#ifdef __APPLE__
-        // Apple does Retina scaling behind the scenes, so we also pass a
-        // Paintable::FIXED image. On the other targets, it is better to
-        // cache the pixmap. We do not do this for TILE and color schemas.
-        // which can result in a correct but possibly blurry picture at a
-        // Retina display. This can be fixed when switching to QT5
-        if (mode == TILE || WPixmapStore::willCorrectColors()) {
-#else
-        if (mode == TILE || mode == Paintable::FIXED || WPixmapStore::willCorrectColors()) {
-#endif
+        if (renderToPixmap) {
             // The SVG renderer doesn't directly support tiling, so we render
             // it to a pixmap which will then get tiled.
             QImage copy_buffer(m_pSvg->defaultSize() * scaleFactor, QImage::Format_ARGB32);
@@ -85,6 +97,9 @@ Paintable::Paintable(const PixmapSource& source, DrawMode mode, double scaleFact
             QPainter painter(&copy_buffer);
             m_pSvg->render(&painter);
             WPixmapStore::correctImageColors(&copy_buffer);
+            if (pPixmapCache) {
+                pPixmapCache->saveImage(source, scaleFactor, copy_buffer);
+            }
 
             m_pPixmap.reset(new QPixmap(copy_buffer.size()));
             m_pPixmap->convertFromImage(copy_buffer);
@@ -11,6 +11,7 @@
 QHash<QString, WeakPaintablePointer> WPixmapStore::m_paintableCache;
 QSharedPointer<ImgSource> WPixmapStore::m_loader
         = QSharedPointer<ImgSource>(new ImgLoader());
+QSharedPointer<SkinPixmapCache> WPixmapStore::m_pPixmapCache;
 
 // static
 PaintablePointer WPixmapStore::getPaintable(const PixmapSource& source,
@@ -64,3 +65,8 @@ void WPixmapStore::setLoader(QSharedPointer<ImgSource> ld) {
     // referring to them are destroyed.
     m_paintableCache.clear();
 }
+
+// static
+void WPixmapStore::setPixmapCache(QSharedPointer<SkinPixmapCache> pCache) {
+    m_pPixmapCache = std::move(pCache);
+}
@@ -12,6 +12,7 @@
 
 #include "skin/legacy/imgsource.h"
 #include "skin/legacy/pixmapsource.h"
+#include "skin/legacy/skinpixmapcache.h"
 #include "widget/paintable.h"
 
 
@@ -29,7 +30,15 @@ class WPixmapStore {
     static void correctImageColors(QImage* p);
     static bool willCorrectColors();
 
+    // Persistent store for rasterized SVG images of the current skin,
+    // may be null.
+    static void setPixmapCache(QSharedPointer<SkinPixmapCache> pCache);
+    static const QSharedPointer<SkinPixmapCache>& pixmapCache() {
+        return m_pPixmapCache;
+    }
+
   private:
     static QHash<QString, WeakPaintablePointer> m_paintableCache;
     static QSharedPointer<ImgSource> m_loader;
+    static QSharedPointer<SkinPixmapCache> m_pPixmapCache;
 };